@@ -48,7 +48,8 @@ ifeq ($(TARGET_PLATFORM),PC)
         SYSLDIRS += /usr/lib
         SYSDEFS += SCREEN_DIM_X=1024 SCREEN_DIM_Y=768 \
                    _XOPEN_SOURCE=700 _BSD_SOURCE=1 _GNU_SOURCE=1 DVP_USE_FS \
-                   DVP_USE_SHARED_T SOSAL_USE_SHARED_T
+                   DVP_USE_SHARED_T SOSAL_USE_SHARED_T \
+                   SOSAL_USE_HUGEPAGES SOSAL_USE_MEMFD SOSAL_USE_FUTEX
         UVC_INC := /usr/include
         GTK_PATH := $(realpath /usr/include/gtk-2.0)
         ifneq ($(GTK_PATH),)
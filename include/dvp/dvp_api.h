@@ -28,6 +28,14 @@
 extern "C" {
 #endif
 
+/*!
+ * \brief The environment variable which names a file to receive a trace of the
+ * graph processing. When it is set, \ref DVP_KernelGraph_Init starts recording
+ * and \ref DVP_KernelGraph_Deinit writes Chrome trace event JSON to the file.
+ * \ingroup group_system
+ */
+#define DVP_TRACE_ENV   "DVP_TRACE"
+
 /*!
  * \brief This function creates an instance of DVP which can process a kernel graph.
  * \note This function must be called before any other call in DVP.
@@ -93,6 +101,21 @@ DVP_Error_e DVP_KernelGraphSection_Init(DVP_Handle handle,
                                       DVP_KernelNode_t *pNodes,
                                       DVP_U32 numNodes);
 
+/*!
+ * \brief This function places the CPU nodes of a section on a NUMA node. Their
+ * work is queued to the CPU workers of that node, which are pinned to its CPUs.
+ * Place the images of the section with \ref DVP_Image_Place as well.
+ * \param [in] handle The handle to the DVP context.
+ * \param [in] graph The pointer to the graph to modify.
+ * \param [in] sectionIndex The index of the section to modify
+ * \param [in] numaNode \ref DVP_NUMA_NODE of the node or \ref DVP_NUMA_NODE_ANY.
+ * \ingroup group_sections
+ */
+DVP_Error_e DVP_KernelGraphSection_Place(DVP_Handle handle,
+                                       DVP_KernelGraph_t *graph,
+                                       DVP_U32 sectionIndex,
+                                       DVP_U32 numaNode);
+
 /*!
  * \brief The typedef for callbacks from completed sections.
  * \param [in] cookie Private pointer supplied to \ref vlProcessGraph.
@@ -109,6 +132,11 @@ typedef void (*DVP_SectionComplete_f)(void *cookie, DVP_KernelGraph_t *graph, DV
  * \param [in] graph The pointer to a Kernel Graph structure.
  * \return Returns a boolean to indicate if the graph is correct.
  * \note Each Kernel Node in the graph will be set to a specific error value.
+ * \note When the graph sets aliasImages, the intermediate images, which the graph
+ * writes before it reads them, share memory where their lifetimes do not overlap.
+ * A lifetime runs from the first to the last node which uses the image, following
+ * the order of the sections. Parallel sections count as a single step. The nodes
+ * are then bound to that memory, the caller's images are left as they were.
  * \post \ref DVP_KernelGraph_Process
  * \ingroup group_graphs
  */
@@ -134,13 +162,58 @@ DVP_U32 DVP_KernelGraph_Process(DVP_Handle handle,
 
 /*!
  * \brief This function clears and initializes the DVP_Perf_t structure.
+ * \note An attached histogram stays attached but is emptied.
  * \ingroup group_performance
  * \param [out] perf The performance structure to clear.
  */
 void DVP_Perf_Clear(DVP_Perf_t *perf);
 
 /*!
- * \brief Initializes the performance data in each node. All prexisting performance data is lost.
+ * \brief Attaches or frees a latency histogram on a performance structure so
+ * that percentiles of the captured times can be reported.
+ * \param [in,out] perf The performance structure.
+ * \param [in] enable DVP_TRUE to attach a histogram, DVP_FALSE to free it.
+ * \return Returns DVP_FALSE if the histogram could not be allocated.
+ * \note The histogram is kept on the host, found by the address of the
+ * performance structure, so the structure shared with the remote cores is
+ * unchanged. Only times captured on the host are recorded.
+ * \ingroup group_performance
+ */
+DVP_BOOL DVP_Perf_Histogram(DVP_Perf_t *perf, DVP_BOOL enable);
+
+/*!
+ * \brief Returns a percentile of the captured times in microseconds, or 0 if
+ * no histogram is attached.
+ * \param [in] perf The performance structure.
+ * \param [in] percent The percentile, i.e. 99.9
+ * \pre \ref DVP_Perf_Histogram
+ * \ingroup group_performance
+ */
+DVP_U64 DVP_Perf_Percentile(DVP_Perf_t *perf, double percent);
+
+/*!
+ * \brief Returns the number of times recorded into the histogram of a
+ * performance structure, or 0 if no histogram is attached.
+ * \param [in] perf The performance structure.
+ * \ingroup group_performance
+ */
+DVP_U64 DVP_Perf_Samples(DVP_Perf_t *perf);
+
+/*!
+ * \brief Attaches or frees latency histograms on the graph, each section and
+ * each node of a graph.
+ * \param [in] handle The handle to DVP returned from \ref DVP_KernelGraph_Init.
+ * \param [in] pGraph The graph.
+ * \param [in] enable DVP_TRUE to attach histograms, DVP_FALSE to free them.
+ * \note \ref DVP_KernelGraph_Free frees those of the graph and sections and
+ * \ref DVP_KernelNode_Free those of the nodes.
+ * \ingroup group_performance
+ */
+DVP_BOOL DVP_PerformanceHistograms(DVP_Handle handle, DVP_KernelGraph_t *pGraph, DVP_BOOL enable);
+
+/*!
+ * \brief Initializes the performance data in each node. All prexisting performance data is lost,
+ * attached histograms are kept but emptied.
  * \param [in] handle The handle to DVP returned from \ref DVP_KernelGraph_Init.
  * \param [in] pNodes The array of nodes to clear.
  * \param [in] numNodes The number of nodes in pNodes
@@ -175,7 +248,8 @@ void DVP_PerformancePrint(DVP_Perf_t *pPerf, const char *prefix);
 
 /*!
  * \brief This function calls printf to list the performance metrics of each node in
- * a format which can be cut and pasted into a CSV file.
+ * a format which can be cut and pasted into a CSV file. The percentile columns
+ * are zero for nodes without a histogram.
  * \param [in] handle The handle to DVP returned from \ref DVP_KernelGraph_Init.
  * \param [in] pNodes The array of nodes to print the performance information from.
  * \param [in] numNodes The number of nodes which \ref nodes refers to.
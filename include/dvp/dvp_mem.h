@@ -29,6 +29,63 @@
 extern "C" {
 #endif
 
+/*!
+ * \brief A line alignment to pass to \ref DVP_Image_AllocAligned for images
+ * in CPU memory (\ref DVP_MTYPE_MPUCACHED_VIRTUAL and \ref DVP_MTYPE_MPUCACHED_VIRTUAL_SHARED).
+ * \ingroup group_images
+ */
+#define DVP_IMAGE_ROW_ALIGN     (64)
+
+/*!
+ * \brief The statistics of the pool of freed images and buffers which a DVP handle reuses.
+ * \ingroup group_memory
+ */
+typedef struct _dvp_mem_pool_stats_t {
+    DVP_U32 hits;       /*!< The number of allocations which reused a freed allocation */
+    DVP_U32 misses;     /*!< The number of poolable allocations which went to the allocator */
+    DVP_U32 recycled;   /*!< The number of frees which were kept by the pool */
+    DVP_U32 released;   /*!< The number of pooled allocations returned to the allocator */
+    DVP_U32 count;      /*!< The number of allocations currently in the pool */
+    DVP_U32 bytes;      /*!< The number of bytes currently in the pool */
+    DVP_U32 limit;      /*!< The maximum number of bytes the pool will hold */
+} DVP_MemPool_Stats_t;
+
+/*!
+ * \brief The ways the CPU memory of a handle's allocations can be committed up front.
+ * \see DVP_MemPin_Set
+ * \ingroup group_memory
+ */
+typedef enum _dvp_mem_pin_e {
+    DVP_MEM_PIN_NONE     = 0x0, /*!< Pages are faulted in by their first access */
+    DVP_MEM_PIN_PREFAULT = 0x1, /*!< Pages are faulted in when they are allocated */
+    DVP_MEM_PIN_LOCK     = 0x2, /*!< Pages are faulted in and locked so they can not be reclaimed */
+} DVP_MemPin_e;
+
+/*!
+ * \brief The statistics of the committed memory of a DVP handle.
+ * \ingroup group_memory
+ */
+typedef struct _dvp_mem_pin_stats_t {
+    DVP_U32 flags;      /*!< The current \ref DVP_MemPin_e flags */
+    DVP_U32 prefaulted; /*!< The number of bytes which were faulted in when allocated */
+    DVP_U32 locked;     /*!< The number of bytes which are currently locked */
+    DVP_U32 count;      /*!< The number of planes which are currently locked */
+    DVP_U32 failures;   /*!< The number of allocations which could not be locked */
+} DVP_MemPin_Stats_t;
+
+/*!
+ * \brief The statistics of the cache maintenance which a DVP handle did for
+ * the remote cores.
+ * \ingroup group_memory
+ */
+typedef struct _dvp_cache_ops_stats_t {
+    DVP_U32 flushes;        /*!< The number of flushes the remote managers asked for */
+    DVP_U32 invalidates;    /*!< The number of invalidates the remote managers asked for */
+    DVP_U32 flushed;        /*!< The number of flushes which were issued */
+    DVP_U32 invalidated;    /*!< The number of invalidates which were issued */
+    DVP_U32 batches;        /*!< The number of batches the issued operations were grouped in */
+} DVP_CacheOps_Stats_t;
+
 /*!
  * \brief Unmaps and frees memory from remote cores.
  * \param [in] handle The handle to the DVP system.
@@ -65,10 +122,51 @@ void DVP_Image_Init(DVP_Image_t *pImage, DVP_U32 width, DVP_U32 height, fourcc_t
  * \param [in] pImage The pointer to the initialized image structure.
  * \param [in] dvpMemType The desired memory allocation type.
  * \note Display buffers are already allocated if acquired through DVP_Display_Alloc. Use an appropriate mem type which will not cause a reallocation.
+ * \note Virtual memory images may reuse the memory of a freed image with the
+ * same planes and dimensions, which is not cleared. See \ref DVP_MemPool_Stats.
+ * \note The lines are packed tightly, see \ref DVP_Image_AllocAligned for padded lines.
  * \ingroup group_images
  */
 DVP_BOOL DVP_Image_Alloc(DVP_Handle handle, DVP_Image_t *pImage, DVP_MemType_e dvpMemType);
 
+/*!
+ * \brief Allocates an image like \ref DVP_Image_Alloc with a requested line alignment.
+ * \param [in] handle The handle to DVP.
+ * \param [in] pImage The pointer to the initialized image structure.
+ * \param [in] dvpMemType The desired memory allocation type.
+ * \param [in] rowAlign The byte multiple of the y_stride, 1 packs the lines tightly.
+ * The stride is also kept a multiple of the x_stride.
+ * \note Only CPU memory types are padded, the other types ignore rowAlign.
+ * When the padding changes the stride, all the planes use the same y_stride
+ * and each plane is followed by a line of readable slack.
+ * \note Not every kernel follows the strides of its images on ARM (some NEON
+ * routines assume packed lines), so only pad the images of kernels which do.
+ * \ingroup group_images
+ */
+DVP_BOOL DVP_Image_AllocAligned(DVP_Handle handle, DVP_Image_t *pImage, DVP_MemType_e dvpMemType, DVP_U32 rowAlign);
+
+/*!
+ * \brief Places the pages of an image on the NUMA node of the section which will process it.
+ * \param [in] handle The handle to DVP.
+ * \param [in] pImage The pointer to the allocated image.
+ * \param [in] numaNode \ref DVP_NUMA_NODE of the node or \ref DVP_NUMA_NODE_ANY, which does nothing.
+ * \note Only CPU memory types are placed. Call this before the image is used, as
+ * pages which were already touched can only be moved on real NUMA machines.
+ * \see DVP_KernelGraphSection_Place
+ * \ingroup group_images
+ */
+DVP_BOOL DVP_Image_Place(DVP_Handle handle, DVP_Image_t *pImage, DVP_U32 numaNode);
+
+/*!
+ * \brief Returns the alignment a kernel can rely on when it walks the lines of an image.
+ * \param [in] pImage The image structure.
+ * \return Returns the largest power of two (up to \ref DVP_PAGE_SIZE) which
+ * divides the data pointer and the line range of every plane, or 0 if the
+ * image is not allocated.
+ * \ingroup group_images
+ */
+DVP_U32 DVP_Image_RowAlign(DVP_Image_t *pImage);
+
 /*!
  * \brief Unmaps and Frees the allocated memory in the image.
  * \param [in] handle The handle to DVP.
@@ -350,6 +448,8 @@ DVP_BOOL DVP_Image_PatchEqual(DVP_Image_t *pDst, DVP_Image_t *pSrc);
  * \param [in] handle The handle to DVP.
  * \param [in] pBuffer The pointer to the buffer structure to fill in.
  * \param [in] dvpMemType The memory type requested.
+ * \note Virtual memory buffers may reuse the memory of a freed buffer of the
+ * same size, which is not cleared. See \ref DVP_MemPool_Stats.
  * \ingroup group_buffers
  */
 DVP_BOOL DVP_Buffer_Alloc(DVP_Handle handle, DVP_Buffer_t *pBuffer, DVP_MemType_e dvpMemType);
@@ -392,6 +492,59 @@ DVP_BOOL DVP_Buffer_Import(DVP_Handle handle, DVP_Buffer_t *pBuffer, DVP_S32 sha
  */
 DVP_BOOL DVP_Buffer_Free_Import(DVP_Handle handle, DVP_Buffer_t *pBuffer, DVP_VALUE hdl);
 
+/*!
+ * \brief Releases the oldest images and buffers held by the memory pool of the
+ * handle until it holds no more than maxBytes, and keeps that as its limit.
+ * \param [in] handle The handle to DVP.
+ * \param [in] maxBytes The new limit of the pool. Zero empties and disables the pool.
+ * \ingroup group_memory
+ */
+void DVP_MemPool_Trim(DVP_Handle handle, DVP_U32 maxBytes);
+
+/*!
+ * \brief Retrieves the statistics of the memory pool of the handle.
+ * \param [in] handle The handle to DVP.
+ * \param [out] pStats The structure to fill in.
+ * \return Returns DVP_FALSE if the handle has no memory pool.
+ * \ingroup group_memory
+ */
+DVP_BOOL DVP_MemPool_Stats(DVP_Handle handle, DVP_MemPool_Stats_t *pStats);
+
+/*!
+ * \brief Sets how the CPU memory of the later image and buffer allocations of
+ * the handle is committed. Latency critical graphs can prefault their images
+ * so the first frame does not take a page fault on every line, and lock them so
+ * they are not reclaimed under memory pressure.
+ * \param [in] handle The handle to DVP.
+ * \param [in] flags A combination of \ref DVP_MemPin_e.
+ * \note Locking is limited by RLIMIT_MEMLOCK, allocations which can not be
+ * locked are still prefaulted and counted in \ref DVP_MemPin_Stats_t.failures.
+ * \note Memory recycled by the memory pool stays locked until it is released.
+ * \ingroup group_memory
+ */
+void DVP_MemPin_Set(DVP_Handle handle, DVP_U32 flags);
+
+/*!
+ * \brief Retrieves how much memory of the handle is committed.
+ * \param [in] handle The handle to DVP.
+ * \param [out] pStats The structure to fill in.
+ * \return Returns DVP_FALSE if the handle has no memory system.
+ * \ingroup group_memory
+ */
+DVP_BOOL DVP_MemPin_Stats(DVP_Handle handle, DVP_MemPin_Stats_t *pStats);
+
+/*!
+ * \brief Retrieves how much cache maintenance the handle did for the remote cores.
+ * Flushes of memory nothing local has written since its last flush or
+ * invalidate are skipped, repeated operations within a run are merged and
+ * invalidates wait until the CPU or the client needs the memory.
+ * \param [in] handle The handle to DVP.
+ * \param [out] pStats The structure to fill in.
+ * \return Returns DVP_FALSE if the handle has no memory system.
+ * \ingroup group_memory
+ */
+DVP_BOOL DVP_CacheOps_Stats(DVP_Handle handle, DVP_CacheOps_Stats_t *pStats);
+
 /*!
  * \brief Initializes the buffer structure to the correct parameters.
  * \note Does not allocate any memory!
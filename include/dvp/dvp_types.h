@@ -1330,6 +1330,17 @@ typedef struct _dvp_knode_t2 {
  */
 #define dvp_knode_to(pNode, type)  ((type *)&((pNode)->data[0]))
 
+/*! \brief Lets the CPU nodes of a section run on any NUMA node.
+ * \ingroup group_sections
+ */
+#define DVP_NUMA_NODE_ANY   (0)
+
+/*! \brief Places the CPU nodes of a section on NUMA node n (counting from zero).
+ * The value is offset so that a zeroed section is not placed.
+ * \ingroup group_sections
+ */
+#define DVP_NUMA_NODE(n)    ((DVP_U32)(n) + 1)
+
 /*!
  * \brief This structure allows a user to specify a series of nodes which are called a section.
  * \note This structure will currently stay on the HOST process space so no special allocator is required.
@@ -1342,6 +1353,7 @@ typedef struct _dvp_kernelgraphsection_t {
     DVP_Perf_t        perf;         /*!<  The performance information related to this section only */
     DVP_S32           coreLoad[DVP_CORE_MAX];     /*!<  Used internally to store the local calculation of load due to this section on each DVP CORE */
     DVP_BOOL          skipSection;     /*!<  A boolean to determine if the section should be skipped, defaults to false. */
+    DVP_U32           numaNode;        /*!<  The NUMA node which runs the CPU nodes of this section, defaults to \ref DVP_NUMA_NODE_ANY. \see DVP_NUMA_NODE */
 } DVP_KernelGraphSection_t;
 
 /*!
@@ -1357,6 +1369,7 @@ typedef struct _dvp_kernelgraph_t {
     DVP_U32                  *order;        /*!< The array of order declarations */
     DVP_Perf_t                totalperf;    /*!< This is the total performance of the entire graph */
     DVP_BOOL                  verified;     /*!< This indicates that the graph has been verified. */
+    DVP_BOOL                  aliasImages;  /*!< Lets \ref DVP_KernelGraph_Verify share memory among the intermediate images, which then must not be used outside of the graph. */
 } DVP_KernelGraph_t;
 
 /*! \brief The structure defines how a set of data is shifted as it moves through
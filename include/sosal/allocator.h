@@ -200,6 +200,10 @@ bool_e allocator_free(allocator_t *alloc,
 
 /*!
  * \brief Returns file descriptors to use in sharing memory.
+ * \note With SOSAL_USE_MEMFD, ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED returns the
+ * memfd descriptors of the allocator, which stay valid until the memory is freed.
+ * The caller must not close them and must pass them to the other process itself
+ * (over a UNIX socket for example).
  * \ingroup group_allocators
  */
 bool_e allocator_share(allocator_t *alloc,
@@ -260,6 +264,46 @@ bool_e allocator_invalidate(allocator_t *alloc,
                             ptr_t *ptrs,
                             value_t *hdls);
 
+/*!
+ * \brief Faults in every page of CPU memory, and optionally locks the pages
+ * so they can not be reclaimed, so the first access does not stall.
+ * The contents are preserved. Other memory types are left alone.
+ * \param alloc
+ * \param mtype
+ * \param nptrs
+ * \param ndims
+ * \param dims
+ * \param ptrs
+ * \param lock If true_e, the pages are also locked with mlock.
+ * \return Returns false_e if any plane could not be locked (the pages are still faulted in).
+ * \note Locked memory must be unlocked with \ref allocator_unpin before it is freed.
+ * \ingroup group_allocators
+ */
+bool_e allocator_pin(allocator_t *alloc,
+                     allocator_memory_type_e mtype,
+                     int32_t nptrs,
+                     int32_t ndims,
+                     allocator_dimensions_t *dims,
+                     ptr_t *ptrs,
+                     bool_e lock);
+
+/*!
+ * \brief Unlocks memory which was locked by \ref allocator_pin.
+ * \param alloc
+ * \param mtype
+ * \param nptrs
+ * \param ndims
+ * \param dims
+ * \param ptrs
+ * \ingroup group_allocators
+ */
+bool_e allocator_unpin(allocator_t *alloc,
+                       allocator_memory_type_e mtype,
+                       int32_t nptrs,
+                       int32_t ndims,
+                       allocator_dimensions_t *dims,
+                       ptr_t *ptrs);
+
 /*!
  * \brief Retrieves the underlying implementations device descriptor if supported by the supplied type.
  * \param alloc
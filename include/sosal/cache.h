@@ -21,6 +21,11 @@
  * \file cache.h
  * \brief A Memory Caching Structure which can be used in front of a frequently
  * read file or any high latency access data structure.
+ * \details Line n of the source may only be held by the lines of set n % numSets,
+ * so a lookup only compares the few ways of one set. Each set has its own mutex
+ * and replaces its lines with a clock hand, so threads which touch different sets
+ * do not contend. The fill and commit functions may therefore be called from
+ * several threads at once, though never for the same line.
  * \author Erik Rainey
  */
 
@@ -45,30 +50,47 @@ typedef enum _cache_policy_e {
     CACHE_POLICY_WRITE_BACK,	/*!< Data is committed when aged out. */
 } cache_policy_e;
 
+/*! \brief The number of lines in each set of the cache.
+ * \ingroup group_cache
+ */
+#define CACHE_WAYS  (4)
+
 /*! \brief The line data of the cache.
  * \ingroup group_cache
  */
 typedef struct _cache_line_t {
-    bool_e locked;
-    bool_e valid;
-    clock_t age;
-    size_t start_offset;
-    size_t end_offset;
-    uint8_t  *data;
+    bool_e locked;          /*!< The line may not be replaced. */
+    bool_e valid;           /*!< The line holds data from the source. */
+    bool_e referenced;      /*!< The line was used since the clock hand last passed it. */
+    bool_e dirty;           /*!< The line holds data which was not committed. */
+    size_t start_offset;    /*!< The offset of the first byte of the line in the source. */
+    size_t end_offset;      /*!< The offset after the last byte of the line in the source. */
+    uint8_t  *data;         /*!< The line data. */
+    uint8_t   resv[SOSAL_CACHE_LINE_SIZE - ((4*sizeof(bool_e) + 2*sizeof(size_t) + sizeof(uint8_t *)) % SOSAL_CACHE_LINE_SIZE)]; /*!< Keeps lines of other sets off the cache line. */
 } cache_line_t;
 
+/*! \brief A set of lines which share a lock and a clock hand.
+ * \ingroup group_cache
+ */
+typedef struct _cache_set_t {
+    mutex_t mutex;          /*!< The mutex which protects the lines of the set. */
+    size_t  hand;           /*!< The way which the clock hand points to. */
+    uint8_t resv[SOSAL_CACHE_LINE_SIZE - ((sizeof(mutex_t) + sizeof(size_t)) % SOSAL_CACHE_LINE_SIZE)]; /*!< Keeps the other sets off the cache line. */
+} cache_set_t;
+
 /*! \brief The top level structure of the cache.
  * \ingroup group_cache
  */
 typedef struct _cache_t {
-    cache_line_t  *line;		/*!< The pointer to the line data. */
+    cache_line_t  *line;		/*!< The pointer to the line data. Line i belongs to set i % numSets. */
     size_t         numLines;	/*!< The number of lines in the cache. */
+    cache_set_t   *sets;		/*!< The sets of lines. */
+    size_t         numSets;		/*!< The number of sets. */
     size_t         lineSize;	/*!< The size of each line in bytes. */
     cache_policy_e policy;		/*!< The aging policy. */
     cache_fill_f   fillLine;	/*!< The line filling function. */
     cache_commit_f commitLine;	/*!< The line committing function. */
     void          *cookie;		/*!< The user's private data to pass to the functions. */
-    mutex_t        mutex;		/*!< The mutex which protects data access for the cache. */
 } cache_t;
 
 #ifdef __cplusplus
@@ -101,6 +123,7 @@ cache_t *cache_create(size_t lineSize,
                       void *cookie);
 
 /*! \brief This functions reads data through the cache from the source.
+ * Each line is locked in turn, so a read which spans lines is not atomic.
  * \param [in] cache The pointer to the cache metadata.
  * \param [in] data The pointer to the buffer to read data into.
  * \param [in] len The length of the data to read.
@@ -118,6 +141,18 @@ size_t cache_read(cache_t *cache, uint8_t *data, size_t len, size_t offset);
  */
 size_t cache_write(cache_t *cache, uint8_t *data, size_t len, size_t offset);
 
+/*! \brief This function drops every line without committing it.
+ * \param [in] cache The pointer to the cache metadata.
+ * \ingroup group_cache
+ */
+void cache_invalidate(cache_t *cache);
+
+/*! \brief This function commits every line to the source and drops it.
+ * \param [in] cache The pointer to the cache metadata.
+ * \ingroup group_cache
+ */
+void cache_flush(cache_t *cache);
+
 #ifdef __cplusplus
 }
 #endif
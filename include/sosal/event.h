@@ -35,6 +35,30 @@ struct timespec
 };
 #endif
 
+#if defined(SOSAL_USE_FUTEX)
+
+/*!
+ * \brief The SOSAL Event Data Type.
+ * With SOSAL_USE_FUTEX on Linux, the event is a set of words which are changed
+ * with atomic operations. Threads only enter the kernel to sleep on or to wake
+ * the sequence word, so an uncontended set or wait costs no system call.
+ * The event is private to the process.
+ * \ingroup group_events
+ */
+struct _event_futex_t {
+    volatile int32_t   set;         /*!< The current event value */
+    volatile int32_t   seq;         /*!< Counts the signals, the waiters sleep on this word */
+    volatile int32_t   waiters;     /*!< The number of threads waiting on the event */
+    bool_e             autoreset;   /*!< Indicates whether the event will auto-reset after signalling */
+};
+
+/*! \brief The SOSAL Event Type.
+ * \ingroup group_events
+ */
+typedef struct _event_futex_t event_t;
+
+#else
+
 /*!
  * \brief The SOSAL Event Data Type.
  * In a POSIX environment, this wraps the pthread implementations of conditions and a mutex.
@@ -53,6 +77,8 @@ struct _event_posix_t {
  */
 typedef struct _event_posix_t event_t;
 
+#endif
+
 #elif defined(SYSBIOS)
 
 #include <ti/sysbios/knl/Event.h>
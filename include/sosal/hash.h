@@ -19,12 +19,15 @@
 
 /*!
  * \file
- * \brief A Hash Table implementation which is an array of lists.
+ * \brief A Hash Table implementation which is an open addressed array of records.
+ * \details Collisions are resolved by linear probing with Robin Hood placement,
+ * where a record which is further from its home slot takes the place of a closer
+ * one, which keeps every probe sequence short. Records are stored in the table
+ * itself so a set or get makes no allocation unless the table has to grow.
  * \author Erik Rainey <erik.rainey@ti.com>
  */
 
 #include <sosal/types.h>
-#include <sosal/list.h>
 
 /*! \brief The key value pair which is the data storage of the hash.
  * \ingroup group_hashes
@@ -41,9 +44,18 @@ typedef enum _hash_sizes {
     HASH_SIZE_SMALL = 8,	/*!< Uses an 8 bit indexable table. */
     HASH_SIZE_MEDIUM = 12,	/*!< Uses a 12 bit indexable table. */
     HASH_SIZE_LARGE = 16,	/*!< Uses a 16 bit indexable table. */
+    HASH_SIZE_MAX = 24,		/*!< The largest table a hash will grow to. */
 } hash_size_e;
 
-/*! \brief The hashing function which generates the indexing into the list array.
+/*! \brief A slot of the table.
+ * \ingroup group_hashes
+ */
+typedef struct _hash_slot_t {
+    record_t record;        /*!< The key value pair */
+    uint32_t distance;      /*!< One more than the distance of the record from its home slot, 0 when the slot is empty */
+} hash_slot_t;
+
+/*! \brief The hashing function which generates the home slot in the table.
  * \param [in] numElem The number of elements in the hash table.
  * \param [in] key The key to use to generate the index in the table.
  * \ingroup group_hashes
@@ -56,10 +68,10 @@ typedef value_t (*hash_func_f)(size_t numElem, value_t key);
 typedef struct _hash {
     hash_size_e size;		/*!< \brief The indexing table bit depth. */
     size_t numTotalElem;	/*!< \brief The number of total elements in the hash. */
-    size_t numActiveSlots;	/*!< \brief The number of active slots in the hash. */
     size_t numSlots;		/*!< \brief The number of slots in the table. */
+    size_t cleanIndex;		/*!< \brief The slot which \ref hash_clean resumes from. */
     hash_func_f keyFunc;	/*!< \brief The function pointer to the hashing function. */
-    list_t **bucket;		/*!< \brief The key indexed table of all lists of elements. */
+    hash_slot_t *slots;		/*!< \brief The table of records. */
 } hash_t;
 
 #ifdef __cplusplus
@@ -68,6 +80,8 @@ extern "C" {
 
 /*! \brief The function which initializes the hash.
  * \param [in] size The enumerated size of the bitdepth of the table. 8, 12, or 16.
+ * This is only the starting size, the table doubles whenever more than three
+ * quarters of its slots are used, up to \ref HASH_SIZE_MAX.
  * \param [in] keyFunc the pointer to the custom keygen function is one is desired.
  * The default implementation will be used if NULL is given.
  * \ingroup group_hashes
@@ -103,7 +117,7 @@ bool_e hash_get(hash_t *h, value_t key, value_t *value);
 size_t hash_clean(hash_t *h, value_t *value);
 
 /*!
- * \brief This function returns the number of actual entries in the hash (including the collisions).
+ * \brief This function returns the number of actual entries in the hash.
  * \param [in] h The hash.
  * \return Returns the number of elements in the hash. A -1 indicates an error.
  * \ingroup group_hashes
@@ -33,6 +33,49 @@ typedef struct _block_t {
     void   *data;       /*!< \brief The pointer to the block data */
 } block_t;
 
+/*! \brief The number of power-of-two size classes in the slab mode of a heap.
+ * The smallest class is the alignment of the heap.
+ * \ingroup group_heaps
+ */
+#define HEAP_SLAB_CLASSES   (6)
+
+/*! \brief The number of free objects of a class a slab cache keeps before
+ * returning half of them to the heap.
+ * \ingroup group_heaps
+ */
+#define HEAP_SLAB_DEPTH     (32)
+
+/*! \brief The free objects of each class held by one thread. It is only
+ * touched by its thread, and is returned to the heap when the thread exits.
+ * \ingroup group_heaps
+ */
+typedef struct _heap_slab_cache_t {
+    struct _heap_t *heap;                   /*!< \brief The heap the objects are returned to */
+    struct _heap_slab_cache_t *next;        /*!< \brief The next cache of the heap (under the heap mutex) */
+    void    *free[HEAP_SLAB_CLASSES];       /*!< \brief The free objects, linked through their first word */
+    size_t   count[HEAP_SLAB_CLASSES];      /*!< \brief The number of objects in each free chain */
+    size_t   allocs;                        /*!< \brief The number of objects handed out from this cache */
+    size_t   frees;                         /*!< \brief The number of objects returned to this cache */
+} heap_slab_cache_t;
+
+/*! \brief The slab area of a heap, which is split into pages of one size class each.
+ * \ingroup group_heaps
+ */
+typedef struct _heap_slab_t {
+    uint8_t *base;                          /*!< \brief The page aligned start of the slab area, NULL when the slab mode is off */
+    uint8_t *classes;                       /*!< \brief The class of each carved page */
+    size_t   pageSize;                      /*!< \brief The size of each page in bytes */
+    size_t   numPages;                      /*!< \brief The number of pages in the slab area */
+    size_t   nextPage;                      /*!< \brief The next page to carve */
+    void    *free[HEAP_SLAB_CLASSES];       /*!< \brief The free objects which are in no cache (under the heap mutex) */
+    heap_slab_cache_t *caches;              /*!< \brief The caches of the live threads (under the heap mutex) */
+    size_t   allocs;                        /*!< \brief The objects handed out without a cache or by exited threads */
+    size_t   frees;                         /*!< \brief The objects returned without a cache or by exited threads */
+#if defined(POSIX)
+    pthread_key_t key;                      /*!< \brief Finds the cache of the calling thread */
+#endif
+} heap_slab_t;
+
 /*! \brief A heap_t is a set of list_t's of block_t's which manage the heap.
  * \ingroup group_heaps
  */
@@ -52,6 +95,7 @@ typedef struct _heap_t {
     bool_e   cleanPolicy;   /*!< \brief This determines if the block is cleaned during frees */
     bool_e   coalescePolicy;/*!< \brief This determines if the blocks will be coalesced during free operations */
     mutex_t  mutex;         /*!< \brief The access mutex */
+    heap_slab_t slab;       /*!< \brief The slab mode of the heap, see \ref heap_slab_init */
 } heap_t;
 
 #ifdef __cplusplus
@@ -82,6 +126,24 @@ bool_e heap_init(heap_t *heap, void *buffer, size_t size, uint32_t p2align);
  */
 void heap_deinit(heap_t *heap);
 
+/*!
+ * \brief Turns on the slab mode of a heap. A slab area is taken from the heap
+ * and split into pages, each of which serves one power-of-two size class
+ * from the alignment of the heap up to \ref HEAP_SLAB_CLASSES classes above it.
+ * Small allocations are then popped from a per-thread cache in constant time
+ * and larger ones (or any once the slab area is used up) fall back to the
+ * best fit search.
+ * \param [in] heap The pointer to the heap meta-data.
+ * \param [in] bytes The size of the slab area, rounded up to whole pages.
+ * \return Returns false if the heap could not supply the slab area.
+ * \note Pages keep their class once carved. Slab objects are not cleaned on free.
+ * \note The per-thread caches need POSIX thread keys. Elsewhere the objects
+ * are taken from the heap under its mutex.
+ * \pre \ref heap_init
+ * \ingroup group_heaps
+ */
+bool_e heap_slab_init(heap_t *heap, size_t bytes);
+
 /*!
  * \brief Allocates a block of memory.
  * \param heap The pointer to the heap meta-data.
@@ -35,6 +35,34 @@ typedef struct _histogram_t {
      int32_t max;		/*!< \brief The maximum value of the histogram */
 } histogram_t;
 
+/*! \brief The number of bits of precision kept by a \ref histogram_hdr_t. Each
+ * power of two range is split into 2^bits bins, so a value is placed within
+ * 1/32nd (about 3%) of itself.
+ * \ingroup group_histograms
+ */
+#define HISTOGRAM_HDR_SUB_BITS  (5)
+
+/*! \brief The number of bins in each power of two range.
+ * \ingroup group_histograms
+ */
+#define HISTOGRAM_HDR_SUB_COUNT (1 << HISTOGRAM_HDR_SUB_BITS)
+
+/*! \brief The number of bins needed to cover every 64 bit value.
+ * \ingroup group_histograms
+ */
+#define HISTOGRAM_HDR_BINS      ((64 - HISTOGRAM_HDR_SUB_BITS + 1) * HISTOGRAM_HDR_SUB_COUNT)
+
+/*! \brief A log-linear (HDR style) histogram of unsigned values such as
+ * latencies. Values are recorded with atomic increments, so many threads may
+ * record into one histogram without a lock, and histograms may be merged.
+ * \ingroup group_histograms
+ */
+typedef struct _histogram_hdr_t {
+    volatile uint64_t min;                          /*!< \brief The smallest recorded value */
+    volatile uint64_t max;                          /*!< \brief The largest recorded value */
+    volatile uint32_t bins[HISTOGRAM_HDR_BINS];     /*!< \brief The count of each bin */
+} histogram_hdr_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -68,6 +96,40 @@ void histogram_inc(histogram_t *histogram, int32_t value);
  */ 
 uint32_t histogram_get(histogram_t *histogram, int32_t value);
 
+/*! \brief Empties a log-linear histogram.
+ * \param [out] hist The histogram.
+ * \ingroup group_histograms
+ */
+void histogram_hdr_init(histogram_hdr_t *hist);
+
+/*! \brief Records a value. This is safe to call from many threads at once.
+ * \param [in,out] hist The histogram.
+ * \param [in] value The value to record.
+ * \ingroup group_histograms
+ */
+void histogram_hdr_record(histogram_hdr_t *hist, uint64_t value);
+
+/*! \brief Adds the counts of one histogram into another.
+ * \param [in,out] dst The histogram to add into.
+ * \param [in] src The histogram to add.
+ * \ingroup group_histograms
+ */
+void histogram_hdr_merge(histogram_hdr_t *dst, histogram_hdr_t *src);
+
+/*! \brief Returns the number of recorded values.
+ * \param [in] hist The histogram.
+ * \ingroup group_histograms
+ */
+uint64_t histogram_hdr_count(histogram_hdr_t *hist);
+
+/*! \brief Returns the value which percent of the recorded values are at or
+ * below, rounded up to the top of its bin, or 0 if nothing was recorded.
+ * \param [in] hist The histogram.
+ * \param [in] percent The percentile, from 0 to 100, i.e. 99.9
+ * \ingroup group_histograms
+ */
+uint64_t histogram_hdr_percentile(histogram_hdr_t *hist, double percent);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (C) 2009-2011 Texas Instruments, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SOSAL_NUMA_H_
+#define _SOSAL_NUMA_H_
+
+/*! \file
+ * \brief The NUMA topology and placement API.
+ * \details The topology is read from /sys/devices/system/node on Linux and
+ * every other platform reports a single node. Setting the environment variable
+ * SOSAL_NUMA_FAKE to a node count splits the online CPUs into that many fake
+ * nodes, which lets the placement code be exercised on single socket machines.
+ * The topology is read once and cached, it is read again when the variable changes.
+ * \author Erik Rainey <erik.rainey@ti.com>
+ */
+
+#include <sosal/types.h>
+
+/*! \brief The maximum number of nodes which are tracked.
+ * \ingroup group_numa
+ */
+#define NUMA_NODE_MAX   (8)
+
+/*! \brief The maximum number of CPUs which are tracked.
+ * \ingroup group_numa
+ */
+#define NUMA_CPU_MAX    (256)
+
+/*! \brief The name of the environment variable which fakes the topology.
+ * \ingroup group_numa
+ */
+#define NUMA_FAKE_ENV   "SOSAL_NUMA_FAKE"
+
+/*! \brief The layout of the CPUs over the nodes.
+ * \ingroup group_numa
+ */
+typedef struct _numa_topology_t {
+    uint32_t numNodes;                          /*!< \brief The number of nodes, at least 1 */
+    uint32_t numCpus;                           /*!< \brief The number of online CPUs */
+    bool_e   fake;                              /*!< \brief The topology was made up from \ref NUMA_FAKE_ENV */
+    uint8_t  cpuNode[NUMA_CPU_MAX];             /*!< \brief The node of each CPU */
+    uint32_t cpus[NUMA_NODE_MAX][NUMA_CPU_MAX/32]; /*!< \brief The bitmask of the CPUs of each node */
+} numa_topology_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief Returns the current topology.
+ * \param [out] topo The topology.
+ * \ingroup group_numa
+ */
+void numa_topology(numa_topology_t *topo);
+
+/*! \brief Returns the number of nodes, at least 1.
+ * \ingroup group_numa
+ */
+uint32_t numa_node_count(void);
+
+/*! \brief Returns the node of a CPU or -1 if the CPU is not online.
+ * \param [in] cpu The index of the CPU.
+ * \ingroup group_numa
+ */
+int32_t numa_cpu_node(uint32_t cpu);
+
+/*! \brief Restricts the calling thread to the CPUs of a node.
+ * \param [in] node The node.
+ * \return Returns false_e if the node has no CPUs or the platform can not pin threads.
+ * \ingroup group_numa
+ */
+bool_e numa_thread_pin(uint32_t node);
+
+/*! \brief Returns the node which the calling thread is restricted to, or -1
+ * if it may run on the CPUs of more than one node. When fake nodes share a
+ * CPU the lowest such node is returned.
+ * \ingroup group_numa
+ */
+int32_t numa_thread_node(void);
+
+/*! \brief Returns the node which the calling thread is restricted to, or when it
+ * may run on more than one node, the node of the CPU which it is running on now.
+ * \ingroup group_numa
+ */
+int32_t numa_current_node(void);
+
+/*! \brief Places the pages of a range of memory on a node. The pages are moved
+ * with mbind when the node is real, otherwise they are first-touched by a
+ * thread pinned to the node, which only affects pages that were never touched.
+ * \param [in] ptr The start of the range.
+ * \param [in] size The size of the range in bytes.
+ * \param [in] node The node.
+ * \note The pages are written in place, so do not call this while others use the range.
+ * \ingroup group_numa
+ */
+bool_e numa_memory_place(void *ptr, size_t size, uint32_t node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
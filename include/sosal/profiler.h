@@ -24,6 +24,7 @@
 
 #include <sosal/types.h>
 #include <sosal/rtimer.h>
+#include <sosal/histogram.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,6 +41,7 @@ typedef struct _profiler_t {
     rtime_t avgTime;    /**< \brief Used to record the average time of execution */
     rtime_t sumTime;    /**< \brief Used to record the total time of execution of all iterations */
     rtime_t rate;       /**< \brief This is used to record the clock rate per second on the local core */
+    histogram_hdr_t *hist; /**< \brief If set, each session time is also recorded here. \ref profiler_clear detaches it. */
 } profiler_t;
 
 /*! \brief Clears the profiling data structure and initializes it to known good values.
@@ -92,6 +92,54 @@ bool_e queue_write(queue_t *q, bool_e blocking, void *datum);
  */
 bool_e queue_read(queue_t *q, bool_e blocking, void *datum);
 
+/*! \brief Returns the slot of the next message so the client can fill it in
+ * place. If blocking is enabled the function will block until space is
+ * available in the queue. The queue stays locked until \ref queue_commit.
+ * \param q The queue to used.
+ * \param blocking If true, blocking could occur if no space is available.
+ * \returns void *
+ * \retval NULL If any error occurred (When not blocking it could indicate
+ * that the queue is full). The queue is not locked.
+ * \post \ref queue_commit
+ * \ingroup group_queues
+ */
+void *queue_reserve(queue_t *q, bool_e blocking);
+
+/*! \brief Ends a \ref queue_reserve and unlocks the queue.
+ * \param q The queue to used.
+ * \param publish If true, the filled message is added to the queue, otherwise
+ * the slot is given back.
+ * \returns bool_e
+ * \retval true_e If the message was added.
+ * \pre \ref queue_reserve
+ * \ingroup group_queues
+ */
+bool_e queue_commit(queue_t *q, bool_e publish);
+
+/*! \brief Returns the oldest message in place without removing it. If blocking
+ * is enabled the function will block until data is available to be read. The
+ * queue stays locked until \ref queue_consume.
+ * \param q The queue to used.
+ * \param blocking If true, blocking could occur if no data is available.
+ * \returns void *
+ * \retval NULL If any error occurred (When not blocking it could indicate
+ * that no data is ready). The queue is not locked.
+ * \post \ref queue_consume
+ * \ingroup group_queues
+ */
+void *queue_peek(queue_t *q, bool_e blocking);
+
+/*! \brief Ends a \ref queue_peek and unlocks the queue.
+ * \param q The queue to used.
+ * \param remove If true, the message is removed from the queue, otherwise it
+ * stays at the front.
+ * \returns bool_e
+ * \retval true_e If the message was removed.
+ * \pre \ref queue_peek
+ * \ingroup group_queues
+ */
+bool_e queue_consume(queue_t *q, bool_e remove);
+
 /*! \brief Enables read and write events on the queue. Waiting listeners may
  * get events depending on the data state of the queue.
  * \param q The queue to affect.
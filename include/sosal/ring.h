@@ -35,6 +35,7 @@ typedef struct _ring_t{
     uint8_t *end;          /*!< always points to the last item in the linear array */
     uint8_t *front;        /*!< always points to the first item in the ring */
     uint8_t *back;         /*!< always points to the last item in the ring */
+    bool_e mirrored;       /*!< the buffer is mapped twice back to back, so regions never wrap */
 } ring_t;
 
 #ifdef __cplusplus
@@ -54,6 +55,20 @@ extern "C" {
  */
 ring_t *ring_create(size_t totalSize);
 
+/**
+ * \brief Initialize a ring buffer whose memory is mapped twice in a row, so
+ * that any region of up to totalSize bytes starting within the buffer is
+ * contiguous. The size is rounded up to a multiple of the page size. On
+ * platforms without shared memory file descriptors this is the same as
+ * \ref ring_create.
+ * \param [in] totalSize The minimum number of bytes in the ring buffer.
+ * \return Returns a pointer to the control structure on success or NULL
+ *         on failure.
+ * \post \ref ring_destroy
+ * \ingroup group_rings
+ */
+ring_t *ring_create_mirrored(size_t totalSize);
+
 /**
  * \brief This function destroy's the ring buffer and it's control structure.
  * \param [out] rb The pointer to the ring buffer's control structure.
@@ -87,6 +102,48 @@ size_t ring_write(ring_t *rb, uint8_t *b, size_t len);
  */
 size_t ring_read(ring_t *rb, uint8_t *b, size_t len);
 
+/**
+ * \brief Returns a pointer to len contiguous free bytes at the back of the ring
+ * which the caller may fill in place. Nothing is visible to readers until
+ * \ref ring_commit is called.
+ * \param [in,out] rb  the ring buffer.
+ * \param [in]     len The number of bytes to reserve.
+ * \return Returns NULL if len bytes are not free in one piece. Regions of a
+ *         \ref ring_create_mirrored ring only fail when the ring is too full.
+ * \post \ref ring_commit
+ * \ingroup group_rings
+ */
+uint8_t *ring_reserve(ring_t *rb, size_t len);
+
+/**
+ * \brief Appends the first len bytes of the last reserved region to the ring.
+ * \param [in,out] rb  the ring buffer.
+ * \param [in]     len The number of bytes to commit, at most the reserved length.
+ * \pre \ref ring_reserve
+ * \ingroup group_rings
+ */
+void ring_commit(ring_t *rb, size_t len);
+
+/**
+ * \brief Returns a pointer to the oldest data in the ring without removing it.
+ * \param [in]  rb  the ring buffer.
+ * \param [out] len The number of contiguous bytes at the pointer. For a
+ *                  \ref ring_create_mirrored ring this is all the used bytes.
+ * \return Returns NULL if the ring is empty.
+ * \post \ref ring_consume
+ * \ingroup group_rings
+ */
+uint8_t *ring_peek(ring_t *rb, size_t *len);
+
+/**
+ * \brief Removes len bytes from the front of the ring.
+ * \param [in,out] rb  the ring buffer.
+ * \param [in]     len The number of bytes to remove, at most the peeked length.
+ * \pre \ref ring_peek
+ * \ingroup group_rings
+ */
+void ring_consume(ring_t *rb, size_t len);
+
 /**
  * This function prints the values of the control structure as well as the
  * values of the ring buffer as well. Do not use on large buffers!
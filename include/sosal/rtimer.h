@@ -71,6 +71,12 @@ extern "C" {
 
 /*! \brief Gets the current time.
  * \return Returns the current time.
+ * \note On POSIX the time is in nanoseconds. Where the CPU has a cycle counter
+ * which ticks at a fixed rate (an invariant TSC which the kernel also uses, or
+ * the ARMv8 generic timer) it is read instead of the clock, so the first call
+ * calibrates it against the clock for a few milliseconds. The clock is
+ * CLOCK_MONOTONIC_RAW where it exists, so the time is not slewed by NTP and
+ * should not be compared with CLOCK_MONOTONIC.
  * \ingroup group_rtimers
  */
 rtime_t rtimer_now();
@@ -113,6 +119,23 @@ double rtimer_to_sec(rtime_t);
  */
 double rtimer_from_rate_to_sec(rtime_t, rtime_t rate);
 
+/*! \brief Gets the raw value of the counter behind \ref rtimer_now.
+ * \return Returns the counter, which is \ref rtimer_now where there is no counter.
+ * \ingroup group_rtimers
+ */
+rtime_t rtimer_cycles();
+
+/*! \brief Gets the calibrated frequency of \ref rtimer_cycles.
+ * \ingroup group_rtimers
+ */
+rtime_t rtimer_cycles_freq();
+
+/*! \brief Converts a number of \ref rtimer_cycles to microseconds.
+ * \param [in] t The cycles to convert.
+ * \ingroup group_rtimers
+ */
+rtime_t rtimer_cycles_to_us(rtime_t t);
+
 #ifdef __cplusplus
 }
 #endif
@@ -54,6 +54,8 @@
  * \defgroup group_unittest SOSAL Unit Tests
  * \defgroup group_histograms SOSAL Histogram
  * \defgroup group_heaps SOSAL Heaps
+ * \defgroup group_numa SOSAL NUMA
+ * \defgroup group_trace SOSAL Trace
  */
 #include <sosal/types.h>
 #include <sosal/status.h>
@@ -61,6 +63,7 @@
 #include <sosal/fourcc.h>
 #include <sosal/image.h>
 #include <sosal/thread.h>
+#include <sosal/numa.h>
 #include <sosal/module.h>
 #include <sosal/mutex.h>
 #include <sosal/serial.h>
@@ -78,6 +81,7 @@
 #include <sosal/fph.h>
 #include <sosal/ini.h>
 #include <sosal/profiler.h>
+#include <sosal/trace.h>
 #include <sosal/socket.h>
 #include <sosal/rpc_socket.h>
 #include <sosal/shared.h>
@@ -20,12 +20,17 @@
 /*! \file
  * \brief Threadpools allow an abstraction around a series of N worker threads attached to 
  * a queue of work per thread. 
+ * \details Each worker owns a bounded deque of work items. Work is issued round robin
+ * under one lock per batch, and any worker may take from the front of any deque with
+ * a compare and swap, so a worker which runs out of its own work steals from the
+ * others. Work can be issued in completion groups which are waited on separately.
  * \author Erik Rainey <erik.rainey@ti.com>
  */
 
 #include <sosal/types.h>
 #include <sosal/thread.h>
-#include <sosal/queue.h>
+#include <sosal/mutex.h>
+#include <sosal/event.h>
 #include <sosal/semaphore.h>
 #include <sosal/profiler.h>
 
@@ -40,11 +45,31 @@ struct _threadpool_worker_t;
  */
 typedef bool_e (*threadpool_f)(struct _threadpool_worker_t *worker);
 
+/*! \brief A set of work items which can be waited on together.
+ * \ingroup group_threadpools
+ */
+typedef struct _threadpool_group_t {
+    volatile int32_t pending;   /*!< \brief The number of issued items which have not completed */
+    mutex_t  lock;              /*!< \brief Orders the transitions to and from no pending items */
+    event_t  completed;         /*!< \brief Raised while there are no pending items */
+} threadpool_group_t;
+
+/*! \brief The bounded deque of work items of a worker. Items are added at the bottom
+ * by the issuer and taken from the top by any worker.
+ * \ingroup group_threadpools
+ */
+typedef struct _threadpool_deque_t {
+    volatile uint32_t top;      /*!< \brief The count of items taken */
+    volatile uint32_t bottom;   /*!< \brief The count of items added */
+    uint32_t mask;              /*!< \brief The number of slots less one, a power of two less one */
+    uint8_t *slots;             /*!< \brief The slots, each holding the group and a copy of the item */
+} threadpool_deque_t;
+
 /*! \brief The structure given to each threadpool worker during execution.
  * \ingroup group_threadpools
  */
 typedef struct _threadpool_worker_t {
-    queue_t *queue;				/*!< \brief The work queue */
+    threadpool_deque_t deque;	/*!< \brief The work items issued to this worker */
     thread_t handle;			/*!< \brief The handle to the worker thread */
     uint32_t index;				/*!< \brief The index of this worker in the pool */
     bool_e   active;			/*!< \brief Indicates whether this worker is currently operating. */
@@ -53,6 +78,7 @@ typedef struct _threadpool_worker_t {
     void    *data;				/*!< \brief The user data pointer */
     struct _threadpool_t *pool; /*!< \brief Pointer to the top level structure. */
     profiler_t perf;			/*!< \brief Performance capture variable. */
+    uint32_t numStolen;			/*!< \brief The number of items taken from other workers */
 } threadpool_worker_t;
 
 /*! \brief The internal structure for tracking a threadpool.
@@ -62,11 +88,15 @@ typedef struct _threadpool_t {
     uint32_t numWorkers;			/*!< \brief The number of threads in the pool */
     uint32_t numWorkItems;			/*!< \brief The maximum number of threads in the queue */
     uint32_t sizeWorkItem;			/*!< \brief Unit size of a work item */
-     int32_t numCurrentItems;		/*!< \brief The number of corrent items in the queue */
+    uint32_t sizeSlot;				/*!< \brief The size of a deque slot */
     threadpool_worker_t *workers;	/*!< \brief The array of workers */
     uint32_t nextWorkerIndex;		/*!< \brief The next index to submit work to */
-    semaphore_t sem;				/*!< \brief The semaphore which protect access to the work queues */
-    event_t  completed;				/*!< \brief The event which indicates that all work is completed */
+    bool_e   pinned;				/*!< \brief Each worker is restricted to one CPU */
+    volatile bool_e exiting;		/*!< \brief The workers are being torn down */
+    mutex_t  issue;					/*!< \brief Serializes the issuers, once per batch */
+    volatile int32_t available;		/*!< \brief The number of issued items which no worker has claimed */
+    event_t  work;					/*!< \brief Raised while there are items to claim */
+    threadpool_group_t group;		/*!< \brief The group of \ref threadpool_issue */
 } threadpool_t;
 
 #ifdef __cplusplus
@@ -93,6 +123,19 @@ void threadpool_destroy(threadpool_t *pool);
  */
 threadpool_t *threadpool_create(uint32_t numThreads, uint32_t numWorkItems, size_t sizeWorkItem, threadpool_f worker, void *arg);
 
+/*!
+ * \brief This function creates a threadpool whose worker N is restricted to
+ * online CPU N modulo the number of CPUs.
+ * \param [in] numThreads How many threads to distribute the work around to.
+ * \param [in] numWorkItems How deep to make the work queues.
+ * \param [in] sizeWorkItem How large each work item is.
+ * \param [in] worker The function which implements the workers.
+ * \param [in] arg A user supplied global memory pointer for each thread.
+ * \note Pinning is only supported on Linux, elsewhere this is \ref threadpool_create.
+ * \ingroup group_threadpools
+ */
+threadpool_t *threadpool_create_pinned(uint32_t numThreads, uint32_t numWorkItems, size_t sizeWorkItem, threadpool_f worker, void *arg);
+
 /*!
  * \brief This function issues work to the threapool to be completed. This will return when the
  * work has been put into the queues but not necessarily when the work is
@@ -106,9 +149,22 @@ threadpool_t *threadpool_create(uint32_t numThreads, uint32_t numWorkItems, size
  */
 bool_e threadpool_issue(threadpool_t *pool, void *workitems[], uint32_t numWorkItems);
 
+/*!
+ * \brief This function issues work to the threadpool as part of a completion group.
+ * \param [in] pool The pointer to the threadpool_t returned by \ref threadpool_create.
+ * \param [in] group The group to count the work items in.
+ * \param [in] workitems An array of work pointers.
+ * \param [in] numWorkItems A count of the number of work pointers in the workitems array.
+ * \retval false_e Some of the work items did not fit in the work queues and were not issued.
+ * \ingroup group_threadpools
+ * \pre \ref threadpool_group_init
+ * \post \ref threadpool_group_complete
+ */
+bool_e threadpool_issue_group(threadpool_t *pool, threadpool_group_t *group, void *workitems[], uint32_t numWorkItems);
+
 /**
- * \brief This function will get the status of the threadpool work queues. If set
- * to blocking, this will return once all workers have completed.
+ * \brief This function will get the status of the work issued with \ref threadpool_issue.
+ * If set to blocking, this will return once that work has completed.
  * \param [in] pool The pointer to the threadpool_t returned by \ref threadpool_create.
  * \param [in] blocking Set to true_e for synchronous and false_e for the
  * current status (polling mode).
@@ -118,6 +174,33 @@ bool_e threadpool_issue(threadpool_t *pool, void *workitems[], uint32_t numWorkI
  */
 bool_e threadpool_complete(threadpool_t *pool, bool_e blocking);
 
+/*!
+ * \brief This function initializes a completion group.
+ * \param [in] group The group.
+ * \ingroup group_threadpools
+ */
+bool_e threadpool_group_init(threadpool_group_t *group);
+
+/*!
+ * \brief This function deinitializes a completion group which has no pending work.
+ * \param [in] group The group.
+ * \ingroup group_threadpools
+ */
+void threadpool_group_deinit(threadpool_group_t *group);
+
+/*!
+ * \brief This function gets the status of the work issued in a group. If set
+ * to blocking, this will return once all of that work has completed.
+ * \param [in] group The group.
+ * \param [in] blocking Set to true_e for synchronous and false_e for polling.
+ * \retval true_e The work of the group has completed.
+ * \retval false_e The work of the group has not yet completed.
+ * \note Once this returns true_e no worker touches the group again, so it may
+ * be deinitialized.
+ * \ingroup group_threadpools
+ */
+bool_e threadpool_group_complete(threadpool_group_t *group, bool_e blocking);
+
 #ifdef __cplusplus
 }
 #endif
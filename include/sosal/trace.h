@@ -0,0 +1,148 @@
+/*
+ *  Copyright (C) 2009-2011 Texas Instruments, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SOSAL_TRACE_H_
+#define _SOSAL_TRACE_H_
+
+/*! \file
+ * \brief The SOSAL Trace API.
+ * \details Each thread records fixed size events into its own ring, so
+ * recording takes no lock and does no I/O. When a ring is full the oldest
+ * events are overwritten. The rings are exported in the Chrome trace event
+ * JSON format, which chrome://tracing and Perfetto load as a timeline.
+ * The name and category strings are stored by pointer, so they must stay valid
+ * until the trace is exported or reset. The buffers live as long as the
+ * process, on POSIX the buffer of an exited thread is given to the next thread
+ * which records an event.
+ * \author Erik Rainey <erik.rainey@ti.com>
+ */
+
+#include <sosal/types.h>
+#include <sosal/rtimer.h>
+
+/*! \brief The number of events each thread keeps, a power of two.
+ * \ingroup group_trace
+ */
+#define TRACE_EVENTS        (8192)
+
+/*! \brief The maximum number of threads which can record events.
+ * \ingroup group_trace
+ */
+#define TRACE_THREADS_MAX   (64)
+
+/*! \brief The kinds of trace events, named after the Chrome phase letters.
+ * \ingroup group_trace
+ */
+typedef enum _trace_phase_e {
+    TRACE_PHASE_BEGIN   = 'B',  /*!< \brief The start of a span on the thread */
+    TRACE_PHASE_END     = 'E',  /*!< \brief The end of the last span on the thread */
+    TRACE_PHASE_INSTANT = 'i',  /*!< \brief A point in time */
+} trace_phase_e;
+
+/*! \brief A recorded event.
+ * \ingroup group_trace
+ */
+typedef struct _trace_event_t {
+    rtime_t     time;       /*!< \brief The \ref rtimer_now time of the event */
+    const char *category;   /*!< \brief The category of the event */
+    const char *name;       /*!< \brief The name of the event */
+    uint32_t    arg;        /*!< \brief A user value shown with the event */
+    uint16_t    cpu;        /*!< \brief The CPU which recorded the event */
+    uint8_t     phase;      /*!< \brief The \ref trace_phase_e */
+    uint8_t     resv;
+} trace_event_t;
+
+/*! \brief The events of one thread.
+ * \ingroup group_trace
+ */
+typedef struct _trace_buffer_t {
+    uint32_t          tid;      /*!< \brief The thread which owns the buffer */
+    volatile uint32_t head;     /*!< \brief The number of events ever recorded */
+    volatile int32_t  owned;    /*!< \brief Set while a running thread records into the buffer */
+    trace_event_t     events[TRACE_EVENTS];
+} trace_buffer_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief Starts or stops the recording of events in every thread.
+ * \param [in] enable true_e to record events.
+ * \ingroup group_trace
+ */
+void trace_enable(bool_e enable);
+
+/*! \brief Returns true_e if events are being recorded.
+ * \ingroup group_trace
+ */
+bool_e trace_enabled(void);
+
+/*! \brief Records the start of a span on the calling thread.
+ * \param [in] category A static string grouping the event.
+ * \param [in] name A static string naming the span.
+ * \param [in] arg A value shown with the event.
+ * \ingroup group_trace
+ */
+void trace_begin(const char *category, const char *name, uint32_t arg);
+
+/*! \brief Records the end of the last span started on the calling thread.
+ * \param [in] category A static string grouping the event.
+ * \param [in] name A static string naming the span.
+ * \param [in] arg A value shown with the event.
+ * \ingroup group_trace
+ */
+void trace_end(const char *category, const char *name, uint32_t arg);
+
+/*! \brief Records a point in time on the calling thread.
+ * \param [in] category A static string grouping the event.
+ * \param [in] name A static string naming the event.
+ * \param [in] arg A value shown with the event.
+ * \ingroup group_trace
+ */
+void trace_instant(const char *category, const char *name, uint32_t arg);
+
+/*! \brief Drops every recorded event.
+ * \ingroup group_trace
+ */
+void trace_reset(void);
+
+/*! \brief Writes the recorded events as Chrome trace event JSON.
+ * \param [in] fp The file to write to.
+ * \return Returns the number of events written.
+ * \note Events which are recorded while exporting may be torn, export when the
+ * traced threads are idle.
+ * \ingroup group_trace
+ */
+size_t trace_export(FILE *fp);
+
+/*! \brief Writes the recorded events as Chrome trace event JSON to a file.
+ * \param [in] filename The name of the file to create.
+ * \ingroup group_trace
+ */
+bool_e trace_export_file(const char *filename);
+
+/*! \brief Stops recording and drops every recorded event. The buffers are kept
+ * for the threads which own them.
+ * \ingroup group_trace
+ */
+void trace_deinit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
@@ -155,6 +155,17 @@ printf("Value="FMT_VALUE_T"\n", value);
 #endif
 #endif
 
+#ifndef SOSAL_HUGE_PAGE_SIZE
+/*! \brief Used to define the size of a huge page (the second level of the MMU on ARM and x86) */
+#define SOSAL_HUGE_PAGE_SIZE (2*1024*1024)
+#endif
+
+#ifndef SOSAL_CACHE_LINE_SIZE
+/*! \brief Used to define the size of a cache line. Fields which different threads
+ * write are kept at least this far apart so that they do not share a line. */
+#define SOSAL_CACHE_LINE_SIZE (64)
+#endif
+
 #if defined(WIN32)
 /*! \brief Used to define the compiler trick to cause structure packing */
 #define PACKED_STRUCT(x)
@@ -80,6 +80,27 @@ bool_e thread_unittest(int argc, char *argv[]);
  */
 bool_e queue_unittest(int argc, char *argv[]);
 
+/*! \brief
+ * \param [in] argc
+ * \param [in] argv
+ * \ingroup group_unittest
+ */
+bool_e ring_unittest(int argc, char *argv[]);
+
+/*! \brief
+ * \param [in] argc
+ * \param [in] argv
+ * \ingroup group_unittest
+ */
+bool_e rtimer_unittest(int argc, char *argv[]);
+
+/*! \brief
+ * \param [in] argc
+ * \param [in] argv
+ * \ingroup group_unittest
+ */
+bool_e trace_unittest(int argc, char *argv[]);
+
 /*! \brief 
  * \param [in] argc
  * \param [in] argv
@@ -115,6 +136,13 @@ bool_e list_unittest(int argc, char *argv[]);
  */
 bool_e histogram_unittest(int argc, char *argv[]);
 
+/*! \brief 
+ * \param [in] argc
+ * \param [in] argv
+ * \ingroup group_unittest
+ */
+bool_e numa_unittest(int argc, char *argv[]);
+
 /*! \brief 
  * \param [in] argc
  * \param [in] argv
@@ -20,5 +20,11 @@ VISION_LIBRARIES += dei
 DVP_FEATURES += DVP_USE_DEI
 DVP_INC += $(DVP_ROOT)/libraries/public/dei/include
 
+else
+
+# The deinterlacer has a "C" version in the CPU KGM.
+DVP_FEATURES += DVP_USE_DEI_C
+DVP_INC += $(DVP_ROOT)/libraries/public/dei/include
+
 endif
 
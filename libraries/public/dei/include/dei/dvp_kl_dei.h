@@ -15,7 +15,7 @@
 #ifndef _DVP_KL_DEI_H_
 #define _DVP_KL_DEI_H_
 
-#ifdef DVP_USE_DEI
+#if defined(DVP_USE_DEI) || defined(DVP_USE_DEI_C)
 
 #include <dvp/dvp_types.h>
 
@@ -38,20 +38,34 @@ enum DVP_KernelNode_Dei_e {
     /*!
      * Deinterlacer initialization.  This is used to acquire the resources
      * required for the deinterlacer kernel.\n
-     * Configuration Structure: Not Applicable
+     * Configuration Structure: Not Applicable (DVP_Deinterlacer_t on the CPU,
+     * where it clears the field history of the instance)
      */
     DVP_KN_DEI_DEINTERLACER_INIT,
 
     /*!
      * Deinterlacer deinitialization.  This is used to release the resources
      * required for the deinterlacer kernel.\n
-     * Configuration Structure: Not Applicable
+     * Configuration Structure: Not Applicable (DVP_Deinterlacer_t on the CPU)
      */
     DVP_KN_DEI_DEINTERLACER_DEINIT
 };
 
+/*!
+ * \brief The interpolation modes of the deinterlacer on the CPU.
+ * \ingroup group_algo_dei
+ */
+typedef enum _dvp_deinterlacer_mode_e {
+    DVP_DEI_MODE_MOTION_ADAPTIVE = 0,   /*!< Blends the previous field with the line average by the motion */
+    DVP_DEI_MODE_LINE_AVERAGE,          /*!< Averages the lines around each missing line */
+} DVP_Deinterlacer_Mode_e;
+
 /*!
  * \brief This structure is use with deinterlacer Kernels.
+ * \note On the CPU the frames are described by the images alone (phy_virt_flag
+ * must be 0) and the current field is on the even lines when fldnum is even.
+ * phy_luma_d0 and phy_luma_d1 hold the luma of the last even and odd fields
+ * and phy_luma_d2 the motion, each of width*height/2 bytes.
  * \ingroup group_algo_dei
  */
 typedef struct _dvp_deinterlacer_t {
@@ -85,9 +99,10 @@ typedef struct _dvp_deinterlacer_t {
     DVP_U32 dbg_param3;                 /*!<  used for debuging */
     DVP_U32 dbg_param4;                 /*!<  used for debuging */
 
+    DVP_U32 mode;                       /*!<  CPU only, see DVP_Deinterlacer_Mode_e */
 } DVP_Deinterlacer_t;
 
-#endif // DVP_USE_DEI
+#endif // DVP_USE_DEI || DVP_USE_DEI_C
 
 #endif // _DVP_KL_DEI_H_
 
@@ -20,5 +20,11 @@ VISION_LIBRARIES += dsplib
 DVP_FEATURES += DVP_USE_DSPLIB
 DVP_INC += $(DVP_ROOT)/libraries/public/dsplib/include
 
+else
+
+# The FFTs, FIRs, IIRs and dot products have "C" versions in the CPU KGM.
+DVP_FEATURES += DVP_USE_DSPLIB_C
+DVP_INC += $(DVP_ROOT)/libraries/public/dsplib/include
+
 endif
 
@@ -15,7 +15,7 @@
 #ifndef _DVP_KL_DSPLIB_H_
 #define _DVP_KL_DSPLIB_H_
 
-#ifdef DVP_USE_DSPLIB
+#if defined(DVP_USE_DSPLIB) || defined(DVP_USE_DSPLIB_C)
 
 #include <dvp/dvp_types.h>
 //#define DVP_DSPLIB_TEST1 1
@@ -490,6 +490,24 @@ typedef struct  _dsp_matmul{
 }DVP_DSP_MatMul;
 
 /*! \brief Generic Function Parameters to DSPLIB functions.
+ * \note The "C" versions in the CPU KGM (DVP_USE_DSPLIB_C) size everything
+ * from numBytes and support ADD16/32, DOTPROD, DOTPRODSQR, VECSUMSQ,
+ * FIR_GEN/R4/R8/SYM, IIR, IIR_LAT, FFT_16x16, FFT_32x32, IFFT_16x16,
+ * IFFT_32x32 and the FFT_16X16, FFT_32x32 and IFFT_16X16 twiddle generators.
+ * \note DOTPROD and VECSUMSQ return the sum in val1. DOTPRODSQR adds the
+ * sum of squares of input1 to val1 and the dot product to the DVP_S32 in output0.
+ * \note FIR: input0 is x, twoway is h and output0 is r. FIR_SYM takes the
+ * nh+1 coefficients of half of the filter and the shift in val1.
+ * \note IIR: input0 is x (nr+4), input1 and twoway are the 5 feed forward and
+ * feedback coefficients, output0 is the output history (nr+4) and output1
+ * receives the nr outputs. IIR_LAT: input0 is x, input1 is k, twoway is the
+ * DVP_S32 state (nk+1) and output0 is r.
+ * \note FFT/IFFT: input0 and output0 hold val1 complex points (0 means the
+ * whole of input0), twoway holds the twiddles from the matching
+ * DVP_KN_GEN_TWIDDLE_* node, which writes val1 points worth of twiddles to
+ * input0 and returns the number of values in val2. The inverse transforms
+ * conjugate the forward twiddles, so both 16x16 generators make the same table.
+ * The forward transforms are scaled by 1/N, the inverse ones are not.
  * \ingroup group_algo_dsplib
  */
 typedef struct  _dsp_func{
@@ -503,6 +521,6 @@ typedef struct  _dsp_func{
     DVP_S32 val3;         /*!<  User defined value 3: typically used to store special integer arguments */
 }DVP_DSPFunc;
 
-#endif // DVP_USE_DSPLIB
+#endif // DVP_USE_DSPLIB || DVP_USE_DSPLIB_C
 
 #endif // _DVP_KL_DSPLIB_H_
@@ -19,5 +19,11 @@ VISION_LIBRARIES += vrun
 DVP_FEATURES += DVP_USE_VRUN
 DVP_INC += $(DVP_ROOT)/libraries/public/vrun/include
 
+else
+
+# The LDC kernels have a "C" version in the CPU KGM.
+DVP_FEATURES += DVP_USE_LDC
+DVP_INC += $(DVP_ROOT)/libraries/public/vrun/include
+
 endif
 
@@ -15,7 +15,7 @@
 #ifndef _DVP_KL_VRUN_H_
 #define _DVP_KL_VRUN_H_
 
-#ifdef DVP_USE_VRUN
+#if defined(DVP_USE_VRUN) || defined(DVP_USE_LDC)
 
 #include <dvp/dvp_types.h>
 
@@ -696,7 +696,7 @@ typedef struct _dvp_nmsstep1_t {
     DVP_S16     nplus1;
 } DVP_NMSStep1_t;
 
-#endif // DVP_USE_VRUN
+#endif // DVP_USE_VRUN || DVP_USE_LDC
 
 #endif // _DVP_KL_VRUN_H_
 
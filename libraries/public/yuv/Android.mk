@@ -23,7 +23,7 @@ LOCAL_MODULE_TAGS := optional
 LOCAL_PRELINK_MODULE := false
 LOCAL_ARM_MODE := arm
 LOCAL_CFLAGS := $(DVP_DEBUGGING) $(DVP_CFLAGS)
-LOCAL_SRC_FILES := $(notdir $(wildcard $(LOCAL_PATH)/*.S))
+LOCAL_SRC_FILES := $(notdir $(wildcard $(LOCAL_PATH)/*.S)) __rotate_180.c __scale_image.c __remap_image.c __uyvy_deinterlace.c
 LOCAL_C_INCLUDES += $(DVP_INCLUDES)
 LOCAL_MODULE := libyuv
 include $(BUILD_STATIC_LIBRARY)
@@ -0,0 +1,138 @@
+/*
+ *  Copyright (C) 2009-2011 Texas Instruments, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*! \file
+ * \brief The "C" version of the planar rotation assembly functions. The plane
+ * is walked in square tiles so that both the reads and the scattered writes
+ * of a tile stay in the cache, and each full tile is transposed in SIMD
+ * registers when SSE2 is available.
+ */
+
+#include "yuv_c.h"
+
+/*! \brief Rotates the pixels of a rectangle of the source plane one at a time.
+ * This handles the partial tiles on the right and bottom edges.
+ */
+static void planar_rotate_rect(uint32_t width, uint32_t height,
+                               uint8_t *pSrc, int32_t srcStride,
+                               uint8_t *pDst, int32_t dstStride,
+                               uint32_t x0, uint32_t y0,
+                               uint32_t x1, uint32_t y1,
+                               int cw)
+{
+    uint32_t x, y;
+    for (y = y0; y < y1; y++)
+    {
+        for (x = x0; x < x1; x++)
+        {
+            if (cw)
+                pDst[(x * dstStride) + (height - 1 - y)] = pSrc[(y * srcStride) + x];
+            else
+                pDst[((width - 1 - x) * dstStride) + y] = pSrc[(y * srcStride) + x];
+        }
+    }
+}
+
+#if defined(__SSE2__)
+/*! \brief Rotates a full tile of the source plane through the SIMD transpose.
+ * Loading the rows bottom-up before transposing gives the clockwise rotation,
+ * loading them top-down gives the counter-clockwise rotation.
+ */
+static void planar_rotate_tile(uint32_t width, uint32_t height,
+                               uint8_t *pSrc, int32_t srcStride,
+                               uint8_t *pDst, int32_t dstStride,
+                               uint32_t x0, uint32_t y0,
+                               int cw)
+{
+    __m128i r[YUV_TILE_SIZE];
+    uint32_t i;
+    for (i = 0; i < YUV_TILE_SIZE; i++)
+    {
+        uint32_t y = (cw ? (y0 + YUV_TILE_SIZE - 1 - i) : (y0 + i));
+        r[i] = _mm_loadu_si128((__m128i *)&pSrc[(y * srcStride) + x0]);
+    }
+    yuv_transpose_16x16_u08(r);
+    for (i = 0; i < YUV_TILE_SIZE; i++)
+    {
+        uint8_t *pOut;
+        if (cw)
+            pOut = &pDst[((x0 + i) * dstStride) + (height - YUV_TILE_SIZE - y0)];
+        else
+            pOut = &pDst[((width - 1 - x0 - i) * dstStride) + y0];
+        _mm_storeu_si128((__m128i *)pOut, r[i]);
+    }
+}
+#endif
+
+static void planar_rotate(uint32_t width, uint32_t height,
+                          uint8_t *pSrc, int32_t srcStride,
+                          uint8_t *pDst, int32_t dstStride,
+                          int cw)
+{
+    uint32_t x0, y0;
+    for (y0 = 0; y0 < height; y0 += YUV_TILE_SIZE)
+    {
+        uint32_t y1 = (y0 + YUV_TILE_SIZE < height ? y0 + YUV_TILE_SIZE : height);
+        for (x0 = 0; x0 < width; x0 += YUV_TILE_SIZE)
+        {
+            uint32_t x1 = (x0 + YUV_TILE_SIZE < width ? x0 + YUV_TILE_SIZE : width);
+#if defined(__SSE2__)
+            if (x1 - x0 == YUV_TILE_SIZE && y1 - y0 == YUV_TILE_SIZE)
+            {
+                planar_rotate_tile(width, height, pSrc, srcStride, pDst, dstStride, x0, y0, cw);
+                continue;
+            }
+#endif
+            planar_rotate_rect(width, height, pSrc, srcStride, pDst, dstStride, x0, y0, x1, y1, cw);
+        }
+    }
+}
+
+void __planar_rotate_cw90(uint32_t width,
+                          uint32_t height,
+                          uint8_t *pSrc,
+                          uint8_t *pDst)
+{
+    planar_rotate(width, height, pSrc, width, pDst, height, 1);
+}
+
+void __planar_rotate_ccw90(uint32_t width,
+                           uint32_t height,
+                           uint8_t *pSrc,
+                           uint8_t *pDst)
+{
+    planar_rotate(width, height, pSrc, width, pDst, height, 0);
+}
+
+void __planar_rotate_cw90_stride(uint32_t width,
+                                 uint32_t height,
+                                 uint8_t *pSrc,
+                                 int32_t srcStride,
+                                 uint8_t *pDst,
+                                 int32_t dstStride)
+{
+    planar_rotate(width, height, pSrc, srcStride, pDst, dstStride, 1);
+}
+
+void __planar_rotate_ccw90_stride(uint32_t width,
+                                  uint32_t height,
+                                  uint8_t *pSrc,
+                                  int32_t srcStride,
+                                  uint8_t *pDst,
+                                  int32_t dstStride)
+{
+    planar_rotate(width, height, pSrc, srcStride, pDst, dstStride, 0);
+}
@@ -0,0 +1,236 @@
+/*
+ *  Copyright (C) 2009-2011 Texas Instruments, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*! \file
+ * \brief Remaps images through a precomputed table of source positions with
+ * bilinear interpolation. These have no assembly version. The table is
+ * blocked by output tiles so both the table and the source area under a tile
+ * stay in the cache; the neighbors are gathered per tile line and then
+ * interpolated in SIMD.
+ */
+
+#include "yuv_c.h"
+#include <yuv/yuv_armv7.h>
+
+#define YUV_REMAP_ONE   (1 << YUV_REMAP_Q)
+#define YUV_REMAP_MASK  (YUV_REMAP_ONE - 1)
+
+uint32_t __remap_table_size(uint32_t width, uint32_t height)
+{
+    uint32_t tilesX = (width + YUV_REMAP_TILE - 1) / YUV_REMAP_TILE;
+    uint32_t tilesY = (height + YUV_REMAP_TILE - 1) / YUV_REMAP_TILE;
+    return sizeof(yuv_remap_table_t) +
+           (tilesX * tilesY * YUV_REMAP_TILE * YUV_REMAP_TILE * sizeof(uint32_t));
+}
+
+void __remap_table_init(uint32_t width, uint32_t height,
+                        uint32_t srcWidth, uint32_t srcHeight,
+                        void *pTable)
+{
+    yuv_remap_table_t *t = (yuv_remap_table_t *)pTable;
+    t->width = width;
+    t->height = height;
+    t->srcWidth = srcWidth;
+    t->srcHeight = srcHeight;
+    t->tilesX = (width + YUV_REMAP_TILE - 1) / YUV_REMAP_TILE;
+    t->tilesY = (height + YUV_REMAP_TILE - 1) / YUV_REMAP_TILE;
+}
+
+void __remap_table_set(void *pTable, uint32_t x, uint32_t y, int32_t srcX, int32_t srcY)
+{
+    yuv_remap_table_t *t = (yuv_remap_table_t *)pTable;
+    int32_t maxX = (t->srcWidth - 1) << YUV_REMAP_Q;
+    int32_t maxY = (t->srcHeight - 1) << YUV_REMAP_Q;
+    uint32_t tile = ((y / YUV_REMAP_TILE) * t->tilesX) + (x / YUV_REMAP_TILE);
+    uint32_t i = (tile * YUV_REMAP_TILE * YUV_REMAP_TILE) +
+                 ((y % YUV_REMAP_TILE) * YUV_REMAP_TILE) + (x % YUV_REMAP_TILE);
+    if (srcX < 0) srcX = 0;
+    if (srcY < 0) srcY = 0;
+    if (srcX > maxX) srcX = maxX;
+    if (srcY > maxY) srcY = maxY;
+    YUV_REMAP_TABLE_POS(t)[i] = ((uint32_t)srcY << 16) | (uint32_t)srcX;
+}
+
+/*! \brief Describes one channel of a source image for the sampler. */
+typedef struct _remap_channel_t {
+    uint8_t *pSrc;      /*!< The first sample of the channel */
+    int32_t  stride;    /*!< The stride in bytes */
+    uint32_t step;      /*!< The distance in bytes between horizontal samples */
+    uint32_t maxX;      /*!< The last valid sample index horizontally */
+    uint32_t maxY;      /*!< The last valid sample index vertically */
+    uint32_t shiftX;    /*!< The subsampling of the channel horizontally (as a shift) */
+    uint32_t shiftY;    /*!< The subsampling of the channel vertically (as a shift) */
+} remap_channel_t;
+
+/*! \brief Samples up to YUV_REMAP_TILE positions of a channel into the destination.
+ * \param [in] pCh The channel.
+ * \param [in] pPos The first position.
+ * \param [in] posStep The distance between the positions to use.
+ * \param [in] count The number of outputs.
+ * \param [out] pDst The first destination byte.
+ * \param [in] dstStep The distance in bytes between destination samples.
+ */
+static void remap_line(const remap_channel_t *pCh,
+                       const uint32_t *pPos, uint32_t posStep, uint32_t count,
+                       uint8_t *pDst, uint32_t dstStep)
+{
+    uint16_t p00[YUV_REMAP_TILE], p01[YUV_REMAP_TILE];
+    uint16_t p10[YUV_REMAP_TILE], p11[YUV_REMAP_TILE];
+    uint16_t wx[YUV_REMAP_TILE], wy[YUV_REMAP_TILE];
+    uint8_t out[YUV_REMAP_TILE];
+    uint32_t i = 0;
+
+    // gather the four neighbors and the fractions of each position
+    for (i = 0; i < count; i++)
+    {
+        uint32_t pos = pPos[i * posStep];
+        uint32_t x = (pos & 0xFFFF) >> pCh->shiftX;
+        uint32_t y = (pos >> 16) >> pCh->shiftY;
+        uint32_t x0 = x >> YUV_REMAP_Q, y0 = y >> YUV_REMAP_Q;
+        // odd sized sources have a partial chroma sample at the edge
+        if (x0 > pCh->maxX) x0 = pCh->maxX;
+        if (y0 > pCh->maxY) y0 = pCh->maxY;
+        uint32_t x1 = (x0 < pCh->maxX ? x0 + 1 : x0);
+        uint32_t y1 = (y0 < pCh->maxY ? y0 + 1 : y0);
+        uint8_t *pA = &pCh->pSrc[y0 * pCh->stride];
+        uint8_t *pB = &pCh->pSrc[y1 * pCh->stride];
+        p00[i] = pA[x0 * pCh->step];
+        p01[i] = pA[x1 * pCh->step];
+        p10[i] = pB[x0 * pCh->step];
+        p11[i] = pB[x1 * pCh->step];
+        wx[i] = (uint16_t)(x & YUV_REMAP_MASK);
+        wy[i] = (uint16_t)(y & YUV_REMAP_MASK);
+    }
+
+    i = 0;
+#if defined(__SSE2__)
+    {
+        const __m128i one = _mm_set1_epi16(YUV_REMAP_ONE);
+        const __m128i round = _mm_set1_epi16(1 << ((2 * YUV_REMAP_Q) - 1));
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i fx = _mm_loadu_si128((__m128i *)&wx[i]);
+            __m128i fy = _mm_loadu_si128((__m128i *)&wy[i]);
+            __m128i gx = _mm_sub_epi16(one, fx);
+            __m128i gy = _mm_sub_epi16(one, fy);
+            // every intermediate fits unsigned 16 bits (255 * 16 * 16)
+            __m128i top = _mm_add_epi16(_mm_mullo_epi16(_mm_loadu_si128((__m128i *)&p00[i]), gx),
+                                        _mm_mullo_epi16(_mm_loadu_si128((__m128i *)&p01[i]), fx));
+            __m128i bot = _mm_add_epi16(_mm_mullo_epi16(_mm_loadu_si128((__m128i *)&p10[i]), gx),
+                                        _mm_mullo_epi16(_mm_loadu_si128((__m128i *)&p11[i]), fx));
+            __m128i v = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(top, gy), _mm_mullo_epi16(bot, fy)), round);
+            v = _mm_srli_epi16(v, 2 * YUV_REMAP_Q);
+            _mm_storel_epi64((__m128i *)&out[i], _mm_packus_epi16(v, v));
+        }
+    }
+#endif
+    for (; i < count; i++)
+    {
+        uint32_t top = (p00[i] * (YUV_REMAP_ONE - wx[i])) + (p01[i] * wx[i]);
+        uint32_t bot = (p10[i] * (YUV_REMAP_ONE - wx[i])) + (p11[i] * wx[i]);
+        uint32_t v = (top * (YUV_REMAP_ONE - wy[i])) + (bot * wy[i]);
+        out[i] = (uint8_t)((v + (1 << ((2 * YUV_REMAP_Q) - 1))) >> (2 * YUV_REMAP_Q));
+    }
+    for (i = 0; i < count; i++)
+        pDst[i * dstStep] = out[i];
+}
+
+/*! \brief Walks the tiles of the table and samples each channel.
+ * \param [in] t The remap table.
+ * \param [in] pCh The source channels.
+ * \param [in] pDst The first destination byte of each channel.
+ * \param [in] dstStride The destination stride of each channel.
+ * \param [in] dstStep The distance between destination samples of each channel.
+ * \param [in] numCh The number of channels.
+ */
+static void remap_tiles(const yuv_remap_table_t *t,
+                        const remap_channel_t *pCh,
+                        uint8_t **pDst, int32_t *dstStride, uint32_t *dstStep,
+                        uint32_t numCh)
+{
+    const uint32_t *pPos = YUV_REMAP_TABLE_POS(t);
+    uint32_t tx, ty, y, c;
+    for (ty = 0; ty < t->tilesY; ty++)
+    {
+        for (tx = 0; tx < t->tilesX; tx++, pPos += YUV_REMAP_TILE * YUV_REMAP_TILE)
+        {
+            uint32_t x0 = tx * YUV_REMAP_TILE, y0 = ty * YUV_REMAP_TILE;
+            uint32_t w = (t->width - x0 < YUV_REMAP_TILE ? t->width - x0 : YUV_REMAP_TILE);
+            uint32_t h = (t->height - y0 < YUV_REMAP_TILE ? t->height - y0 : YUV_REMAP_TILE);
+            for (c = 0; c < numCh; c++)
+            {
+                // subsampled channels use the positions of the even pixels
+                uint32_t sx = pCh[c].shiftX, sy = pCh[c].shiftY;
+                for (y = 0; y < h; y += (1 << sy))
+                {
+                    uint8_t *pOut = &pDst[c][((y0 + y) >> sy) * dstStride[c] + ((x0 >> sx) * dstStep[c])];
+                    remap_line(&pCh[c], &pPos[y * YUV_REMAP_TILE], 1 << sx, (w + (1 << sx) - 1) >> sx,
+                               pOut, dstStep[c]);
+                }
+            }
+        }
+    }
+}
+
+void __planar_remap_bilinear(void *pTable,
+                             uint8_t *pSrc,
+                             int32_t srcStride,
+                             uint8_t *pDst,
+                             int32_t dstStride)
+{
+    const yuv_remap_table_t *t = (yuv_remap_table_t *)pTable;
+    remap_channel_t ch = {pSrc, srcStride, 1, t->srcWidth - 1, t->srcHeight - 1, 0, 0};
+    uint32_t step = 1;
+    remap_tiles(t, &ch, &pDst, &dstStride, &step, 1);
+}
+
+void __uyvy_remap_bilinear(void *pTable,
+                           uint8_t *pSrc,
+                           int32_t srcStride,
+                           uint8_t *pDst,
+                           int32_t dstStride)
+{
+    const yuv_remap_table_t *t = (yuv_remap_table_t *)pTable;
+    remap_channel_t ch[3] = {
+        {&pSrc[1], srcStride, 2, t->srcWidth - 1,   t->srcHeight - 1, 0, 0}, // Y
+        {&pSrc[0], srcStride, 4, t->srcWidth/2 - 1, t->srcHeight - 1, 1, 0}, // U
+        {&pSrc[2], srcStride, 4, t->srcWidth/2 - 1, t->srcHeight - 1, 1, 0}, // V
+    };
+    uint8_t *dst[3] = {&pDst[1], &pDst[0], &pDst[2]};
+    int32_t strides[3] = {dstStride, dstStride, dstStride};
+    uint32_t steps[3] = {2, 4, 4};
+    remap_tiles(t, ch, dst, strides, steps, 3);
+}
+
+void __nv12_remap_bilinear(void *pTable,
+                           uint8_t *pSrcY,
+                           uint8_t *pSrcUV,
+                           int32_t srcStride,
+                           uint8_t *pDstY,
+                           uint8_t *pDstUV,
+                           int32_t dstStride)
+{
+    const yuv_remap_table_t *t = (yuv_remap_table_t *)pTable;
+    remap_channel_t ch[3] = {
+        {pSrcY,      srcStride, 1, t->srcWidth - 1,   t->srcHeight - 1,   0, 0}, // Y
+        {&pSrcUV[0], srcStride, 2, t->srcWidth/2 - 1, t->srcHeight/2 - 1, 1, 1}, // U
+        {&pSrcUV[1], srcStride, 2, t->srcWidth/2 - 1, t->srcHeight/2 - 1, 1, 1}, // V
+    };
+    uint8_t *dst[3] = {pDstY, &pDstUV[0], &pDstUV[1]};
+    int32_t strides[3] = {dstStride, dstStride, dstStride};
+    uint32_t steps[3] = {1, 2, 2};
+    remap_tiles(t, ch, dst, strides, steps, 3);
+}
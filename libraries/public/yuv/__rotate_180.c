@@ -0,0 +1,46 @@
+/*
+ *  Copyright (C) 2009-2011 Texas Instruments, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*! \file
+ * \brief Rotations by 180 degrees. These have no assembly version, the lines
+ * are reversed with SSE2 where it is available and with plain "C" elsewhere.
+ */
+
+#include "yuv_c.h"
+
+void __planar_rotate_180(uint32_t width,
+                         uint32_t height,
+                         uint8_t *pSrc,
+                         int32_t srcStride,
+                         uint8_t *pDst,
+                         int32_t dstStride)
+{
+    uint32_t y;
+    for (y = 0; y < height; y++)
+        yuv_reverse_line_u08(width, &pSrc[y * srcStride], &pDst[(height - 1 - y) * dstStride]);
+}
+
+void __uyvy_rotate_180(uint32_t width,
+                       uint32_t height,
+                       uint8_t *pSrc,
+                       int32_t srcStride,
+                       uint8_t *pDst,
+                       int32_t dstStride)
+{
+    uint32_t y;
+    for (y = 0; y < height; y++)
+        yuv_mirror_line_uyvy(width, &pSrc[y * srcStride], &pDst[(height - 1 - y) * dstStride]);
+}
@@ -0,0 +1,296 @@
+/*
+ *  Copyright (C) 2009-2011 Texas Instruments, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*! \file
+ * \brief The arbitrary ratio scalers. These have no assembly version. The
+ * coefficients of both dimensions are precomputed into tables (see
+ * \ref __scale_table_init) so that the per-frame work is only the filtering.
+ * Each destination line is made by a vertical pass over the contributing
+ * source lines, which runs in SIMD, and a horizontal pass over the result
+ * using the per-column starting indexes and weights.
+ */
+
+#include "yuv_c.h"
+#include <yuv/yuv_armv7.h>
+
+#define YUV_SCALE_ONE       (1 << YUV_SCALE_Q)
+#define YUV_SCALE_TMP_SHIFT (YUV_SCALE_Q - YUV_SCALE_TMP_Q)
+#define YUV_SCALE_OUT_SHIFT (YUV_SCALE_Q + YUV_SCALE_TMP_Q)
+
+uint32_t __scale_table_taps(uint32_t srcLen, uint32_t dstLen, uint32_t filter)
+{
+    uint32_t taps = 1;
+    if (filter == YUV_SCALE_BILINEAR)
+        taps = 2;
+    else if (filter == YUV_SCALE_AREA)
+        taps = ((srcLen + dstLen - 1) / dstLen) + 1;
+    if (taps > srcLen)
+        taps = srcLen;
+    return taps;
+}
+
+uint32_t __scale_table_size(uint32_t srcLen, uint32_t dstLen, uint32_t filter)
+{
+    uint32_t taps = __scale_table_taps(srcLen, dstLen, filter);
+    uint32_t size = sizeof(yuv_scale_table_t) +
+                    (dstLen * sizeof(int32_t)) +
+                    (dstLen * taps * sizeof(int16_t));
+    return (size + 3) & ~3;
+}
+
+void __scale_table_init(uint32_t srcLen, uint32_t dstLen, uint32_t filter, void *pTable)
+{
+    yuv_scale_table_t *t = (yuv_scale_table_t *)pTable;
+    int32_t *start = YUV_SCALE_TABLE_START(pTable);
+    int16_t *weights = NULL;
+    uint32_t taps = __scale_table_taps(srcLen, dstLen, filter);
+    uint32_t o, k;
+
+    t->srcLen = srcLen;
+    t->dstLen = dstLen;
+    t->taps = taps;
+    t->resv = 0;
+    weights = YUV_SCALE_TABLE_WEIGHTS(pTable);
+
+    for (o = 0; o < dstLen; o++)
+    {
+        int16_t *w = &weights[o * taps];
+        int32_t first = 0, i, last = 0, s;
+        int32_t sum = 0, big = 0;
+
+        for (k = 0; k < taps; k++)
+            w[k] = 0;
+
+        // All positions are kept as integers in units of 1/(2*dstLen) of a
+        // source pixel, so the tables are exact and need no floating point.
+        if (filter == YUV_SCALE_BILINEAR)
+        {
+            int64_t n = ((int64_t)(2 * o + 1) * srcLen) - dstLen;
+            int64_t d = 2 * (int64_t)dstLen;
+            int64_t i0 = (n >= 0 ? n / d : -((d - 1 - n) / d));
+            int32_t a = (int32_t)((((n - (i0 * d)) << YUV_SCALE_Q) + (d / 2)) / d);
+            first = (int32_t)i0;
+            s = first;
+            if (s > (int32_t)(srcLen - taps)) s = srcLen - taps;
+            if (s < 0) s = 0;
+            for (k = 0; k < 2; k++)
+            {
+                i = first + k;
+                if (i < 0) i = 0;
+                if (i > (int32_t)srcLen - 1) i = srcLen - 1;
+                i -= s;
+                if (i > (int32_t)taps - 1) i = taps - 1;
+                w[i] += (int16_t)(k == 0 ? YUV_SCALE_ONE - a : a);
+            }
+        }
+        else if (filter == YUV_SCALE_AREA)
+        {
+            // the destination pixel covers [lo, hi) in units of 1/dstLen
+            int64_t lo = (int64_t)o * srcLen;
+            int64_t hi = (int64_t)(o + 1) * srcLen;
+            first = (int32_t)(lo / dstLen);
+            last = (int32_t)((hi + dstLen - 1) / dstLen);
+            s = first;
+            if (s > (int32_t)(srcLen - taps)) s = srcLen - taps;
+            for (i = first; i < last; i++)
+            {
+                int64_t a = (lo > (int64_t)i * dstLen ? lo : (int64_t)i * dstLen);
+                int64_t b = (hi < (int64_t)(i + 1) * dstLen ? hi : (int64_t)(i + 1) * dstLen);
+                int32_t j = i - s;
+                if (j > (int32_t)taps - 1) j = taps - 1;
+                w[j] += (int16_t)((((b - a) << YUV_SCALE_Q) + (srcLen / 2)) / srcLen);
+            }
+        }
+        else // YUV_SCALE_NEAREST
+        {
+            s = (int32_t)(((int64_t)(2 * o + 1) * srcLen) / (2 * (int64_t)dstLen));
+            if (s > (int32_t)srcLen - 1) s = srcLen - 1;
+            w[0] = YUV_SCALE_ONE;
+        }
+        start[o] = s;
+
+        // make the weights sum to exactly one by adjusting the largest
+        for (k = 0; k < taps; k++)
+        {
+            sum += w[k];
+            if (w[k] > w[big])
+                big = k;
+        }
+        w[big] += (int16_t)(YUV_SCALE_ONE - sum);
+    }
+}
+
+/*! \brief Filters the contributing source lines of a destination line into
+ * the intermediate line, in YUV_SCALE_TMP_Q precision.
+ */
+static void scale_vertical(uint8_t *pSrc, int32_t srcStride, uint32_t bytes,
+                           uint32_t taps, const int16_t *w, int32_t *pTmp)
+{
+    uint32_t x = 0, k;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(1 << (YUV_SCALE_TMP_SHIFT - 1));
+    for (; x + 16 <= bytes; x += 16)
+    {
+        __m128i acc[4];
+        acc[0] = acc[1] = acc[2] = acc[3] = round;
+        for (k = 0; k < taps; k += 2)
+        {
+            // pairs of lines are interleaved so that each multiply-add
+            // applies two taps at once, an odd last tap has a zero partner.
+            uint8_t *pA = &pSrc[(k * srcStride) + x];
+            uint8_t *pB = (k + 1 < taps ? pA + srcStride : pA);
+            int16_t wB = (k + 1 < taps ? w[k+1] : 0);
+            __m128i wp = _mm_set1_epi32(((uint32_t)(uint16_t)wB << 16) | (uint16_t)w[k]);
+            __m128i a = _mm_loadu_si128((__m128i *)pA);
+            __m128i b = _mm_loadu_si128((__m128i *)pB);
+            __m128i alo = _mm_unpacklo_epi8(a, zero);
+            __m128i ahi = _mm_unpackhi_epi8(a, zero);
+            __m128i blo = _mm_unpacklo_epi8(b, zero);
+            __m128i bhi = _mm_unpackhi_epi8(b, zero);
+            acc[0] = _mm_add_epi32(acc[0], _mm_madd_epi16(_mm_unpacklo_epi16(alo, blo), wp));
+            acc[1] = _mm_add_epi32(acc[1], _mm_madd_epi16(_mm_unpackhi_epi16(alo, blo), wp));
+            acc[2] = _mm_add_epi32(acc[2], _mm_madd_epi16(_mm_unpacklo_epi16(ahi, bhi), wp));
+            acc[3] = _mm_add_epi32(acc[3], _mm_madd_epi16(_mm_unpackhi_epi16(ahi, bhi), wp));
+        }
+        for (k = 0; k < 4; k++)
+            _mm_storeu_si128((__m128i *)&pTmp[x + (k * 4)], _mm_srai_epi32(acc[k], YUV_SCALE_TMP_SHIFT));
+    }
+#endif
+    for (; x < bytes; x++)
+    {
+        int32_t acc = 1 << (YUV_SCALE_TMP_SHIFT - 1);
+        for (k = 0; k < taps; k++)
+            acc += w[k] * pSrc[(k * srcStride) + x];
+        pTmp[x] = acc >> YUV_SCALE_TMP_SHIFT;
+    }
+}
+
+/*! \brief Filters one channel of the intermediate line into the destination.
+ * \param [in] pTmp The intermediate line.
+ * \param [in] srcStep The distance in elements between source pixels of the channel.
+ * \param [in] t The horizontal coefficient table.
+ * \param [out] pDst The first destination byte of the channel.
+ * \param [in] dstStep The distance in bytes between destination pixels of the channel.
+ */
+static void scale_horizontal(int32_t *pTmp, uint32_t srcStep,
+                             const yuv_scale_table_t *t,
+                             uint8_t *pDst, uint32_t dstStep)
+{
+    const int32_t *start = YUV_SCALE_TABLE_START(t);
+    const int16_t *w = YUV_SCALE_TABLE_WEIGHTS(t);
+    uint32_t o, k, taps = t->taps;
+    for (o = 0; o < t->dstLen; o++, w += taps)
+    {
+        int32_t *pIn = &pTmp[start[o] * srcStep];
+        int32_t acc = 1 << (YUV_SCALE_OUT_SHIFT - 1);
+        for (k = 0; k < taps; k++)
+            acc += pIn[k * srcStep] * w[k];
+        acc >>= YUV_SCALE_OUT_SHIFT;
+        pDst[o * dstStep] = (uint8_t)(acc > 255 ? 255 : acc);
+    }
+}
+
+void __planar_scale_image(uint32_t srcWidth,
+                          uint32_t srcHeight,
+                          uint8_t *pSrc,
+                          int32_t srcStride,
+                          uint32_t dstWidth,
+                          uint32_t dstHeight,
+                          uint8_t *pDst,
+                          int32_t dstStride,
+                          uint32_t channels,
+                          void *pXTable,
+                          void *pYTable,
+                          int32_t *pTmp)
+{
+    const yuv_scale_table_t *tx = (yuv_scale_table_t *)pXTable;
+    const yuv_scale_table_t *ty = (yuv_scale_table_t *)pYTable;
+    const int32_t *xs = YUV_SCALE_TABLE_START(tx);
+    const int32_t *ys = YUV_SCALE_TABLE_START(ty);
+    const int16_t *wy = YUV_SCALE_TABLE_WEIGHTS(ty);
+    uint32_t x, y, c;
+
+    if (tx->srcLen != srcWidth || tx->dstLen != dstWidth ||
+        ty->srcLen != srcHeight || ty->dstLen != dstHeight)
+        return;
+
+    for (y = 0; y < dstHeight; y++)
+    {
+        uint8_t *pIn = &pSrc[ys[y] * srcStride];
+        uint8_t *pOut = &pDst[y * dstStride];
+        if (tx->taps == 1 && ty->taps == 1)
+        {
+            // nearest neighbor needs no arithmetic at all
+            for (x = 0; x < dstWidth; x++)
+                for (c = 0; c < channels; c++)
+                    pOut[(x * channels) + c] = pIn[(xs[x] * channels) + c];
+            continue;
+        }
+        scale_vertical(pIn, srcStride, srcWidth * channels, ty->taps, &wy[y * ty->taps], pTmp);
+        for (c = 0; c < channels; c++)
+            scale_horizontal(&pTmp[c], channels, tx, &pOut[c], channels);
+    }
+}
+
+void __uyvy_scale_image(uint32_t srcWidth,
+                        uint32_t srcHeight,
+                        uint8_t *pSrc,
+                        int32_t srcStride,
+                        uint32_t dstWidth,
+                        uint32_t dstHeight,
+                        uint8_t *pDst,
+                        int32_t dstStride,
+                        void *pXLumaTable,
+                        void *pXChromaTable,
+                        void *pYTable,
+                        int32_t *pTmp)
+{
+    const yuv_scale_table_t *tl = (yuv_scale_table_t *)pXLumaTable;
+    const yuv_scale_table_t *tc = (yuv_scale_table_t *)pXChromaTable;
+    const yuv_scale_table_t *ty = (yuv_scale_table_t *)pYTable;
+    const int32_t *ls = YUV_SCALE_TABLE_START(tl);
+    const int32_t *cs = YUV_SCALE_TABLE_START(tc);
+    const int32_t *ys = YUV_SCALE_TABLE_START(ty);
+    const int16_t *wy = YUV_SCALE_TABLE_WEIGHTS(ty);
+    uint32_t x, y;
+
+    if (tl->srcLen != srcWidth || tl->dstLen != dstWidth ||
+        tc->srcLen != srcWidth/2 || tc->dstLen != dstWidth/2 ||
+        ty->srcLen != srcHeight || ty->dstLen != dstHeight)
+        return;
+
+    for (y = 0; y < dstHeight; y++)
+    {
+        uint8_t *pIn = &pSrc[ys[y] * srcStride];
+        uint8_t *pOut = &pDst[y * dstStride];
+        if (tl->taps == 1 && tc->taps == 1 && ty->taps == 1)
+        {
+            for (x = 0; x < dstWidth; x++)
+                pOut[(x * 2) + 1] = pIn[(ls[x] * 2) + 1];
+            for (x = 0; x < dstWidth/2; x++)
+            {
+                pOut[(x * 4) + 0] = pIn[(cs[x] * 4) + 0];
+                pOut[(x * 4) + 2] = pIn[(cs[x] * 4) + 2];
+            }
+            continue;
+        }
+        scale_vertical(pIn, srcStride, srcWidth * 2, ty->taps, &wy[y * ty->taps], pTmp);
+        scale_horizontal(&pTmp[1], 2, tl, &pOut[1], 2); // Y
+        scale_horizontal(&pTmp[0], 4, tc, &pOut[0], 4); // U
+        scale_horizontal(&pTmp[2], 4, tc, &pOut[2], 4); // V
+    }
+}
@@ -0,0 +1,172 @@
+/*
+ *  Copyright (C) 2009-2011 Texas Instruments, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*! \file
+ * \brief Deinterlacers for UYVY frames. These have no assembly version. The
+ * missing field is rebuilt in place, either from the average of the lines
+ * around it or by blending that average with the previous field where no
+ * motion is detected. The lines are processed with SSE2 where it is available.
+ */
+
+#include "yuv_c.h"
+#include <yuv/yuv_armv7.h>
+
+/*! \brief The weight of the spatial interpolation when the motion is maximal. */
+#define YUV_DEI_ONE (256)
+
+/*! \brief Returns the field lines above and below a missing line. */
+static void dei_neighbors(uint32_t y, uint32_t height, uint32_t *pA, uint32_t *pB)
+{
+    *pA = (y > 0 ? y - 1 : y + 1);
+    *pB = (y + 1 < height ? y + 1 : y - 1);
+}
+
+void __uyvy_deinterlace_line_average(uint32_t width,
+                                     uint32_t height,
+                                     uint8_t *pFrame,
+                                     int32_t stride,
+                                     uint32_t parity)
+{
+    uint32_t y, a, b, i;
+    for (y = (parity & 1) ^ 1; y < height; y += 2)
+    {
+        uint8_t *pA, *pB, *pO = &pFrame[y * stride];
+        dei_neighbors(y, height, &a, &b);
+        pA = &pFrame[a * stride];
+        pB = &pFrame[b * stride];
+        i = 0;
+#if defined(__SSE2__)
+        for (; i + 16 <= width * 2; i += 16)
+            _mm_storeu_si128((__m128i *)&pO[i], _mm_avg_epu8(_mm_loadu_si128((__m128i *)&pA[i]),
+                                                             _mm_loadu_si128((__m128i *)&pB[i])));
+#endif
+        for (; i < width * 2; i++)
+            pO[i] = (uint8_t)((pA[i] + pB[i] + 1) >> 1);
+    }
+}
+
+/*! \brief Returns the weight of the spatial interpolation for a motion. */
+static uint32_t dei_weight(uint32_t motion, uint32_t bias, uint32_t scale, uint32_t shift)
+{
+    uint32_t w = (motion > bias ? ((motion - bias) * scale) >> shift : 0);
+    return (w > YUV_DEI_ONE ? YUV_DEI_ONE : w);
+}
+
+void __uyvy_deinterlace_motion_adaptive(uint32_t width,
+                                        uint32_t height,
+                                        uint8_t *pFrame,
+                                        int32_t stride,
+                                        uint8_t *pPrev,
+                                        int32_t prevStride,
+                                        uint32_t parity,
+                                        uint8_t *pHistory,
+                                        uint8_t *pMotion,
+                                        uint32_t bias,
+                                        uint32_t scale,
+                                        uint32_t shift)
+{
+    uint32_t y, a, b, i, x;
+    for (y = (parity & 1) ^ 1; y < height; y += 2)
+    {
+        uint8_t *pA, *pB, *pO = &pFrame[y * stride];
+        uint8_t *pT = &pPrev[y * prevStride];
+        uint8_t *pHA, *pHB, *pM = &pMotion[(y / 2) * width];
+        dei_neighbors(y, height, &a, &b);
+        pA = &pFrame[a * stride];
+        pB = &pFrame[b * stride];
+        // the history holds the luma of the last field of the same parity
+        pHA = &pHistory[(a / 2) * width];
+        pHB = &pHistory[(b / 2) * width];
+        x = 0;
+#if defined(__SSE2__)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i one = _mm_set1_epi16(YUV_DEI_ONE);
+            const __m128i round = _mm_set1_epi16(YUV_DEI_ONE/2);
+            const __m128i vbias = _mm_set1_epi16((int16_t)(bias > 255 ? 255 : bias));
+            const __m128i vscale = _mm_set1_epi16((int16_t)scale);
+            const __m128i vshift = _mm_cvtsi32_si128((int)shift);
+            // 8 pixels (4 macropixels) per iteration
+            for (; x + 8 <= width; x += 8)
+            {
+                __m128i a8 = _mm_loadu_si128((__m128i *)&pA[x * 2]);
+                __m128i b8 = _mm_loadu_si128((__m128i *)&pB[x * 2]);
+                __m128i t8 = _mm_loadu_si128((__m128i *)&pT[x * 2]);
+                __m128i ya = _mm_srli_epi16(a8, 8);
+                __m128i yb = _mm_srli_epi16(b8, 8);
+                __m128i ha = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i *)&pHA[x]), zero);
+                __m128i hb = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i *)&pHB[x]), zero);
+                __m128i m0 = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i *)&pM[x]), zero);
+                __m128i da = _mm_or_si128(_mm_subs_epu16(ya, ha), _mm_subs_epu16(ha, ya));
+                __m128i db = _mm_or_si128(_mm_subs_epu16(yb, hb), _mm_subs_epu16(hb, yb));
+                __m128i m = _mm_max_epi16(da, db);
+                __m128i w, s, lo, hi, wl, wh;
+                // both pixels of a macropixel share the chroma, so share the motion
+                m = _mm_max_epi16(m, _mm_or_si128(_mm_slli_epi32(m, 16), _mm_srli_epi32(m, 16)));
+                // the motion decays over the following fields of the same line
+                m = _mm_max_epi16(m, _mm_srli_epi16(m0, 1));
+                _mm_storel_epi64((__m128i *)&pM[x], _mm_packus_epi16(m, m));
+                // w = min(((m - bias) * scale) >> shift, 256), the product fits in 16 bits
+                w = _mm_srl_epi16(_mm_mullo_epi16(_mm_subs_epu16(m, vbias), vscale), vshift);
+                w = _mm_sub_epi16(one, _mm_subs_epu16(one, w));
+                wl = _mm_unpacklo_epi16(w, w);
+                wh = _mm_unpackhi_epi16(w, w);
+                // out = (t * (256 - w) + s * w + 128) >> 8
+                s = _mm_avg_epu8(a8, b8);
+                lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(t8, zero), _mm_sub_epi16(one, wl)),
+                                   _mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), wl));
+                hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(t8, zero), _mm_sub_epi16(one, wh)),
+                                   _mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), wh));
+                lo = _mm_srli_epi16(_mm_add_epi16(lo, round), 8);
+                hi = _mm_srli_epi16(_mm_add_epi16(hi, round), 8);
+                _mm_storeu_si128((__m128i *)&pO[x * 2], _mm_packus_epi16(lo, hi));
+            }
+        }
+#endif
+        for (; x < width; x += 2)
+        {
+            uint32_t m = 0, w, j;
+            for (j = 0; j < 2; j++)
+            {
+                uint32_t ya = pA[(x + j) * 2 + 1], yb = pB[(x + j) * 2 + 1];
+                uint32_t da = (ya > pHA[x + j] ? ya - pHA[x + j] : pHA[x + j] - ya);
+                uint32_t db = (yb > pHB[x + j] ? yb - pHB[x + j] : pHB[x + j] - yb);
+                m = (da > m ? da : m);
+                m = (db > m ? db : m);
+            }
+            for (j = 0; j < 2; j++)
+            {
+                uint32_t mj = (m > (uint32_t)(pM[x + j] >> 1) ? m : (uint32_t)(pM[x + j] >> 1));
+                pM[x + j] = (uint8_t)mj;
+            }
+            for (i = x * 2; i < (x + 2) * 2; i++)
+            {
+                uint32_t s = (pA[i] + pB[i] + 1) >> 1;
+                w = dei_weight(pM[i / 2], bias, scale, shift);
+                pO[i] = (uint8_t)(((pT[i] * (YUV_DEI_ONE - w)) + (s * w) + (YUV_DEI_ONE/2)) >> 8);
+            }
+        }
+    }
+
+    // remember this field for the next one of the same parity
+    for (y = parity & 1; y < height; y += 2)
+    {
+        uint8_t *pL = &pFrame[y * stride];
+        uint8_t *pH = &pHistory[(y / 2) * width];
+        for (x = 0; x < width; x++)
+            pH[x] = pL[x * 2 + 1];
+    }
+}
@@ -0,0 +1,148 @@
+/*
+ *  Copyright (C) 2009-2011 Texas Instruments, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*! \file
+ * \brief The "C" version of the UYVY rotation assembly functions. Each output
+ * macropixel is made from two vertically adjacent source pixels, so the
+ * chroma of the two source rows is averaged. The image is walked in square
+ * tiles, which on SSE2 are split into luma and chroma, transposed in registers
+ * and re-interleaved.
+ */
+
+#include "yuv_c.h"
+
+/*! \brief Rotates a rectangle of the source image one macropixel at a time.
+ * This handles the partial tiles on the right and bottom edges. The
+ * rectangle must start and end on even rows and columns.
+ */
+static void uyvy_rotate_rect(uint32_t width, uint32_t height,
+                             uint8_t *pSrc, int32_t srcStride,
+                             uint8_t *pDst, int32_t dstStride,
+                             uint32_t x0, uint32_t y0,
+                             uint32_t x1, uint32_t y1,
+                             int cw)
+{
+    uint32_t x, y;
+    for (y = y0; y < y1; y += 2)
+    {
+        uint8_t *pA = &pSrc[y * srcStride];
+        uint8_t *pB = &pSrc[(y + 1) * srcStride];
+        for (x = x0; x < x1; x++)
+        {
+            uint32_t c = (x & ~1) * 2;
+            YUV422 out;
+            out.UYVY.U0 = (uint8_t)((pA[c+0] + pB[c+0] + 1) >> 1);
+            out.UYVY.V0 = (uint8_t)((pA[c+2] + pB[c+2] + 1) >> 1);
+            if (cw)
+            {
+                out.UYVY.Y0 = pB[(x * 2) + 1];
+                out.UYVY.Y1 = pA[(x * 2) + 1];
+                *(uint32_t *)&pDst[(x * dstStride) + ((height - 2 - y) * 2)] = out.packed;
+            }
+            else
+            {
+                out.UYVY.Y0 = pA[(x * 2) + 1];
+                out.UYVY.Y1 = pB[(x * 2) + 1];
+                *(uint32_t *)&pDst[((width - 1 - x) * dstStride) + (y * 2)] = out.packed;
+            }
+        }
+    }
+}
+
+#if defined(__SSE2__)
+/*! \brief Rotates a full tile of the source image in SIMD registers. The luma
+ * is transposed as a 16x16 byte tile and the row-averaged chroma as an 8x8
+ * tile of UV pairs, then both are interleaved back into macropixels.
+ */
+static void uyvy_rotate_tile(uint32_t width, uint32_t height,
+                             uint8_t *pSrc, int32_t srcStride,
+                             uint8_t *pDst, int32_t dstStride,
+                             uint32_t x0, uint32_t y0,
+                             int cw)
+{
+    const __m128i chroma = _mm_set1_epi16(0x00FF);
+    __m128i luma[YUV_TILE_SIZE];
+    __m128i uv[YUV_TILE_SIZE];
+    uint32_t i;
+    for (i = 0; i < YUV_TILE_SIZE; i++)
+    {
+        uint32_t y = (cw ? (y0 + YUV_TILE_SIZE - 1 - i) : (y0 + i));
+        uint8_t *pIn = &pSrc[(y * srcStride) + (x0 * 2)];
+        __m128i lo = _mm_loadu_si128((__m128i *)&pIn[0]);
+        __m128i hi = _mm_loadu_si128((__m128i *)&pIn[16]);
+        luma[i] = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+        uv[i] = _mm_packus_epi16(_mm_and_si128(lo, chroma), _mm_and_si128(hi, chroma));
+    }
+    for (i = 0; i < YUV_TILE_SIZE/2; i++)
+        uv[i] = _mm_avg_epu8(uv[2*i], uv[2*i+1]);
+    yuv_transpose_16x16_u08(luma);
+    yuv_transpose_8x8_u16(uv);
+    for (i = 0; i < YUV_TILE_SIZE; i++)
+    {
+        uint8_t *pOut;
+        if (cw)
+            pOut = &pDst[((x0 + i) * dstStride) + ((height - YUV_TILE_SIZE - y0) * 2)];
+        else
+            pOut = &pDst[((width - 1 - x0 - i) * dstStride) + (y0 * 2)];
+        _mm_storeu_si128((__m128i *)&pOut[0],  _mm_unpacklo_epi8(uv[i/2], luma[i]));
+        _mm_storeu_si128((__m128i *)&pOut[16], _mm_unpackhi_epi8(uv[i/2], luma[i]));
+    }
+}
+#endif
+
+static void uyvy_rotate(uint32_t width, uint32_t height,
+                        uint8_t *pSrc, int32_t srcStride,
+                        uint8_t *pDst, int32_t dstStride,
+                        int cw)
+{
+    uint32_t x0, y0;
+    for (y0 = 0; y0 < height; y0 += YUV_TILE_SIZE)
+    {
+        uint32_t y1 = (y0 + YUV_TILE_SIZE < height ? y0 + YUV_TILE_SIZE : height);
+        for (x0 = 0; x0 < width; x0 += YUV_TILE_SIZE)
+        {
+            uint32_t x1 = (x0 + YUV_TILE_SIZE < width ? x0 + YUV_TILE_SIZE : width);
+#if defined(__SSE2__)
+            if (x1 - x0 == YUV_TILE_SIZE && y1 - y0 == YUV_TILE_SIZE)
+            {
+                uyvy_rotate_tile(width, height, pSrc, srcStride, pDst, dstStride, x0, y0, cw);
+                continue;
+            }
+#endif
+            uyvy_rotate_rect(width, height, pSrc, srcStride, pDst, dstStride, x0, y0, x1, y1, cw);
+        }
+    }
+}
+
+void __uyvy_rotate_ccw90(uint32_t width,
+                         uint32_t height,
+                         uint8_t *pSrc,
+                         uint8_t *pDst,
+                         int32_t srcStride,
+                         int32_t dstStride)
+{
+    uyvy_rotate(width, height, pSrc, srcStride, pDst, dstStride, 0);
+}
+
+void __uyvy_rotate_cw90(uint32_t width,
+                        uint32_t height,
+                        uint8_t *pSrc,
+                        uint8_t *pDst,
+                        int32_t srcStride,
+                        int32_t dstStride)
+{
+    uyvy_rotate(width, height, pSrc, srcStride, pDst, dstStride, 1);
+}
@@ -26,7 +26,8 @@ ifdef DVP_LOCAL_BUILD
 TARGET=yuv
 TARGETTYPE=library
 ASSEMBLY:=$(all-S-files)
-CSOURCES:=
+CSOURCES:=__rotate_180.c __scale_image.c __remap_image.c __uyvy_deinterlace.c
+IDIRS+=$(_MODPATH)/include
 endif # LOCAL
 
 include $(FINALE)
@@ -37,15 +38,16 @@ else # ARM
 
 include $(PRELUDE)
 
-# Don't expose this yet.
-#VISION_LIBRARIES+=yuv
-#DVP_INC+=$(_MODPATH)/include
-#DVP_FEATURES+=DVP_USE_YUV
+# Only the kernels which have a "C" model are exposed.
+VISION_LIBRARIES+=yuv
+DVP_INC+=$(_MODPATH)/include
+DVP_FEATURES+=DVP_USE_YUV_C
 
 ifdef DVP_LOCAL_BUILD
 TARGET=yuv
 TARGETTYPE=library
 CSOURCES:=$(all-c-files)
+IDIRS+=$(_MODPATH)/include
 endif # LOCAL
 
 include $(FINALE)
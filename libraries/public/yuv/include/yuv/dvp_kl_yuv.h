@@ -24,7 +24,7 @@
 #ifndef _DVP_KL_YUV_H_
 #define _DVP_KL_YUV_H_
 
-#ifdef DVP_USE_YUV
+#if defined(DVP_USE_YUV) || defined(DVP_USE_YUV_C)
 
 #include <dvp/dvp_types.h>
 
@@ -219,6 +219,31 @@ enum DVP_KernelNode_Yuv_e {
      * \param [out] output Image color type supported: FOURCC_RGBP
      */
     DVP_KN_YUV_YUV444_TO_RGBp,
+
+    /*!
+     * Rotates any N plane (8 bit per plane) image by 180 Degrees\n
+     * Configuration Structure: DVP_Transform_t
+     * \param [in] input     Image color type supported: FOURCC_Y800, FOURCC_IYUV, FOURCC_YV12, FOURCC_YU16, FOURCC_YV16, FOURCC_YU24, FOURCC_YV24
+     * \param [out] output    Image color type supported: same as input
+     */
+    DVP_KN_YUV_Y800_ROTATE_180,
+
+    /*!
+     * Rotates FOURCC_UYVY data by 180 Degrees\n
+     * Configuration Structure: DVP_Transform_t
+     * \param [in] input     Image color type supported: FOURCC_UYVY
+     * \param [out] output    Image color type supported: FOURCC_UYVY
+     */
+    DVP_KN_YUV_UYVY_ROTATE_180,
+
+    /*!
+     * Scales an image by an arbitrary ratio in each dimension. The filter
+     * coefficients are computed when the graph is verified.\n
+     * Configuration Structure: DVP_YUV_Scale_t
+     * \param [in] input     Image color type supported: FOURCC_Y800, FOURCC_UYVY, FOURCC_NV12
+     * \param [out] output    Image color type supported: same as input
+     */
+    DVP_KN_YUV_SCALE,
 };
 
 /*! \brief Use this struct with the YUV kernels which support one input and three outputs.
@@ -232,7 +257,25 @@ typedef struct _dvp_yuv_triple_transform_t {
     DVP_Image_t out3;
 } DVP_YUV_TripleTransform_t;
 
-#endif // DVP_USE_YUV
+/*! \brief The filters available to \ref DVP_KN_YUV_SCALE.
+ * \ingroup group_yuv
+ */
+typedef enum _dvp_yuv_scale_filter_e {
+    DVP_YUV_SCALE_NEAREST = 0,  /*!< Nearest neighbor, the fastest */
+    DVP_YUV_SCALE_BILINEAR,     /*!< Bilinear interpolation of the 4 nearest pixels */
+    DVP_YUV_SCALE_AREA,         /*!< Averages all the covered source pixels, the best for downscaling */
+} DVP_YUV_ScaleFilter_e;
+
+/*! \brief Use this struct with \ref DVP_KN_YUV_SCALE.
+ * \ingroup group_yuv
+ */
+typedef struct _dvp_yuv_scale_t {
+    DVP_Image_t input;      /*!< The source image */
+    DVP_Image_t output;     /*!< The destination image, its dimensions set the ratio */
+    DVP_U32     filter;     /*!< \see DVP_YUV_ScaleFilter_e */
+} DVP_YUV_Scale_t;
+
+#endif // DVP_USE_YUV || DVP_USE_YUV_C
 
 #endif // _DVP_KL_YUV_H_
 
@@ -307,6 +307,42 @@ void __planar_rotate_ccw90(uint32_t width,
                            uint8_t *pSrc,
                            uint8_t *pDst);
 
+#if defined(DVP_USE_YUV_C)
+/*! \brief Rotates a single plane of byte sized data clockwise 90 degrees
+ * between strided planes. Only the "C" model provides this.
+ * \param [in] width The width in pixels.
+ * \param [in] height The height in pixels.
+ * \param [in] pSrc The pointer to the source image.
+ * \param [in] srcStride The stride in bytes of the source image.
+ * \param [out] pDst The pointer to the destination image.
+ * \param [in] dstStride The stride in bytes of the destination image.
+ * \ingroup group_yuv
+ */
+void __planar_rotate_cw90_stride(uint32_t width,
+                                 uint32_t height,
+                                 uint8_t *pSrc,
+                                 int32_t srcStride,
+                                 uint8_t *pDst,
+                                 int32_t dstStride);
+
+/*! \brief Rotates a single plane of byte sized data counter-clockwise 90 degrees
+ * between strided planes. Only the "C" model provides this.
+ * \param [in] width The width in pixels.
+ * \param [in] height The height in pixels.
+ * \param [in] pSrc The pointer to the source image.
+ * \param [in] srcStride The stride in bytes of the source image.
+ * \param [out] pDst The pointer to the destination image.
+ * \param [in] dstStride The stride in bytes of the destination image.
+ * \ingroup group_yuv
+ */
+void __planar_rotate_ccw90_stride(uint32_t width,
+                                  uint32_t height,
+                                  uint8_t *pSrc,
+                                  int32_t srcStride,
+                                  uint8_t *pDst,
+                                  int32_t dstStride);
+#endif
+
 /*! \brief A subroutine to scale down a UYVY image by 2.
  * \param [in] width The width in pixels.
  * \param [in] height The height in pixels.
@@ -387,6 +423,256 @@ void __uyvy_rotate_cw90(uint32_t width,
                         int32_t srcStride,
                         int32_t dstStride);
 
+/*! \brief Rotates a single plane of byte sized data 180 degrees.
+ * \param [in] width The width in pixels.
+ * \param [in] height The height in pixels.
+ * \param [in] pSrc The pointer to the source image.
+ * \param [in] srcStride The stride in bytes of the source image.
+ * \param [out] pDst The pointer to the destination image.
+ * \param [in] dstStride The stride in bytes of the destination image.
+ * \ingroup group_yuv
+ */
+void __planar_rotate_180(uint32_t width,
+                         uint32_t height,
+                         uint8_t *pSrc,
+                         int32_t srcStride,
+                         uint8_t *pDst,
+                         int32_t dstStride);
+
+/*! \brief Rotates a UYVY formated image 180 degrees.
+ * \param [in] width The width in pixels.
+ * \param [in] height The height in pixels.
+ * \param [in] pSrc The pointer to the source image.
+ * \param [in] srcStride The stride in bytes of the source image.
+ * \param [out] pDst The pointer to the destination image.
+ * \param [in] dstStride The stride in bytes of the destination image.
+ * \ingroup group_yuv
+ */
+void __uyvy_rotate_180(uint32_t width,
+                       uint32_t height,
+                       uint8_t *pSrc,
+                       int32_t srcStride,
+                       uint8_t *pDst,
+                       int32_t dstStride);
+
+/*! \brief The nearest neighbor filter of the arbitrary ratio scalers. \ingroup group_yuv */
+#define YUV_SCALE_NEAREST   (0)
+/*! \brief The bilinear filter of the arbitrary ratio scalers. \ingroup group_yuv */
+#define YUV_SCALE_BILINEAR  (1)
+/*! \brief The area (box) filter of the arbitrary ratio scalers. \ingroup group_yuv */
+#define YUV_SCALE_AREA      (2)
+
+/*! \brief Returns the number of source pixels which contribute to each
+ * destination pixel for a scaling ratio and filter.
+ * \param [in] srcLen The number of source pixels along the dimension.
+ * \param [in] dstLen The number of destination pixels along the dimension.
+ * \param [in] filter One of YUV_SCALE_NEAREST, YUV_SCALE_BILINEAR or YUV_SCALE_AREA.
+ * \ingroup group_yuv
+ */
+uint32_t __scale_table_taps(uint32_t srcLen, uint32_t dstLen, uint32_t filter);
+
+/*! \brief Returns the size in bytes of a scaler coefficient table.
+ * \param [in] srcLen The number of source pixels along the dimension.
+ * \param [in] dstLen The number of destination pixels along the dimension.
+ * \param [in] filter One of YUV_SCALE_NEAREST, YUV_SCALE_BILINEAR or YUV_SCALE_AREA.
+ * \ingroup group_yuv
+ */
+uint32_t __scale_table_size(uint32_t srcLen, uint32_t dstLen, uint32_t filter);
+
+/*! \brief Computes the coefficients of one dimension of a scaler into a table.
+ * This is meant to be done once per configuration, not per frame.
+ * \param [in] srcLen The number of source pixels along the dimension.
+ * \param [in] dstLen The number of destination pixels along the dimension.
+ * \param [in] filter One of YUV_SCALE_NEAREST, YUV_SCALE_BILINEAR or YUV_SCALE_AREA.
+ * \param [out] pTable The table, of __scale_table_size bytes, aligned to 4 bytes.
+ * \ingroup group_yuv
+ */
+void __scale_table_init(uint32_t srcLen, uint32_t dstLen, uint32_t filter, void *pTable);
+
+/*! \brief Scales a plane of byte sized data with interleaved channels (ie.
+ * Y800 or the UV plane of NV12) by an arbitrary ratio.
+ * \param [in] srcWidth The source width in pixels.
+ * \param [in] srcHeight The source height in pixels.
+ * \param [in] pSrc The pointer to the source image.
+ * \param [in] srcStride The stride in bytes of the source image.
+ * \param [in] dstWidth The destination width in pixels.
+ * \param [in] dstHeight The destination height in pixels.
+ * \param [out] pDst The pointer to the destination image.
+ * \param [in] dstStride The stride in bytes of the destination image.
+ * \param [in] channels The number of interleaved bytes per pixel.
+ * \param [in] pXTable The table from srcWidth to dstWidth.
+ * \param [in] pYTable The table from srcHeight to dstHeight.
+ * \param [in] pTmp Scratch memory of srcWidth*channels elements.
+ * \ingroup group_yuv
+ */
+void __planar_scale_image(uint32_t srcWidth,
+                          uint32_t srcHeight,
+                          uint8_t *pSrc,
+                          int32_t srcStride,
+                          uint32_t dstWidth,
+                          uint32_t dstHeight,
+                          uint8_t *pDst,
+                          int32_t dstStride,
+                          uint32_t channels,
+                          void *pXTable,
+                          void *pYTable,
+                          int32_t *pTmp);
+
+/*! \brief Scales a UYVY image by an arbitrary ratio.
+ * \param [in] srcWidth The source width in pixels.
+ * \param [in] srcHeight The source height in pixels.
+ * \param [in] pSrc The pointer to the source image.
+ * \param [in] srcStride The stride in bytes of the source image.
+ * \param [in] dstWidth The destination width in pixels.
+ * \param [in] dstHeight The destination height in pixels.
+ * \param [out] pDst The pointer to the destination image.
+ * \param [in] dstStride The stride in bytes of the destination image.
+ * \param [in] pXLumaTable The table from srcWidth to dstWidth.
+ * \param [in] pXChromaTable The table from srcWidth/2 to dstWidth/2.
+ * \param [in] pYTable The table from srcHeight to dstHeight.
+ * \param [in] pTmp Scratch memory of srcWidth*2 elements.
+ * \ingroup group_yuv
+ */
+void __uyvy_scale_image(uint32_t srcWidth,
+                        uint32_t srcHeight,
+                        uint8_t *pSrc,
+                        int32_t srcStride,
+                        uint32_t dstWidth,
+                        uint32_t dstHeight,
+                        uint8_t *pDst,
+                        int32_t dstStride,
+                        void *pXLumaTable,
+                        void *pXChromaTable,
+                        void *pYTable,
+                        int32_t *pTmp);
+
+/*! \brief Returns the size in bytes of a remap table.
+ * \param [in] width The width of the destination in pixels.
+ * \param [in] height The height of the destination in pixels.
+ * \ingroup group_yuv
+ */
+uint32_t __remap_table_size(uint32_t width, uint32_t height);
+
+/*! \brief Initializes the header of a remap table. The positions must then
+ * be set for every destination pixel with __remap_table_set.
+ * \param [in] width The width of the destination in pixels.
+ * \param [in] height The height of the destination in pixels.
+ * \param [in] srcWidth The width of the source in pixels.
+ * \param [in] srcHeight The height of the source in pixels.
+ * \param [out] pTable The table, of __remap_table_size bytes, aligned to 4 bytes.
+ * \ingroup group_yuv
+ */
+void __remap_table_init(uint32_t width,
+                        uint32_t height,
+                        uint32_t srcWidth,
+                        uint32_t srcHeight,
+                        void *pTable);
+
+/*! \brief Sets the source position of a destination pixel. Positions outside
+ * of the source are clamped to its edges.
+ * \param [in] pTable The table.
+ * \param [in] x The destination column.
+ * \param [in] y The destination row.
+ * \param [in] srcX The source column in Q4.
+ * \param [in] srcY The source row in Q4.
+ * \ingroup group_yuv
+ */
+void __remap_table_set(void *pTable, uint32_t x, uint32_t y, int32_t srcX, int32_t srcY);
+
+/*! \brief Remaps a plane of bytes through a table with bilinear interpolation.
+ * \param [in] pTable The table.
+ * \param [in] pSrc The pointer to the source plane.
+ * \param [in] srcStride The stride in bytes of the source.
+ * \param [out] pDst The pointer to the destination plane.
+ * \param [in] dstStride The stride in bytes of the destination.
+ * \ingroup group_yuv
+ */
+void __planar_remap_bilinear(void *pTable,
+                             uint8_t *pSrc,
+                             int32_t srcStride,
+                             uint8_t *pDst,
+                             int32_t dstStride);
+
+/*! \brief Remaps a UYVY image through a table with bilinear interpolation.
+ * The chroma of each macropixel is taken from the position of its even pixel.
+ * \param [in] pTable The table.
+ * \param [in] pSrc The pointer to the source image.
+ * \param [in] srcStride The stride in bytes of the source.
+ * \param [out] pDst The pointer to the destination image.
+ * \param [in] dstStride The stride in bytes of the destination.
+ * \ingroup group_yuv
+ */
+void __uyvy_remap_bilinear(void *pTable,
+                           uint8_t *pSrc,
+                           int32_t srcStride,
+                           uint8_t *pDst,
+                           int32_t dstStride);
+
+/*! \brief Remaps a NV12 image through a table with bilinear interpolation.
+ * The chroma is taken from the positions of the even pixels of the even lines.
+ * \param [in] pTable The table.
+ * \param [in] pSrcY The pointer to the source luma plane.
+ * \param [in] pSrcUV The pointer to the source chroma plane.
+ * \param [in] srcStride The stride in bytes of both source planes.
+ * \param [out] pDstY The pointer to the destination luma plane.
+ * \param [out] pDstUV The pointer to the destination chroma plane.
+ * \param [in] dstStride The stride in bytes of both destination planes.
+ * \ingroup group_yuv
+ */
+void __nv12_remap_bilinear(void *pTable,
+                           uint8_t *pSrcY,
+                           uint8_t *pSrcUV,
+                           int32_t srcStride,
+                           uint8_t *pDstY,
+                           uint8_t *pDstUV,
+                           int32_t dstStride);
+
+/*! \brief Rebuilds the missing field of an interlaced UYVY frame in place
+ * from the average of the field lines around each missing line.
+ * \param [in] width The width in pixels.
+ * \param [in] height The height of the frame in lines.
+ * \param [in,out] pFrame The frame which holds the current field.
+ * \param [in] stride The stride in bytes of the frame.
+ * \param [in] parity The lines of the current field, 0 for the even lines, 1 for the odd lines.
+ * \ingroup group_yuv
+ */
+void __uyvy_deinterlace_line_average(uint32_t width,
+                                     uint32_t height,
+                                     uint8_t *pFrame,
+                                     int32_t stride,
+                                     uint32_t parity);
+
+/*! \brief Rebuilds the missing field of an interlaced UYVY frame in place.
+ * Each missing pixel blends the previous field with the line average by the
+ * luma motion measured against the last field of the current parity.
+ * \param [in] width The width in pixels.
+ * \param [in] height The height of the frame in lines.
+ * \param [in,out] pFrame The frame which holds the current field.
+ * \param [in] stride The stride in bytes of the frame.
+ * \param [in] pPrev The previous frame, which holds the previous field on the missing lines.
+ * \param [in] prevStride The stride in bytes of the previous frame.
+ * \param [in] parity The lines of the current field, 0 for the even lines, 1 for the odd lines.
+ * \param [in,out] pHistory The luma of the last field of this parity, width*height/2 bytes. It is updated with the current field.
+ * \param [in,out] pMotion The motion of the missing lines, width*height/2 bytes. Fill it with 255 before the first field.
+ * \param [in] bias The motion below which the previous field is used alone.
+ * \param [in] scale The gain of the motion, up to 256.
+ * \param [in] shift The downshift of the gain. The line average is used alone
+ * once ((motion - bias) * scale) >> shift reaches 256.
+ * \ingroup group_yuv
+ */
+void __uyvy_deinterlace_motion_adaptive(uint32_t width,
+                                        uint32_t height,
+                                        uint8_t *pFrame,
+                                        int32_t stride,
+                                        uint8_t *pPrev,
+                                        int32_t prevStride,
+                                        uint32_t parity,
+                                        uint8_t *pHistory,
+                                        uint8_t *pMotion,
+                                        uint32_t bias,
+                                        uint32_t scale,
+                                        uint32_t shift);
+
 /*! \brief Converts a UYVY formated image to a YUV444 planar image.
  * \param [in] width The width in pixels.
  * \param [in] height The height in pixels.
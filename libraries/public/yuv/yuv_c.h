@@ -199,4 +199,172 @@ typedef union _rgb565pair {
     v = (((7192 * r) >> 14) - ((6029 * g) >> 14) - ((1163 * b) >> 14) + 128); \
     if (v < 128) v = 128; if (v > 240) v = 240; \
 }
+
+/*! \brief The fixed point precision of the scaler coefficients. */
+#define YUV_SCALE_Q         (14)
+
+/*! \brief The precision of the intermediate (vertically filtered) values of the scaler. */
+#define YUV_SCALE_TMP_Q     (8)
+
+/*! \brief The layout of a scaler coefficient table. The structure is followed
+ * in memory by the starting source index of each destination index and then
+ * by "taps" weights per destination index, which sum to 1 << YUV_SCALE_Q.
+ */
+typedef struct _yuv_scale_table_t {
+    uint32_t srcLen;    /*!< The number of source pixels along the dimension */
+    uint32_t dstLen;    /*!< The number of destination pixels along the dimension */
+    uint32_t taps;      /*!< The number of source pixels contributing to each destination pixel */
+    uint32_t resv;      /*!< Keeps the arrays which follow aligned */
+} yuv_scale_table_t;
+
+#define YUV_SCALE_TABLE_START(t)    ((int32_t *)&((yuv_scale_table_t *)(t))[1])
+#define YUV_SCALE_TABLE_WEIGHTS(t)  ((int16_t *)&YUV_SCALE_TABLE_START(t)[((yuv_scale_table_t *)(t))->dstLen])
+
+/*! \brief The edge length in pixels of the square output tiles of a remap table. */
+#define YUV_REMAP_TILE      (16)
+
+/*! \brief The number of fractional bits of the source positions in a remap table. */
+#define YUV_REMAP_Q         (4)
+
+/*! \brief The layout of a remap table. The structure is followed in memory by
+ * one packed source position per destination pixel, grouped by tiles of
+ * YUV_REMAP_TILE x YUV_REMAP_TILE pixels so that a tile reads one contiguous
+ * run of the table. Each position holds x in the low 16 bits and y in the high
+ * 16 bits, both unsigned with YUV_REMAP_Q fractional bits.
+ */
+typedef struct _yuv_remap_table_t {
+    uint32_t width;     /*!< The destination width */
+    uint32_t height;    /*!< The destination height */
+    uint32_t srcWidth;  /*!< The source width, positions are clamped inside it */
+    uint32_t srcHeight; /*!< The source height, positions are clamped inside it */
+    uint32_t tilesX;    /*!< The number of tiles across */
+    uint32_t tilesY;    /*!< The number of tiles down */
+} yuv_remap_table_t;
+
+#define YUV_REMAP_TABLE_POS(t)  ((uint32_t *)&((yuv_remap_table_t *)(t))[1])
+
+/*! \brief The edge length in pixels of the square tiles used by the rotation models.
+ * A 16x16 tile of bytes fits in a set of 16 SIMD registers and keeps both the
+ * source rows and the destination rows of a tile resident in the L1 cache.
+ */
+#define YUV_TILE_SIZE   (16)
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+/*! \brief Transposes a 16x16 tile of bytes held in 16 SSE2 registers in place.
+ * \param [in,out] r The 16 rows of the tile, which become the 16 columns.
+ */
+static inline void yuv_transpose_16x16_u08(__m128i r[16])
+{
+    __m128i a[16], b[16], c[16];
+    int i, k;
+    // interleave pairs of rows, each register holds 8 columns of 2 rows
+    for (i = 0; i < 16; i += 2) {
+        a[i+0] = _mm_unpacklo_epi8(r[i], r[i+1]);
+        a[i+1] = _mm_unpackhi_epi8(r[i], r[i+1]);
+    }
+    // interleave pairs of pairs, each register holds 4 columns of 4 rows
+    for (i = 0; i < 16; i += 4) {
+        b[i+0] = _mm_unpacklo_epi16(a[i+0], a[i+2]);
+        b[i+1] = _mm_unpackhi_epi16(a[i+0], a[i+2]);
+        b[i+2] = _mm_unpacklo_epi16(a[i+1], a[i+3]);
+        b[i+3] = _mm_unpackhi_epi16(a[i+1], a[i+3]);
+    }
+    // each register holds 2 columns of 8 rows
+    for (i = 0; i < 16; i += 8) {
+        for (k = 0; k < 4; k++) {
+            c[i+2*k+0] = _mm_unpacklo_epi32(b[i+k], b[i+4+k]);
+            c[i+2*k+1] = _mm_unpackhi_epi32(b[i+k], b[i+4+k]);
+        }
+    }
+    // each register holds 1 column of 16 rows
+    for (k = 0; k < 8; k++) {
+        r[2*k+0] = _mm_unpacklo_epi64(c[k], c[8+k]);
+        r[2*k+1] = _mm_unpackhi_epi64(c[k], c[8+k]);
+    }
+}
+
+/*! \brief Transposes an 8x8 tile of 16 bit elements held in 8 SSE2 registers in place.
+ * \param [in,out] r The 8 rows of the tile, which become the 8 columns.
+ */
+static inline void yuv_transpose_8x8_u16(__m128i r[8])
+{
+    __m128i a[8], b[8];
+    int i, k;
+    for (i = 0; i < 8; i += 2) {
+        a[i+0] = _mm_unpacklo_epi16(r[i], r[i+1]);
+        a[i+1] = _mm_unpackhi_epi16(r[i], r[i+1]);
+    }
+    for (i = 0; i < 8; i += 4) {
+        b[i+0] = _mm_unpacklo_epi32(a[i+0], a[i+2]);
+        b[i+1] = _mm_unpackhi_epi32(a[i+0], a[i+2]);
+        b[i+2] = _mm_unpacklo_epi32(a[i+1], a[i+3]);
+        b[i+3] = _mm_unpackhi_epi32(a[i+1], a[i+3]);
+    }
+    for (k = 0; k < 4; k++) {
+        r[2*k+0] = _mm_unpacklo_epi64(b[k], b[4+k]);
+        r[2*k+1] = _mm_unpackhi_epi64(b[k], b[4+k]);
+    }
+}
+#endif
+
+/*! \brief Writes a line of bytes to the destination in reverse order.
+ * \param [in] width The number of bytes in the line.
+ * \param [in] pSrc The pointer to the first byte of the source line.
+ * \param [out] pDst The pointer to the first byte of the destination line.
+ */
+static inline void yuv_reverse_line_u08(uint32_t width, uint8_t *pSrc, uint8_t *pDst)
+{
+    uint32_t x = 0;
+#if defined(__SSE2__)
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i v = _mm_loadu_si128((__m128i *)&pSrc[x]);
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0,1,2,3));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0,1,2,3));
+        v = _mm_shuffle_epi32(v, _MM_SHUFFLE(1,0,3,2));
+        _mm_storeu_si128((__m128i *)&pDst[width - x - 16], v);
+    }
+#endif
+    for (; x < width; x++)
+        pDst[width - x - 1] = pSrc[x];
+}
+
+/*! \brief Writes a line of UYVY macropixels to the destination in reverse
+ * order, swapping the Y0 and Y1 in each macropixel, which mirrors the line.
+ * \param [in] width The number of pixels in the line (must be even).
+ * \param [in] pSrc The pointer to the first byte of the source line.
+ * \param [out] pDst The pointer to the first byte of the destination line.
+ */
+static inline void yuv_mirror_line_uyvy(uint32_t width, uint8_t *pSrc, uint8_t *pDst)
+{
+    uint32_t m = 0, macros = width/2;
+    uint32_t *pS = (uint32_t *)pSrc;
+    uint32_t *pD = (uint32_t *)pDst;
+#if defined(__SSE2__)
+    const __m128i chroma = _mm_set1_epi32(0x00FF00FF);
+    for (; m + 4 <= macros; m += 4)
+    {
+        __m128i v = _mm_loadu_si128((__m128i *)&pS[m]);
+        __m128i uv = _mm_and_si128(v, chroma);
+        __m128i yy = _mm_andnot_si128(chroma, v);
+        yy = _mm_or_si128(_mm_slli_epi32(yy, 16), _mm_srli_epi32(yy, 16));
+        v = _mm_shuffle_epi32(_mm_or_si128(uv, yy), _MM_SHUFFLE(0,1,2,3));
+        _mm_storeu_si128((__m128i *)&pD[macros - m - 4], v);
+    }
+#endif
+    for (; m < macros; m++)
+    {
+        YUV422 a, b;
+        a.packed = pS[m];
+        b.UYVY.U0 = a.UYVY.U0;
+        b.UYVY.Y0 = a.UYVY.Y1;
+        b.UYVY.V0 = a.UYVY.V0;
+        b.UYVY.Y1 = a.UYVY.Y0;
+        pD[macros - m - 1] = b.packed;
+    }
+}
+
 #endif
@@ -37,11 +37,23 @@
 #define DVP_OPTIMIZED_KERNELS
 #include <dvp_ll.h>
 
-#if defined(DVP_USE_YUV)
+#if defined(DVP_USE_YUV) || defined(DVP_USE_YUV_C)
 #include <yuv/yuv_armv7.h>
 #include <yuv/dvp_kl_yuv.h>
 #endif
 
+#if defined(DVP_USE_LDC)
+#include <vrun/dvp_kl_vrun.h>
+#endif
+
+#if defined(DVP_USE_DEI_C)
+#include <dei/dvp_kl_dei.h>
+#endif
+
+#if defined(DVP_USE_DSPLIB_C)
+#include <dsplib/dvp_kl_dsplib.h>
+#endif
+
 #if defined(DVP_USE_IMGFILTER)
 #include <imgfilter/imgFilter_armv7.h>
 #include <imgfilter/dvp_kl_imgfilter.h>
@@ -475,10 +487,6 @@ static DVP_CoreFunction_t local_kernels[] = {
     {"NEON \"YUV\" NV12 to YUV444p", DVP_KN_YUV_NV12_TO_YU24_HALF_SCALE, 0, NULL, NULL},
     {"NEON \"YUV\" UYVY HALF SCALE", DVP_KN_YUV_UYVY_HALF_SCALE, 0, NULL, NULL},
     {"NEON \"YUV\" UYVY QTR SCALE",  DVP_KN_YUV_UYVY_QTR_SCALE, 0, NULL, NULL},
-    {"NEON \"YUV\" PLANAR ROTATE CW90", DVP_KN_YUV_Y800_ROTATE_CW_90, 0, NULL, NULL},
-    {"NEON \"YUV\" PLANAR ROTATE CCW90", DVP_KN_YUV_Y800_ROTATE_CCW_90, 0, NULL, NULL},
-    {"NEON \"YUV\" UYVY ROTATE CW90", DVP_KN_YUV_UYVY_ROTATE_CW_90, 0, NULL, NULL},
-    {"NEON \"YUV\" UYVY ROTATE CCW90", DVP_KN_YUV_UYVY_ROTATE_CCW_90, 0, NULL, NULL},
     {"NEON \"YUV\" UYVY to BGR",     DVP_KN_YUV_UYVY_TO_BGR, 0, NULL, NULL},
     {"NEON \"YUV\" ARGB to UYVY",    DVP_KN_YUV_ARGB_TO_UYVY, 0, NULL, NULL},
 
@@ -486,6 +494,55 @@ static DVP_CoreFunction_t local_kernels[] = {
     {"NEON \"YUV\" BGR3 to IYUV", DVP_KN_YUV_BGR_TO_IYUV, 0, NULL, NULL},
 #endif
 
+#if defined(DVP_USE_YUV)
+    {"NEON \"YUV\" PLANAR ROTATE CW90", DVP_KN_YUV_Y800_ROTATE_CW_90, 0, NULL, NULL},
+    {"NEON \"YUV\" PLANAR ROTATE CCW90", DVP_KN_YUV_Y800_ROTATE_CCW_90, 0, NULL, NULL},
+    {"NEON \"YUV\" UYVY ROTATE CW90", DVP_KN_YUV_UYVY_ROTATE_CW_90, 0, NULL, NULL},
+    {"NEON \"YUV\" UYVY ROTATE CCW90", DVP_KN_YUV_UYVY_ROTATE_CCW_90, 0, NULL, NULL},
+    {"NEON \"YUV\" UYVY MIRROR", DVP_KN_YUV_UYVY_MIRROR, 0, NULL, NULL},
+#elif defined(DVP_USE_YUV_C)
+    {"\"C\" \"YUV\" PLANAR ROTATE CW90", DVP_KN_YUV_Y800_ROTATE_CW_90, 0, NULL, NULL},
+    {"\"C\" \"YUV\" PLANAR ROTATE CCW90", DVP_KN_YUV_Y800_ROTATE_CCW_90, 0, NULL, NULL},
+    {"\"C\" \"YUV\" UYVY ROTATE CW90", DVP_KN_YUV_UYVY_ROTATE_CW_90, 0, NULL, NULL},
+    {"\"C\" \"YUV\" UYVY ROTATE CCW90", DVP_KN_YUV_UYVY_ROTATE_CCW_90, 0, NULL, NULL},
+    {"\"C\" \"YUV\" UYVY MIRROR", DVP_KN_YUV_UYVY_MIRROR, 0, NULL, NULL},
+#endif
+#if defined(DVP_USE_YUV) || defined(DVP_USE_YUV_C)
+    {"\"C\" \"YUV\" PLANAR ROTATE 180", DVP_KN_YUV_Y800_ROTATE_180, 0, NULL, NULL},
+    {"\"C\" \"YUV\" UYVY ROTATE 180", DVP_KN_YUV_UYVY_ROTATE_180, 0, NULL, NULL},
+    {"\"C\" \"YUV\" SCALE",       DVP_KN_YUV_SCALE, 0, NULL, NULL},
+#endif
+#if defined(DVP_USE_LDC)
+    {"\"C\" LDC AFFINE",       DVP_KN_LDC_AFFINE_TRANSFORM, 0, NULL, NULL},
+    {"\"C\" LDC DISTORTION",   DVP_KN_LDC_DISTORTION_CORRECTION, 0, NULL, NULL},
+    {"\"C\" LDC DISTORTION AND AFFINE", DVP_KN_LDC_DISTORTION_AND_AFFINE, 0, NULL, NULL},
+#endif
+#if defined(DVP_USE_DEI_C)
+    {"\"C\" DEI INIT",         DVP_KN_DEI_DEINTERLACER_INIT, 0, NULL, NULL},
+    {"\"C\" DEI DEINIT",       DVP_KN_DEI_DEINTERLACER_DEINIT, 0, NULL, NULL},
+    {"\"C\" Deinterlacer",     DVP_KN_DEI_DEINTERLACER, 0, NULL, NULL},
+#endif
+#if defined(DVP_USE_DSPLIB_C)
+    {"\"C\" DSP ADD16",          DVP_KN_DSP_ADD16, 0, NULL, NULL},
+    {"\"C\" DSP ADD32",          DVP_KN_DSP_ADD32, 0, NULL, NULL},
+    {"\"C\" DSP DOTPROD",        DVP_KN_DSP_DOTPROD, 0, NULL, NULL},
+    {"\"C\" DSP DOTPRODSQR",     DVP_KN_DSP_DOTPRODSQR, 0, NULL, NULL},
+    {"\"C\" DSP VECSUMSQ",       DVP_KN_DSP_VECSUMSQ, 0, NULL, NULL},
+    {"\"C\" DSP FIR GEN",        DVP_KN_DSP_FIR_GEN, 0, NULL, NULL},
+    {"\"C\" DSP FIR R4",         DVP_KN_DSP_FIR_R4, 0, NULL, NULL},
+    {"\"C\" DSP FIR R8",         DVP_KN_DSP_FIR_R8, 0, NULL, NULL},
+    {"\"C\" DSP FIR SYM",        DVP_KN_DSP_FIR_SYM, 0, NULL, NULL},
+    {"\"C\" DSP IIR",            DVP_KN_DSP_IIR, 0, NULL, NULL},
+    {"\"C\" DSP IIR LAT",        DVP_KN_DSP_IIR_LAT, 0, NULL, NULL},
+    {"\"C\" DSP FFT 16x16",      DVP_KN_DSP_FFT_16x16, 0, NULL, NULL},
+    {"\"C\" DSP FFT 32x32",      DVP_KN_DSP_FFT_32x32, 0, NULL, NULL},
+    {"\"C\" DSP IFFT 16x16",     DVP_KN_DSP_IFFT_16x16, 0, NULL, NULL},
+    {"\"C\" DSP IFFT 32x32",     DVP_KN_DSP_IFFT_32x32, 0, NULL, NULL},
+    {"\"C\" DSP FFT Twiddle 16x16",  DVP_KN_GEN_TWIDDLE_FFT_16X16, 0, NULL, NULL},
+    {"\"C\" DSP FFT Twiddle 32x32",  DVP_KN_GEN_TWIDDLE_FFT_32x32, 0, NULL, NULL},
+    {"\"C\" DSP IFFT Twiddle 16x16", DVP_KN_GEN_TWIDDLE_IFFT_16X16, 0, NULL, NULL},
+#endif
+
 #if defined(DVP_USE_IMGFILTER)
     {"NEON IMGFILTER Sobel3x3",   DVP_KN_IMGFILTER_SOBEL, 0, NULL, NULL},
     {"NEON IMGFILTER Scharr3x3",  DVP_KN_IMGFILTER_SCHARR, 0, NULL, NULL},
@@ -538,6 +595,18 @@ MODULE_EXPORT DVP_U32 DVP_GetSupportedKernels(DVP_CoreFunction_t **pFuncs)
 #if defined(DVP_USE_YUV)
     DVP_PRINT(DVP_ZONE_KGM, KGM_TAG" DVP_USE_YUV enabled!\n");
 #endif
+#if defined(DVP_USE_YUV_C)
+    DVP_PRINT(DVP_ZONE_KGM, KGM_TAG" DVP_USE_YUV_C enabled!\n");
+#endif
+#if defined(DVP_USE_LDC)
+    DVP_PRINT(DVP_ZONE_KGM, KGM_TAG" DVP_USE_LDC enabled!\n");
+#endif
+#if defined(DVP_USE_DEI_C)
+    DVP_PRINT(DVP_ZONE_KGM, KGM_TAG" DVP_USE_DEI_C enabled!\n");
+#endif
+#if defined(DVP_USE_DSPLIB_C)
+    DVP_PRINT(DVP_ZONE_KGM, KGM_TAG" DVP_USE_DSPLIB_C enabled!\n");
+#endif
 #if defined(DVP_USE_IMAGE)
     DVP_PRINT(DVP_ZONE_KGM, KGM_TAG" DVP_USE_IMAGE enabled!\n");
 #endif
@@ -571,8 +640,18 @@ MODULE_EXPORT DVP_U32 DVP_GetMaximumLoad(void)
     return TARGET_NUM_CORES * 1000;
 }
 
-static thread_t workers[TARGET_NUM_CORES];
-static queue_t *workqueue;
+/*! \brief The CPU workers are grouped by NUMA node. Each group is pinned to
+ * its node and fed from its own queue so that placed sections stay local.
+ */
+typedef struct _dvp_kgm_group_t {
+    DVP_U32   node;
+    DVP_U32   numWorkers;
+    thread_t  workers[TARGET_NUM_CORES];
+    queue_t  *workqueue;
+} DVP_KGM_Group_t;
+
+static DVP_KGM_Group_t groups[NUMA_NODE_MAX];
+static DVP_U32 numGroups;
 static queue_t *retqueue;
 
 static void DVP_Image_to_image_t(image_t *img, DVP_Image_t *pImage)
@@ -632,6 +711,7 @@ static DVP_U32 DVP_KernelGraphManager_CPU(DVP_KernelNode_t *pSubNodes, DVP_U32 s
     DVP_S32 processed = 0;
     DVP_Perf_t *pPerf = NULL;
     DVP_ENUM kernel = 0;
+    const char *kernelName = NULL;
 
     if (pSubNodes)
     {
@@ -681,6 +761,13 @@ static DVP_U32 DVP_KernelGraphManager_CPU(DVP_KernelNode_t *pSubNodes, DVP_U32 s
             pPerf = &pSubNodes[n].header.perf;
             pPerf->rate = rtimer_freq(); // fill in the clock rate used to capture data.
             DVP_PerformanceStart(pPerf);
+            // optimized kernels have no entry of their own
+            if (pSubNodes[n].header.funcIndex < dimof(local_kernels) &&
+                local_kernels[pSubNodes[n].header.funcIndex].kernel == (DVP_S32)kernel)
+                kernelName = local_kernels[pSubNodes[n].header.funcIndex].name;
+            else
+                kernelName = "node";
+            trace_begin("cpu", kernelName, kernel);
 
             // initialize the error status. Change to an error if one
             // occurs.
@@ -2203,6 +2290,56 @@ static DVP_U32 DVP_KernelGraphManager_CPU(DVP_KernelNode_t *pSubNodes, DVP_U32 s
                     }
                     break;
                 }
+                case DVP_KN_Y800_TO_XYXY:
+                case DVP_KN_YUV_Y800_TO_XYXY:
+                {
+                    DVP_Transform_t *pT = dvp_knode_to(&pSubNodes[n], DVP_Transform_t);
+                    if (pT->input.color == FOURCC_Y800 &&
+                        pT->output.color == FOURCC_UYVY)
+                    {
+                        __luma_to_uyvy_image(pT->input.width,
+                                             pT->input.height,
+                                             pT->input.pData[0],
+                                             pT->input.y_stride,
+                                             pT->output.pData[0],
+                                             pT->output.y_stride);
+                    }
+                    break;
+                }
+                case DVP_KN_UYVY_TO_BGR:
+                case DVP_KN_YUV_UYVY_TO_BGR:
+                {
+                    DVP_Transform_t *pT = dvp_knode_to(&pSubNodes[n], DVP_Transform_t);
+                    if (pT->input.color == FOURCC_UYVY &&
+                        pT->output.color == FOURCC_BGR)
+                    {
+                        __uyvy_to_bgr_image_bt601(pT->input.width, pT->input.height,
+                                                  pT->input.pData[0], pT->input.y_stride,
+                                                  pT->output.pData[0], pT->output.y_stride);
+                    }
+                    break;
+                }
+                case DVP_KN_YUV_ARGB_TO_UYVY:
+                {
+                    DVP_Transform_t *pT = dvp_knode_to(&pSubNodes[n], DVP_Transform_t);
+                    if (pT->input.color == FOURCC_ARGB &&
+                        pT->output.color == FOURCC_UYVY)
+                    {
+                        DVP_PrintImage(DVP_ZONE_KGM, &pT->input);
+                        DVP_PrintImage(DVP_ZONE_KGM, &pT->output);
+                        __argb_to_uyvy_image_bt601(pT->input.width, pT->input.height,
+                                                   pT->input.pData[0], pT->input.y_stride,
+                                                   pT->output.pData[0], pT->output.y_stride);
+                    }
+                    break;
+                }
+#endif // YUV ONLY CASES
+
+#if defined(DVP_USE_YUV) || defined(DVP_USE_YUV_C)
+                //******************************************************
+                // YUV ROTATION AND SCALING CASES
+                //******************************************************
+
                 case DVP_KN_YUV_Y800_ROTATE_CW_90:
                 case DVP_KN_YUV_Y800_ROTATE_CCW_90:
                 {
@@ -2210,9 +2347,12 @@ static DVP_U32 DVP_KernelGraphManager_CPU(DVP_KernelNode_t *pSubNodes, DVP_U32 s
                     if (pT->input.color == pT->output.color &&
                         pT->input.width == pT->output.height &&
                         pT->input.height == pT->output.width &&
-                        pT->input.planes == pT->output.planes &&
-                        (DVP_U32)pT->input.y_stride == pT->input.width &&
-                        (DVP_U32)pT->output.y_stride == pT->output.width)
+                        pT->input.planes == pT->output.planes
+#if !defined(DVP_USE_YUV_C)
+                        && (DVP_U32)pT->input.y_stride == pT->input.width &&
+                        (DVP_U32)pT->output.y_stride == pT->output.width
+#endif
+                        )
                     {
                         uint32_t p = 0;
                         for (p = 0; p < pT->input.planes; p++)
@@ -2234,6 +2374,23 @@ static DVP_U32 DVP_KernelGraphManager_CPU(DVP_KernelNode_t *pSubNodes, DVP_U32 s
                                 }
                             }
 
+#if defined(DVP_USE_YUV_C)
+                            // the C model follows the strides, padded lines are fine
+                            if (kernel == DVP_KN_YUV_Y800_ROTATE_CW_90)
+                                __planar_rotate_cw90_stride(pT->input.width/div_x,
+                                                            pT->input.height/div_y,
+                                                            pT->input.pData[p],
+                                                            DVP_Image_LineRange(&pT->input, p),
+                                                            pT->output.pData[p],
+                                                            DVP_Image_LineRange(&pT->output, p));
+                            else if (kernel == DVP_KN_YUV_Y800_ROTATE_CCW_90)
+                                __planar_rotate_ccw90_stride(pT->input.width/div_x,
+                                                             pT->input.height/div_y,
+                                                             pT->input.pData[p],
+                                                             DVP_Image_LineRange(&pT->input, p),
+                                                             pT->output.pData[p],
+                                                             DVP_Image_LineRange(&pT->output, p));
+#else
                             if (kernel == DVP_KN_YUV_Y800_ROTATE_CW_90)
                                 __planar_rotate_cw90(pT->input.width/div_x,
                                                      pT->input.height/div_y,
@@ -2244,6 +2401,46 @@ static DVP_U32 DVP_KernelGraphManager_CPU(DVP_KernelNode_t *pSubNodes, DVP_U32 s
                                                       pT->input.height/div_y,
                                                       pT->input.pData[p],
                                                       pT->output.pData[p]);
+#endif
+                        }
+                    }
+                    else
+                        processed -= 1;
+                    break;
+                }
+                case DVP_KN_YUV_Y800_ROTATE_180:
+                {
+                    DVP_Transform_t *pT = dvp_knode_to(&pSubNodes[n], DVP_Transform_t);
+                    if (pT->input.color == pT->output.color &&
+                        pT->input.width == pT->output.width &&
+                        pT->input.height == pT->output.height &&
+                        pT->input.planes == pT->output.planes)
+                    {
+                        uint32_t p = 0;
+                        for (p = 0; p < pT->input.planes; p++)
+                        {
+                            uint32_t div_x = 1;
+                            uint32_t div_y = 1;
+                            if (p > 0 )
+                            {
+                                if (pT->input.color == FOURCC_IYUV ||
+                                    pT->input.color == FOURCC_YV12)
+                                {
+                                    div_x = 2;
+                                    div_y = 2;
+                                }
+                                else if (pT->input.color == FOURCC_YU16 ||
+                                         pT->input.color == FOURCC_YV16)
+                                {
+                                    div_x = 2;
+                                }
+                            }
+                            __planar_rotate_180(pT->input.width/div_x,
+                                                pT->input.height/div_y,
+                                                pT->input.pData[p],
+                                                DVP_Image_LineRange(&pT->input, p),
+                                                pT->output.pData[p],
+                                                DVP_Image_LineRange(&pT->output, p));
                         }
                     }
                     else
@@ -2278,50 +2475,104 @@ static DVP_U32 DVP_KernelGraphManager_CPU(DVP_KernelNode_t *pSubNodes, DVP_U32 s
                         processed -= 1;
                     break;
                 }
-                case DVP_KN_Y800_TO_XYXY:
-                case DVP_KN_YUV_Y800_TO_XYXY:
+                case DVP_KN_YUV_UYVY_ROTATE_180:
+                case DVP_KN_YUV_UYVY_MIRROR:
                 {
                     DVP_Transform_t *pT = dvp_knode_to(&pSubNodes[n], DVP_Transform_t);
-                    if (pT->input.color == FOURCC_Y800 &&
-                        pT->output.color == FOURCC_UYVY)
-                    {
-                        __luma_to_uyvy_image(pT->input.width,
-                                             pT->input.height,
-                                             pT->input.pData[0],
-                                             pT->input.y_stride,
-                                             pT->output.pData[0],
-                                             pT->output.y_stride);
+                    if (pT->input.color == pT->output.color &&
+                        pT->input.color == FOURCC_UYVY &&
+                        pT->input.width == pT->output.width &&
+                        pT->input.height == pT->output.height)
+                    {
+                        if (kernel == DVP_KN_YUV_UYVY_ROTATE_180)
+                            __uyvy_rotate_180(pT->input.width,
+                                              pT->input.height,
+                                              pT->input.pData[0],
+                                              pT->input.y_stride,
+                                              pT->output.pData[0],
+                                              pT->output.y_stride);
+                        else if (kernel == DVP_KN_YUV_UYVY_MIRROR)
+                            __uyvy_horizontal_mirror_image(pT->input.width,
+                                                           pT->input.height,
+                                                           pT->input.pData[0],
+                                                           pT->input.y_stride,
+                                                           pT->output.pData[0],
+                                                           pT->output.y_stride);
                     }
+                    else
+                        processed -= 1;
                     break;
                 }
-                case DVP_KN_UYVY_TO_BGR:
-                case DVP_KN_YUV_UYVY_TO_BGR:
+                case DVP_KN_YUV_SCALE:
                 {
-                    DVP_Transform_t *pT = dvp_knode_to(&pSubNodes[n], DVP_Transform_t);
-                    if (pT->input.color == FOURCC_UYVY &&
-                        pT->output.color == FOURCC_BGR)
-                    {
-                        __uyvy_to_bgr_image_bt601(pT->input.width, pT->input.height,
-                                                  pT->input.pData[0], pT->input.y_stride,
-                                                  pT->output.pData[0], pT->output.y_stride);
-                    }
+                    if (DVP_Scale(&pSubNodes[n]) == DVP_FALSE)
+                        processed -= 1;
                     break;
                 }
-                case DVP_KN_YUV_ARGB_TO_UYVY:
+#endif // YUV ROTATION AND SCALING CASES
+#if defined(DVP_USE_LDC)
+                //******************************************************
+                // LDC CASES
+                //******************************************************
+                case DVP_KN_LDC_AFFINE_TRANSFORM:
+                case DVP_KN_LDC_DISTORTION_CORRECTION:
+                case DVP_KN_LDC_DISTORTION_AND_AFFINE:
                 {
-                    DVP_Transform_t *pT = dvp_knode_to(&pSubNodes[n], DVP_Transform_t);
-                    if (pT->input.color == FOURCC_ARGB &&
-                        pT->output.color == FOURCC_UYVY)
-                    {
-                        DVP_PrintImage(DVP_ZONE_KGM, &pT->input);
-                        DVP_PrintImage(DVP_ZONE_KGM, &pT->output);
-                        __argb_to_uyvy_image_bt601(pT->input.width, pT->input.height,
-                                                   pT->input.pData[0], pT->input.y_stride,
-                                                   pT->output.pData[0], pT->output.y_stride);
-                    }
+                    if (DVP_Ldc(&pSubNodes[n]) == DVP_FALSE)
+                        processed -= 1;
                     break;
                 }
-#endif // YUV ONLY CASES
+#endif // LDC CASES
+#if defined(DVP_USE_DEI_C)
+                //******************************************************
+                // DEI CASES
+                //******************************************************
+                case DVP_KN_DEI_DEINTERLACER_INIT:
+                {
+                    DVP_Deinterlacer_Init(dvp_knode_to(&pSubNodes[n], DVP_Deinterlacer_t));
+                    break;
+                }
+                case DVP_KN_DEI_DEINTERLACER_DEINIT:
+                {
+                    DVP_Deinterlacer_Deinit(dvp_knode_to(&pSubNodes[n], DVP_Deinterlacer_t));
+                    break;
+                }
+                case DVP_KN_DEI_DEINTERLACER:
+                {
+                    DVP_Deinterlacer_t *pD = dvp_knode_to(&pSubNodes[n], DVP_Deinterlacer_t);
+                    if (DVP_Deinterlace(pD) == DVP_FALSE)
+                        processed -= 1;
+                    break;
+                }
+#endif // DEI CASES
+#if defined(DVP_USE_DSPLIB_C)
+                //******************************************************
+                // DSPLIB CASES
+                //******************************************************
+                case DVP_KN_DSP_ADD16:
+                case DVP_KN_DSP_ADD32:
+                case DVP_KN_DSP_DOTPROD:
+                case DVP_KN_DSP_DOTPRODSQR:
+                case DVP_KN_DSP_VECSUMSQ:
+                case DVP_KN_DSP_FIR_GEN:
+                case DVP_KN_DSP_FIR_R4:
+                case DVP_KN_DSP_FIR_R8:
+                case DVP_KN_DSP_FIR_SYM:
+                case DVP_KN_DSP_IIR:
+                case DVP_KN_DSP_IIR_LAT:
+                case DVP_KN_DSP_FFT_16x16:
+                case DVP_KN_DSP_FFT_32x32:
+                case DVP_KN_DSP_IFFT_16x16:
+                case DVP_KN_DSP_IFFT_32x32:
+                case DVP_KN_GEN_TWIDDLE_FFT_16X16:
+                case DVP_KN_GEN_TWIDDLE_FFT_32x32:
+                case DVP_KN_GEN_TWIDDLE_IFFT_16X16:
+                {
+                    if (DVP_Dsp(dvp_knode_to(&pSubNodes[n], DVP_DSPFunc), pSubNodes[n].header.kernel) == DVP_FALSE)
+                        processed -= 1;
+                    break;
+                }
+#endif // DSPLIB CASES
 
 #if defined(DVP_USE_YUV) || defined(DVP_USE_VLIB)
                 //******************************************************
@@ -2342,11 +2593,7 @@ static DVP_U32 DVP_KernelGraphManager_CPU(DVP_KernelNode_t *pSubNodes, DVP_U32 s
                     {
                         DVP_U08 *pU, *pV;
                         int y_stride = pT->output.y_stride;
-                        int uv_stride = y_stride >> 1;
-#if defined(DVP_USE_TILER)
-                        if (y_stride == TILER_STRIDE_8BIT)
-                            uv_stride = y_stride;
-#endif
+                        int uv_stride = DVP_Image_LineRange(&pT->output, 1);
                         if (pT->output.color == FOURCC_YV12)
                         {
                             pV = pT->output.pData[1];
@@ -4083,20 +4330,25 @@ static DVP_U32 DVP_KernelGraphManager_CPU(DVP_KernelNode_t *pSubNodes, DVP_U32 s
             }
             processed++;
             DVP_PerformanceStop(pPerf);
+            trace_end("cpu", kernelName, pSubNodes[n].header.error);
         }
         DVP_PRINT(DVP_ZONE_KGM, "DVP KGM CPU: Processed %u nodes!\n", processed);
     }
     return processed;
 }
 
-static thread_ret_t DVP_KernelGraphManagerThread_CPU(void *arg __attribute__((unused)))
+static thread_ret_t DVP_KernelGraphManagerThread_CPU(void *arg)
 {
+    DVP_KGM_Group_t *group = (DVP_KGM_Group_t *)arg;
     DVP_KGM_Thread_t kgmt;
     DVP_S32 processed = 0;
 
-    thread_nextaffinity();
+    if (numGroups == 1)
+        thread_nextaffinity();
+    else if (numa_thread_pin(group->node) == false_e)
+        DVP_PRINT(DVP_ZONE_WARNING, "DVP KGM CPU: Worker could not be pinned to node %u!\n", group->node);
 
-    while (queue_read(workqueue, true_e, &kgmt) == true_e)
+    while (queue_read(group->workqueue, true_e, &kgmt) == true_e)
     {
         DVP_KernelNode_t *pSubNodes = kgmt.pSubNodes;
         DVP_U32 startNode = kgmt.startNode;
@@ -4104,8 +4356,8 @@ static thread_ret_t DVP_KernelGraphManagerThread_CPU(void *arg __attribute__((un
         kgmt.numNodesExecuted = 0;
         processed = 0;
 
-        DVP_PRINT(DVP_ZONE_KGM, "DVP KGM CPU Thread Read a Work Item! %p[%d] (%p) for %d nodes\n",
-            pSubNodes, startNode, &pSubNodes[startNode], numNodes);
+        DVP_PRINT(DVP_ZONE_KGM, "DVP KGM CPU Thread Read a Work Item! %p[%d] (%p) for %d nodes on node %u\n",
+            pSubNodes, startNode, &pSubNodes[startNode], numNodes, group->node);
 
         processed = DVP_KernelGraphManager_CPU(pSubNodes, startNode, numNodes);
 
@@ -4116,6 +4368,35 @@ static thread_ret_t DVP_KernelGraphManagerThread_CPU(void *arg __attribute__((un
     thread_exit(0);
 }
 
+static DVP_U32 DVP_KernelGraphManager_Queue(DVP_KGM_Group_t *group, DVP_KernelNode_t *pSubNodes, DVP_U32 startNode, DVP_U32 numNodes)
+{
+    DVP_KGM_Thread_t kgmt = {pSubNodes, startNode, numNodes, 0};
+    if (queue_write(group->workqueue, true_e, &kgmt) == true_e) // this is internally a copy
+    {
+        do {
+            DVP_KGM_Thread_t kgmr;
+
+            if (queue_read(retqueue, true_e, &kgmr) == true_e)
+            {
+                if (kgmt.pSubNodes == kgmr.pSubNodes &&
+                    kgmt.startNode == kgmr.startNode &&
+                    kgmt.numNodes  == kgmr.numNodes) // this is ours, return.
+                {
+                    DVP_PRINT(DVP_ZONE_KGM, "Work Thread returned %u nodes!\n", kgmr.numNodesExecuted);
+                    return kgmr.numNodesExecuted;
+                }
+                else // it's not ours, put it back in the queue
+                    queue_write(retqueue, true_e, &kgmr);
+            }
+            else
+            {
+                DVP_PRINT(DVP_ZONE_WARNING, "Failed to read from return queue, trying again!\n");
+            }
+        } while (1);
+    }
+    return 0;
+}
+
 MODULE_EXPORT void DVP_KernelGraphManagerRestart(void *arg  __attribute__((unused)))
 {
     // do nothing, since this should never be called.
@@ -4123,24 +4404,41 @@ MODULE_EXPORT void DVP_KernelGraphManagerRestart(void *arg  __attribute__((unuse
 
 MODULE_EXPORT DVP_BOOL DVP_KernelGraphManagerDeinit(void)
 {
-    DVP_U32 i;
-    queue_pop(workqueue);
+    DVP_U32 g, i;
+    for (g = 0; g < numGroups; g++)
+        queue_pop(groups[g].workqueue);
     queue_pop(retqueue);
-    for (i = 0; i < dimof(workers); i++)
-        thread_join(workers[i]);
-    queue_destroy(workqueue);
+    for (g = 0; g < numGroups; g++)
+    {
+        for (i = 0; i < groups[g].numWorkers; i++)
+            thread_join(groups[g].workers[i]);
+        queue_destroy(groups[g].workqueue);
+    }
     queue_destroy(retqueue);
+    numGroups = 0;
+    DVP_Tables_Deinit();
     return DVP_TRUE;
 }
 
 MODULE_EXPORT DVP_BOOL DVP_KernelGraphManagerInit(DVP_RPC_t *pRPC __attribute__ ((unused)),
                                     DVP_RPC_Core_t *pCore __attribute__ ((unused)))
 {
-    DVP_U32 i = 0;
-    workqueue = queue_create(10, sizeof(DVP_KGM_Thread_t));
+    DVP_U32 g, i = 0;
+    DVP_Tables_Init();
+    numGroups = numa_node_count();
     retqueue = queue_create(10, sizeof(DVP_KGM_Thread_t));
-    for (i = 0; i < dimof(workers); i++)
-        workers[i] = thread_create(DVP_KernelGraphManagerThread_CPU, NULL);
+    for (g = 0; g < numGroups; g++)
+    {
+        // spread the workers over the nodes, giving every node at least one
+        groups[g].node = g;
+        groups[g].numWorkers = (TARGET_NUM_CORES / numGroups) + (g < (TARGET_NUM_CORES % numGroups) ? 1 : 0);
+        if (groups[g].numWorkers == 0)
+            groups[g].numWorkers = 1;
+        groups[g].workqueue = queue_create(10, sizeof(DVP_KGM_Thread_t));
+        for (i = 0; i < groups[g].numWorkers; i++)
+            groups[g].workers[i] = thread_create(DVP_KernelGraphManagerThread_CPU, &groups[g]);
+    }
+    DVP_PRINT(DVP_ZONE_KGM, KGM_TAG" started workers on %u NUMA nodes\n", numGroups);
     return DVP_TRUE;
 }
 
@@ -4149,31 +4447,11 @@ MODULE_EXPORT DVP_U32 DVP_KernelGraphManager(DVP_KernelNode_t *pSubNodes, DVP_U3
     DVP_PRINT(DVP_ZONE_KGM, "Entered "KGM_TAG" Kernel Manager! (%s)\n",(sync?"SYNC":"QUEUED"));
     if (sync == DVP_FALSE)
     {
-        DVP_KGM_Thread_t kgmt = {pSubNodes, startNode, numNodes, 0};
-        if (queue_write(workqueue, true_e, &kgmt) == true_e) // this is internally a copy
-        {
-            do {
-                DVP_KGM_Thread_t kgmr;
-
-                if (queue_read(retqueue, true_e, &kgmr) == true_e)
-                {
-                    if (kgmt.pSubNodes == kgmr.pSubNodes &&
-                        kgmt.startNode == kgmr.startNode &&
-                        kgmt.numNodes  == kgmr.numNodes) // this is ours, return.
-                    {
-                        DVP_PRINT(DVP_ZONE_KGM, "Work Thread returned %u nodes!\n", kgmr.numNodesExecuted);
-                        return kgmr.numNodesExecuted;
-                    }
-                    else // it's not ours, put it back in the queue
-                        queue_write(retqueue, true_e, &kgmr);
-                }
-                else
-                {
-                    DVP_PRINT(DVP_ZONE_WARNING, "Failed to read from return queue, trying again!\n");
-                }
-            } while (1);
-        }
-        return 0;
+        DVP_KGM_Group_t *group = &groups[0];
+        // unplaced work stays on the caller's node, where its data most likely is
+        if (numGroups > 1)
+            group = &groups[numa_current_node() % numGroups];
+        return DVP_KernelGraphManager_Queue(group, pSubNodes, startNode, numNodes);
     }
     else
     {
@@ -4181,6 +4459,126 @@ MODULE_EXPORT DVP_U32 DVP_KernelGraphManager(DVP_KernelNode_t *pSubNodes, DVP_U3
     }
 }
 
+MODULE_EXPORT DVP_U32 DVP_KernelGraphManagerPlaced(DVP_KernelNode_t *pSubNodes, DVP_U32 startNode, DVP_U32 numNodes, DVP_BOOL sync, DVP_U32 numaNode)
+{
+    DVP_PRINT(DVP_ZONE_KGM, "Entered "KGM_TAG" Kernel Manager for NUMA node %u!\n", numaNode - 1);
+    if (numaNode == DVP_NUMA_NODE_ANY || numGroups <= 1)
+        return DVP_KernelGraphManager(pSubNodes, startNode, numNodes, sync);
+    // even synchronous work is queued, the calling thread may not be on the node.
+    return DVP_KernelGraphManager_Queue(&groups[(numaNode - 1) % numGroups], pSubNodes, startNode, numNodes);
+}
+
+MODULE_EXPORT void DVP_KernelGraphManagerRelease(DVP_KernelNode_t *pSubNodes, DVP_U32 startNode, DVP_U32 numNodes)
+{
+    DVP_U32 n;
+    for (n = startNode; n < startNode + numNodes; n++)
+        DVP_Tables_Detach(&pSubNodes[n]);
+}
+
+MODULE_EXPORT DVP_BOOL DVP_KernelGraphManagerImages(DVP_KernelNode_t *pNode,
+                                                     DVP_Image_t *pImages[DVP_KNODE_MAX_IMAGES],
+                                                     DVP_BOOL outputs[DVP_KNODE_MAX_IMAGES],
+                                                     DVP_U32 *pNumImages)
+{
+    DVP_U32 i = 0;
+    switch (pNode->header.kernel)
+    {
+        case DVP_KN_NOOP:
+            break;
+        case DVP_KN_COPY:
+        case DVP_KN_XYXY_TO_Y800:
+        case DVP_KN_YXYX_TO_Y800:
+        case DVP_KN_Y800_TO_XYXY:
+        case DVP_KN_UYVY_TO_RGBp:
+        case DVP_KN_UYVY_TO_BGR:
+        case DVP_KN_UYVY_TO_YUV420p:
+        case DVP_KN_UYVY_TO_YUV422p:
+        case DVP_KN_UYVY_TO_YUV444p:
+        case DVP_KN_YUV420p_TO_RGBp:
+        case DVP_KN_YUV420p_TO_UYVY:
+        case DVP_KN_YUV422p_TO_UYVY:
+        case DVP_KN_YUV444p_TO_RGBp:
+        case DVP_KN_YUV444p_TO_UYVY:
+        case DVP_KN_NV12_TO_UYVY:
+        case DVP_KN_NV12_TO_YUV444p:
+        case DVP_KN_BGR3_TO_UYVY:
+        case DVP_KN_BGR3_TO_IYUV:
+        case DVP_KN_BGR3_TO_NV12:
+#if defined(DVP_USE_YUV) || defined(DVP_USE_YUV_C)
+        case DVP_KN_YUV_Y800_ROTATE_CW_90:
+        case DVP_KN_YUV_Y800_ROTATE_CCW_90:
+        case DVP_KN_YUV_Y800_ROTATE_180:
+        case DVP_KN_YUV_UYVY_ROTATE_CW_90:
+        case DVP_KN_YUV_UYVY_ROTATE_CCW_90:
+        case DVP_KN_YUV_UYVY_ROTATE_180:
+        case DVP_KN_YUV_UYVY_MIRROR:
+#endif
+        case DVP_KN_SOBEL_8:
+        case DVP_KN_PREWITT_8:
+        case DVP_KN_SCHARR_8:
+        case DVP_KN_KROON_8:
+        case DVP_KN_SOBEL_3x3_8:
+        case DVP_KN_SOBEL_3x3_8s:
+        case DVP_KN_SOBEL_3x3_16:
+        case DVP_KN_SOBEL_3x3_16s:
+        case DVP_KN_THRESHOLD:
+        case DVP_KN_XSTRIDE_CONVERT:
+        case DVP_KN_XSTRIDE_SHIFT:
+        case DVP_KN_INTEGRAL_IMAGE_8:
+        {
+            DVP_Transform_t *pT = dvp_knode_to(pNode, DVP_Transform_t);
+            pImages[i] = &pT->input;   outputs[i++] = DVP_FALSE;
+            pImages[i] = &pT->output;  outputs[i++] = DVP_TRUE;
+            break;
+        }
+        case DVP_KN_NONMAXSUPPRESS_3x3_S16:
+        case DVP_KN_NONMAXSUPPRESS_5x5_S16:
+        case DVP_KN_NONMAXSUPPRESS_7x7_S16:
+        case DVP_KN_THR_GT2MAX_8:
+        case DVP_KN_THR_GT2THR_8:
+        case DVP_KN_THR_LE2MIN_8:
+        case DVP_KN_THR_LE2THR_8:
+        case DVP_KN_THR_GT2MAX_16:
+        case DVP_KN_THR_GT2THR_16:
+        case DVP_KN_THR_LE2MIN_16:
+        case DVP_KN_THR_LE2THR_16:
+        {
+            DVP_Threshold_t *pThresh = dvp_knode_to(pNode, DVP_Threshold_t);
+            pImages[i] = &pThresh->input;  outputs[i++] = DVP_FALSE;
+            pImages[i] = &pThresh->output; outputs[i++] = DVP_TRUE;
+            break;
+        }
+        case DVP_KN_DILATE_CROSS:
+        case DVP_KN_DILATE_MASK:
+        case DVP_KN_DILATE_SQUARE:
+        case DVP_KN_ERODE_CROSS:
+        case DVP_KN_ERODE_MASK:
+        case DVP_KN_ERODE_SQUARE:
+        {
+            DVP_Morphology_t *pMorph = dvp_knode_to(pNode, DVP_Morphology_t);
+            pImages[i] = &pMorph->input;   outputs[i++] = DVP_FALSE;
+            pImages[i] = &pMorph->output;  outputs[i++] = DVP_TRUE;
+            pImages[i] = &pMorph->mask;    outputs[i++] = DVP_FALSE;
+            break;
+        }
+        case DVP_KN_CONV_3x3:
+        case DVP_KN_CONV_5x5:
+        case DVP_KN_CONV_7x7:
+        case DVP_KN_CANNY_IMAGE_SMOOTHING:
+        {
+            DVP_ImageConvolution_t *pConv = dvp_knode_to(pNode, DVP_ImageConvolution_t);
+            pImages[i] = &pConv->input;    outputs[i++] = DVP_FALSE;
+            pImages[i] = &pConv->output;   outputs[i++] = DVP_TRUE;
+            pImages[i] = &pConv->mask;     outputs[i++] = DVP_FALSE;
+            break;
+        }
+        default:
+            return DVP_FALSE;
+    }
+    *pNumImages = i;
+    return DVP_TRUE;
+}
+
 MODULE_EXPORT DVP_U32 DVP_KernelGraphManagerVerify(DVP_KernelNode_t *pSubNodes,
                                                    DVP_U32 startNode,
                                                    DVP_U32 numNodes)
@@ -4366,6 +4764,147 @@ MODULE_EXPORT DVP_U32 DVP_KernelGraphManagerVerify(DVP_KernelNode_t *pSubNodes,
                     pSubNodes[n].header.error = DVP_ERROR_INVALID_PARAMETER;
                 break;
             }
+#if defined(DVP_USE_YUV) || defined(DVP_USE_YUV_C)
+            case DVP_KN_YUV_Y800_ROTATE_CW_90:
+            case DVP_KN_YUV_Y800_ROTATE_CCW_90:
+            case DVP_KN_YUV_Y800_ROTATE_180:
+            {
+                DVP_Transform_t *pT = dvp_knode_to(&pSubNodes[n], DVP_Transform_t);
+                fourcc_t valid_colors[] = {FOURCC_Y800, FOURCC_IYUV, FOURCC_YV12,
+                                           FOURCC_YU16, FOURCC_YV16, FOURCC_YU24,
+                                           FOURCC_YV24, FOURCC_RGBP};
+                if (DVP_Image_Validate(&pT->input, 1, 1, 1, 1, valid_colors, dimof(valid_colors)) == DVP_FALSE ||
+                    DVP_Image_Validate(&pT->output, 1, 1, 1, 1, &pT->input.color, 1) == DVP_FALSE)
+                    pSubNodes[n].header.error = DVP_ERROR_INVALID_PARAMETER;
+                else if (pSubNodes[n].header.kernel == DVP_KN_YUV_Y800_ROTATE_180)
+                {
+                    if (pT->input.width != pT->output.width ||
+                        pT->input.height != pT->output.height)
+                        pSubNodes[n].header.error = DVP_ERROR_INVALID_PARAMETER;
+                }
+                else if (pT->input.width != pT->output.height ||
+                         pT->input.height != pT->output.width)
+                    pSubNodes[n].header.error = DVP_ERROR_INVALID_PARAMETER;
+                // a quarter turn would make 4:2:2 chroma subsampled vertically instead
+                else if (pT->input.color == FOURCC_YU16 || pT->input.color == FOURCC_YV16)
+                    pSubNodes[n].header.error = DVP_ERROR_INVALID_PARAMETER;
+#if !defined(DVP_USE_YUV_C)
+                // the assembly rotations only handle tightly packed planes
+                else if ((DVP_U32)pT->input.y_stride != pT->input.width ||
+                         (DVP_U32)pT->output.y_stride != pT->output.width)
+                    pSubNodes[n].header.error = DVP_ERROR_INVALID_PARAMETER;
+#endif
+                break;
+            }
+            case DVP_KN_YUV_UYVY_ROTATE_CW_90:
+            case DVP_KN_YUV_UYVY_ROTATE_CCW_90:
+            case DVP_KN_YUV_UYVY_ROTATE_180:
+            case DVP_KN_YUV_UYVY_MIRROR:
+            {
+                DVP_Transform_t *pT = dvp_knode_to(&pSubNodes[n], DVP_Transform_t);
+                fourcc_t valid_colors[] = {FOURCC_UYVY};
+                // macropixels must stay whole in both orientations
+                if (DVP_Image_Validate(&pT->input, 4, 1, 2, 2, valid_colors, dimof(valid_colors)) == DVP_FALSE ||
+                    DVP_Image_Validate(&pT->output, 4, 1, 2, 2, valid_colors, dimof(valid_colors)) == DVP_FALSE)
+                    pSubNodes[n].header.error = DVP_ERROR_INVALID_PARAMETER;
+                else if (pSubNodes[n].header.kernel == DVP_KN_YUV_UYVY_ROTATE_180 ||
+                         pSubNodes[n].header.kernel == DVP_KN_YUV_UYVY_MIRROR)
+                {
+                    if (pT->input.width != pT->output.width ||
+                        pT->input.height != pT->output.height)
+                        pSubNodes[n].header.error = DVP_ERROR_INVALID_PARAMETER;
+                }
+                else if (pT->input.width != pT->output.height ||
+                         pT->input.height != pT->output.width)
+                    pSubNodes[n].header.error = DVP_ERROR_INVALID_PARAMETER;
+                break;
+            }
+            case DVP_KN_YUV_SCALE:
+            {
+                DVP_YUV_Scale_t *pS = dvp_knode_to(&pSubNodes[n], DVP_YUV_Scale_t);
+                fourcc_t valid_colors[] = {FOURCC_Y800, FOURCC_UYVY, FOURCC_NV12};
+                DVP_U32 mult = (pS->input.color == FOURCC_Y800 ? 1 : 2);
+                if (DVP_Image_Validate(&pS->input, 1, 1, mult, mult, valid_colors, dimof(valid_colors)) == DVP_FALSE ||
+                    DVP_Image_Validate(&pS->output, 1, 1, mult, mult, &pS->input.color, 1) == DVP_FALSE ||
+                    pS->filter > DVP_YUV_SCALE_AREA)
+                    pSubNodes[n].header.error = DVP_ERROR_INVALID_PARAMETER;
+                else if (DVP_Scale_Prepare(&pSubNodes[n]) == DVP_FALSE) // computes the coefficients
+                    pSubNodes[n].header.error = DVP_ERROR_NO_MEMORY;
+                break;
+            }
+#endif
+#if defined(DVP_USE_LDC)
+            case DVP_KN_LDC_AFFINE_TRANSFORM:
+            case DVP_KN_LDC_DISTORTION_CORRECTION:
+            case DVP_KN_LDC_DISTORTION_AND_AFFINE:
+            {
+                DVP_Ldc_t *pLdc = dvp_knode_to(&pSubNodes[n], DVP_Ldc_t);
+                fourcc_t valid_colors[] = {FOURCC_UYVY, FOURCC_NV12};
+                if (DVP_Image_Validate(&pLdc->input, 1, 1, 2, 2, valid_colors, dimof(valid_colors)) == DVP_FALSE ||
+                    DVP_Image_Validate(&pLdc->output, 1, 1, 2, 2, &pLdc->input.color, 1) == DVP_FALSE)
+                    pSubNodes[n].header.error = DVP_ERROR_INVALID_PARAMETER;
+                else if (pSubNodes[n].header.kernel != DVP_KN_LDC_AFFINE_TRANSFORM &&
+                         (pLdc->ldcLut.pData == NULL ||
+                          pLdc->ldcLut.numBytes < 256 * sizeof(DVP_U16) ||
+                          pLdc->ldcRth == 0 ||
+                          pLdc->ldcRightShiftBits > 16))
+                    pSubNodes[n].header.error = DVP_ERROR_INVALID_PARAMETER;
+                else if (DVP_Ldc_Prepare(&pSubNodes[n]) == DVP_FALSE) // computes the remap table
+                    pSubNodes[n].header.error = DVP_ERROR_NO_MEMORY;
+                break;
+            }
+#endif
+#if defined(DVP_USE_DEI_C)
+            case DVP_KN_DEI_DEINTERLACER_INIT:
+            case DVP_KN_DEI_DEINTERLACER_DEINIT:
+            case DVP_KN_DEI_DEINTERLACER:
+            {
+                DVP_Deinterlacer_t *pD = dvp_knode_to(&pSubNodes[n], DVP_Deinterlacer_t);
+                fourcc_t valid_colors[] = {FOURCC_UYVY};
+                DVP_U32 fieldSize = pD->phy_fld_in_current.width * (pD->phy_fld_in_current.height / 2);
+                if (pSubNodes[n].header.kernel == DVP_KN_DEI_DEINTERLACER_DEINIT)
+                    break;
+                if (pD->phy_virt_flag != 0 ||
+                    pD->mode > DVP_DEI_MODE_LINE_AVERAGE ||
+                    DVP_Image_Validate(&pD->phy_fld_in_current, 4, 1, 2, 2, valid_colors, dimof(valid_colors)) == DVP_FALSE)
+                    pSubNodes[n].header.error = DVP_ERROR_INVALID_PARAMETER;
+                else if (pD->mode == DVP_DEI_MODE_MOTION_ADAPTIVE &&
+                         (DVP_Image_Validate(&pD->phy_fld_in_prev, 4, 1, 2, 2, valid_colors, dimof(valid_colors)) == DVP_FALSE ||
+                          pD->phy_fld_in_prev.width != pD->phy_fld_in_current.width ||
+                          pD->phy_fld_in_prev.height != pD->phy_fld_in_current.height ||
+                          pD->phy_luma_d0.pData == NULL || pD->phy_luma_d0.numBytes < fieldSize ||
+                          pD->phy_luma_d1.pData == NULL || pD->phy_luma_d1.numBytes < fieldSize ||
+                          pD->phy_luma_d2.pData == NULL || pD->phy_luma_d2.numBytes < fieldSize ||
+                          pD->sad_scale > 256 || pD->sad_corr > 15)) // the motion gain is computed in 16 bits
+                    pSubNodes[n].header.error = DVP_ERROR_INVALID_PARAMETER;
+                break;
+            }
+#endif
+#if defined(DVP_USE_DSPLIB_C)
+            case DVP_KN_DSP_ADD16:
+            case DVP_KN_DSP_ADD32:
+            case DVP_KN_DSP_DOTPROD:
+            case DVP_KN_DSP_DOTPRODSQR:
+            case DVP_KN_DSP_VECSUMSQ:
+            case DVP_KN_DSP_FIR_GEN:
+            case DVP_KN_DSP_FIR_R4:
+            case DVP_KN_DSP_FIR_R8:
+            case DVP_KN_DSP_FIR_SYM:
+            case DVP_KN_DSP_IIR:
+            case DVP_KN_DSP_IIR_LAT:
+            case DVP_KN_DSP_FFT_16x16:
+            case DVP_KN_DSP_FFT_32x32:
+            case DVP_KN_DSP_IFFT_16x16:
+            case DVP_KN_DSP_IFFT_32x32:
+            case DVP_KN_GEN_TWIDDLE_FFT_16X16:
+            case DVP_KN_GEN_TWIDDLE_FFT_32x32:
+            case DVP_KN_GEN_TWIDDLE_IFFT_16X16:
+            {
+                if (DVP_Dsp_Check(dvp_knode_to(&pSubNodes[n], DVP_DSPFunc), pSubNodes[n].header.kernel) == DVP_FALSE)
+                    pSubNodes[n].header.error = DVP_ERROR_INVALID_PARAMETER;
+                break;
+            }
+#endif
 #ifdef DVP_USE_YUV
             case DVP_KN_YUV_ARGB_TO_UYVY:
             {
@@ -4391,16 +4930,12 @@ MODULE_EXPORT DVP_U32 DVP_KernelGraphManagerVerify(DVP_KernelNode_t *pSubNodes,
             // case DVP_KN_YUV_NV12_TO_YU24_HALF_SCALE:
             // case DVP_KN_YUV_UYVY_HALF_SCALE:
             // case DVP_KN_YUV_UYVY_QTR_SCALE:
-            // case DVP_KN_YUV_UYVY_ROTATE_CCW_90:
-            // case DVP_KN_YUV_UYVY_ROTATE_CW_90:
             case DVP_KN_YUV_UYVY_TO_BGR:
             case DVP_KN_YUV_UYVY_TO_IYUV:
             case DVP_KN_YUV_UYVY_TO_RGBp:
             // case DVP_KN_YUV_UYVY_TO_RGBp_Y800_YU24:
             case DVP_KN_YUV_UYVY_TO_YUV444p:
             case DVP_KN_YUV_XYXY_TO_Y800:
-            // case DVP_KN_YUV_Y800_ROTATE_CCW_90:
-            // case DVP_KN_YUV_Y800_ROTATE_CW_90:
             case DVP_KN_YUV_Y800_TO_XYXY:
             case DVP_KN_YUV_YXYX_TO_Y800:
 #endif
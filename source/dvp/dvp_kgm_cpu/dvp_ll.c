@@ -22,6 +22,49 @@
 #include <imgfilter/imgFilter_armv7.h>
 #endif
 
+#if defined(DVP_USE_YUV) || defined(DVP_USE_YUV_C)
+#include <yuv/yuv_armv7.h>
+#endif
+
+#if defined(DVP_USE_LDC)
+#include <vrun/dvp_kl_vrun.h>
+#endif
+
+#if defined(DVP_USE_DSPLIB_C) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define DVP_TABLES_MAX      (16)
+#define DVP_TABLES_KEY_MAX  (576) // an LDC key carries its whole LUT
+
+typedef struct _dvp_table_entry_t {
+    DVP_U32 kernel;
+    DVP_U32 keyLen;
+    DVP_U08 key[DVP_TABLES_KEY_MAX];
+    void   *pTable;
+    DVP_U32 refs;       /*!< The number of nodes currently executing with the table */
+    DVP_U32 lastUse;
+} DVP_TableEntry_t;
+
+/*! \brief What a verified node keeps until it is freed, so that executing it
+ * takes no lock and allocates nothing.
+ */
+typedef struct _dvp_node_tables_t {
+    struct _dvp_node_tables_t *next;
+    DVP_KernelNode_t *pNode;         /*!< The node which keeps these, the node itself is not written */
+    DVP_U32 kernel;
+    DVP_U32 keyLen;
+    DVP_U08 key[DVP_TABLES_KEY_MAX]; /*!< The parameters the table was acquired for */
+    void   *pTable;
+    DVP_U32 tmpSize;
+    void   *pTmp;                    /*!< Scratch memory of the node, follows in the same block */
+} DVP_NodeTables_t;
+
+static DVP_TableEntry_t tables[DVP_TABLES_MAX];
+static DVP_U32 tablesClock;
+static mutex_t tablesLock;
+static DVP_NodeTables_t *nodeTables; // every node which holds a table, guarded by tablesLock
+
 void DVP_imgFilter(DVP_Image_t *pLuma,
                    DVP_ImageFilter_e type,
                    DVP_Image_t *pOut)
@@ -83,3 +126,978 @@ void DVP_imgFilter(DVP_Image_t *pLuma,
 #endif
 }
 
+void DVP_Tables_Init(void)
+{
+    memset(tables, 0, sizeof(tables));
+    tablesClock = 0;
+    nodeTables = NULL;
+    mutex_init(&tablesLock);
+}
+
+void DVP_Tables_Deinit(void)
+{
+    DVP_U32 i;
+    mutex_lock(&tablesLock);
+    // nodes which are still allocated forget their tables, the manager is going away
+    while (nodeTables)
+    {
+        DVP_NodeTables_t *pN = nodeTables;
+        nodeTables = pN->next;
+        free(pN);
+    }
+    for (i = 0; i < dimof(tables); i++)
+    {
+        if (tables[i].refs > 0)
+            DVP_PRINT(DVP_ZONE_WARNING, "Table %p is still in use!\n", tables[i].pTable);
+        free(tables[i].pTable);
+        tables[i].pTable = NULL;
+    }
+    mutex_unlock(&tablesLock);
+    mutex_deinit(&tablesLock);
+}
+
+static void *DVP_Tables_Find(DVP_U32 kernel, void *pKey, DVP_U32 keyLen)
+{
+    DVP_U32 i;
+    for (i = 0; i < dimof(tables); i++)
+    {
+        if (tables[i].pTable != NULL &&
+            tables[i].kernel == kernel &&
+            tables[i].keyLen == keyLen &&
+            memcmp(tables[i].key, pKey, keyLen) == 0)
+        {
+            tables[i].refs++;
+            tables[i].lastUse = ++tablesClock;
+            return tables[i].pTable;
+        }
+    }
+    return NULL;
+}
+
+void *DVP_Tables_Acquire(DVP_U32 kernel, void *pKey, DVP_U32 keyLen, DVP_TableBuild_f build)
+{
+    void *pTable = NULL;
+    void *pCached = NULL;
+    DVP_S32 victim = -1;
+    DVP_U32 i;
+
+    if (keyLen > DVP_TABLES_KEY_MAX)
+        return build(pKey); // uncached, freed on release
+
+    mutex_lock(&tablesLock);
+    pTable = DVP_Tables_Find(kernel, pKey, keyLen);
+    mutex_unlock(&tablesLock);
+    if (pTable)
+        return pTable;
+
+    // build outside of the lock, the tables can take a while to compute.
+    pTable = build(pKey);
+    if (pTable == NULL)
+        return NULL;
+
+    mutex_lock(&tablesLock);
+    pCached = DVP_Tables_Find(kernel, pKey, keyLen);
+    if (pCached)
+    {
+        // another thread built the same table in the meantime
+        mutex_unlock(&tablesLock);
+        free(pTable);
+        return pCached;
+    }
+    for (i = 0; i < dimof(tables); i++)
+    {
+        if (tables[i].pTable == NULL)
+        {
+            victim = i;
+            break;
+        }
+        if (tables[i].refs == 0 &&
+            (victim == -1 || tables[i].lastUse < tables[victim].lastUse))
+            victim = i;
+    }
+    if (victim >= 0)
+    {
+        DVP_TableEntry_t *pE = &tables[victim];
+        free(pE->pTable);
+        pE->kernel = kernel;
+        pE->keyLen = keyLen;
+        memcpy(pE->key, pKey, keyLen);
+        pE->pTable = pTable;
+        pE->refs = 1;
+        pE->lastUse = ++tablesClock;
+    }
+    mutex_unlock(&tablesLock);
+    return pTable;
+}
+
+void DVP_Tables_Release(void *pTable)
+{
+    DVP_BOOL cached = DVP_FALSE;
+    DVP_U32 i;
+    if (pTable == NULL)
+        return;
+    mutex_lock(&tablesLock);
+    for (i = 0; i < dimof(tables); i++)
+    {
+        if (tables[i].pTable == pTable)
+        {
+            if (tables[i].refs > 0)
+                tables[i].refs--;
+            cached = DVP_TRUE;
+            break;
+        }
+    }
+    mutex_unlock(&tablesLock);
+    if (cached == DVP_FALSE)
+        free(pTable);
+}
+
+// the node header has no field for the manager and its reserved words belong to the
+// other cores, so what each node keeps is found by the node's address instead
+static DVP_NodeTables_t *DVP_Tables_Node(DVP_KernelNode_t *pNode)
+{
+    DVP_NodeTables_t *pN = NULL;
+    mutex_lock(&tablesLock);
+    for (pN = nodeTables; pN != NULL; pN = pN->next)
+        if (pN->pNode == pNode)
+            break;
+    mutex_unlock(&tablesLock);
+    return pN;
+}
+
+void DVP_Tables_Detach(DVP_KernelNode_t *pNode)
+{
+    DVP_NodeTables_t *pN = NULL;
+    DVP_NodeTables_t **ppN;
+    mutex_lock(&tablesLock);
+    for (ppN = &nodeTables; *ppN != NULL; ppN = &(*ppN)->next)
+    {
+        if ((*ppN)->pNode == pNode)
+        {
+            pN = *ppN;
+            *ppN = pN->next;
+            break;
+        }
+    }
+    mutex_unlock(&tablesLock);
+    if (pN)
+    {
+        DVP_Tables_Release(pN->pTable);
+        free(pN);
+    }
+}
+
+/*! \brief Acquires the table of the key for the node and allocates its
+ * scratch memory, both are kept until \ref DVP_Tables_Detach.
+ */
+static DVP_NodeTables_t *DVP_Tables_Attach(DVP_KernelNode_t *pNode, DVP_U32 kernel, void *pKey, DVP_U32 keyLen, DVP_TableBuild_f build, DVP_U32 tmpSize)
+{
+    DVP_NodeTables_t *pN = NULL;
+
+    DVP_Tables_Detach(pNode); // the node may be verified again
+    if (keyLen > DVP_TABLES_KEY_MAX)
+        return NULL;
+    pN = (DVP_NodeTables_t *)calloc(1, sizeof(DVP_NodeTables_t) + tmpSize);
+    if (pN == NULL)
+        return NULL;
+    pN->pTable = DVP_Tables_Acquire(kernel, pKey, keyLen, build);
+    if (pN->pTable == NULL)
+    {
+        free(pN);
+        return NULL;
+    }
+    pN->pNode = pNode;
+    pN->kernel = kernel;
+    pN->keyLen = keyLen;
+    memcpy(pN->key, pKey, keyLen);
+    pN->tmpSize = tmpSize;
+    pN->pTmp = (tmpSize > 0 ? &pN[1] : NULL);
+    mutex_lock(&tablesLock);
+    pN->next = nodeTables;
+    nodeTables = pN;
+    mutex_unlock(&tablesLock);
+    return pN;
+}
+
+/*! \brief Returns what the node kept at verify if its parameters have not
+ * changed since, otherwise acquires again.
+ */
+static DVP_NodeTables_t *DVP_Tables_Attached(DVP_KernelNode_t *pNode, DVP_U32 kernel, void *pKey, DVP_U32 keyLen, DVP_TableBuild_f build, DVP_U32 tmpSize)
+{
+    DVP_NodeTables_t *pN = DVP_Tables_Node(pNode);
+    if (pN != NULL &&
+        pN->kernel == kernel &&
+        pN->keyLen == keyLen &&
+        pN->tmpSize >= tmpSize &&
+        memcmp(pN->key, pKey, keyLen) == 0)
+        return pN;
+    return DVP_Tables_Attach(pNode, kernel, pKey, keyLen, build, tmpSize);
+}
+
+#if defined(DVP_USE_YUV) || defined(DVP_USE_YUV_C)
+
+typedef struct _dvp_scale_key_t {
+    fourcc_t color;
+    DVP_U32  filter;
+    DVP_U32  srcWidth;
+    DVP_U32  srcHeight;
+    DVP_U32  dstWidth;
+    DVP_U32  dstHeight;
+} DVP_ScaleKey_t;
+
+/*! \brief The precomputed coefficients of a scale, the tables follow in the same block. */
+typedef struct _dvp_scale_tables_t {
+    void *xLuma;
+    void *yLuma;
+    void *xChroma;
+    void *yChroma;
+} DVP_ScaleTables_t;
+
+static void *DVP_Scale_Build(void *pKey)
+{
+    DVP_ScaleKey_t *pK = (DVP_ScaleKey_t *)pKey;
+    DVP_ScaleTables_t *pT = NULL;
+    DVP_U32 cw = pK->srcWidth/2, cdw = pK->dstWidth/2;
+    DVP_U32 ch = pK->srcHeight, cdh = pK->dstHeight;
+    DVP_U32 sizes[4];
+    DVP_U08 *ptr;
+
+    if (pK->color == FOURCC_NV12)
+    {
+        ch = pK->srcHeight/2;
+        cdh = pK->dstHeight/2;
+    }
+    sizes[0] = __scale_table_size(pK->srcWidth, pK->dstWidth, pK->filter);
+    sizes[1] = __scale_table_size(pK->srcHeight, pK->dstHeight, pK->filter);
+    sizes[2] = (pK->color == FOURCC_Y800 ? 0 : __scale_table_size(cw, cdw, pK->filter));
+    sizes[3] = (pK->color == FOURCC_NV12 ? __scale_table_size(ch, cdh, pK->filter) : 0);
+
+    ptr = (DVP_U08 *)calloc(1, sizeof(DVP_ScaleTables_t) + sizes[0] + sizes[1] + sizes[2] + sizes[3]);
+    if (ptr == NULL)
+        return NULL;
+    pT = (DVP_ScaleTables_t *)ptr;
+    ptr += sizeof(DVP_ScaleTables_t);
+    pT->xLuma = ptr;    ptr += sizes[0];
+    pT->yLuma = ptr;    ptr += sizes[1];
+    pT->xChroma = ptr;  ptr += sizes[2];
+    pT->yChroma = ptr;
+    __scale_table_init(pK->srcWidth, pK->dstWidth, pK->filter, pT->xLuma);
+    __scale_table_init(pK->srcHeight, pK->dstHeight, pK->filter, pT->yLuma);
+    if (sizes[2])
+        __scale_table_init(cw, cdw, pK->filter, pT->xChroma);
+    if (sizes[3])
+        __scale_table_init(ch, cdh, pK->filter, pT->yChroma);
+    else
+        pT->yChroma = pT->yLuma;
+    return pT;
+}
+
+static void DVP_Scale_Key(DVP_YUV_Scale_t *pS, DVP_ScaleKey_t *pKey)
+{
+    memset(pKey, 0, sizeof(*pKey));
+    pKey->color = pS->input.color;
+    pKey->filter = pS->filter;
+    pKey->srcWidth = pS->input.width;
+    pKey->srcHeight = pS->input.height;
+    pKey->dstWidth = pS->output.width;
+    pKey->dstHeight = pS->output.height;
+}
+
+// one line of intermediate results
+#define DVP_Scale_TmpSize(pS)   ((pS)->input.width * (pS)->input.x_stride * sizeof(int32_t))
+
+DVP_BOOL DVP_Scale_Prepare(DVP_KernelNode_t *pNode)
+{
+    DVP_YUV_Scale_t *pS = dvp_knode_to(pNode, DVP_YUV_Scale_t);
+    DVP_ScaleKey_t key;
+    DVP_Scale_Key(pS, &key);
+    if (DVP_Tables_Attach(pNode, DVP_KN_YUV_SCALE, &key, sizeof(key), DVP_Scale_Build, DVP_Scale_TmpSize(pS)) == NULL)
+        return DVP_FALSE;
+    return DVP_TRUE;
+}
+
+DVP_BOOL DVP_Scale(DVP_KernelNode_t *pNode)
+{
+    DVP_YUV_Scale_t *pS = dvp_knode_to(pNode, DVP_YUV_Scale_t);
+    DVP_ScaleKey_t key;
+    DVP_NodeTables_t *pN;
+    DVP_ScaleTables_t *pT;
+    int32_t *pTmp;
+
+    DVP_Scale_Key(pS, &key);
+    pN = DVP_Tables_Attached(pNode, DVP_KN_YUV_SCALE, &key, sizeof(key), DVP_Scale_Build, DVP_Scale_TmpSize(pS));
+    if (pN == NULL)
+        return DVP_FALSE;
+    pT = (DVP_ScaleTables_t *)pN->pTable;
+    pTmp = (int32_t *)pN->pTmp;
+    if (pS->input.color == FOURCC_UYVY)
+    {
+        __uyvy_scale_image(pS->input.width, pS->input.height,
+                           pS->input.pData[0], pS->input.y_stride,
+                           pS->output.width, pS->output.height,
+                           pS->output.pData[0], pS->output.y_stride,
+                           pT->xLuma, pT->xChroma, pT->yLuma, pTmp);
+    }
+    else
+    {
+        __planar_scale_image(pS->input.width, pS->input.height,
+                             pS->input.pData[0], pS->input.y_stride,
+                             pS->output.width, pS->output.height,
+                             pS->output.pData[0], pS->output.y_stride,
+                             1, pT->xLuma, pT->yLuma, pTmp);
+        if (pS->input.color == FOURCC_NV12)
+            __planar_scale_image(pS->input.width/2, pS->input.height/2,
+                                 pS->input.pData[1], pS->input.y_stride,
+                                 pS->output.width/2, pS->output.height/2,
+                                 pS->output.pData[1], pS->output.y_stride,
+                                 2, pT->xChroma, pT->yChroma, pTmp);
+    }
+    return DVP_TRUE;
+}
+
+#endif
+
+#if defined(DVP_USE_LDC)
+
+#define DVP_LDC_LUT_SIZE    (256)
+
+/*! \brief The parameters which the remap table of an LDC node depends on. */
+typedef struct _dvp_ldc_key_t {
+    fourcc_t color;
+    DVP_U32  srcWidth;
+    DVP_U32  srcHeight;
+    DVP_U32  dstWidth;
+    DVP_U32  dstHeight;
+    DVP_S16  affine[6];
+    DVP_U16  centerX;
+    DVP_U16  centerY;
+    DVP_U08  K[4];          /*!< Khl, Khr, Kvu, Kvl */
+    DVP_U16  Rth;
+    DVP_U16  shift;
+    DVP_BOOL affineOn;
+    DVP_BOOL distortionOn;
+    DVP_U16  lut[DVP_LDC_LUT_SIZE]; /*!< Compared as part of the key, a hash could collide */
+} DVP_LdcKey_t;
+
+static DVP_U32 DVP_Ldc_Sqrt(DVP_U64 v)
+{
+    DVP_U64 r = 0, bit = 1ULL << 62;
+    while (bit > v)
+        bit >>= 2;
+    while (bit)
+    {
+        if (v >= r + bit)
+        {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        }
+        else
+            r >>= 1;
+        bit >>= 2;
+    }
+    return (DVP_U32)r;
+}
+
+/*!
+ * \brief Computes the source position of every output pixel. The output
+ * position is first moved by the affine transform (A,B,D,E are Q12 and C,F
+ * are Q3) then pushed radially away from the lens center by the LUT, which is
+ * indexed by the radius over Rth and holds ratios in Q(ldcRightShiftBits).
+ * The K factors (Q4) scale the distances on each side of the center before
+ * the radius is computed.
+ */
+static void *DVP_Ldc_Build(void *pKey)
+{
+    DVP_LdcKey_t *pK = (DVP_LdcKey_t *)pKey;
+    void *pTable = malloc(__remap_table_size(pK->dstWidth, pK->dstHeight));
+    DVP_S64 cx = (DVP_S64)pK->centerX << 4;
+    DVP_S64 cy = (DVP_S64)pK->centerY << 4;
+    DVP_U32 x, y;
+
+    if (pTable == NULL)
+        return NULL;
+    __remap_table_init(pK->dstWidth, pK->dstHeight, pK->srcWidth, pK->srcHeight, pTable);
+    for (y = 0; y < pK->dstHeight; y++)
+    {
+        for (x = 0; x < pK->dstWidth; x++)
+        {
+            // all positions are in Q4
+            DVP_S64 h = (DVP_S64)x << 4;
+            DVP_S64 v = (DVP_S64)y << 4;
+            if (pK->affineOn)
+            {
+                DVP_S64 ha = (((DVP_S64)pK->affine[0] * h + (DVP_S64)pK->affine[1] * v) >> 12) + ((DVP_S64)pK->affine[2] << 1);
+                DVP_S64 va = (((DVP_S64)pK->affine[3] * h + (DVP_S64)pK->affine[4] * v) >> 12) + ((DVP_S64)pK->affine[5] << 1);
+                h = ha;
+                v = va;
+            }
+            if (pK->distortionOn)
+            {
+                DVP_S64 dh = h - cx;
+                DVP_S64 dv = v - cy;
+                DVP_S64 kh = (dh * (dh < 0 ? pK->K[0] : pK->K[1])) >> 4;
+                DVP_S64 kv = (dv * (dv < 0 ? pK->K[2] : pK->K[3])) >> 4;
+                DVP_U64 r = DVP_Ldc_Sqrt((DVP_U64)(kh * kh + kv * kv));
+                DVP_U64 pos = (r * DVP_LDC_LUT_SIZE) / pK->Rth; // LUT index in Q4
+                DVP_U32 i = (DVP_U32)(pos >> 4), f = (DVP_U32)(pos & 0xF);
+                DVP_S64 ratio;
+                if (i >= DVP_LDC_LUT_SIZE - 1)
+                    ratio = pK->lut[DVP_LDC_LUT_SIZE - 1];
+                else
+                    ratio = ((pK->lut[i] * (16 - f)) + (pK->lut[i + 1] * f) + 8) >> 4;
+                h = cx + ((dh * ratio) >> pK->shift);
+                v = cy + ((dv * ratio) >> pK->shift);
+            }
+            if (h < 0) h = 0;
+            if (v < 0) v = 0;
+            if (h > 0x7FFFFFFF) h = 0x7FFFFFFF;
+            if (v > 0x7FFFFFFF) v = 0x7FFFFFFF;
+            __remap_table_set(pTable, x, y, (int32_t)h, (int32_t)v);
+        }
+    }
+    return pTable;
+}
+
+static void DVP_Ldc_Key(DVP_Ldc_t *pLdc, DVP_U32 kernel, DVP_LdcKey_t *pKey)
+{
+    memset(pKey, 0, sizeof(*pKey));
+    pKey->color = pLdc->input.color;
+    pKey->srcWidth = pLdc->input.width;
+    pKey->srcHeight = pLdc->input.height;
+    pKey->dstWidth = pLdc->output.width;
+    pKey->dstHeight = pLdc->output.height;
+    pKey->affineOn = (kernel != DVP_KN_LDC_DISTORTION_CORRECTION ? DVP_TRUE : DVP_FALSE);
+    pKey->distortionOn = (kernel != DVP_KN_LDC_AFFINE_TRANSFORM ? DVP_TRUE : DVP_FALSE);
+    if (pKey->affineOn)
+        memcpy(pKey->affine, pLdc->affine, sizeof(pKey->affine));
+    if (pKey->distortionOn)
+    {
+        pKey->centerX = pLdc->ldcLensCenterX;
+        pKey->centerY = pLdc->ldcLensCenterY;
+        pKey->K[0] = pLdc->ldcKhl;
+        pKey->K[1] = pLdc->ldcKhr;
+        pKey->K[2] = pLdc->ldcKvu;
+        pKey->K[3] = pLdc->ldcKvl;
+        pKey->Rth = pLdc->ldcRth;
+        pKey->shift = pLdc->ldcRightShiftBits;
+        memcpy(pKey->lut, pLdc->ldcLut.pData, sizeof(pKey->lut));
+    }
+}
+
+// the remap is the same for every DVP_KN_LDC_* kernel, the key says which parts apply
+DVP_BOOL DVP_Ldc_Prepare(DVP_KernelNode_t *pNode)
+{
+    DVP_Ldc_t *pLdc = dvp_knode_to(pNode, DVP_Ldc_t);
+    DVP_LdcKey_t key;
+    DVP_Ldc_Key(pLdc, pNode->header.kernel, &key);
+    if (DVP_Tables_Attach(pNode, DVP_KN_LDC_DISTORTION_AND_AFFINE, &key, sizeof(key), DVP_Ldc_Build, 0) == NULL)
+        return DVP_FALSE;
+    return DVP_TRUE;
+}
+
+DVP_BOOL DVP_Ldc(DVP_KernelNode_t *pNode)
+{
+    DVP_Ldc_t *pLdc = dvp_knode_to(pNode, DVP_Ldc_t);
+    DVP_LdcKey_t key;
+    DVP_NodeTables_t *pN;
+
+    DVP_Ldc_Key(pLdc, pNode->header.kernel, &key);
+    pN = DVP_Tables_Attached(pNode, DVP_KN_LDC_DISTORTION_AND_AFFINE, &key, sizeof(key), DVP_Ldc_Build, 0);
+    if (pN == NULL)
+        return DVP_FALSE;
+    // bicubic is executed as bilinear and the edges are clamped instead of padded.
+    if (pLdc->input.color == FOURCC_NV12)
+        __nv12_remap_bilinear(pN->pTable,
+                              pLdc->input.pData[0], pLdc->input.pData[1], pLdc->input.y_stride,
+                              pLdc->output.pData[0], pLdc->output.pData[1], pLdc->output.y_stride);
+    else
+        __uyvy_remap_bilinear(pN->pTable,
+                              pLdc->input.pData[0], pLdc->input.y_stride,
+                              pLdc->output.pData[0], pLdc->output.y_stride);
+    return DVP_TRUE;
+}
+
+#endif
+
+#if defined(DVP_USE_DEI_C)
+
+void DVP_Deinterlacer_Init(DVP_Deinterlacer_t *pD)
+{
+    if (pD->mode == DVP_DEI_MODE_MOTION_ADAPTIVE)
+    {
+        memset(pD->phy_luma_d0.pData, 0, pD->phy_luma_d0.numBytes);
+        memset(pD->phy_luma_d1.pData, 0, pD->phy_luma_d1.numBytes);
+        // everything is moving until the history is filled
+        memset(pD->phy_luma_d2.pData, 0xFF, pD->phy_luma_d2.numBytes);
+    }
+    pD->initialized = 1;
+}
+
+void DVP_Deinterlacer_Deinit(DVP_Deinterlacer_t *pD)
+{
+    pD->initialized = 0;
+}
+
+DVP_BOOL DVP_Deinterlace(DVP_Deinterlacer_t *pD)
+{
+    DVP_Image_t *pCur = &pD->phy_fld_in_current;
+    DVP_Image_t *pPrev = &pD->phy_fld_in_prev;
+    DVP_U32 parity = pD->fldnum & 1;
+
+    if (pD->initialized == 0)
+        DVP_Deinterlacer_Init(pD);
+    if (pD->mode == DVP_DEI_MODE_LINE_AVERAGE)
+        __uyvy_deinterlace_line_average(pCur->width, pCur->height,
+                                        pCur->pData[0], pCur->y_stride,
+                                        parity);
+    else
+        __uyvy_deinterlace_motion_adaptive(pCur->width, pCur->height,
+                                           pCur->pData[0], pCur->y_stride,
+                                           pPrev->pData[0], pPrev->y_stride,
+                                           parity,
+                                           (parity ? pD->phy_luma_d1.pData : pD->phy_luma_d0.pData),
+                                           pD->phy_luma_d2.pData,
+                                           pD->bias, pD->sad_scale, pD->sad_corr);
+    return DVP_TRUE;
+}
+
+#endif
+
+#if defined(DVP_USE_DSPLIB_C)
+
+#define DVP_DSP_PI  (3.14159265358979323846)
+
+static DVP_U32 DVP_Dsp_Count(DVP_Buffer_t *pB, DVP_U32 size)
+{
+    return (pB->pData ? pB->numBytes / size : 0);
+}
+
+static DVP_S64 DVP_Dsp_Sat(DVP_S64 v, DVP_U32 q)
+{
+    DVP_S64 max = ((DVP_S64)1 << q) - 1;
+    if (v > max)
+        return max;
+    if (v < -max - 1)
+        return -max - 1;
+    return v;
+}
+
+static DVP_S64 DVP_Dsp_Shift(DVP_S64 v, DVP_U32 shift)
+{
+    return (shift ? (v + ((DVP_S64)1 << (shift - 1))) >> shift : v);
+}
+
+/*! \brief The 32 bit dot product of two Q15 vectors, wrapping on overflow like the DSP accumulators. */
+static DVP_S32 DVP_Dsp_Dot16(const DVP_S16 *a, const DVP_S16 *b, DVP_U32 n)
+{
+    DVP_U32 i = 0, sum = 0;
+#if defined(__SSE2__)
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 8 <= n; i += 8)
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)&a[i]),
+                                                _mm_loadu_si128((const __m128i *)&b[i])));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1,0,3,2)));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2,3,0,1)));
+    sum = (DVP_U32)_mm_cvtsi128_si32(acc);
+#endif
+    for (; i < n; i++)
+        sum += (DVP_U32)((DVP_S32)a[i] * b[i]);
+    return (DVP_S32)sum;
+}
+
+static void DVP_Dsp_Add16(const DVP_S16 *x, const DVP_S16 *y, DVP_S16 *r, DVP_U32 n)
+{
+    DVP_U32 i = 0;
+#if defined(__SSE2__)
+    for (; i + 8 <= n; i += 8)
+        _mm_storeu_si128((__m128i *)&r[i], _mm_add_epi16(_mm_loadu_si128((const __m128i *)&x[i]),
+                                                         _mm_loadu_si128((const __m128i *)&y[i])));
+#endif
+    for (; i < n; i++)
+        r[i] = (DVP_S16)(x[i] + y[i]);
+}
+
+static void DVP_Dsp_Add32(const DVP_S32 *x, const DVP_S32 *y, DVP_S32 *r, DVP_U32 n)
+{
+    DVP_U32 i = 0;
+#if defined(__SSE2__)
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_si128((__m128i *)&r[i], _mm_add_epi32(_mm_loadu_si128((const __m128i *)&x[i]),
+                                                         _mm_loadu_si128((const __m128i *)&y[i])));
+#endif
+    for (; i < n; i++)
+        r[i] = (DVP_S32)((DVP_U32)x[i] + (DVP_U32)y[i]);
+}
+
+/*! \brief r[j] = sum(x[j+i] * h[i]) >> 15, as DSP_fir_gen/r4/r8. */
+static void DVP_Dsp_Fir(const DVP_S16 *x, const DVP_S16 *h, DVP_S16 *r, DVP_U32 nh, DVP_U32 nr)
+{
+    DVP_U32 j;
+    for (j = 0; j < nr; j++)
+        r[j] = (DVP_S16)(DVP_Dsp_Dot16(&x[j], h, nh) >> 15);
+}
+
+/*! \brief The symmetric filter of 2*nh+1 taps from the nh+1 coefficients of its first half, as DSP_fir_sym. */
+static void DVP_Dsp_FirSym(const DVP_S16 *x, const DVP_S16 *h, DVP_S16 *r, DVP_U32 nh, DVP_U32 nr, DVP_U32 s)
+{
+    DVP_U32 i, j;
+    for (j = 0; j < nr; j++)
+    {
+        DVP_S64 y0 = 0;
+        for (i = 0; i < nh; i++)
+            y0 += (DVP_S32)(x[j + i] + x[j + 2*nh - i]) * h[i];
+        y0 += (DVP_S32)x[j + nh] * h[nh];
+        r[j] = (DVP_S16)(y0 >> s);
+    }
+}
+
+/*! \brief The 4th order IIR of DSP_iir, r1 holds the 4 previous outputs before the nr new ones. */
+static void DVP_Dsp_Iir(const DVP_S16 *x, const DVP_S16 *h2, const DVP_S16 *h1, DVP_S16 *r1, DVP_S16 *r2, DVP_U32 nr)
+{
+    DVP_U32 i, j;
+    for (i = 0; i < nr; i++)
+    {
+        DVP_U32 sum = (DVP_U32)((DVP_S32)h2[0] * x[4 + i]);
+        for (j = 1; j <= 4; j++)
+            sum += (DVP_U32)((DVP_S32)h2[j] * x[4 + i - j]) - (DVP_U32)((DVP_S32)h1[j] * r1[4 + i - j]);
+        r1[4 + i] = (DVP_S16)((DVP_S32)sum >> 15);
+        r2[i] = r1[4 + i];
+    }
+}
+
+/*! \brief The all pole lattice filter of DSP_iirlat, b holds the nk+1 delays between calls. */
+static void DVP_Dsp_IirLat(const DVP_S16 *x, DVP_U32 nx, const DVP_S16 *k, DVP_U32 nk, DVP_S32 *b, DVP_S16 *r)
+{
+    DVP_U32 j;
+    DVP_S32 i;
+    for (j = 0; j < nx; j++)
+    {
+        DVP_S32 rt = (DVP_S32)x[j] * 32768;
+        for (i = (DVP_S32)nk - 1; i >= 0; i--)
+        {
+            rt = (DVP_S32)((DVP_U32)rt - (DVP_U32)((DVP_S16)(b[i] >> 15) * k[i]));
+            b[i + 1] = (DVP_S32)((DVP_U32)b[i] + (DVP_U32)((DVP_S16)(rt >> 15) * k[i]));
+        }
+        b[0] = rt;
+        r[j] = (DVP_S16)(rt >> 15);
+    }
+}
+
+DVP_U32 DVP_Dsp_TwiddleCount(DVP_U32 n)
+{
+    DVP_U32 j, k = 0;
+    for (j = 1; j < n >> 2; j <<= 2)
+        k += (3 * n) / (2 * j);
+    return k;
+}
+
+static DVP_S64 DVP_Dsp_D2Q(double d, DVP_U32 q)
+{
+    double max = (double)(((DVP_S64)1 << q) - 1);
+    if (d >= max)
+        return (DVP_S64)max;
+    if (d <= -max - 1.0)
+        return (DVP_S64)(-max - 1.0);
+    return (DVP_S64)d;
+}
+
+/*!
+ * \brief Generates the twiddles of every radix 4 stage of an FFT of n points
+ * in the layout of gen_twiddle_fft16x16 (q = 15: sin/cos of W^b, W^(b+1),
+ * W^2b, ... for 2 butterflies per group of 12) or gen_twiddle_fft32x32
+ * (q = 31: sin/cos of W^b, W^2b, W^3b per group of 6).
+ */
+static DVP_U32 DVP_Dsp_Twiddle(void *w, DVP_U32 n, DVP_U32 q)
+{
+    double M = (double)((DVP_S64)1 << q) - 0.5;
+    DVP_U32 i, j, k = 0, m, o, step = (q == 31 ? 1 : 2);
+
+    for (j = 1; j < n >> 2; j <<= 2)
+    {
+        for (i = 0; i < n >> 2; i += j * step)
+        {
+            for (o = 0; o < step; o++)
+            {
+                for (m = 1; m <= 3; m++)
+                {
+                    double a = 2.0 * m * DVP_DSP_PI * (i + o * j) / n;
+                    DVP_U32 idx = (q == 31 ? k + 2*(m - 1) : k + 4*(m - 1) + 2*o);
+                    if (q == 31)
+                    {
+                        ((DVP_S32 *)w)[idx + 0] = (DVP_S32)DVP_Dsp_D2Q(M * sin(a), q);
+                        ((DVP_S32 *)w)[idx + 1] = (DVP_S32)DVP_Dsp_D2Q(M * cos(a), q);
+                    }
+                    else
+                    {
+                        ((DVP_S16 *)w)[idx + 0] = (DVP_S16)DVP_Dsp_D2Q(M * sin(a), q);
+                        ((DVP_S16 *)w)[idx + 1] = (DVP_S16)DVP_Dsp_D2Q(M * cos(a), q);
+                    }
+                }
+            }
+            k += 6 * step;
+        }
+    }
+    return k;
+}
+
+static DVP_S64 DVP_Dsp_Load(const void *p, DVP_U32 i, DVP_U32 q)
+{
+    return (q == 31 ? ((const DVP_S32 *)p)[i] : ((const DVP_S16 *)p)[i]);
+}
+
+static void DVP_Dsp_Store(void *p, DVP_U32 i, DVP_S64 v, DVP_U32 q)
+{
+    if (q == 31)
+        ((DVP_S32 *)p)[i] = (DVP_S32)v;
+    else
+        ((DVP_S16 *)p)[i] = (DVP_S16)v;
+}
+
+/*!
+ * \brief The radix 4 decimation in frequency butterfly of the complex a,b,c,d
+ * in v. It leaves X0,X2,X1,X3 in v so that the outputs end up in bit reversed
+ * order, which lets the last stage be radix 2.
+ */
+static void DVP_Dsp_Radix4(DVP_S64 *v, DVP_BOOL inverse, DVP_U32 shift, DVP_U32 q)
+{
+    DVP_S64 t0r = v[0] + v[4], t0i = v[1] + v[5];
+    DVP_S64 t1r = v[0] - v[4], t1i = v[1] - v[5];
+    DVP_S64 t2r = v[2] + v[6], t2i = v[3] + v[7];
+    DVP_S64 t3r = v[2] - v[6], t3i = v[3] - v[7];
+    DVP_U32 i;
+
+    if (inverse) // -j becomes +j
+    {
+        t3r = -t3r;
+        t3i = -t3i;
+    }
+    v[0] = t0r + t2r; v[1] = t0i + t2i;
+    v[2] = t0r - t2r; v[3] = t0i - t2i;
+    v[4] = t1r + t3i; v[5] = t1i - t3r;
+    v[6] = t1r - t3i; v[7] = t1i + t3r;
+    for (i = 0; i < 8; i++)
+        v[i] = DVP_Dsp_Sat(DVP_Dsp_Shift(v[i], shift), q);
+}
+
+/*! \brief Multiplies the complex v by W^(m*b) of the stage whose twiddles start at base. */
+static void DVP_Dsp_Rotate(DVP_S64 *v, const void *w, DVP_U32 base, DVP_U32 b, DVP_U32 m, DVP_BOOL inverse, DVP_U32 q)
+{
+    DVP_U32 k = (q == 31 ? base + b*6 + 2*(m - 1) : base + (b >> 1)*12 + (b & 1)*2 + 4*(m - 1));
+    DVP_S64 si = DVP_Dsp_Load(w, k, q);
+    DVP_S64 co = DVP_Dsp_Load(w, k + 1, q);
+    DVP_S64 re, im;
+
+    if (inverse)
+        si = -si;
+    re = (v[0] * co + v[1] * si + ((DVP_S64)1 << (q - 1))) >> q;
+    im = (v[1] * co - v[0] * si + ((DVP_S64)1 << (q - 1))) >> q;
+    v[0] = DVP_Dsp_Sat(re, q);
+    v[1] = DVP_Dsp_Sat(im, q);
+}
+
+/*!
+ * \brief A radix 4 FFT of n interleaved complex points in Q(q) with a radix 2
+ * last stage when n is not a power of 4. The forward transform rounds each
+ * stage down by its radix so that the output is the DFT / n, the inverse one
+ * saturates instead.
+ */
+static void DVP_Dsp_Fft(const void *w, DVP_U32 n, const void *x, void *y, DVP_U32 q, DVP_BOOL inverse)
+{
+    DVP_U32 size = (q == 31 ? sizeof(DVP_S32) : sizeof(DVP_S16));
+    DVP_U32 L, j, s, b, i, t, r, bits = 0, tw = 0;
+    DVP_U08 tmp[2*sizeof(DVP_S32)];
+    DVP_S64 v[8];
+
+    if (x != y)
+        memcpy(y, x, 2 * n * size);
+    for (L = n, j = 1; L > 4; L >>= 2, j <<= 2)
+    {
+        DVP_U32 L4 = L >> 2;
+        for (s = 0; s < n; s += L)
+        {
+            for (b = 0; b < L4; b++)
+            {
+                for (i = 0; i < 4; i++)
+                {
+                    v[2*i + 0] = DVP_Dsp_Load(y, 2*(s + b + i*L4) + 0, q);
+                    v[2*i + 1] = DVP_Dsp_Load(y, 2*(s + b + i*L4) + 1, q);
+                }
+                DVP_Dsp_Radix4(v, inverse, (inverse ? 0 : 2), q);
+                DVP_Dsp_Rotate(&v[2], w, tw, b, 2, inverse, q);
+                DVP_Dsp_Rotate(&v[4], w, tw, b, 1, inverse, q);
+                DVP_Dsp_Rotate(&v[6], w, tw, b, 3, inverse, q);
+                for (i = 0; i < 4; i++)
+                {
+                    DVP_Dsp_Store(y, 2*(s + b + i*L4) + 0, v[2*i + 0], q);
+                    DVP_Dsp_Store(y, 2*(s + b + i*L4) + 1, v[2*i + 1], q);
+                }
+            }
+        }
+        tw += (3 * n) / (2 * j);
+    }
+    for (s = 0; s < n; s += L)
+    {
+        for (i = 0; i < 2*L; i++)
+            v[i] = DVP_Dsp_Load(y, 2*s + i, q);
+        if (L == 4)
+            DVP_Dsp_Radix4(v, inverse, (inverse ? 0 : 2), q);
+        else
+        {
+            DVP_S64 ar = v[0], ai = v[1];
+            DVP_U32 shift = (inverse ? 0 : 1);
+            v[0] = DVP_Dsp_Sat(DVP_Dsp_Shift(ar + v[2], shift), q);
+            v[1] = DVP_Dsp_Sat(DVP_Dsp_Shift(ai + v[3], shift), q);
+            v[2] = DVP_Dsp_Sat(DVP_Dsp_Shift(ar - v[2], shift), q);
+            v[3] = DVP_Dsp_Sat(DVP_Dsp_Shift(ai - v[3], shift), q);
+        }
+        for (i = 0; i < 2*L; i++)
+            DVP_Dsp_Store(y, 2*s + i, v[i], q);
+    }
+    while ((1U << bits) < n)
+        bits++;
+    for (i = 0; i < n; i++)
+    {
+        for (t = 0, r = 0; t < bits; t++)
+            r |= ((i >> t) & 1) << (bits - 1 - t);
+        if (i < r)
+        {
+            DVP_U08 *pi = (DVP_U08 *)y + i * 2 * size;
+            DVP_U08 *pr = (DVP_U08 *)y + r * 2 * size;
+            memcpy(tmp, pi, 2 * size);
+            memcpy(pi, pr, 2 * size);
+            memcpy(pr, tmp, 2 * size);
+        }
+    }
+}
+
+static DVP_U32 DVP_Dsp_Points(DVP_DSPFunc *pF, DVP_U32 size)
+{
+    return (pF->val1 > 0 ? (DVP_U32)pF->val1 : DVP_Dsp_Count(&pF->input0, size) / 2);
+}
+
+DVP_BOOL DVP_Dsp_Check(DVP_DSPFunc *pF, DVP_U32 kernel)
+{
+    DVP_U32 nx = DVP_Dsp_Count(&pF->input0, sizeof(DVP_S16));
+    DVP_U32 nh = DVP_Dsp_Count(&pF->twoway, sizeof(DVP_S16));
+    DVP_U32 nr = DVP_Dsp_Count(&pF->output0, sizeof(DVP_S16));
+    DVP_U32 n;
+
+    switch (kernel)
+    {
+        case DVP_KN_DSP_ADD16:
+            return (nx > 0 && DVP_Dsp_Count(&pF->input1, sizeof(DVP_S16)) >= nx && nr >= nx ? DVP_TRUE : DVP_FALSE);
+        case DVP_KN_DSP_ADD32:
+            n = DVP_Dsp_Count(&pF->input0, sizeof(DVP_S32));
+            return (n > 0 && DVP_Dsp_Count(&pF->input1, sizeof(DVP_S32)) >= n &&
+                    DVP_Dsp_Count(&pF->output0, sizeof(DVP_S32)) >= n ? DVP_TRUE : DVP_FALSE);
+        case DVP_KN_DSP_DOTPROD:
+            return (nx > 0 && DVP_Dsp_Count(&pF->input1, sizeof(DVP_S16)) >= nx ? DVP_TRUE : DVP_FALSE);
+        case DVP_KN_DSP_DOTPRODSQR:
+            return (nx > 0 && DVP_Dsp_Count(&pF->input1, sizeof(DVP_S16)) >= nx &&
+                    DVP_Dsp_Count(&pF->output0, sizeof(DVP_S32)) >= 1 ? DVP_TRUE : DVP_FALSE);
+        case DVP_KN_DSP_VECSUMSQ:
+            return (nx > 0 ? DVP_TRUE : DVP_FALSE);
+        case DVP_KN_DSP_FIR_GEN:
+        case DVP_KN_DSP_FIR_R4:
+        case DVP_KN_DSP_FIR_R8:
+            if ((kernel == DVP_KN_DSP_FIR_R4 && (nh % 4) != 0) ||
+                (kernel == DVP_KN_DSP_FIR_R8 && (nh % 8) != 0))
+                return DVP_FALSE;
+            return (nh > 0 && nr > 0 && nx >= nr + nh - 1 ? DVP_TRUE : DVP_FALSE);
+        case DVP_KN_DSP_FIR_SYM:
+            return (nh > 1 && nr > 0 && nx >= nr + 2*(nh - 1) && pF->val1 >= 0 && pF->val1 < 32 ? DVP_TRUE : DVP_FALSE);
+        case DVP_KN_DSP_IIR:
+            n = DVP_Dsp_Count(&pF->output1, sizeof(DVP_S16));
+            return (n > 0 && nx >= n + 4 && nr >= n + 4 && nh >= 5 &&
+                    DVP_Dsp_Count(&pF->input1, sizeof(DVP_S16)) >= 5 ? DVP_TRUE : DVP_FALSE);
+        case DVP_KN_DSP_IIR_LAT:
+            n = DVP_Dsp_Count(&pF->input1, sizeof(DVP_S16));
+            return (nx > 0 && n > 0 && nr >= nx && DVP_Dsp_Count(&pF->twoway, sizeof(DVP_S32)) >= n + 1 ? DVP_TRUE : DVP_FALSE);
+        case DVP_KN_DSP_FFT_16x16:
+        case DVP_KN_DSP_IFFT_16x16:
+            n = DVP_Dsp_Points(pF, sizeof(DVP_S16));
+            return (isPowerOf(n, 2) && nx >= 2*n && nr >= 2*n && nh >= DVP_Dsp_TwiddleCount(n) ? DVP_TRUE : DVP_FALSE);
+        case DVP_KN_DSP_FFT_32x32:
+        case DVP_KN_DSP_IFFT_32x32:
+            n = DVP_Dsp_Points(pF, sizeof(DVP_S32));
+            return (isPowerOf(n, 2) &&
+                    DVP_Dsp_Count(&pF->input0, sizeof(DVP_S32)) >= 2*n &&
+                    DVP_Dsp_Count(&pF->output0, sizeof(DVP_S32)) >= 2*n &&
+                    DVP_Dsp_Count(&pF->twoway, sizeof(DVP_S32)) >= DVP_Dsp_TwiddleCount(n) ? DVP_TRUE : DVP_FALSE);
+        case DVP_KN_GEN_TWIDDLE_FFT_16X16:
+        case DVP_KN_GEN_TWIDDLE_IFFT_16X16:
+            return (isPowerOf(pF->val1, 2) && nx >= DVP_Dsp_TwiddleCount(pF->val1) ? DVP_TRUE : DVP_FALSE);
+        case DVP_KN_GEN_TWIDDLE_FFT_32x32:
+            return (isPowerOf(pF->val1, 2) &&
+                    DVP_Dsp_Count(&pF->input0, sizeof(DVP_S32)) >= DVP_Dsp_TwiddleCount(pF->val1) ? DVP_TRUE : DVP_FALSE);
+        default:
+            return DVP_FALSE;
+    }
+}
+
+DVP_BOOL DVP_Dsp(DVP_DSPFunc *pF, DVP_U32 kernel)
+{
+    DVP_S16 *x = (DVP_S16 *)pF->input0.pData;
+    DVP_S16 *y = (DVP_S16 *)pF->input1.pData;
+    DVP_S16 *h = (DVP_S16 *)pF->twoway.pData;
+    DVP_S16 *r = (DVP_S16 *)pF->output0.pData;
+    DVP_U32 nx = DVP_Dsp_Count(&pF->input0, sizeof(DVP_S16));
+    DVP_U32 nh = DVP_Dsp_Count(&pF->twoway, sizeof(DVP_S16));
+    DVP_U32 nr = DVP_Dsp_Count(&pF->output0, sizeof(DVP_S16));
+
+    switch (kernel)
+    {
+        case DVP_KN_DSP_ADD16:
+            DVP_Dsp_Add16(x, y, r, nx);
+            break;
+        case DVP_KN_DSP_ADD32:
+            DVP_Dsp_Add32((DVP_S32 *)x, (DVP_S32 *)y, (DVP_S32 *)r, DVP_Dsp_Count(&pF->input0, sizeof(DVP_S32)));
+            break;
+        case DVP_KN_DSP_DOTPROD:
+            pF->val1 = DVP_Dsp_Dot16(x, y, nx);
+            break;
+        case DVP_KN_DSP_DOTPRODSQR:
+            pF->val1 = (DVP_S32)((DVP_U32)pF->val1 + (DVP_U32)DVP_Dsp_Dot16(y, y, nx));
+            *(DVP_S32 *)r = (DVP_S32)((DVP_U32)*(DVP_S32 *)r + (DVP_U32)DVP_Dsp_Dot16(x, y, nx));
+            break;
+        case DVP_KN_DSP_VECSUMSQ:
+            pF->val1 = DVP_Dsp_Dot16(x, x, nx);
+            break;
+        case DVP_KN_DSP_FIR_GEN:
+        case DVP_KN_DSP_FIR_R4:
+        case DVP_KN_DSP_FIR_R8:
+            DVP_Dsp_Fir(x, h, r, nh, nr);
+            break;
+        case DVP_KN_DSP_FIR_SYM:
+            DVP_Dsp_FirSym(x, h, r, nh - 1, nr, pF->val1);
+            break;
+        case DVP_KN_DSP_IIR:
+            DVP_Dsp_Iir(x, y, h, r, (DVP_S16 *)pF->output1.pData, DVP_Dsp_Count(&pF->output1, sizeof(DVP_S16)));
+            break;
+        case DVP_KN_DSP_IIR_LAT:
+            DVP_Dsp_IirLat(x, nx, y, DVP_Dsp_Count(&pF->input1, sizeof(DVP_S16)), (DVP_S32 *)h, r);
+            break;
+        case DVP_KN_DSP_FFT_16x16:
+        case DVP_KN_DSP_IFFT_16x16:
+            DVP_Dsp_Fft(h, DVP_Dsp_Points(pF, sizeof(DVP_S16)), x, r, 15,
+                        (kernel == DVP_KN_DSP_IFFT_16x16 ? DVP_TRUE : DVP_FALSE));
+            break;
+        case DVP_KN_DSP_FFT_32x32:
+        case DVP_KN_DSP_IFFT_32x32:
+            DVP_Dsp_Fft(h, DVP_Dsp_Points(pF, sizeof(DVP_S32)), x, r, 31,
+                        (kernel == DVP_KN_DSP_IFFT_32x32 ? DVP_TRUE : DVP_FALSE));
+            break;
+        case DVP_KN_GEN_TWIDDLE_FFT_16X16:
+        case DVP_KN_GEN_TWIDDLE_IFFT_16X16:
+            pF->val2 = DVP_Dsp_Twiddle(x, pF->val1, 15);
+            break;
+        case DVP_KN_GEN_TWIDDLE_FFT_32x32:
+            pF->val2 = DVP_Dsp_Twiddle(x, pF->val1, 31);
+            break;
+        default:
+            return DVP_FALSE;
+    }
+    return DVP_TRUE;
+}
+
+#endif
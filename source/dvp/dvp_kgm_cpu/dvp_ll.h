@@ -19,6 +19,22 @@
 
 #include <dvp/dvp_types.h>
 
+#if defined(DVP_USE_YUV) || defined(DVP_USE_YUV_C)
+#include <yuv/dvp_kl_yuv.h>
+#endif
+
+#if defined(DVP_USE_LDC)
+#include <vrun/dvp_kl_vrun.h>
+#endif
+
+#if defined(DVP_USE_DEI_C)
+#include <dei/dvp_kl_dei.h>
+#endif
+
+#if defined(DVP_USE_DSPLIB_C)
+#include <dsplib/dvp_kl_dsplib.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -32,6 +48,81 @@ typedef enum _dvp_imgfilter_e {
 
 void DVP_imgFilter(DVP_Image_t *pLuma, DVP_ImageFilter_e type, DVP_Image_t *pO);
 
+/*! \brief Builds the table for a key. The table must be a single block from malloc. */
+typedef void *(*DVP_TableBuild_f)(void *pKey);
+
+/*! \brief Initializes the cache of the tables which kernels precompute when
+ * their nodes are verified.
+ */
+void DVP_Tables_Init(void);
+
+/*! \brief Frees all the cached tables. */
+void DVP_Tables_Deinit(void);
+
+/*! \brief Returns the table of a kernel for a key, building it on a miss. The
+ * least recently used idle table is evicted when the cache is full.
+ * \param [in] kernel The kernel which owns the table.
+ * \param [in] pKey The parameters the table depends on, compared bytewise (zero any padding).
+ * \param [in] keyLen The size of the key in bytes.
+ * \param [in] build The function which makes the table on a miss.
+ * \return Returns NULL if the table could not be built.
+ * \post \ref DVP_Tables_Release
+ */
+void *DVP_Tables_Acquire(DVP_U32 kernel, void *pKey, DVP_U32 keyLen, DVP_TableBuild_f build);
+
+/*! \brief Releases a table returned by \ref DVP_Tables_Acquire. */
+void DVP_Tables_Release(void *pTable);
+
+/*! \brief Releases the table and scratch memory a node kept since it was
+ * verified. Nodes which kept nothing are ignored.
+ */
+void DVP_Tables_Detach(DVP_KernelNode_t *pNode);
+
+#if defined(DVP_USE_YUV) || defined(DVP_USE_YUV_C)
+/*! \brief Precomputes the coefficients of a scale node and keeps them, with
+ * its temporary line, in the node until \ref DVP_Tables_Detach.
+ */
+DVP_BOOL DVP_Scale_Prepare(DVP_KernelNode_t *pNode);
+
+/*! \brief Executes a scale node with what \ref DVP_Scale_Prepare kept. */
+DVP_BOOL DVP_Scale(DVP_KernelNode_t *pNode);
+#endif
+
+#if defined(DVP_USE_LDC)
+/*! \brief Expands a lens distortion correction node (any of the DVP_KN_LDC_*
+ * kernels) into a remap table and keeps it in the node until \ref DVP_Tables_Detach.
+ */
+DVP_BOOL DVP_Ldc_Prepare(DVP_KernelNode_t *pNode);
+
+/*! \brief Executes a lens distortion correction node with the table kept by \ref DVP_Ldc_Prepare. */
+DVP_BOOL DVP_Ldc(DVP_KernelNode_t *pNode);
+#endif
+
+#if defined(DVP_USE_DEI_C)
+/*! \brief Clears the field history of a deinterlacer instance. */
+void DVP_Deinterlacer_Init(DVP_Deinterlacer_t *pD);
+
+/*! \brief Releases a deinterlacer instance. */
+void DVP_Deinterlacer_Deinit(DVP_Deinterlacer_t *pD);
+
+/*! \brief Rebuilds the missing field of the current frame, initializing the instance first if needed. */
+DVP_BOOL DVP_Deinterlace(DVP_Deinterlacer_t *pD);
+#endif
+
+#if defined(DVP_USE_DSPLIB_C)
+/*! \brief Returns the number of twiddle values an FFT of n points uses. */
+DVP_U32 DVP_Dsp_TwiddleCount(DVP_U32 n);
+
+/*! \brief Checks that the buffers of a DSPLIB node are large enough for its kernel.
+ * \param [in] pF The configuration.
+ * \param [in] kernel One of the DVP_KN_DSP_* or DVP_KN_GEN_TWIDDLE_* kernels.
+ */
+DVP_BOOL DVP_Dsp_Check(DVP_DSPFunc *pF, DVP_U32 kernel);
+
+/*! \brief Executes a DSPLIB kernel which was checked by \ref DVP_Dsp_Check. */
+DVP_BOOL DVP_Dsp(DVP_DSPFunc *pF, DVP_U32 kernel);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -275,6 +275,11 @@ void DVP_KernelGraphBossDeinit(DVP_t *dvp)
     {
         DVP_U32 i = 0;
 
+        // the pooled memory is still associated with the remote cores
+        dvp_mem_pool_deinit((DVP_Handle)dvp, &dvp->pool);
+        dvp_mem_pin_deinit((DVP_Handle)dvp, &dvp->pins);
+        dvp_mem_cache_deinit((DVP_Handle)dvp, &dvp->cacheops);
+
         for (i = 0; i < dvp->numMgrs; i++)
         {
             if (dvp->managers[i].enabled == true_e)
@@ -315,7 +320,6 @@ void DVP_KernelGraphBossDeinit(DVP_t *dvp)
                 DVP_PRINT(DVP_ZONE_KGB, "Zeroing DVP Load Table.\n");
 
                 dvp->loads->initialized = false_e;
-                semaphore_delete(&dvp->loads->sem);
                 memset(dvp->loads->cores, 0, sizeof(DVP_Core_Load_t) * DVP_CORE_MAX);
             }
         }
@@ -346,8 +350,8 @@ DVP_t *DVP_KernelGraphBossInit(DVP_U32 mask)
             dvp->loads = dvp->shared_memory->data;
             if (dvp->loads->initialized == false_e)
             {
+                // a zeroed table is ready to use, the cores are updated atomically
                 DVP_PRINT(DVP_ZONE_KGB, "Initialized DVP Load Table\n");
-                semaphore_create(&dvp->loads->sem, 1, true_e); // only 1 process can access at a time
                 dvp->loads->initialized = true_e;
             }
             else
@@ -381,7 +385,6 @@ DVP_t *DVP_KernelGraphBossInit(DVP_U32 mask)
             if (dvp->shared_memory)
             {
                 dvp->loads = (DVP_Load_t *)dvp->shared_memory;
-                semaphore_create(&dvp->loads->sem, 1, false_e);
                 dvp->loads->initialized = true_e;
             }
 #else
@@ -451,6 +454,9 @@ DVP_t *DVP_KernelGraphBossInit(DVP_U32 mask)
     if ((mask & DVP_KGB_INIT_MEM_MGR) && dvp)
     {
         dvp->mem = dvp_mem_init();
+        dvp->pool = dvp_mem_pool_init();
+        dvp->pins = dvp_mem_pin_init();
+        dvp->cacheops = dvp_mem_cache_init();
         if (dvp->mem == NULL) {
             if ((mask & DVP_KGB_INIT_KGMS))
                 errors+=dvp->numMgrs; // force an error condition
@@ -484,26 +490,36 @@ DVP_BOOL DVP_CommitLoad(DVP_t *dvp, DVP_KernelGraphSection_t *section)
     {
         DVP_BOOL ret = DVP_TRUE;
 #ifdef DVP_USE_LOAD_TABLE
-        DVP_Core_e c;
-        DVP_PRINT(DVP_ZONE_LOAD, "LOAD: Grabbing Shared Memory Semaphore for section %p!\n",section);
-        semaphore_wait(&dvp->loads->sem);
-        // accumulate each coreLoad in the section into
-        // the load's currentLoad as long as it's below the maximumLoad.
+        DVP_S32 c;
+        DVP_PRINT(DVP_ZONE_LOAD, "LOAD: Committing the loads of section %p!\n",section);
+        // each core is claimed on its own, so sections on other cores and in
+        // other processes never wait on this one.
         for (c = DVP_CORE_MIN + 1; c < DVP_CORE_MAX; c++)
         {
-            dvp->loads->cores[c].currentLoad += section->coreLoad[c];
-            DVP_PRINT(DVP_ZONE_LOAD, "LOAD: Attempting to commit core %u load %4u\n", c, section->coreLoad[c]);
-            if (dvp->loads->cores[c].currentLoad > dvp->loads->cores[c].maximumLoad)
+            DVP_Core_Load_t *core = &dvp->loads->cores[c];
+            DVP_S32 load = section->coreLoad[c];
+            DVP_S32 current;
+            if (load == 0)
+                continue;
+            do {
+                current = core->currentLoad;
+                DVP_PRINT(DVP_ZONE_LOAD, "LOAD: Attempting to commit core %u load %4u\n", c, load);
+                if (current + load > core->maximumLoad)
+                {
+                    DVP_PRINT(DVP_ZONE_ERROR, "ERROR: Could not commit core load of %d as it exceeds maximum value of %d!\n", load, core->maximumLoad);
+                    ret = DVP_FALSE;
+                    break;
+                }
+            } while (!__sync_bool_compare_and_swap(&core->currentLoad, current, current + load));
+            if (ret == DVP_FALSE)
             {
-                DVP_PRINT(DVP_ZONE_ERROR, "ERROR: Could not commit core load of %d as it exceeds maximum value of %d!\n", section->coreLoad[c], dvp->loads->cores[c].maximumLoad);
-                // unwind the loads
-                for (/*c=c*/; c > DVP_CORE_MIN; c--)
-                    dvp->loads->cores[c].currentLoad -= section->coreLoad[c];
-                ret = DVP_FALSE;
+                // unwind the cores which were claimed
+                for (c = c - 1; c > DVP_CORE_MIN; c--)
+                    if (section->coreLoad[c] != 0)
+                        __sync_fetch_and_sub(&dvp->loads->cores[c].currentLoad, section->coreLoad[c]);
                 break;
             }
         }
-        semaphore_post(&dvp->loads->sem);
 #endif
 
         return ret;
@@ -517,12 +533,11 @@ void DVP_DecommitLoad(DVP_t *dvp, DVP_KernelGraphSection_t *section)
     else
     {
 #ifdef DVP_USE_LOAD_TABLE
-        DVP_Core_e c;
-        semaphore_wait(&dvp->loads->sem);
+        DVP_S32 c;
         // remove the section's load from the cores
         for (c = DVP_CORE_MIN + 1; c < DVP_CORE_MAX; c++)
-            dvp->loads->cores[c].currentLoad -= section->coreLoad[c];
-        semaphore_post(&dvp->loads->sem);
+            if (section->coreLoad[c] != 0)
+                __sync_fetch_and_sub(&dvp->loads->cores[c].currentLoad, section->coreLoad[c]);
 #endif
     }
 }
@@ -685,10 +700,17 @@ DVP_U32 DVP_KernelGraphBoss_Process(DVP_t *dvp, DVP_KernelGraphSection_t *sectio
     DVP_KernelNode_t *pNodes = section->pNodes;
     DVP_U32 numNodes = section->numNodes;
     DVP_Perf_t *perf = &(section->perf);
+    rtime_t start;
 
     DVP_PRINT(DVP_ZONE_KGB, "Executing Section %p with %u nodes (%s)\n", section, section->numNodes, (sync?"SYNC":"QUEUED"));
 
-    DVP_PerformanceStart(perf);
+    trace_begin("dvp", "section", numNodes);
+    // the start is kept by this thread, the sections run in parallel sit next to each other
+    // in the graph and should not trade cache lines while they run.
+    start = rtimer_now();
+
+    // the client may have written any of the memory since the last section
+    dvp_mem_cache_reset((DVP_Handle)dvp);
 
     // we're going to try this over and over until we can execute with no faults in configuration.
     do {
@@ -700,6 +722,7 @@ DVP_U32 DVP_KernelGraphBoss_Process(DVP_t *dvp, DVP_KernelGraphSection_t *sectio
                 DVP_U32 targetMgrIndex = pNodes[n].header.mgrIndex;
                 DVP_U32 subgraphNumNodes = 1; // at least one node is on this core...
                 DVP_U32 numNodesProcessed = 0;
+                DVP_BOOL local = (dvp->managers[targetMgrIndex].calls.getCore() == DVP_CORE_CPU ? DVP_TRUE : DVP_FALSE);
 #ifdef DVP_OPTIMIZED_GRAPHS
                 DVP_U32 i;
                 // determine how many nodes forward of the current node are on the same core...
@@ -712,7 +735,17 @@ DVP_U32 DVP_KernelGraphBoss_Process(DVP_t *dvp, DVP_KernelGraphSection_t *sectio
                 }
 #endif
                 DVP_PRINT(DVP_ZONE_KGB, "KGB: Executing %u nodes on %s core\n", subgraphNumNodes, dvp->managers[pNodes[n].header.mgrIndex].name);
-                numNodesProcessed = dvp->managers[pNodes[n].header.mgrIndex].calls.manager(pNodes,n,subgraphNumNodes, sync);
+                // the CPU must see what the remote cores wrote before it runs
+                if (local)
+                    dvp_mem_cache_commit((DVP_Handle)dvp, DVP_TRUE);
+                trace_begin("dvp", dvp->managers[targetMgrIndex].name, subgraphNumNodes);
+                if (section->numaNode != DVP_NUMA_NODE_ANY && dvp->managers[targetMgrIndex].calls.placed)
+                    numNodesProcessed = dvp->managers[targetMgrIndex].calls.placed(pNodes,n,subgraphNumNodes, sync, section->numaNode);
+                else
+                    numNodesProcessed = dvp->managers[targetMgrIndex].calls.manager(pNodes,n,subgraphNumNodes, sync);
+                trace_end("dvp", dvp->managers[targetMgrIndex].name, numNodesProcessed);
+                if (local)
+                    dvp_mem_cache_reset((DVP_Handle)dvp);
                 // increment the processed by the number literally processed (regardless of errors)
                 processed += numNodesProcessed;
                 DVP_PRINT(DVP_ZONE_KGB, "KGB: Executed %u nodes on %s core (%u total processed)\n", numNodesProcessed, dvp->managers[pNodes[n].header.mgrIndex].name, processed);
@@ -723,6 +756,8 @@ DVP_U32 DVP_KernelGraphBoss_Process(DVP_t *dvp, DVP_KernelGraphSection_t *sectio
                     break; // something went wrong in the graph
 #endif
             }
+            // the client will read the outputs once the section completes
+            dvp_mem_cache_commit((DVP_Handle)dvp, DVP_TRUE);
             DVP_DecommitLoad(dvp, section);
             // success!
             break;
@@ -741,19 +776,20 @@ DVP_U32 DVP_KernelGraphBoss_Process(DVP_t *dvp, DVP_KernelGraphSection_t *sectio
         DVP_PRINT(DVP_ZONE_ERROR, "ERROR! There are unhandled nodes in the graph. Processing can not continue!\n");
     }
 
+    // the section's performance is written once it is done
+    perf->tmpTime = start;
     DVP_PerformanceStop(perf);
+    trace_end("dvp", "section", processed);
 
     DVP_PRINT(DVP_ZONE_KGB, "KGB: Processed %u nodes!\n", processed);
 
 #if defined(GRE_DEBUG) && (DVP_ZONE_LOAD != 0)
     {
         DVP_Core_e c;
-        //semaphore_wait(&dvp->loads->sem);
         for (c = DVP_CORE_MIN + 1; c < DVP_CORE_MAX; c++)
         {
             DVP_PRINT(DVP_ZONE_LOAD, "Core[%u] Current Load=%4u Maximum Load=%4u\n", c, dvp->loads->cores[c].currentLoad, dvp->loads->cores[c].maximumLoad);
         }
-        //semaphore_post(&dvp->loads->sem);
     }
 #endif
 
@@ -773,9 +809,9 @@ void DVP_SetMaxLoad(DVP_t *dvp, DVP_Core_e core, DVP_U32 load)
 #if defined(DVP_USE_LOAD_TABLE)
                 if (dvp->loads->initialized)
                 {
-                    semaphore_wait(&dvp->loads->sem);
+                    // commits compare against whichever value they read
                     dvp->loads->cores[core].maximumLoad = load;
-                    semaphore_post(&dvp->loads->sem);
+                    __sync_synchronize();
                 }
                 else
                 {
@@ -801,11 +837,7 @@ DVP_U32 DVP_GetMaxLoad(DVP_t *dvp, DVP_Core_e core, DVP_U32 *pCoreMax)
                 *pCoreMax = dvp->managers[m].calls.getLoad();
 #if defined(DVP_USE_LOAD_TABLE)
                 if (dvp->loads->initialized)
-                {
-                    semaphore_wait(&dvp->loads->sem);
                     load = dvp->loads->cores[core].maximumLoad;
-                    semaphore_post(&dvp->loads->sem);
-                }
 #endif
                 DVP_PRINT(DVP_ZONE_LOAD, "DVP: Core[%u] has table max load of %u and HW max load of %u\n", core, load, *pCoreMax);
             }
@@ -104,7 +104,9 @@ static void dvp_graphlock_init(DVP_GraphLock_t *gl)
 
 static DVP_BOOL dvp_graph_lock(DVP_GraphLock_t *gl)
 {
+    trace_begin("dvp", "graph lock", 0);
     mutex_lock(&gl->m_lock);
+    trace_end("dvp", "graph lock", 0);
     if (gl->m_enabled)
     {
         gl->m_count++;
@@ -142,6 +144,201 @@ static void dvp_graphlock_deinit(DVP_GraphLock_t *gl)
     mutex_deinit(&gl->m_lock);
 }
 
+#define DVP_ALIAS_NONE  (0xFFFFFFFF)
+
+typedef struct _dvp_alias_t {
+    DVP_Image_t image;      /*!< The image as the first node which uses it holds it */
+    DVP_U32     first;      /*!< The first step which uses the image */
+    DVP_U32     last;       /*!< The last step which uses the image */
+    DVP_U32     written;    /*!< The first step which writes the image */
+    DVP_U32     read;       /*!< The first step which reads the image */
+    DVP_U32     owner;      /*!< One more than the index of the image whose memory this one uses */
+    DVP_U32     end;        /*!< The last step which uses the memory this image owns */
+} DVP_Alias_t;
+
+// asks the managers which images of the node are inputs and which are outputs
+static DVP_BOOL dvp_alias_images(DVP_t *dvp, DVP_KernelNode_t *pNode, DVP_Image_t *pImages[DVP_KNODE_MAX_IMAGES], DVP_BOOL outputs[DVP_KNODE_MAX_IMAGES], DVP_U32 *pNumImages)
+{
+    DVP_U32 m;
+    for (m = 0; m < dvp->numMgrs; m++)
+    {
+        if (dvp->managers[m].enabled == true_e && dvp->managers[m].calls.images &&
+            dvp->managers[m].calls.images(pNode, pImages, outputs, pNumImages) == DVP_TRUE)
+            return DVP_TRUE;
+    }
+    return DVP_FALSE;
+}
+
+static DVP_BOOL dvp_alias_fits(DVP_Image_t *pImage, DVP_Image_t *pOwner)
+{
+    DVP_U32 p;
+    if (pImage->memType != pOwner->memType || pImage->planes != pOwner->planes)
+        return DVP_FALSE;
+    for (p = 0; p < pImage->planes; p++)
+        if (DVP_Image_PlaneRange(pImage, p) > DVP_Image_PlaneRange(pOwner, p))
+            return DVP_FALSE;
+    return DVP_TRUE;
+}
+
+// records the lifetime of each image, or rebinds the nodes' images to their owners' memory
+static DVP_BOOL dvp_alias_node(DVP_t *dvp, DVP_KernelNode_t *pNode, DVP_U32 step, DVP_Alias_t *aliases, DVP_U32 *pNumAliases, DVP_BOOL rebind)
+{
+    DVP_Image_t *pImages[DVP_KNODE_MAX_IMAGES];
+    DVP_BOOL outputs[DVP_KNODE_MAX_IMAGES];
+    DVP_U32 numImages = 0, i, j, p;
+
+    if (dvp_alias_images(dvp, pNode, pImages, outputs, &numImages) == DVP_FALSE)
+        return DVP_FALSE;
+
+    for (i = 0; i < numImages; i++)
+    {
+        DVP_Image_t *pImage = pImages[i];
+        DVP_Alias_t *a = NULL;
+        if (pImage->pBuffer[0] == NULL)
+            continue;
+        // copies of the same image share their buffers
+        for (j = 0; j < *pNumAliases; j++)
+            if (aliases[j].image.pBuffer[0] == pImage->pBuffer[0])
+                break;
+        if (rebind == DVP_TRUE)
+        {
+            DVP_Image_t *pOwner;
+            if (j == *pNumAliases || aliases[j].owner == 0 || aliases[j].owner == j + 1)
+                continue;
+            // keep the patch of the image within its new memory
+            pOwner = &aliases[aliases[j].owner - 1].image;
+            for (p = 0; p < pImage->planes; p++)
+            {
+                pImage->pData[p] = pOwner->pBuffer[p] + (pImage->pData[p] - pImage->pBuffer[p]);
+                pImage->pBuffer[p] = pOwner->pBuffer[p];
+            }
+            continue;
+        }
+        a = &aliases[j];
+        if (j == *pNumAliases)
+        {
+            memset(a, 0, sizeof(DVP_Alias_t));
+            a->image = *pImage;
+            a->first = step;
+            a->written = DVP_ALIAS_NONE;
+            a->read = DVP_ALIAS_NONE;
+            (*pNumAliases)++;
+        }
+        a->last = step;
+        if (outputs[i] == DVP_TRUE && a->written == DVP_ALIAS_NONE)
+            a->written = step;
+        if (outputs[i] == DVP_FALSE && a->read == DVP_ALIAS_NONE)
+            a->read = step;
+    }
+    return DVP_TRUE;
+}
+
+// walks the nodes in the order the graph processes them
+static DVP_BOOL dvp_alias_walk(DVP_t *dvp, DVP_KernelGraph_t *pGraph, DVP_Alias_t *aliases, DVP_U32 *pNumAliases, DVP_BOOL rebind)
+{
+    DVP_U32 s, n, o, maxOrder = 0, step = 0;
+
+    for (s = 0; s < pGraph->numSections; s++)
+        if (pGraph->order[s] > maxOrder)
+            maxOrder = pGraph->order[s];
+
+    for (o = 0; o <= maxOrder; o++)
+    {
+        DVP_U32 count = 0, width = 1;
+        for (s = 0; s < pGraph->numSections; s++)
+            if (pGraph->order[s] == o)
+                count++;
+        if (count == 0)
+            continue;
+        for (s = 0; s < pGraph->numSections; s++)
+        {
+            DVP_KernelGraphSection_t *pSection = &pGraph->sections[s];
+            if (pGraph->order[s] != o)
+                continue;
+            // nodes of a lone section run in sequence, parallel sections share one step
+            for (n = 0; n < pSection->numNodes; n++)
+                if (dvp_alias_node(dvp, &pSection->pNodes[n], (count == 1 ? step + n : step), aliases, pNumAliases, rebind) == DVP_FALSE)
+                    return DVP_FALSE;
+            if (count == 1 && pSection->numNodes > 0)
+                width = pSection->numNodes;
+        }
+        step += width;
+    }
+    return DVP_TRUE;
+}
+
+// lets intermediate images whose lifetimes do not overlap share the memory of one of them
+static void dvp_alias_intermediates(DVP_t *dvp, DVP_KernelGraph_t *pGraph)
+{
+    DVP_Alias_t *aliases = NULL;
+    DVP_U32 s, i, j, numNodes = 0, numAliases = 0, numShared = 0, bytes = 0;
+
+    for (s = 0; s < pGraph->numSections; s++)
+        numNodes += pGraph->sections[s].numNodes;
+    if (numNodes == 0 || pGraph->order == NULL)
+        return;
+
+    aliases = (DVP_Alias_t *)calloc(numNodes * DVP_KNODE_MAX_IMAGES, sizeof(DVP_Alias_t));
+    if (aliases == NULL)
+        return;
+
+    // a kernel the managers can not describe may use any image at any time
+    if (dvp_alias_walk(dvp, pGraph, aliases, &numAliases, DVP_FALSE) == DVP_FALSE)
+    {
+        DVP_PRINT(DVP_ZONE_KGAPI, "Graph %p has undescribed kernels, its images will not be aliased\n", pGraph);
+        free(aliases);
+        return;
+    }
+
+    // intermediates are written by the graph before it reads them, take them by their first use
+    for (;;)
+    {
+        DVP_Alias_t *a = NULL;
+        DVP_U32 best = numAliases;
+        for (i = 0; i < numAliases; i++)
+        {
+            if (aliases[i].owner != 0 ||
+                aliases[i].written == DVP_ALIAS_NONE ||
+                aliases[i].read == DVP_ALIAS_NONE ||
+                aliases[i].written >= aliases[i].read ||
+                aliases[i].image.planes == 0 ||
+                aliases[i].image.planes > DVP_MAX_PLANES ||
+                dvp_mem_type_virtual(aliases[i].image.memType) == DVP_FALSE)
+                continue;
+            if (a == NULL || aliases[i].first < a->first)
+                a = &aliases[i];
+        }
+        if (a == NULL)
+            break;
+        // reuse the smallest memory which is dead by now and holds the image
+        for (j = 0; j < numAliases; j++)
+        {
+            if (aliases[j].owner != j + 1 || aliases[j].end >= a->first ||
+                dvp_alias_fits(&a->image, &aliases[j].image) == DVP_FALSE)
+                continue;
+            if (best == numAliases || aliases[j].image.numBytes < aliases[best].image.numBytes)
+                best = j;
+        }
+        if (best == numAliases)
+        {
+            best = (DVP_U32)(a - aliases);
+        }
+        else
+        {
+            bytes += a->image.numBytes;
+            numShared++;
+        }
+        a->owner = best + 1;
+        aliases[best].end = a->last;
+    }
+
+    DVP_PRINT(DVP_ZONE_KGAPI, "Graph %p shares the memory of %u intermediate images, %u bytes\n", pGraph, numShared, bytes);
+
+    if (numShared > 0)
+        dvp_alias_walk(dvp, pGraph, aliases, &numAliases, DVP_TRUE);
+    free(aliases);
+}
+
 //******************************************************************************
 // GLOBAL FUNCTIONS
 //******************************************************************************
@@ -152,6 +349,8 @@ DVP_Handle DVP_KernelGraph_Init()
     semaphore_create(&workData.sem, 1, false_e);
     workData.count = 0;
     memset(collectors, 0, sizeof(DVP_KernelGraphCollector_t) * MAX_SECTIONS);
+    if (getenv(DVP_TRACE_ENV))
+        trace_enable(true_e);
     pool = threadpool_create(MAX_SECTIONS, MAX_QUEUE_DEPTH, sizeof(DVP_KernelGraphCollector_t), dvp_kernelgraph_worker, &workData);
     dvp = DVP_KernelGraphBossInit(DVP_KGB_INIT_ALL);
     if (dvp)
@@ -177,6 +376,13 @@ void DVP_KernelGraph_Deinit(DVP_Handle handle)
         threadpool_destroy(pool);
         semaphore_delete(&workData.sem);
         dvp_graphlock_deinit(&dvp->graphLock);
+        if (getenv(DVP_TRACE_ENV))
+        {
+            trace_enable(false_e);
+            trace_export_file(getenv(DVP_TRACE_ENV));
+        }
+        // the kernel names belong to the managers which are about to be unloaded
+        trace_reset();
         DVP_KernelGraphBossDeinit(dvp);
     }
 }
@@ -203,6 +409,11 @@ DVP_BOOL DVP_KernelGraph_Verify(DVP_Handle handle, DVP_KernelGraph_t *pGraph)
             DVP_U32 s = 0;
             DVP_U32 numNodesVerified = 0;
             DVP_U32 numNodes = 0;
+
+            // the nodes are verified with the memory their images end up in
+            if (pGraph->aliasImages == DVP_TRUE)
+                dvp_alias_intermediates(dvp, pGraph);
+
             for (s = 0; s < pGraph->numSections; s++)
             {
                 numNodes += pGraph->sections[s].numNodes;
@@ -249,6 +460,7 @@ DVP_U32 DVP_KernelGraph_Process(DVP_Handle handle, DVP_KernelGraph_t *pGraph, vo
         dvp_graph_lock(&dvp->graphLock);
     }
 
+    trace_begin("dvp", "graph", pGraph->numSections);
     DVP_PerformanceStart(&(pGraph->totalperf));
 
     for (order = 0; /* no order limit */; order++)
@@ -269,6 +481,7 @@ DVP_U32 DVP_KernelGraph_Process(DVP_Handle handle, DVP_KernelGraph_t *pGraph, vo
             else if (numOrder >= MAX_SECTIONS)
             {
                 DVP_PRINT(DVP_ZONE_ERROR, "Can't run more than %u graphs in parallel at any given time\n", MAX_SECTIONS);
+                trace_end("dvp", "graph", numSectionsRun);
                 return numSectionsRun;
             }
             else if (pGraph->sections[section].skipSection == DVP_TRUE)
@@ -283,6 +496,7 @@ DVP_U32 DVP_KernelGraph_Process(DVP_Handle handle, DVP_KernelGraph_t *pGraph, vo
         {
             DVP_U32 s,g = 0;
             void *workitems[dimof(collectors)];
+            threadpool_group_t group;
 
             for (g = 0; g < numOrder; g++)
             {
@@ -295,14 +509,18 @@ DVP_U32 DVP_KernelGraph_Process(DVP_Handle handle, DVP_KernelGraph_t *pGraph, vo
                 collectors[g].cookie = cookie;
                 collectors[g].callback = callback;
                 workitems[g] = &collectors[g];
+                trace_instant("dvp", "section dispatch", collectors[g].index);
             }
 
-            if (threadpool_issue(pool, workitems, numOrder) == true_e)
+            // wait only for these sections, other graphs may share the pool
+            threadpool_group_init(&group);
+            if (threadpool_issue_group(pool, &group, workitems, numOrder) == true_e)
             {
                 DVP_PRINT(DVP_ZONE_KGAPI, "DVP_KernelGraphs issued %u sections to execute in parallel\n", numOrder);
             }
 
-            if (threadpool_complete(pool, true_e) == true_e)
+            trace_begin("dvp", "wait sections", numOrder);
+            if (threadpool_group_complete(&group, true_e) == true_e)
             {
                 DVP_PRINT(DVP_ZONE_KGAPI, "DVP_KernelGraphs completed %u sections\n", numOrder);
                 numSectionsRun += g;
@@ -311,6 +529,8 @@ DVP_U32 DVP_KernelGraph_Process(DVP_Handle handle, DVP_KernelGraph_t *pGraph, vo
             {
                 DVP_PRINT(DVP_ZONE_ERROR, "ERROR: FAILED TO WAIT FOR SECTIONS TO COMPLETE!\n");
             }
+            trace_end("dvp", "wait sections", numOrder);
+            threadpool_group_deinit(&group);
         }
         else if (numOrder == 1) // special optimized case
         {
@@ -336,6 +556,7 @@ DVP_U32 DVP_KernelGraph_Process(DVP_Handle handle, DVP_KernelGraph_t *pGraph, vo
             break; // if no graphs of this order, then exit.
     }
     DVP_PerformanceStop(&(pGraph->totalperf));
+    trace_end("dvp", "graph", numSectionsRun);
     dvp_graph_unlock(&dvp->graphLock);
     return numSectionsRun;
 }
@@ -369,11 +590,171 @@ void DVP_SetCoreCapacity(DVP_Handle handle, DVP_Core_e core, DVP_U32 limit)
     }
 }
 
+/*! \brief The most histograms which can be attached at once (a power of two). */
+#define DVP_PERF_HISTS_MAX  (1024)
+
+/*! \brief Marks a slot whose histogram was freed, so that lookups probe past it. */
+#define DVP_PERF_HIST_FREED ((DVP_Perf_t *)1)
+
+/*! \brief A latency histogram and the performance structure it belongs to.
+ * The histograms are kept here rather than in the DVP_Perf_t, which is
+ * embedded in the node headers shared with the remote cores.
+ */
+typedef struct _dvp_perf_hist_t {
+    DVP_Perf_t      *perf;
+    histogram_hdr_t *hist;
+} DVP_PerfHist_t;
+
+// an open addressed table, written under the lock and read without it
+static DVP_PerfHist_t perfHists[DVP_PERF_HISTS_MAX];
+static volatile DVP_U32 perfHistsCount;
+static volatile DVP_U32 perfHistsLock;
+
+static DVP_U32 DVP_Perf_Slot(DVP_Perf_t *perf)
+{
+    DVP_U64 key = (DVP_U64)(size_t)perf * 0x9E3779B97F4A7C15ULL;
+    return (DVP_U32)(key >> 32) & (DVP_PERF_HISTS_MAX - 1);
+}
+
+static DVP_Perf_t *DVP_Perf_SlotPerf(DVP_PerfHist_t *entry)
+{
+#if defined(__ATOMIC_ACQUIRE)
+    return __atomic_load_n(&entry->perf, __ATOMIC_ACQUIRE);
+#else
+    DVP_Perf_t *perf = *(DVP_Perf_t * volatile *)&entry->perf;
+    __sync_synchronize();
+    return perf;
+#endif
+}
+
+/*! \brief Returns the histogram attached to a performance structure. This is
+ * only a load while no histograms are attached at all.
+ */
+static histogram_hdr_t *DVP_Perf_Find(DVP_Perf_t *perf)
+{
+    DVP_U32 i, slot;
+    if (perfHistsCount == 0)
+        return NULL;
+    slot = DVP_Perf_Slot(perf);
+    for (i = 0; i < DVP_PERF_HISTS_MAX; i++)
+    {
+        DVP_PerfHist_t *entry = &perfHists[(slot + i) & (DVP_PERF_HISTS_MAX - 1)];
+        DVP_Perf_t *p = DVP_Perf_SlotPerf(entry);
+        if (p == perf)
+            return entry->hist;
+        if (p == NULL)
+            break;
+    }
+    return NULL;
+}
+
 void DVP_Perf_Clear(DVP_Perf_t *perf)
 {
+    histogram_hdr_t *hist = DVP_Perf_Find(perf);
     memset(perf, 0, sizeof(DVP_Perf_t));
     perf->rate = rtimer_freq();
     perf->minTime = MAX_RTIMER_T;
+    if (hist)
+        histogram_hdr_init(hist);
+}
+
+DVP_BOOL DVP_Perf_Histogram(DVP_Perf_t *perf, DVP_BOOL enable)
+{
+    DVP_BOOL ret = DVP_TRUE;
+    DVP_U32 i, slot;
+    DVP_PerfHist_t *entry = NULL;
+    histogram_hdr_t *hist = NULL;
+
+    if (perf == NULL)
+        return DVP_FALSE;
+    if (enable == DVP_TRUE)
+    {
+        hist = (histogram_hdr_t *)malloc(sizeof(histogram_hdr_t));
+        if (hist == NULL)
+            return DVP_FALSE;
+        histogram_hdr_init(hist);
+    }
+
+    while (__sync_lock_test_and_set(&perfHistsLock, 1))
+        thread_msleep(0); // attaching is rare, the lock is only held briefly
+    slot = DVP_Perf_Slot(perf);
+    for (i = 0; i < DVP_PERF_HISTS_MAX; i++)
+    {
+        DVP_PerfHist_t *e = &perfHists[(slot + i) & (DVP_PERF_HISTS_MAX - 1)];
+        if (e->perf == perf)
+        {
+            entry = e;
+            break;
+        }
+        if (entry == NULL && (e->perf == NULL || e->perf == DVP_PERF_HIST_FREED))
+            entry = e; // the first slot it could go in, unless it is attached further on
+        if (e->perf == NULL)
+            break;
+    }
+    if (enable == DVP_TRUE)
+    {
+        if (entry == NULL)
+            ret = DVP_FALSE; // full
+        else if (entry->perf != perf)
+        {
+            // the histogram must be visible before the slot is
+            entry->hist = hist;
+            __sync_synchronize();
+            entry->perf = perf;
+            perfHistsCount++;
+            hist = NULL;
+        }
+    }
+    else if (entry && entry->perf == perf)
+    {
+        hist = entry->hist;
+        entry->perf = DVP_PERF_HIST_FREED;
+        entry->hist = NULL;
+        if (--perfHistsCount == 0)
+            memset(perfHists, 0, sizeof(perfHists)); // clear the freed marks
+    }
+    __sync_lock_release(&perfHistsLock);
+    free(hist); // the one which was not needed, or the one which was detached
+    return ret;
+}
+
+DVP_U64 DVP_Perf_Percentile(DVP_Perf_t *perf, double percent)
+{
+    histogram_hdr_t *hist = (perf ? DVP_Perf_Find(perf) : NULL);
+    if (hist == NULL)
+        return 0;
+    return (DVP_U64)rtimer_from_rate_to_us(histogram_hdr_percentile(hist, percent), perf->rate);
+}
+
+DVP_U64 DVP_Perf_Samples(DVP_Perf_t *perf)
+{
+    histogram_hdr_t *hist = (perf ? DVP_Perf_Find(perf) : NULL);
+    if (hist == NULL)
+        return 0;
+    return histogram_hdr_count(hist);
+}
+
+DVP_BOOL DVP_PerformanceHistograms(DVP_Handle handle __attribute__ ((unused)), DVP_KernelGraph_t *pGraph, DVP_BOOL enable)
+{
+    DVP_BOOL ret = DVP_TRUE;
+    DVP_U32 s, n;
+
+    if (pGraph == NULL)
+        return DVP_FALSE;
+    if (DVP_Perf_Histogram(&pGraph->totalperf, enable) == DVP_FALSE)
+        ret = DVP_FALSE;
+    for (s = 0; s < pGraph->numSections; s++)
+    {
+        DVP_KernelGraphSection_t *section = &pGraph->sections[s];
+        if (DVP_Perf_Histogram(&section->perf, enable) == DVP_FALSE)
+            ret = DVP_FALSE;
+        for (n = 0; n < section->numNodes; n++)
+        {
+            if (DVP_Perf_Histogram(&section->pNodes[n].header.perf, enable) == DVP_FALSE)
+                ret = DVP_FALSE;
+        }
+    }
+    return ret;
 }
 
 void DVP_PerformanceClear(DVP_Handle handle __attribute__ ((unused)), DVP_KernelNode_t *pNodes, DVP_U32 numNodes)
@@ -396,6 +777,7 @@ void DVP_PerformanceStop(DVP_Perf_t *pPerf)
     if (pPerf)
     {
         rtime_t now = rtimer_now();
+        histogram_hdr_t *hist = NULL;
         pPerf->tmpTime = (now - pPerf->tmpTime);
         pPerf->numTimes++;
         if (pPerf->minTime > pPerf->tmpTime)
@@ -404,6 +786,9 @@ void DVP_PerformanceStop(DVP_Perf_t *pPerf)
             pPerf->maxTime = pPerf->tmpTime;
         pPerf->sumTime += pPerf->tmpTime;
         pPerf->avgTime = pPerf->sumTime/pPerf->numTimes;
+        hist = DVP_Perf_Find(pPerf);
+        if (hist)
+            histogram_hdr_record(hist, pPerf->tmpTime);
     }
 }
 
@@ -418,6 +803,13 @@ void DVP_PerformancePrint(DVP_Perf_t *pPerf, const char *prefix)
             (DVP_U64)rtimer_to_us(pPerf->avgTime),
             (DVP_U64)rtimer_to_us(pPerf->sumTime),
             (DVP_U64)rtimer_to_us(pPerf->tmpTime));
+    if (DVP_Perf_Samples(pPerf) > 0)
+    {
+        DVP_PRINT(DVP_ZONE_PERF, "%s: (us) p50="FMT_U64(14)" p99="FMT_U64(14)" p99.9="FMT_U64(14)"\n", prefix,
+                DVP_Perf_Percentile(pPerf, 50.0),
+                DVP_Perf_Percentile(pPerf, 99.0),
+                DVP_Perf_Percentile(pPerf, 99.9));
+    }
 }
 
 void DVP_PrintPerformanceCSV(DVP_Handle handle, DVP_KernelNode_t *pNodes, DVP_U32 numNodes)
@@ -429,15 +821,19 @@ void DVP_PrintPerformanceCSV(DVP_Handle handle, DVP_KernelNode_t *pNodes, DVP_U3
     dvp = dvp; // warnings
     pNodes = pNodes; // warnings
 
-    DVP_PRINT(DVP_ZONE_PERF, "Node, %6s, %8s, %14s, %14s, %14s, %14s,\n",
-           "Core", "Kernel", "Minmum","Maximum","Average","Summation");
+    DVP_PRINT(DVP_ZONE_PERF, "Node, %6s, %8s, %14s, %14s, %14s, %14s, %14s, %14s, %14s,\n",
+           "Core", "Kernel", "Minmum","Maximum","Average","Summation","P50","P99","P99.9");
     for (i = 0; i < numNodes; i++)
     {
-        DVP_PRINT(DVP_ZONE_PERF, "%4u, %6s[%u], %8u, "FMT_U64(14)", "FMT_U64(14)", "FMT_U64(14)", "FMT_U64(14)",\n", i, dvp->managers[pNodes[i].header.mgrIndex].name, pNodes[i].header.mgrIndex, pNodes[i].header.kernel,
-                  (DVP_U64)rtimer_from_rate_to_us(pNodes[i].header.perf.minTime, pNodes[i].header.perf.rate),
-                  (DVP_U64)rtimer_from_rate_to_us(pNodes[i].header.perf.maxTime, pNodes[i].header.perf.rate),
-                  (DVP_U64)rtimer_from_rate_to_us(pNodes[i].header.perf.avgTime, pNodes[i].header.perf.rate),
-                  (DVP_U64)rtimer_from_rate_to_us(pNodes[i].header.perf.sumTime, pNodes[i].header.perf.rate));
+        DVP_Perf_t *perf = &pNodes[i].header.perf;
+        DVP_PRINT(DVP_ZONE_PERF, "%4u, %6s[%u], %8u, "FMT_U64(14)", "FMT_U64(14)", "FMT_U64(14)", "FMT_U64(14)", "FMT_U64(14)", "FMT_U64(14)", "FMT_U64(14)",\n", i, dvp->managers[pNodes[i].header.mgrIndex].name, pNodes[i].header.mgrIndex, pNodes[i].header.kernel,
+                  (DVP_U64)rtimer_from_rate_to_us(perf->minTime, perf->rate),
+                  (DVP_U64)rtimer_from_rate_to_us(perf->maxTime, perf->rate),
+                  (DVP_U64)rtimer_from_rate_to_us(perf->avgTime, perf->rate),
+                  (DVP_U64)rtimer_from_rate_to_us(perf->sumTime, perf->rate),
+                  DVP_Perf_Percentile(perf, 50.0),
+                  DVP_Perf_Percentile(perf, 99.0),
+                  DVP_Perf_Percentile(perf, 99.9));
     }
 }
 
@@ -488,6 +884,13 @@ void DVP_PrintPerformanceSection(DVP_Handle handle, DVP_KernelGraphSection_t *pS
             (DVP_U64)rtimer_to_us(perf->maxTime),
             (DVP_U64)rtimer_to_us(perf->avgTime),
             (DVP_U64)rtimer_to_us(perf->sumTime));
+    if (DVP_Perf_Samples(perf) > 0)
+    {
+        DVP_PRINT(DVP_ZONE_PERF, "Graph Section Percentiles (us): p50="FMT_U64(14)" p99="FMT_U64(14)" p99.9="FMT_U64(14)"\n",
+                DVP_Perf_Percentile(perf, 50.0),
+                DVP_Perf_Percentile(perf, 99.0),
+                DVP_Perf_Percentile(perf, 99.9));
+    }
     overhead.minTime = rtimer_to_us(perf->minTime) - overhead.minTime;
     overhead.maxTime = rtimer_to_us(perf->maxTime) - overhead.maxTime;
     overhead.avgTime = rtimer_to_us(perf->avgTime) - overhead.avgTime;
@@ -526,7 +929,13 @@ void DVP_PrintPerformanceGraph(DVP_Handle handle, DVP_KernelGraph_t *pGraph)
             (DVP_U64)rtimer_to_us(perf->maxTime),
             (DVP_U64)rtimer_to_us(perf->avgTime),
             (DVP_U64)rtimer_to_us(perf->sumTime));
-
+    if (DVP_Perf_Samples(perf) > 0)
+    {
+        DVP_PRINT(DVP_ZONE_PERF, "Overall Graph Percentiles (us): p50="FMT_U64(14)" p99="FMT_U64(14)" p99.9="FMT_U64(14)"\n",
+                DVP_Perf_Percentile(perf, 50.0),
+                DVP_Perf_Percentile(perf, 99.0),
+                DVP_Perf_Percentile(perf, 99.9));
+    }
 }
 
 void DVP_PrintNode(DVP_U32 zone, DVP_KernelNode_t *node)
@@ -614,11 +1023,33 @@ DVP_Error_e DVP_KernelGraphSection_Init(DVP_Handle handle,
     }
 }
 
+DVP_Error_e DVP_KernelGraphSection_Place(DVP_Handle handle,
+                                       DVP_KernelGraph_t *graph,
+                                       DVP_U32 sectionIndex,
+                                       DVP_U32 numaNode)
+{
+    DVP_t *dvp = (DVP_t *)handle;
+    if (dvp && graph && sectionIndex < graph->numSections)
+    {
+        graph->sections[sectionIndex].numaNode = numaNode;
+        return DVP_SUCCESS;
+    }
+    else
+    {
+        DVP_PRINT(DVP_ZONE_ERROR, "ERROR: Invalid Parameters to %s!\n", __FUNCTION__);
+        return DVP_ERROR_INVALID_PARAMETER;
+    }
+}
+
 void DVP_KernelGraph_Free(DVP_Handle handle, DVP_KernelGraph_t *graph)
 {
     DVP_t *dvp = (DVP_t *)handle;
     if (dvp && graph)
     {
+        DVP_U32 s;
+        DVP_Perf_Histogram(&graph->totalperf, DVP_FALSE);
+        for (s = 0; graph->sections && s < graph->numSections; s++)
+            DVP_Perf_Histogram(&graph->sections[s].perf, DVP_FALSE);
         free(graph->sections);
         free(graph->order);
         free(graph);
@@ -699,4 +1130,3 @@ void DVP_KernelGraph_ImageShiftAccum(DVP_Handle handle, DVP_KernelNode_t *node,
     }
 }
 
-/******************************************************************************/
@@ -37,6 +37,9 @@ DVP_U32 DVP_KernelGraphManagerLoad(DVP_GraphManager_t *pManager)
         pManager->calls.deinit      = (DVP_GraphManagerDeinit_f)     module_symbol(pManager->handle, "DVP_KernelGraphManagerDeinit");
         pManager->calls.restart     = (DVP_GraphManagerRestart_f)    module_symbol(pManager->handle, "DVP_KernelGraphManagerRestart");
         pManager->calls.verify      = (DVP_KernelGraphManagerVerify_f)module_symbol(pManager->handle, "DVP_KernelGraphManagerVerify");
+        pManager->calls.placed      = (DVP_GraphManagerPlaced_f)     module_symbol(pManager->handle, "DVP_KernelGraphManagerPlaced");
+        pManager->calls.release     = (DVP_KernelGraphManagerRelease_f)module_symbol(pManager->handle, "DVP_KernelGraphManagerRelease");
+        pManager->calls.images      = (DVP_KernelGraphManagerImages_f)module_symbol(pManager->handle, "DVP_KernelGraphManagerImages");
         if (pManager->calls.init == NULL ||
             pManager->calls.manager == NULL ||
             pManager->calls.verify == NULL ||
@@ -45,7 +48,7 @@ DVP_U32 DVP_KernelGraphManagerLoad(DVP_GraphManager_t *pManager)
             pManager->calls.getRemote == NULL ||
             pManager->calls.getCore == NULL ||
             pManager->calls.getLoad == NULL ||
-            pManager->calls.deinit == NULL) // we don't check restart yet
+            pManager->calls.deinit == NULL) // we don't check restart yet, placed, release and images are optional
         {
             module_unload(pManager->handle);
             pManager->handle = NULL;
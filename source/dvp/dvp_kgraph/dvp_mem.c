@@ -19,6 +19,10 @@
 #include <dvp/dvp_debug.h>
 #include <dvp_kgb.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 // dims mutex_t
 static mutex_t dims_mutex = MUTEX_INITIAL;
 
@@ -429,6 +433,59 @@ DVP_Dim_t *DVP_Image_Dims(DVP_Image_t *pImage)
     return dims;
 }
 
+static DVP_BOOL DVP_Image_RowsPadded(DVP_MemType_e dvpMemType)
+{
+    if (dvpMemType == DVP_MTYPE_MPUCACHED_VIRTUAL ||
+        dvpMemType == DVP_MTYPE_MPUCACHED_VIRTUAL_SHARED)
+        return DVP_TRUE;
+    return DVP_FALSE;
+}
+
+// An image is padded when its CPU lines are longer than its pixels, only DVP_Image_AllocAligned makes these.
+static DVP_BOOL DVP_Image_Padded(DVP_Image_t *pImage, DVP_MemType_e dvpMemType)
+{
+    if (DVP_Image_RowsPadded(dvpMemType) == DVP_TRUE &&
+        (DVP_U32)abs(pImage->y_stride) > DVP_Image_LineSize(pImage, 0))
+        return DVP_TRUE;
+    return DVP_FALSE;
+}
+
+// Padded images are allocated as byte planes of their line range with a spare line of slack,
+// the same dimensions must be recomputed from the image to find it in the pool or import it.
+static DVP_Dim_t *DVP_Image_AllocDims(DVP_Image_t *pImage, DVP_MemType_e dvpMemType)
+{
+    static DVP_Dim_t dims[DVP_MAX_PLANES];
+    DVP_U32 p;
+
+    if (DVP_Image_Padded(pImage, dvpMemType) == DVP_FALSE)
+        return DVP_Image_Dims(pImage);
+
+    memset(dims, 0, sizeof(dims));
+    for (p = 0; p < pImage->planes; p++)
+    {
+        dims[p].img.bpp = 1;
+        dims[p].img.width = DVP_Image_LineRange(pImage, p);
+        dims[p].img.height = (pImage->bufHeight / DVP_Image_HeightDiv(pImage, p)) + 1;
+    }
+    return dims;
+}
+
+DVP_U32 DVP_Image_RowAlign(DVP_Image_t *pImage)
+{
+    DVP_U32 p, bits = DVP_PAGE_SIZE;
+    if (pImage == NULL || pImage->planes == 0 || pImage->y_stride == 0)
+        return 0;
+    for (p = 0; p < pImage->planes && p < DVP_MAX_PLANES; p++)
+    {
+        if (pImage->pData[p] == NULL)
+            return 0;
+        bits |= (DVP_U32)(size_t)pImage->pData[p];
+        bits |= DVP_Image_LineRange(pImage, p);
+    }
+    // the lowest set bit is the largest power of two which divides all of them
+    return bits & (~bits + 1);
+}
+
 DVP_BOOL DVP_Image_Free(DVP_Handle handle, DVP_Image_t *pImage)
 {
     DVP_BOOL ret = DVP_FALSE;
@@ -443,7 +500,7 @@ DVP_BOOL DVP_Image_Free(DVP_Handle handle, DVP_Image_t *pImage)
         DVP_U32 nptrs = pImage->planes;
 
         mutex_lock(&dims_mutex);
-        dims = DVP_Image_Dims(pImage);
+        dims = DVP_Image_AllocDims(pImage, pImage->memType);
 #if defined(DVP_USE_TILER)
         nptrs = 1;  // tiler buffers are allocated in bulk but freed alone
 #endif
@@ -452,7 +509,7 @@ DVP_BOOL DVP_Image_Free(DVP_Handle handle, DVP_Image_t *pImage)
             pImage->memType == DVP_MTYPE_MPUNONCACHED_2DTILED)
             free(pImage->reserved); // free the array of pointers to omap_bo's
 #endif
-        ret = dvp_mem_free(handle, pImage->memType, nptrs, ndims, dims, (DVP_PTR *)pImage->pBuffer);
+        ret = dvp_mem_pool_free(handle, pImage->memType, nptrs, ndims, dims, (DVP_PTR *)pImage->pBuffer);
         mutex_unlock(&dims_mutex);
     }
     else if (handle && pImage && pImage->memType == DVP_MTYPE_DISPLAY_2DTILED)
@@ -490,6 +547,11 @@ DVP_BOOL DVP_Image_Free(DVP_Handle handle, DVP_Image_t *pImage)
 }
 
 DVP_BOOL DVP_Image_Alloc(DVP_Handle handle, DVP_Image_t *pImage, DVP_MemType_e dvpMemType)
+{
+    return DVP_Image_AllocAligned(handle, pImage, dvpMemType, 1);
+}
+
+DVP_BOOL DVP_Image_AllocAligned(DVP_Handle handle, DVP_Image_t *pImage, DVP_MemType_e dvpMemType, DVP_U32 rowAlign)
 {
     DVP_BOOL ret = DVP_FALSE;
 #if defined(DVP_USE_CAMERA_SERVICE)
@@ -507,26 +569,52 @@ DVP_BOOL DVP_Image_Alloc(DVP_Handle handle, DVP_Image_t *pImage, DVP_MemType_e d
                                              {{{0,0,0}}},
                                              {{{0,0,0}}}};
 
+        DVP_S32 y_stride = pImage->y_stride;
+        DVP_BOOL padded = DVP_FALSE;
+
+        if (DVP_Image_RowsPadded(dvpMemType) == DVP_TRUE && rowAlign > 1)
+        {
+            // the rows must stay a whole number of pixels so round to a multiple of both
+            DVP_U32 line = DVP_Image_LineSize(pImage, 0);
+            DVP_U32 align = rowAlign;
+            while (pImage->x_stride > 1 && (align % pImage->x_stride))
+                align += rowAlign;
+            pImage->y_stride = ((line + align - 1) / align) * align;
+            padded = DVP_Image_Padded(pImage, dvpMemType);
+            if (padded == DVP_FALSE)
+                pImage->y_stride = y_stride; // already aligned, allocate it like any other
+        }
+
         mutex_lock(&dims_mutex);
-        dims = DVP_Image_Dims(pImage);
-        if (dvp_mem_calloc(handle, dvpMemType, nptrs, ndims, dims, (DVP_PTR *)pImage->pBuffer, strides) == DVP_TRUE)
+        dims = DVP_Image_AllocDims(pImage, dvpMemType);
+        if (dvp_mem_pool_calloc(handle, dvpMemType, nptrs, ndims, dims, (DVP_PTR *)pImage->pBuffer, strides) == DVP_TRUE)
         {
             for (p = 0; p < pImage->planes; p++)
                 pImage->pData[p] = pImage->pBuffer[p]; // assign each pointer
 
             pImage->memType = dvpMemType;
-            // just take the first plane's strides since DVP_Image_t does not track each plane.
-#if defined(DVP_USE_TILER)
-            if (pImage->color == FOURCC_UYVY || pImage->color == FOURCC_YUY2 ||
-                pImage->color == FOURCC_VYUY || pImage->color == FOURCC_YVYU)
+            if (padded == DVP_TRUE)
             {
-                strides[0].dim.x = 2; // was set to 4 to force 32 TILER allocations
+                // every plane was allocated as bytes, the strides were already decided
+                pImage->numBytes = 0;
+                for (p = 0; p < pImage->planes; p++)
+                    pImage->numBytes += DVP_Image_PlaneRange(pImage, p);
             }
+            else
+            {
+                // just take the first plane's strides since DVP_Image_t does not track each plane.
+#if defined(DVP_USE_TILER)
+                if (pImage->color == FOURCC_UYVY || pImage->color == FOURCC_YUY2 ||
+                    pImage->color == FOURCC_VYUY || pImage->color == FOURCC_YVYU)
+                {
+                    strides[0].dim.x = 2; // was set to 4 to force 32 TILER allocations
+                }
 #endif
-            pImage->x_stride = strides[0].dim.x;
-            pImage->y_stride = strides[0].dim.y;
-            // num bytes must encompass the entire image, not just the first plane.
-            pImage->numBytes = DVP_Image_Range(pImage);
+                pImage->x_stride = strides[0].dim.x;
+                pImage->y_stride = strides[0].dim.y;
+                // num bytes must encompass the entire image, not just the first plane.
+                pImage->numBytes = DVP_Image_Range(pImage);
+            }
 #if defined(DVP_USE_GRALLOC)
             if (pImage->memType == DVP_MTYPE_GRALLOC_2DTILED)
             {
@@ -556,6 +644,8 @@ DVP_BOOL DVP_Image_Alloc(DVP_Handle handle, DVP_Image_t *pImage, DVP_MemType_e d
 #endif
             ret = DVP_TRUE;
         }
+        else
+            pImage->y_stride = y_stride;
         mutex_unlock(&dims_mutex);
     }
     else if (handle && pImage && dvpMemType == DVP_MTYPE_DISPLAY_2DTILED)
@@ -621,6 +711,27 @@ DVP_BOOL DVP_Image_Alloc(DVP_Handle handle, DVP_Image_t *pImage, DVP_MemType_e d
     return ret;
 }
 
+DVP_BOOL DVP_Image_Place(DVP_Handle handle, DVP_Image_t *pImage, DVP_U32 numaNode)
+{
+    DVP_BOOL ret = DVP_FALSE;
+    if (handle && pImage && DVP_Image_RowsPadded(pImage->memType) == DVP_TRUE)
+    {
+        DVP_U32 p;
+        ret = DVP_TRUE;
+        if (numaNode == DVP_NUMA_NODE_ANY)
+            return ret;
+        for (p = 0; p < pImage->planes; p++)
+        {
+            if (pImage->pBuffer[p] == NULL)
+                continue;
+            if (numa_memory_place(pImage->pBuffer[p], DVP_Image_PlaneRange(pImage, p), numaNode - 1) == false_e)
+                ret = DVP_FALSE;
+        }
+        DVP_PRINT(DVP_ZONE_MEM, "Placed image %p on NUMA node %u (%s)\n", pImage, numaNode - 1, (ret?"OK":"FAILED"));
+    }
+    return ret;
+}
+
 DVP_BOOL DVP_Image_Share(DVP_Handle handle, DVP_Image_t *pImage, DVP_S32 *fds)
 {
     DVP_BOOL ret = DVP_FALSE;
@@ -645,7 +756,7 @@ DVP_BOOL DVP_Image_Import(DVP_Handle handle, DVP_Image_t *pImage, DVP_S32 *share
                                              {{{0,0,0}}},
                                              {{{0,0,0}}}};
         mutex_lock(&dims_mutex);
-        dims = DVP_Image_Dims(pImage);
+        dims = DVP_Image_AllocDims(pImage, pImage->memType);
 #if defined(DVP_USE_TILER)
         nptrs = 1;  // tiler buffers are allocated in bulk but freed alone
 #endif
@@ -661,9 +772,19 @@ DVP_BOOL DVP_Image_Import(DVP_Handle handle, DVP_Image_t *pImage, DVP_S32 *share
 #endif
             for (p = 0; p < pImage->planes; p++)
                 pImage->pData[p] = pImage->pBuffer[p]; // assign each pointer
-            pImage->x_stride = strides[0].dim.x;
-            pImage->y_stride = strides[0].dim.y;
-            pImage->numBytes = strides[0].dim.z;
+            if (DVP_Image_Padded(pImage, pImage->memType) == DVP_TRUE)
+            {
+                // the byte planes do not describe the pixels, keep the image's own strides
+                pImage->numBytes = 0;
+                for (p = 0; p < pImage->planes; p++)
+                    pImage->numBytes += DVP_Image_PlaneRange(pImage, p);
+            }
+            else
+            {
+                pImage->x_stride = strides[0].dim.x;
+                pImage->y_stride = strides[0].dim.y;
+                pImage->numBytes = strides[0].dim.z;
+            }
             ret = DVP_TRUE;
         }
         mutex_unlock(&dims_mutex);
@@ -680,7 +801,7 @@ DVP_BOOL DVP_Image_Free_Import(DVP_Handle handle, DVP_Image_t *pImage, DVP_VALUE
         DVP_Dim_t *dims = NULL;
         DVP_U32 nptrs = pImage->planes;
         mutex_lock(&dims_mutex);
-        dims = DVP_Image_Dims(pImage);
+        dims = DVP_Image_AllocDims(pImage, pImage->memType);
 #if defined(DVP_USE_TILER)
         nptrs = 1;  // tiler buffers are allocated in bulk but freed alone
 #endif
@@ -710,9 +831,101 @@ void DVP_Image_Fill(DVP_Image_t *pImage, DVP_S08 *buf, uint32_t size)
     }
 }
 
+// copies the patch lines of a plane, in one block when neither image has gaps between its lines
+static void DVP_Image_CopyPlane(DVP_Image_t *pDst, DVP_Image_t *pSrc, DVP_U32 p)
+{
+    DVP_U32 y;
+    DVP_U32 ydiv = DVP_Image_HeightDiv(pSrc, p);
+    DVP_U32 line = DVP_Image_PatchLineSize(pSrc, p);
+    DVP_U32 rows = pSrc->height/ydiv;
+
+    if (pSrc->y_stride > 0 && pDst->y_stride > 0 &&
+        DVP_Image_LineRange(pSrc, p) == line &&
+        DVP_Image_LineRange(pDst, p) == line)
+    {
+        memcpy(DVP_Image_PatchAddressing(pDst, 0, 0, p),
+               DVP_Image_PatchAddressing(pSrc, 0, 0, p),
+               line * rows);
+        return;
+    }
+    for (y = 0; y < rows; y++)
+    {
+        memcpy(DVP_Image_PatchAddressing(pDst, 0, y*ydiv, p),
+               DVP_Image_PatchAddressing(pSrc, 0, y*ydiv, p),
+               line);
+    }
+}
+
+// expands a line of luma into an interleaved 4:2:2 line with neutral chroma
+static void DVP_Image_LumaLine(DVP_U08 *pDst, const DVP_U08 *pLuma, DVP_U32 width, DVP_BOOL lumaFirst)
+{
+    DVP_U32 x = 0;
+    DVP_U32 l = (lumaFirst ? 0 : 1);
+#if defined(__SSE2__)
+    __m128i c = _mm_set1_epi8((char)128);
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)&pLuma[x]);
+        __m128i lo, hi;
+        if (lumaFirst)
+        {
+            lo = _mm_unpacklo_epi8(v, c);
+            hi = _mm_unpackhi_epi8(v, c);
+        }
+        else
+        {
+            lo = _mm_unpacklo_epi8(c, v);
+            hi = _mm_unpackhi_epi8(c, v);
+        }
+        _mm_storeu_si128((__m128i *)&pDst[2*x], lo);
+        _mm_storeu_si128((__m128i *)&pDst[2*x + 16], hi);
+    }
+#endif
+    for (; x < width; x++)
+    {
+        pDst[2*x + l] = pLuma[x];
+        pDst[2*x + (1 - l)] = 128; // "zero" Chromance
+    }
+}
+
+// reorders the bytes of each macro pixel of an interleaved 4:2:2 line, either
+// swapping each pair of bytes {1,0,3,2} or rotating the macro pixel {3,0,1,2}
+static void DVP_Image_SwizzleLine(DVP_U08 *pDst, const DVP_U08 *pSrc, DVP_U32 width, DVP_BOOL swap)
+{
+    DVP_U32 x = 0, bytes = (width/2)*4;
+#if defined(__SSE2__)
+    for (; x + 16 <= bytes; x += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)&pSrc[x]);
+        if (swap)
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        else
+            v = _mm_or_si128(_mm_slli_epi32(v, 8), _mm_srli_epi32(v, 24));
+        _mm_storeu_si128((__m128i *)&pDst[x], v);
+    }
+#endif
+    for (; x < bytes; x += 4)
+    {
+        if (swap)
+        {
+            pDst[x+0] = pSrc[x+1];
+            pDst[x+1] = pSrc[x+0];
+            pDst[x+2] = pSrc[x+3];
+            pDst[x+3] = pSrc[x+2];
+        }
+        else
+        {
+            pDst[x+0] = pSrc[x+3];
+            pDst[x+1] = pSrc[x+0];
+            pDst[x+2] = pSrc[x+1];
+            pDst[x+3] = pSrc[x+2];
+        }
+    }
+}
+
 DVP_BOOL DVP_Image_Copy(DVP_Image_t *pDst, DVP_Image_t *pSrc)
 {
-    DVP_U32 p,x,y;
+    DVP_U32 p,y;
     DVP_PrintImage(DVP_ZONE_MEM, pSrc);
     DVP_PrintImage(DVP_ZONE_MEM, pDst);
 
@@ -734,107 +947,36 @@ DVP_BOOL DVP_Image_Copy(DVP_Image_t *pDst, DVP_Image_t *pSrc)
     if (pDst->color == pSrc->color)
     {
         for (p = 0; p < pSrc->planes; p++)
-        {
-            DVP_U32 ydiv = DVP_Image_HeightDiv(pSrc, p);
-            for (y = 0; y < (pSrc->height/ydiv); y++)
-            {
-                memcpy(DVP_Image_PatchAddressing(pDst, 0, y*ydiv, p),
-                       DVP_Image_PatchAddressing(pSrc, 0, y*ydiv, p),
-                       DVP_Image_PatchLineSize(pSrc, p));
-            }
-        }
+            DVP_Image_CopyPlane(pDst, pSrc, p);
         return DVP_TRUE;
     }
     else
     {
         // convert the colors
-        if (pSrc->color == FOURCC_Y800 && (pDst->color == FOURCC_UYVY || pDst->color == FOURCC_VYUY))
+        if (pSrc->color == FOURCC_Y800 &&
+            (pDst->color == FOURCC_UYVY || pDst->color == FOURCC_VYUY ||
+             pDst->color == FOURCC_YUY2 || pDst->color == FOURCC_YVYU))
         {
-            DVP_U08 *luma;
-            DVP_U08 *xyxy;
+            DVP_BOOL lumaFirst = (pDst->color == FOURCC_YUY2 || pDst->color == FOURCC_YVYU ? DVP_TRUE : DVP_FALSE);
             for (y = 0; y < pSrc->height; y++)
             {
-                for (x = 0; x < pSrc->width; x+=2) // macro pixel
-                {
-                    luma = DVP_Image_PatchAddressing(pSrc, x, y, 0);
-                    xyxy = DVP_Image_PatchAddressing(pDst, x, y, 0);
-                    xyxy[0] = 128; // "zero" Chromance
-                    xyxy[1] = luma[0];
-                    xyxy[2] = 128; // "zero" Chromance
-                    xyxy[3] = luma[1];
-                }
-            }
-            return DVP_TRUE;
-        }
-        if (pSrc->color == FOURCC_Y800 && (pDst->color == FOURCC_YUY2 || pDst->color == FOURCC_YVYU))
-        {
-            DVP_U08 *luma;
-            DVP_U08 *yxyx;
-            for (y = 0; y < pSrc->height; y++)
-            {
-                for (x = 0; x < pSrc->width; x+=2) // macro pixel
-                {
-                    luma = DVP_Image_PatchAddressing(pSrc, x, y, 0);
-                    yxyx = DVP_Image_PatchAddressing(pDst, x, y, 0);
-                    yxyx[0] = luma[0];
-                    yxyx[1] = 128; // "zero" Chromance
-                    yxyx[2] = luma[1];
-                    yxyx[3] = 128; // "zero" Chromance
-                }
+                DVP_Image_LumaLine(DVP_Image_PatchAddressing(pDst, 0, y, 0),
+                                   DVP_Image_PatchAddressing(pSrc, 0, y, 0),
+                                   pSrc->width, lumaFirst);
             }
             return DVP_TRUE;
         }
         else if ((pDst->color == FOURCC_UYVY || pDst->color == FOURCC_VYUY) &&
                  (pSrc->color == FOURCC_YVYU || pSrc->color == FOURCC_YUY2))
         {
-            // reswizzle
-            DVP_U08 *xyxy;
-            DVP_U08 *yxyx;
+            // reswizzle, YUYV to UYVY and YVYU to VYUY swap the pairs of bytes,
+            // YUYV to VYUY and YVYU to UYVY rotate the macro pixel
+            DVP_BOOL swap = ((pSrc->color == FOURCC_YUY2) == (pDst->color == FOURCC_UYVY) ? DVP_TRUE : DVP_FALSE);
             for (y = 0; y < pSrc->height; y++)
             {
-                for (x = 0; x < pSrc->width; x+=2) // macro pixels
-                {
-                    yxyx = DVP_Image_PatchAddressing(pSrc, x, y, 0);
-                    xyxy = DVP_Image_PatchAddressing(pDst, x, y, 0);
-                    if (pSrc->color == FOURCC_YUY2)
-                    {
-                        if (pDst->color == FOURCC_UYVY)
-                        {
-                          //UYVY      YUYV
-                            xyxy[0] = yxyx[1];
-                            xyxy[1] = yxyx[0];
-                            xyxy[2] = yxyx[3];
-                            xyxy[3] = yxyx[2];
-                        }
-                        else
-                        {
-                          //VYUY      YUYV
-                            xyxy[0] = yxyx[3];
-                            xyxy[1] = yxyx[0];
-                            xyxy[2] = yxyx[1];
-                            xyxy[3] = yxyx[2];
-                        }
-                    }
-                    else
-                    {
-                        if (pDst->color == FOURCC_UYVY)
-                        {
-                          //UYVY      YVYU
-                            xyxy[0] = yxyx[3];
-                            xyxy[1] = yxyx[0];
-                            xyxy[2] = yxyx[1];
-                            xyxy[3] = yxyx[2];
-                        }
-                        else
-                        {
-                          //VYUY      YVYU
-                            xyxy[0] = yxyx[1];
-                            xyxy[1] = yxyx[0];
-                            xyxy[2] = yxyx[3];
-                            xyxy[3] = yxyx[2];
-                        }
-                    }
-                }
+                DVP_Image_SwizzleLine(DVP_Image_PatchAddressing(pDst, 0, y, 0),
+                                      DVP_Image_PatchAddressing(pSrc, 0, y, 0),
+                                      pSrc->width, swap);
             }
             return DVP_TRUE;
         }
@@ -851,12 +993,7 @@ DVP_BOOL DVP_Image_Copy(DVP_Image_t *pDst, DVP_Image_t *pSrc)
                  pDst->color == FOURCC_Y800)
         {
             // a "luma" extract kind-of (luma plane does not have ydiv)
-            for (y = 0; y < pSrc->height; y++)
-            {
-                memcpy(DVP_Image_PatchAddressing(pDst, 0, y, 0),
-                       DVP_Image_PatchAddressing(pSrc, 0, y, 0),
-                       DVP_Image_PatchLineSize(pSrc, 0));
-            }
+            DVP_Image_CopyPlane(pDst, pSrc, 0);
             return DVP_TRUE;
         }
     }
@@ -1234,7 +1371,7 @@ DVP_BOOL DVP_Buffer_Free(DVP_Handle handle, DVP_Buffer_t *pBuffer)
     {
         DVP_U32 numElem = pBuffer->numBytes/pBuffer->elemSize;
         DVP_Dim_t dims[1] = { {{{pBuffer->elemSize, numElem, 1}}} };
-        return dvp_mem_free(handle, pBuffer->memType, dimof(dims), 2, dims, (DVP_PTR *)&pBuffer->pData);
+        return dvp_mem_pool_free(handle, pBuffer->memType, dimof(dims), 2, dims, (DVP_PTR *)&pBuffer->pData);
     }
     return DVP_FALSE;
 }
@@ -1248,7 +1385,7 @@ DVP_BOOL DVP_Buffer_Alloc(DVP_Handle handle, DVP_Buffer_t *pBuffer, DVP_MemType_
         DVP_Dim_t dims[1] = { {{{pBuffer->elemSize, numElem, 1}}} };
         DVP_PTR ptrs[1] = {NULL};
         DVP_Dim_t strs[1] = { {{{0,0,0}}} };
-        ret = dvp_mem_calloc(handle, dvpMemType, dimof(ptrs), 2, dims, ptrs, strs);
+        ret = dvp_mem_pool_calloc(handle, dvpMemType, dimof(ptrs), 2, dims, ptrs, strs);
         if (ret == DVP_TRUE) {
             pBuffer->memType = dvpMemType;
             pBuffer->pData = (DVP_U08 *)ptrs[0];
@@ -1257,6 +1394,55 @@ DVP_BOOL DVP_Buffer_Alloc(DVP_Handle handle, DVP_Buffer_t *pBuffer, DVP_MemType_
     return ret;
 }
 
+void DVP_MemPool_Trim(DVP_Handle handle, DVP_U32 maxBytes)
+{
+    dvp_mem_pool_trim(handle, maxBytes);
+}
+
+DVP_BOOL DVP_MemPool_Stats(DVP_Handle handle, DVP_MemPool_Stats_t *pStats)
+{
+    DVP_t *dvp = (DVP_t *)handle;
+    if (dvp && dvp->pool && pStats)
+    {
+        mutex_lock(&dvp->pool->lock);
+        memcpy(pStats, &dvp->pool->stats, sizeof(DVP_MemPool_Stats_t));
+        mutex_unlock(&dvp->pool->lock);
+        return DVP_TRUE;
+    }
+    return DVP_FALSE;
+}
+
+void DVP_MemPin_Set(DVP_Handle handle, DVP_U32 flags)
+{
+    dvp_mem_pin_set(handle, flags);
+}
+
+DVP_BOOL DVP_MemPin_Stats(DVP_Handle handle, DVP_MemPin_Stats_t *pStats)
+{
+    DVP_t *dvp = (DVP_t *)handle;
+    if (dvp && dvp->pins && pStats)
+    {
+        mutex_lock(&dvp->pins->lock);
+        memcpy(pStats, &dvp->pins->stats, sizeof(DVP_MemPin_Stats_t));
+        mutex_unlock(&dvp->pins->lock);
+        return DVP_TRUE;
+    }
+    return DVP_FALSE;
+}
+
+DVP_BOOL DVP_CacheOps_Stats(DVP_Handle handle, DVP_CacheOps_Stats_t *pStats)
+{
+    DVP_t *dvp = (DVP_t *)handle;
+    if (dvp && dvp->cacheops && pStats)
+    {
+        mutex_lock(&dvp->cacheops->lock);
+        memcpy(pStats, &dvp->cacheops->stats, sizeof(DVP_CacheOps_Stats_t));
+        mutex_unlock(&dvp->cacheops->lock);
+        return DVP_TRUE;
+    }
+    return DVP_FALSE;
+}
+
 void DVP_Buffer_Init(DVP_Buffer_t *pBuffer, DVP_U32 elemSize, DVP_U32 numElems)
 {
     // clean out any dirty values
@@ -1337,12 +1523,14 @@ void DVP_KernelNode_Free(DVP_Handle handle, DVP_KernelNode_t *pNodes, DVP_U32 nu
     {
         DVP_Dim_t dims[] = {{{{sizeof(DVP_KernelNode_t), numNodes, 1}}}};
         DVP_PTR ptrs[] = {pNodes};
+        DVP_t *dvp = (DVP_t *)handle;
         DVP_U32 n = 0;
 
         // make sure the debugging handles are closed so that the data has been
         // committed to the files.
         for (n = 0; n < numNodes; n++) {
             DVP_ImageDebug_t *img = dvp_knode_to(&pNodes[n],DVP_ImageDebug_t);
+            DVP_Perf_Histogram(&pNodes[n].header.perf, DVP_FALSE);
 #if defined(DVP_USE_FS)
             if (pNodes[n].header.kernel == DVP_KN_IMAGE_DEBUG && img->fp)
                 fclose(img->fp);
@@ -1351,6 +1539,13 @@ void DVP_KernelNode_Free(DVP_Handle handle, DVP_KernelNode_t *pNodes, DVP_U32 nu
 #endif
         }
 
+        // let the managers drop what they kept for the nodes at verify
+        for (n = 0; n < dvp->numMgrs; n++)
+        {
+            if (dvp->managers[n].enabled == true_e && dvp->managers[n].calls.release)
+                dvp->managers[n].calls.release(pNodes, 0, numNodes);
+        }
+
         memset(pNodes, 0, numNodes*sizeof(DVP_KernelNode_t));
         dvp_mem_free(handle, DVP_MTYPE_KERNELGRAPH, dimof(ptrs), 2, dims, ptrs);
     }
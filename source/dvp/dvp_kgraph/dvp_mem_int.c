@@ -138,6 +138,357 @@ DVP_BOOL dvp_mem_invalidate(DVP_Handle handle,
     return DVP_TRUE;
 }
 
+DVP_CacheOps_t *dvp_mem_cache_init()
+{
+    DVP_CacheOps_t *cache = (DVP_CacheOps_t *)calloc(1, sizeof(DVP_CacheOps_t));
+    if (cache)
+        mutex_init(&cache->lock);
+    return cache;
+}
+
+void dvp_mem_cache_deinit(DVP_Handle handle, DVP_CacheOps_t **pcache)
+{
+    DVP_t *dvp = (DVP_t *)handle;
+    if (dvp && pcache && *pcache)
+    {
+        DVP_CacheOps_t *cache = *pcache;
+        dvp_mem_cache_commit(handle, DVP_TRUE);
+        DVP_PRINT(DVP_ZONE_MEM, "Cache Ops: %u of %u flushes and %u of %u invalidates issued in %u batches\n",
+                  cache->stats.flushed, cache->stats.flushes,
+                  cache->stats.invalidated, cache->stats.invalidates,
+                  cache->stats.batches);
+        dvp->cacheops = NULL;
+        mutex_deinit(&cache->lock);
+        free(cache);
+        *pcache = NULL;
+    }
+}
+
+// nothing local has written the range since it was last flushed or invalidated
+static DVP_BOOL dvp_mem_cache_is_clean(DVP_CacheOps_t *cache, DVP_PTR ptr, DVP_U32 size)
+{
+    DVP_U32 i;
+    for (i = 0; i < cache->numClean; i++)
+        if (cache->clean[i].ptr == (DVP_U08 *)ptr)
+            return (cache->clean[i].size >= size ? DVP_TRUE : DVP_FALSE);
+    return DVP_FALSE;
+}
+
+// forgetting a clean range only costs an extra flush, so the oldest is replaced when full
+static void dvp_mem_cache_set_clean(DVP_CacheOps_t *cache, DVP_PTR ptr, DVP_U32 size)
+{
+    DVP_U32 i;
+    for (i = 0; i < cache->numClean; i++)
+    {
+        if (cache->clean[i].ptr == (DVP_U08 *)ptr)
+        {
+            if (cache->clean[i].size < size)
+                cache->clean[i].size = size;
+            return;
+        }
+    }
+    if (cache->numClean < DVP_CACHE_CLEAN_MAX)
+        i = cache->numClean++;
+    else
+        i = cache->nextClean++ % DVP_CACHE_CLEAN_MAX;
+    cache->clean[i].ptr = (DVP_U08 *)ptr;
+    cache->clean[i].size = size;
+}
+
+// queues an operation unless the same range is already queued
+static void dvp_mem_cache_queue(DVP_CacheOp_t *ops, DVP_U32 *pNum, DVP_Core_e core, DVP_PTR ptr, DVP_U32 size, DVP_MemType_e mtype)
+{
+    DVP_U32 i;
+    for (i = 0; i < *pNum; i++)
+    {
+        if (ops[i].ptr == (DVP_U08 *)ptr && ops[i].core == core && ops[i].mtype == mtype)
+        {
+            if (ops[i].size < size)
+                ops[i].size = size;
+            return;
+        }
+    }
+    ops[*pNum].core = core;
+    ops[*pNum].mtype = mtype;
+    ops[*pNum].ptr = (DVP_U08 *)ptr;
+    ops[*pNum].size = size;
+    (*pNum)++;
+}
+
+static int dvp_mem_cache_op_compare(const void *a, const void *b)
+{
+    const DVP_CacheOp_t *opA = (const DVP_CacheOp_t *)a;
+    const DVP_CacheOp_t *opB = (const DVP_CacheOp_t *)b;
+    if (opA->core != opB->core)
+        return (opA->core < opB->core ? -1 : 1);
+    if (opA->mtype != opB->mtype)
+        return (opA->mtype < opB->mtype ? -1 : 1);
+    if (opA->ptr != opB->ptr)
+        return (opA->ptr < opB->ptr ? -1 : 1);
+    return 0;
+}
+
+// sorts the operations and fuses the ranges which touch, returning how many remain
+static DVP_U32 dvp_mem_cache_fuse(DVP_CacheOp_t *ops, DVP_U32 num)
+{
+    DVP_U32 i, n = 0;
+    if (num == 0)
+        return 0;
+    qsort(ops, num, sizeof(DVP_CacheOp_t), dvp_mem_cache_op_compare);
+    for (i = 1; i < num; i++)
+    {
+        DVP_CacheOp_t *last = &ops[n];
+        if (ops[i].core == last->core && ops[i].mtype == last->mtype &&
+            ops[i].ptr <= last->ptr + last->size)
+        {
+            DVP_U08 *end = ops[i].ptr + ops[i].size;
+            if (end > last->ptr + last->size)
+                last->size = (DVP_U32)(end - last->ptr);
+        }
+        else
+            ops[++n] = ops[i];
+    }
+    return n + 1;
+}
+
+// must be called with the lock held, the lock is released while the operations are issued
+static void dvp_mem_cache_issue(DVP_t *dvp, DVP_CacheOps_t *cache, DVP_BOOL invalidate)
+{
+    DVP_CacheOp_t ops[DVP_CACHE_OPS_MAX];
+    DVP_U32 i, num;
+
+    if (invalidate)
+    {
+        num = dvp_mem_cache_fuse(cache->invals, cache->numInvals);
+        memcpy(ops, cache->invals, num * sizeof(DVP_CacheOp_t));
+        cache->numInvals = 0;
+        cache->stats.invalidated += num;
+    }
+    else
+    {
+        num = dvp_mem_cache_fuse(cache->flushes, cache->numFlushes);
+        memcpy(ops, cache->flushes, num * sizeof(DVP_CacheOp_t));
+        cache->numFlushes = 0;
+        cache->stats.flushed += num;
+    }
+    if (num == 0)
+        return;
+    cache->stats.batches++;
+    mutex_unlock(&cache->lock);
+    for (i = 0; i < num; i++)
+    {
+        if (invalidate) {
+            DVP_COMPLAIN_IF_FALSE(dvp_rpc_invalidate(dvp->rpc, ops[i].core, ops[i].ptr, ops[i].size, ops[i].mtype));
+        } else {
+            DVP_COMPLAIN_IF_FALSE(dvp_rpc_flush(dvp->rpc, ops[i].core, ops[i].ptr, ops[i].size, ops[i].mtype));
+        }
+    }
+    mutex_lock(&cache->lock);
+}
+
+void dvp_mem_cache_read(DVP_Handle handle, DVP_Core_e core, DVP_PTR ptr, DVP_U32 size, DVP_MemType_e mtype)
+{
+    DVP_t *dvp = (DVP_t *)handle;
+
+    if (dvp == NULL || ptr == NULL || size == 0)
+        return;
+    if (dvp->cacheops == NULL)
+    {
+        DVP_COMPLAIN_IF_FALSE(dvp_rpc_flush(dvp->rpc, core, ptr, size, mtype));
+        return;
+    }
+    mutex_lock(&dvp->cacheops->lock);
+    dvp->cacheops->stats.flushes++;
+    if (dvp_mem_cache_is_clean(dvp->cacheops, ptr, size) == DVP_FALSE)
+    {
+        if (dvp->cacheops->numFlushes == DVP_CACHE_OPS_MAX)
+            dvp_mem_cache_issue(dvp, dvp->cacheops, DVP_FALSE);
+        dvp_mem_cache_queue(dvp->cacheops->flushes, &dvp->cacheops->numFlushes, core, ptr, size, mtype);
+        dvp_mem_cache_set_clean(dvp->cacheops, ptr, size);
+    }
+    mutex_unlock(&dvp->cacheops->lock);
+}
+
+void dvp_mem_cache_written(DVP_Handle handle, DVP_Core_e core, DVP_PTR ptr, DVP_U32 size, DVP_MemType_e mtype)
+{
+    DVP_t *dvp = (DVP_t *)handle;
+
+    if (dvp == NULL || ptr == NULL || size == 0)
+        return;
+    if (dvp->cacheops == NULL)
+    {
+        DVP_COMPLAIN_IF_FALSE(dvp_rpc_invalidate(dvp->rpc, core, ptr, size, mtype));
+        return;
+    }
+    mutex_lock(&dvp->cacheops->lock);
+    dvp->cacheops->stats.invalidates++;
+    if (dvp->cacheops->numInvals == DVP_CACHE_OPS_MAX)
+        dvp_mem_cache_issue(dvp, dvp->cacheops, DVP_TRUE);
+    dvp_mem_cache_queue(dvp->cacheops->invals, &dvp->cacheops->numInvals, core, ptr, size, mtype);
+    // once invalidated the local caches hold none of the buffer
+    dvp_mem_cache_set_clean(dvp->cacheops, ptr, size);
+    mutex_unlock(&dvp->cacheops->lock);
+}
+
+void dvp_mem_cache_commit(DVP_Handle handle, DVP_BOOL invalidate)
+{
+    DVP_t *dvp = (DVP_t *)handle;
+    if (dvp && dvp->cacheops)
+    {
+        mutex_lock(&dvp->cacheops->lock);
+        dvp_mem_cache_issue(dvp, dvp->cacheops, DVP_FALSE);
+        if (invalidate)
+            dvp_mem_cache_issue(dvp, dvp->cacheops, DVP_TRUE);
+        mutex_unlock(&dvp->cacheops->lock);
+    }
+}
+
+void dvp_mem_cache_reset(DVP_Handle handle)
+{
+    DVP_t *dvp = (DVP_t *)handle;
+    if (dvp && dvp->cacheops)
+    {
+        mutex_lock(&dvp->cacheops->lock);
+        dvp->cacheops->numClean = 0;
+        mutex_unlock(&dvp->cacheops->lock);
+    }
+}
+
+// allocations are page aligned, so their page numbers are unique keys
+static DVP_VALUE dvp_mem_pin_key(DVP_PTR ptr)
+{
+    return (DVP_VALUE)ptr / DVP_PAGE_SIZE;
+}
+
+DVP_MemPin_t *dvp_mem_pin_init()
+{
+    DVP_MemPin_t *pins = (DVP_MemPin_t *)calloc(1, sizeof(DVP_MemPin_t));
+    if (pins)
+    {
+        mutex_init(&pins->lock);
+        pins->locked = hash_init(HASH_SIZE_SMALL, NULL);
+        if (pins->locked == NULL)
+        {
+            mutex_deinit(&pins->lock);
+            free(pins);
+            pins = NULL;
+        }
+    }
+    return pins;
+}
+
+void dvp_mem_pin_deinit(DVP_Handle handle, DVP_MemPin_t **ppins)
+{
+    DVP_t *dvp = (DVP_t *)handle;
+    if (dvp && ppins && *ppins)
+    {
+        DVP_MemPin_t *pins = *ppins;
+        DVP_PRINT(DVP_ZONE_MEM, "Memory Pins: %u bytes prefaulted, %u bytes still locked, %u failures\n",
+                  pins->stats.prefaulted, pins->stats.locked, pins->stats.failures);
+        // leaked allocations stay mapped, but they are unlocked so they are no
+        // longer charged to the lock limit
+        mutex_lock(&pins->lock);
+        while (hash_length(pins->locked) > 0)
+        {
+            value_t value = 0;
+            hash_clean(pins->locked, &value);
+            if (value)
+            {
+                DVP_MemPin_Range_t *range = (DVP_MemPin_Range_t *)value;
+                allocator_unpin(dvp->mem, dvp_mem_type_xlate(range->mtype), 1, range->ndims, &range->dim, &range->ptr);
+                free(range);
+            }
+        }
+        hash_deinit(pins->locked);
+        mutex_unlock(&pins->lock);
+        mutex_deinit(&pins->lock);
+        free(pins);
+        *ppins = NULL;
+    }
+}
+
+void dvp_mem_pin_set(DVP_Handle handle, DVP_U32 flags)
+{
+    DVP_t *dvp = (DVP_t *)handle;
+    if (dvp && dvp->pins)
+    {
+        mutex_lock(&dvp->pins->lock);
+        dvp->pins->stats.flags = flags;
+        mutex_unlock(&dvp->pins->lock);
+    }
+}
+
+// commits the planes of an allocation as the flags of the handle ask, skipping planes already locked
+static void dvp_mem_pin(DVP_t *dvp, DVP_MemType_e mtype, DVP_S32 nptrs, DVP_S32 ndims, DVP_Dim_t *dims, DVP_PTR *ptrs)
+{
+    DVP_MemPin_t *pins = dvp->pins;
+    DVP_S32 n, p;
+
+    if (pins == NULL || pins->stats.flags == DVP_MEM_PIN_NONE)
+        return;
+
+    mutex_lock(&pins->lock);
+    for (p = 0; p < nptrs; p++)
+    {
+        value_t value = 0;
+        DVP_U32 size = 1;
+        bool_e lock = ((pins->stats.flags & DVP_MEM_PIN_LOCK) ? true_e : false_e);
+
+        if (ptrs[p] == NULL || hash_get(pins->locked, dvp_mem_pin_key(ptrs[p]), &value) == true_e)
+            continue;
+        for (n = 0; n < ndims; n++)
+            size *= dims[p].dims[n];
+        if (allocator_pin(dvp->mem, dvp_mem_type_xlate(mtype), 1, ndims, &dims[p], &ptrs[p], lock) == true_e)
+        {
+            DVP_MemPin_Range_t *range = NULL;
+            if (lock == true_e)
+                range = (DVP_MemPin_Range_t *)calloc(1, sizeof(DVP_MemPin_Range_t));
+            if (range)
+            {
+                range->mtype = mtype;
+                range->ndims = ndims;
+                range->dim = dims[p];
+                range->ptr = ptrs[p];
+                range->size = size;
+                hash_set(pins->locked, dvp_mem_pin_key(ptrs[p]), (value_t)range);
+                pins->stats.locked += size;
+                pins->stats.count++;
+            }
+            else if (lock == true_e) // it could not be remembered, so do not keep it locked
+                allocator_unpin(dvp->mem, dvp_mem_type_xlate(mtype), 1, ndims, &dims[p], &ptrs[p]);
+        }
+        else
+            pins->stats.failures++;
+        pins->stats.prefaulted += size;
+    }
+    mutex_unlock(&pins->lock);
+}
+
+static void dvp_mem_unpin(DVP_t *dvp, DVP_MemType_e mtype, DVP_S32 nptrs, DVP_S32 ndims, DVP_Dim_t *dims, DVP_PTR *ptrs)
+{
+    DVP_MemPin_t *pins = dvp->pins;
+    DVP_S32 p;
+
+    if (pins == NULL)
+        return;
+
+    mutex_lock(&pins->lock);
+    for (p = 0; p < nptrs && pins->stats.count > 0; p++)
+    {
+        value_t value = 0;
+        DVP_MemPin_Range_t *range;
+        if (ptrs[p] == NULL || hash_get(pins->locked, dvp_mem_pin_key(ptrs[p]), &value) == false_e)
+            continue;
+        range = (DVP_MemPin_Range_t *)value;
+        allocator_unpin(dvp->mem, dvp_mem_type_xlate(mtype), 1, ndims, &dims[p], &ptrs[p]);
+        hash_set(pins->locked, dvp_mem_pin_key(ptrs[p]), 0);
+        pins->stats.locked -= range->size;
+        pins->stats.count--;
+        free(range);
+    }
+    mutex_unlock(&pins->lock);
+}
+
 DVP_BOOL dvp_mem_free(DVP_Handle handle,
                       DVP_MemType_e mtype,
                       DVP_S32 nptrs,
@@ -166,6 +517,9 @@ DVP_BOOL dvp_mem_free(DVP_Handle handle,
         dvp_rpc_dissociate(dvp->rpc, dvp->mem, ptrs[p], &hdls[p], size, mtype);
     }
 
+    // locked pages must be unlocked before the allocator reuses them
+    dvp_mem_unpin(dvp, mtype, nptrs, ndims, dims, ptrs);
+
     if (true_e == allocator_free(dvp->mem, dvp_mem_type_xlate(mtype), nptrs, ptrs, hdls))
         return DVP_TRUE;
     else
@@ -205,6 +559,7 @@ DVP_BOOL dvp_mem_calloc(DVP_Handle handle,
             // associate the memory with the remote cores
             dvp_rpc_associate(dvp->rpc, dvp->mem, ptrs[p], hdls[p], size, mtype);
         }
+        dvp_mem_pin(dvp, mtype, nptrs, ndims, dims, ptrs);
     }
     else
     {
@@ -213,6 +568,209 @@ DVP_BOOL dvp_mem_calloc(DVP_Handle handle,
     return ret;
 }
 
+DVP_BOOL dvp_mem_type_virtual(DVP_MemType_e mtype)
+{
+    DVP_U32 t = 0;
+    for (t = 0; t < dimof(mem_correlation); t++)
+    {
+        if (mtype == mem_correlation[t].dmtype)
+            return (mem_correlation[t].amtype == ALLOCATOR_MEMORY_TYPE_VIRTUAL ? DVP_TRUE : DVP_FALSE);
+    }
+    return DVP_FALSE;
+}
+
+static DVP_BOOL dvp_mem_pool_match(DVP_MemPool_Entry_t *e,
+                                   DVP_MemType_e mtype,
+                                   DVP_S32 nptrs,
+                                   DVP_S32 ndims,
+                                   DVP_Dim_t *dims)
+{
+    DVP_S32 n, p;
+    if (e->mtype != mtype || e->nptrs != nptrs || e->ndims != ndims)
+        return DVP_FALSE;
+    for (p = 0; p < nptrs; p++)
+        for (n = 0; n < ndims; n++)
+            if (e->dims[p].dims[n] != dims[p].dims[n])
+                return DVP_FALSE;
+    return DVP_TRUE;
+}
+
+// the lock must be held
+static void dvp_mem_pool_release(DVP_t *dvp, DVP_MemPool_t *pool, DVP_U32 maxBytes, DVP_U32 maxEntries)
+{
+    while (pool->stats.count > 0 && (pool->stats.bytes > maxBytes || pool->stats.count > maxEntries))
+    {
+        DVP_U32 i, oldest = 0;
+        DVP_MemPool_Entry_t *e;
+
+        for (i = 1; i < pool->stats.count; i++)
+        {
+            if ((DVP_S32)(pool->entries[i].age - pool->entries[oldest].age) < 0)
+                oldest = i;
+        }
+        e = &pool->entries[oldest];
+        DVP_PRINT(DVP_ZONE_MEM, "Releasing pooled allocation %p (%u bytes)\n", e->ptrs[0], e->size);
+        dvp_mem_free((DVP_Handle)dvp, e->mtype, e->nptrs, e->ndims, e->dims, e->ptrs);
+        pool->stats.bytes -= e->size;
+        pool->stats.released++;
+        pool->entries[oldest] = pool->entries[--pool->stats.count];
+    }
+}
+
+DVP_MemPool_t *dvp_mem_pool_init()
+{
+    DVP_MemPool_t *pool = (DVP_MemPool_t *)calloc(1, sizeof(DVP_MemPool_t));
+    if (pool)
+    {
+        mutex_init(&pool->lock);
+        pool->stats.limit = DVP_MEM_POOL_DEFAULT_LIMIT;
+    }
+    return pool;
+}
+
+void dvp_mem_pool_deinit(DVP_Handle handle, DVP_MemPool_t **ppool)
+{
+    DVP_t *dvp = (DVP_t *)handle;
+    if (dvp && ppool && *ppool)
+    {
+        DVP_MemPool_t *pool = *ppool;
+        mutex_lock(&pool->lock);
+        DVP_PRINT(DVP_ZONE_MEM, "Memory Pool: %u hits, %u misses, %u recycled, %u released\n",
+                  pool->stats.hits, pool->stats.misses, pool->stats.recycled, pool->stats.released);
+        dvp_mem_pool_release(dvp, pool, 0, 0);
+        mutex_unlock(&pool->lock);
+        mutex_deinit(&pool->lock);
+        free(pool);
+        *ppool = NULL;
+    }
+}
+
+void dvp_mem_pool_trim(DVP_Handle handle, DVP_U32 maxBytes)
+{
+    DVP_t *dvp = (DVP_t *)handle;
+    if (dvp && dvp->pool)
+    {
+        mutex_lock(&dvp->pool->lock);
+        dvp_mem_pool_release(dvp, dvp->pool, maxBytes, DVP_MEM_POOL_MAX_ENTRIES);
+        dvp->pool->stats.limit = maxBytes;
+        mutex_unlock(&dvp->pool->lock);
+    }
+}
+
+DVP_BOOL dvp_mem_pool_calloc(DVP_Handle handle,
+                             DVP_MemType_e mtype,
+                             DVP_S32 nptrs,
+                             DVP_S32 ndims,
+                             DVP_Dim_t *dims,
+                             DVP_PTR *ptrs,
+                             DVP_Dim_t *strides)
+{
+    DVP_t *dvp = (DVP_t *)handle;
+    DVP_MemPool_t *pool = (dvp ? dvp->pool : NULL);
+
+    if (pool && dvp_mem_type_virtual(mtype) &&
+        nptrs > 0 && nptrs <= DVP_MAX_PLANES &&
+        ndims > 0 && ndims <= SOSAL_ALLOCATOR_MAX_DIMS &&
+        dims != NULL && ptrs != NULL && strides != NULL)
+    {
+        DVP_U32 i, found = DVP_MEM_POOL_MAX_ENTRIES;
+
+        mutex_lock(&pool->lock);
+        // take the most recently freed match, it is the most likely to still be in the cache
+        for (i = 0; i < pool->stats.count; i++)
+        {
+            if (dvp_mem_pool_match(&pool->entries[i], mtype, nptrs, ndims, dims) &&
+                (found == DVP_MEM_POOL_MAX_ENTRIES ||
+                 (DVP_S32)(pool->entries[i].age - pool->entries[found].age) > 0))
+                found = i;
+        }
+        if (found < DVP_MEM_POOL_MAX_ENTRIES)
+        {
+            DVP_MemPool_Entry_t *e = &pool->entries[found];
+            memcpy(ptrs, e->ptrs, nptrs * sizeof(DVP_PTR));
+            memcpy(strides, e->strides, nptrs * sizeof(DVP_Dim_t));
+            pool->stats.bytes -= e->size;
+            pool->stats.hits++;
+            pool->entries[found] = pool->entries[--pool->stats.count];
+            mutex_unlock(&pool->lock);
+            // recycled memory was already touched, it only needs locking if it was freed unlocked
+            if (dvp->pins && (dvp->pins->stats.flags & DVP_MEM_PIN_LOCK))
+                dvp_mem_pin(dvp, mtype, nptrs, ndims, dims, ptrs);
+            return DVP_TRUE;
+        }
+        pool->stats.misses++;
+        mutex_unlock(&pool->lock);
+    }
+    return dvp_mem_calloc(handle, mtype, nptrs, ndims, dims, ptrs, strides);
+}
+
+DVP_BOOL dvp_mem_pool_free(DVP_Handle handle,
+                           DVP_MemType_e mtype,
+                           DVP_S32 nptrs,
+                           DVP_S32 ndims,
+                           DVP_Dim_t *dims,
+                           DVP_PTR *ptrs)
+{
+    DVP_t *dvp = (DVP_t *)handle;
+    DVP_MemPool_t *pool = (dvp ? dvp->pool : NULL);
+    DVP_BOOL kept = DVP_FALSE;
+
+    if (pool && dvp_mem_type_virtual(mtype) &&
+        nptrs > 0 && nptrs <= DVP_MAX_PLANES &&
+        ndims > 0 && ndims <= SOSAL_ALLOCATOR_MAX_DIMS &&
+        dims != NULL && ptrs != NULL)
+    {
+        DVP_MemPool_Entry_t *e;
+        DVP_U32 size = 0, s;
+        DVP_S32 n, p;
+
+        for (p = 0; p < nptrs; p++)
+        {
+            if (ptrs[p] == NULL)
+                return dvp_mem_free(handle, mtype, nptrs, ndims, dims, ptrs);
+            s = 1;
+            for (n = 0; n < ndims; n++)
+                s *= dims[p].dims[n];
+            size += s;
+        }
+
+        mutex_lock(&pool->lock);
+        if (size <= pool->stats.limit)
+        {
+            // make room by releasing the oldest allocations
+            dvp_mem_pool_release(dvp, pool, pool->stats.limit - size, DVP_MEM_POOL_MAX_ENTRIES - 1);
+
+            e = &pool->entries[pool->stats.count++];
+            e->mtype = mtype;
+            e->nptrs = nptrs;
+            e->ndims = ndims;
+            e->size = size;
+            e->age = pool->clock++;
+            for (p = 0; p < nptrs; p++)
+            {
+                // the virtual allocator's strides are the running products of the dimensions
+                s = 1;
+                memset(&e->strides[p], 0, sizeof(DVP_Dim_t));
+                for (n = 0; n < ndims; n++)
+                {
+                    s *= dims[p].dims[n];
+                    e->strides[p].dims[n] = s;
+                }
+                e->dims[p] = dims[p];
+                e->ptrs[p] = ptrs[p];
+                ptrs[p] = NULL;
+            }
+            pool->stats.bytes += size;
+            pool->stats.recycled++;
+            kept = DVP_TRUE;
+        }
+        mutex_unlock(&pool->lock);
+    }
+    if (kept == DVP_FALSE)
+        return dvp_mem_free(handle, mtype, nptrs, ndims, dims, ptrs);
+    return DVP_TRUE;
+}
+
 DVP_BOOL dvp_mem_share(DVP_Handle handle,
                        DVP_MemType_e mtype,
                        DVP_S32 nptrs,
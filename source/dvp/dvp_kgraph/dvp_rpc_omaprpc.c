@@ -273,7 +273,7 @@ void dvp_rpc_prepare_image(DVP_RPC_t *rpc, DVP_Core_e core, DVP_Image_t *pImage,
     {
         DVP_U32 planeSize = DVP_Image_PlaneSize(pImage, p);
         if (cached && cacheOp && !pImage->skipCacheOpFlush) {
-            DVP_COMPLAIN_IF_FALSE(dvp_rpc_flush(rpc, core, pImage->pBuffer[p], planeSize, pImage->memType));
+            dvp_mem_cache_read(rpc->handle, core, pImage->pBuffer[p], planeSize, pImage->memType);
         }
 
         {
@@ -340,7 +340,7 @@ void dvp_rpc_return_image(DVP_RPC_t *rpc, DVP_Core_e core, DVP_Image_t *pImage,
         DVP_U32 planeSize = DVP_Image_PlaneSize(pImage, p);
         pImage->pBuffer[p] = dvp_rpc_mem_xlate_back(rpc, core, pImage->pBuffer[p], pImage->memType);
         if (cached && cacheOp && !pImage->skipCacheOpInval) {
-            DVP_COMPLAIN_IF_FALSE(dvp_rpc_invalidate(rpc, core, (DVP_PTR)pImage->pBuffer[p], planeSize, pImage->memType));
+            dvp_mem_cache_written(rpc->handle, core, (DVP_PTR)pImage->pBuffer[p], planeSize, pImage->memType);
         }
     }
 }
@@ -358,7 +358,7 @@ void dvp_rpc_prepare_buffer(DVP_RPC_t *rpc, DVP_Core_e core, DVP_Buffer_t *pBuff
         cached = DVP_FALSE;
 #endif
     if (cached && cacheOp && !pBuffer->skipCacheOpFlush) {
-        DVP_COMPLAIN_IF_FALSE(dvp_rpc_flush(rpc, core, pBuffer->pData, pBuffer->numBytes, pBuffer->memType));
+        dvp_mem_cache_read(rpc->handle, core, pBuffer->pData, pBuffer->numBytes, pBuffer->memType);
     }
 
     if (trans)
@@ -387,7 +387,7 @@ void dvp_rpc_return_buffer(DVP_RPC_t *rpc, DVP_Core_e core, DVP_Buffer_t *pBuffe
 #endif
     pBuffer->pData = dvp_rpc_mem_xlate_back(rpc, core, pBuffer->pData, pBuffer->memType);
     if (cached && cacheOp && !pBuffer->skipCacheOpInval) {
-        DVP_COMPLAIN_IF_FALSE(dvp_rpc_invalidate(rpc, core, (DVP_PTR)pBuffer->pData, pBuffer->numBytes, pBuffer->memType));
+        dvp_mem_cache_written(rpc->handle, core, (DVP_PTR)pBuffer->pData, pBuffer->numBytes, pBuffer->memType);
     }
 }
 
@@ -665,6 +665,9 @@ int dvp_rpc_remote_execute(DVP_RPC_t *rpc, DVP_RPC_Core_t *rpcc, int cliIndex, D
     if (rpc == NULL || rpcc == NULL)
         return 0;
 
+    // the remote core must see what the CPU wrote into the inputs of the run
+    dvp_mem_cache_commit(rpc->handle, DVP_FALSE);
+
     // trans can be NULL if there is nothing to translate
     // remove warnings
     trans = trans;
@@ -681,6 +684,7 @@ int dvp_rpc_remote_execute(DVP_RPC_t *rpc, DVP_RPC_Core_t *rpcc, int cliIndex, D
         numTranslations = trans->numTranslations;
 
     DVP_PerformanceStart(&rpc_perf);
+    trace_begin("rpc", "remote execute", (uint32_t)cliIndex);
 
     // compute the size the structure plus the number of translations times the
     // size of a translation.
@@ -773,6 +777,7 @@ int dvp_rpc_remote_execute(DVP_RPC_t *rpc, DVP_RPC_Core_t *rpcc, int cliIndex, D
 
         free(function);
     }
+    trace_end("rpc", "remote execute", (uint32_t)ret);
     DVP_PerformanceStop(&rpc_perf);
     DVP_PerformancePrint(&rpc_perf, "DVP RPC EXEC");
     return ret;
@@ -672,7 +672,7 @@ void dvp_rpc_prepare_image(DVP_RPC_t *rpc, DVP_Core_e core, DVP_Image_t *pImage,
     {
         DVP_U32 planeSize = DVP_Image_PlaneSize(pImage, p);
         if (cached && cacheOp && !pImage->skipCacheOpFlush) {
-            DVP_COMPLAIN_IF_FALSE(dvp_rpc_flush(rpc, core, pImage->pBuffer[p], planeSize, pImage->memType));
+            dvp_mem_cache_read(rpc->handle, core, pImage->pBuffer[p], planeSize, pImage->memType);
         }
         // @NOTE could the output buffers be accidently written back from the cache during operations?
         pImage->pBuffer[p] = dvp_rpc_mem_xlate_fwrd(rpc, core, pImage->pBuffer[p], planeSize, pImage->memType);
@@ -700,7 +700,7 @@ void dvp_rpc_return_image(DVP_RPC_t *rpc, DVP_Core_e core, DVP_Image_t *pImage,
         DVP_U32 planeSize = DVP_Image_PlaneSize(pImage, p);
         pImage->pBuffer[p] = dvp_rpc_mem_xlate_back(rpc, core, pImage->pBuffer[p], pImage->memType);
         if (cached && cacheOp && !pImage->skipCacheOpInval) {
-            DVP_COMPLAIN_IF_FALSE(dvp_rpc_invalidate(rpc, core, (DVP_PTR)pImage->pBuffer[p], planeSize, pImage->memType));
+            dvp_mem_cache_written(rpc->handle, core, (DVP_PTR)pImage->pBuffer[p], planeSize, pImage->memType);
         }
         // recalculate the pData pointer
         pImage->pData[p] = DVP_Image_Addressing(pImage, pImage->x_start, pImage->y_start, p);
@@ -720,7 +720,7 @@ void dvp_rpc_prepare_buffer(DVP_RPC_t *rpc, DVP_Core_e core, DVP_Buffer_t *pBuff
         cached = DVP_FALSE;
 #endif
     if (cached && cacheOp && !pBuffer->skipCacheOpFlush) {
-        DVP_COMPLAIN_IF_FALSE(dvp_rpc_flush(rpc, core, pBuffer->pData, pBuffer->numBytes, pBuffer->memType));
+        dvp_mem_cache_read(rpc->handle, core, pBuffer->pData, pBuffer->numBytes, pBuffer->memType);
     }
     // @NOTE could the output buffers be accidently written back from the cache during operations?
     pBuffer->pData = dvp_rpc_mem_xlate_fwrd(rpc, core, pBuffer->pData, pBuffer->numBytes, pBuffer->memType);
@@ -735,7 +735,7 @@ void dvp_rpc_return_buffer(DVP_RPC_t *rpc, DVP_Core_e core, DVP_Buffer_t *pBuffe
 #endif
     pBuffer->pData = dvp_rpc_mem_xlate_back(rpc, core, pBuffer->pData, pBuffer->memType);
     if (cached && cacheOp && !pBuffer->skipCacheOpInval) {
-        DVP_COMPLAIN_IF_FALSE(dvp_rpc_invalidate(rpc, core, (DVP_PTR)pBuffer->pData, pBuffer->numBytes, pBuffer->memType));
+        dvp_mem_cache_written(rpc->handle, core, (DVP_PTR)pBuffer->pData, pBuffer->numBytes, pBuffer->memType);
     }
 }
 
@@ -967,6 +967,9 @@ int dvp_rpc_remote_execute(DVP_RPC_t *rpc, DVP_RPC_Core_t *rpcc, int cliIndex, D
     if (rpc == NULL || rpcc == NULL)
         return 0;
 
+    // the remote core must see what the CPU wrote into the inputs of the run
+    dvp_mem_cache_commit(rpc->handle, DVP_FALSE);
+
     // trans can be NULL if there is nothing to translate
     // remove warnings
     trans = trans;
@@ -1017,7 +1020,9 @@ int dvp_rpc_remote_execute(DVP_RPC_t *rpc, DVP_RPC_Core_t *rpcc, int cliIndex, D
 #endif
 
         // call the remote function!
+        trace_begin("rpc", "remote execute", (uint32_t)cliIndex);
         status = RcmClient_exec(rpcc->client.handle, pPacket, &pResponse);
+        trace_end("rpc", "remote execute", (uint32_t)status);
         DVP_PRINT(DVP_ZONE_RPC, "RcmClient_exec returned 0x%08x (result = 0x%08x)\n", status, pPacket->result);
         if (status >= 0)
         {
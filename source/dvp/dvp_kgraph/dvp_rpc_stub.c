@@ -147,6 +147,8 @@ int dvp_rpc_remote_execute(DVP_RPC_t *rpc,
                            DVP_U32 numParams,
                            DVP_RPC_Translation_t *trans)
 {
+    if (rpc)
+        dvp_mem_cache_commit(rpc->handle, DVP_FALSE);
     return 0;
 }
 
@@ -156,7 +158,9 @@ DVP_BOOL dvp_rpc_invalidate(DVP_RPC_t *rpc,
                             DVP_U32 size,
                             DVP_MemType_e mtype)
 {
-    return DVP_FALSE;
+    // there are no remote caches to keep coherent
+    DVP_PRINT(DVP_ZONE_RPC, "Invalidating address:%p for %u bytes type:%d core:%d\n", address, size, mtype, core);
+    return (rpc ? DVP_TRUE : DVP_FALSE);
 }
 
 DVP_BOOL dvp_rpc_flush(DVP_RPC_t *rpc,
@@ -165,7 +169,8 @@ DVP_BOOL dvp_rpc_flush(DVP_RPC_t *rpc,
                        DVP_U32 size,
                        DVP_MemType_e mtype)
 {
-    return DVP_FALSE;
+    DVP_PRINT(DVP_ZONE_RPC, "Flushing address:%p for %u bytes type:%d core:%d\n", address, size, mtype, core);
+    return (rpc ? DVP_TRUE : DVP_FALSE);
 }
 
 void dvp_rpc_prepare_image(DVP_RPC_t *rpc,
@@ -175,7 +180,10 @@ void dvp_rpc_prepare_image(DVP_RPC_t *rpc,
                            DVP_PTR base,
                            DVP_RPC_Translation_t *trans)
 {
-    ; // do nothing
+    DVP_U32 p;
+    if (rpc && cacheOp && !pImage->skipCacheOpFlush)
+        for (p = 0; p < pImage->planes; p++)
+            dvp_mem_cache_read(rpc->handle, core, pImage->pBuffer[p], DVP_Image_PlaneSize(pImage, p), pImage->memType);
 }
 
 void dvp_rpc_return_image(DVP_RPC_t *rpc,
@@ -183,7 +191,10 @@ void dvp_rpc_return_image(DVP_RPC_t *rpc,
                           DVP_Image_t *pImage,
                           DVP_BOOL cacheOp)
 {
-    ; // do nothing
+    DVP_U32 p;
+    if (rpc && cacheOp && !pImage->skipCacheOpInval)
+        for (p = 0; p < pImage->planes; p++)
+            dvp_mem_cache_written(rpc->handle, core, pImage->pBuffer[p], DVP_Image_PlaneSize(pImage, p), pImage->memType);
 }
 
 void dvp_rpc_prepare_buffer(DVP_RPC_t *rpc,
@@ -193,7 +204,8 @@ void dvp_rpc_prepare_buffer(DVP_RPC_t *rpc,
                             DVP_PTR base,
                             DVP_RPC_Translation_t *trans)
 {
-    ; // do nothing
+    if (rpc && cacheOp && !pBuffer->skipCacheOpFlush)
+        dvp_mem_cache_read(rpc->handle, core, pBuffer->pData, pBuffer->numBytes, pBuffer->memType);
 }
 
 void dvp_rpc_return_buffer(DVP_RPC_t *rpc,
@@ -201,7 +213,8 @@ void dvp_rpc_return_buffer(DVP_RPC_t *rpc,
                            DVP_Buffer_t *pBuffer,
                            DVP_BOOL cacheOp)
 {
-    ; // do nothing
+    if (rpc && cacheOp && !pBuffer->skipCacheOpInval)
+        dvp_mem_cache_written(rpc->handle, core, pBuffer->pData, pBuffer->numBytes, pBuffer->memType);
 }
 
 #endif
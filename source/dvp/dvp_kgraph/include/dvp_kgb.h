@@ -67,16 +67,16 @@
  * \ingroup group_dvp_kgb
  */
 typedef struct _dvp_core_load_t {
-    DVP_S32     maximumLoad;
-    DVP_S32     currentLoad;
+    volatile DVP_S32 maximumLoad;
+    volatile DVP_S32 currentLoad;
 } DVP_Core_Load_t;
 
-/*! \brief The system load structure.
+/*! \brief The system load structure, shared by every process using DVP. The
+ * loads of each core are updated with atomic operations.
  * \ingroup group_dvp_kgb
  */
 typedef struct _dvp_load_t {
     bool_e          initialized;
-    semaphore_t     sem;
     DVP_Core_Load_t cores[DVP_CORE_MAX];
 } DVP_Load_t;
 
@@ -101,6 +101,9 @@ typedef struct _dvp_t {
     DVP_Load_t         *loads;
     DVP_RPC_t          *rpc;
     DVP_Mem_t          *mem;
+    DVP_MemPool_t      *pool;
+    DVP_MemPin_t       *pins;
+    DVP_CacheOps_t     *cacheops;
     DVP_GraphLock_t     graphLock;
 } DVP_t;
 
@@ -140,6 +143,23 @@ DVP_U32 DVP_KernelGraphBoss_Verify(DVP_t *dvp,  DVP_KernelGraphSection_t *sectio
  */
 DVP_U32 DVP_KernelGraphBoss_Process(DVP_t *dvp,  DVP_KernelGraphSection_t *section, DVP_BOOL sync);
 
+/*!
+ * \brief This function adds the load of a section to each core in the shared load table.
+ * \param [in] dvp The pointer to the DVP_t context.
+ * \param [in] section The section whose coreLoad is committed.
+ * \return Returns DVP_FALSE and commits nothing if any core would exceed its maximum load.
+ * \ingroup group_dvp_kgb
+ */
+DVP_BOOL DVP_CommitLoad(DVP_t *dvp, DVP_KernelGraphSection_t *section);
+
+/*!
+ * \brief This function removes the load of a section committed by \ref DVP_CommitLoad.
+ * \param [in] dvp The pointer to the DVP_t context.
+ * \param [in] section The section whose coreLoad is removed.
+ * \ingroup group_dvp_kgb
+ */
+void DVP_DecommitLoad(DVP_t *dvp, DVP_KernelGraphSection_t *section);
+
 /*!
  * \brief This function allows the caller to limit max load of a requested core in the shared load table.
  * \param [in] dvp The pointer to the DVP_t context.
@@ -57,6 +57,12 @@ typedef void (*DVP_GraphManagerRestart_f)(void *arg);
  */
 typedef DVP_U32 (*DVP_GraphManager_f)(DVP_KernelNode_t *pSubNodes, DVP_U32 startNode, DVP_U32 numNodes, DVP_BOOL sync);
 
+/*! \brief The optional function pointer to the function which processes the subarray of kernel nodes on a NUMA node.
+ * \see DVP_NUMA_NODE
+ * \ingroup group_dvp_kgm
+ */
+typedef DVP_U32 (*DVP_GraphManagerPlaced_f)(DVP_KernelNode_t *pSubNodes, DVP_U32 startNode, DVP_U32 numNodes, DVP_BOOL sync, DVP_U32 numaNode);
+
 /*! \brief The function pointer to the function which returns the pointer the list of support kernels.
  * \ingroup group_dvp_kgm
  */
@@ -87,6 +93,22 @@ typedef DVP_U32 (*DVP_GetMaximumLoad_f)(void);
  */
 typedef  DVP_U32 (*DVP_KernelGraphManagerVerify_f)(DVP_KernelNode_t *pSubNodes, DVP_U32 startNode, DVP_U32 numNodes);
 
+/*! \brief The optional function pointer to the function which releases whatever the manager kept for the nodes at verify, before they are freed.
+ * \ingroup group_dvp_kgm
+ */
+typedef void (*DVP_KernelGraphManagerRelease_f)(DVP_KernelNode_t *pSubNodes, DVP_U32 startNode, DVP_U32 numNodes);
+
+/*! \brief The maximum number of images a manager describes for a single node.
+ * \ingroup group_dvp_kgm
+ */
+#define DVP_KNODE_MAX_IMAGES (4)
+
+/*! \brief The optional function pointer to the function which lists the images a node reads and writes.
+ * It returns DVP_FALSE when the manager does not describe the kernel of the node.
+ * \ingroup group_dvp_kgm
+ */
+typedef DVP_BOOL (*DVP_KernelGraphManagerImages_f)(DVP_KernelNode_t *pNode, DVP_Image_t *pImages[DVP_KNODE_MAX_IMAGES], DVP_BOOL outputs[DVP_KNODE_MAX_IMAGES], DVP_U32 *pNumImages);
+
 /*!
  * \brief This is the interface structure to a DVP Kernel Graph Manager.
  * \ingroup group_dvp_kgm
@@ -102,6 +124,9 @@ typedef struct _dvp_graph_manager_funcs_t {
     DVP_GraphManagerDeinit_f      deinit;
     DVP_GraphManagerRestart_f     restart;
     DVP_KernelGraphManagerVerify_f verify;
+    DVP_GraphManagerPlaced_f      placed;
+    DVP_KernelGraphManagerRelease_f release;
+    DVP_KernelGraphManagerImages_f images;
 } DVP_GraphManager_Calls_t;
 
 /*! \brief This indicates that the manager's priority is invalid and will not be used.
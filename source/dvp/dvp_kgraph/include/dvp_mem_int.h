@@ -24,7 +24,10 @@
 #define _DVP_MEM_INT_H_
 
 #include <dvp/dvp_types.h>
+#include <dvp/dvp_mem.h>
 #include <sosal/allocator.h>
+#include <sosal/mutex.h>
+#include <sosal/hash.h>
 
 /*! \brief Recasting the SOSAL allocator type as a DVP_Mem_t. 
  * \ingroup group_dvp_mem
@@ -36,6 +39,100 @@ typedef allocator_t DVP_Mem_t;
  */
 typedef allocator_dimensions_t DVP_Dim_t;
 
+/*! \brief The maximum number of freed allocations the memory pool will hold.
+ * \ingroup group_dvp_mem
+ */
+#define DVP_MEM_POOL_MAX_ENTRIES    (32)
+
+/*! \brief The default number of bytes the memory pool may hold.
+ * \ingroup group_dvp_mem
+ */
+#define DVP_MEM_POOL_DEFAULT_LIMIT  (32*1024*1024)
+
+/*! \brief A freed allocation which is held by the memory pool.
+ * \ingroup group_dvp_mem
+ */
+typedef struct _dvp_mem_pool_entry_t {
+    DVP_MemType_e mtype;                    /*!< The memory type of the allocation */
+    DVP_S32       nptrs;                    /*!< The number of pointers */
+    DVP_S32       ndims;                    /*!< The number of valid dimensions */
+    DVP_Dim_t     dims[DVP_MAX_PLANES];     /*!< The dimensions it was allocated with */
+    DVP_Dim_t     strides[DVP_MAX_PLANES];  /*!< The strides it was allocated with */
+    DVP_PTR       ptrs[DVP_MAX_PLANES];     /*!< The pointers, still associated with the remote cores */
+    DVP_U32       size;                     /*!< The number of bytes held */
+    DVP_U32       age;                      /*!< The pool clock when it was freed */
+} DVP_MemPool_Entry_t;
+
+/*! \brief The per handle pool of freed virtual allocations which
+ * \ref dvp_mem_pool_calloc reuses.
+ * \ingroup group_dvp_mem
+ */
+typedef struct _dvp_mem_pool_t {
+    mutex_t             lock;
+    DVP_U32             clock;
+    DVP_MemPool_Entry_t entries[DVP_MEM_POOL_MAX_ENTRIES];
+    DVP_MemPool_Stats_t stats;
+} DVP_MemPool_t;
+
+/*! \brief A plane which \ref dvp_mem_calloc locked, kept so it can be unlocked
+ * even if it is never freed.
+ * \ingroup group_dvp_mem
+ */
+typedef struct _dvp_mem_pin_range_t {
+    DVP_MemType_e       mtype;
+    DVP_S32             ndims;
+    DVP_Dim_t           dim;
+    DVP_PTR             ptr;
+    DVP_U32             size;
+} DVP_MemPin_Range_t;
+
+/*! \brief The per handle record of committed memory which \ref dvp_mem_calloc
+ * prefaults or locks.
+ * \ingroup group_dvp_mem
+ */
+typedef struct _dvp_mem_pin_t {
+    mutex_t             lock;
+    hash_t             *locked;     /*!< The \ref DVP_MemPin_Range_t of each locked plane, keyed by its page number */
+    DVP_MemPin_Stats_t  stats;
+} DVP_MemPin_t;
+
+/*! \brief The maximum number of cache operations which wait for a batch.
+ * \ingroup group_dvp_mem
+ */
+#define DVP_CACHE_OPS_MAX   (64)
+
+/*! \brief The maximum number of buffers remembered as clean in the local caches.
+ * \ingroup group_dvp_mem
+ */
+#define DVP_CACHE_CLEAN_MAX (128)
+
+/*! \brief A range of memory which needs cache maintenance for a remote core.
+ * \ingroup group_dvp_mem
+ */
+typedef struct _dvp_cache_op_t {
+    DVP_Core_e    core;     /*!< The remote core the operation is for */
+    DVP_MemType_e mtype;    /*!< The memory type of the range */
+    DVP_U08      *ptr;      /*!< The local address of the range */
+    DVP_U32       size;     /*!< The size of the range in bytes */
+} DVP_CacheOp_t;
+
+/*! \brief The per handle batch of cache maintenance for the runs on remote
+ * cores. Flushes are issued when the run is sent to the remote core and
+ * invalidates when the KGB next needs the local caches to be coherent.
+ * \ingroup group_dvp_mem
+ */
+typedef struct _dvp_cache_ops_t {
+    mutex_t              lock;
+    DVP_CacheOp_t        flushes[DVP_CACHE_OPS_MAX];
+    DVP_U32              numFlushes;
+    DVP_CacheOp_t        invals[DVP_CACHE_OPS_MAX];
+    DVP_U32              numInvals;
+    DVP_CacheOp_t        clean[DVP_CACHE_CLEAN_MAX];    /*!< The ranges nothing local has written since their last flush or invalidate */
+    DVP_U32              numClean;
+    DVP_U32              nextClean;
+    DVP_CacheOps_Stats_t stats;
+} DVP_CacheOps_t;
+
 /*! \brief This function initializes the DVP memory system.
  * \ingroup group_dvp_mem
  */
@@ -48,6 +145,108 @@ DVP_Mem_t *dvp_mem_init();
  */
 void dvp_mem_deinit(DVP_Mem_t **pmem);
 
+/*! \brief Returns DVP_TRUE if the memory type is plain virtual memory whose
+ * strides only depend on the dimensions.
+ * \ingroup group_dvp_mem
+ */
+DVP_BOOL dvp_mem_type_virtual(DVP_MemType_e mtype);
+
+/*! \brief Creates the record of committed memory of a DVP context.
+ * \ingroup group_dvp_mem
+ */
+DVP_MemPin_t *dvp_mem_pin_init();
+
+/*! \brief Destroys the record of committed memory, unlocking anything still locked.
+ * \param [in] handle The handle to the DVP context.
+ * \param [in] ppins The pointer to the pointer to the record. This will be set to NULL during this call.
+ * \ingroup group_dvp_mem
+ */
+void dvp_mem_pin_deinit(DVP_Handle handle, DVP_MemPin_t **ppins);
+
+/*! \brief Changes the \ref DVP_MemPin_e flags of the later allocations.
+ * \ingroup group_dvp_mem
+ */
+void dvp_mem_pin_set(DVP_Handle handle, DVP_U32 flags);
+
+/*! \brief Creates the batch of cache maintenance of a DVP context.
+ * \ingroup group_dvp_mem
+ */
+DVP_CacheOps_t *dvp_mem_cache_init();
+
+/*! \brief Issues any queued cache maintenance and destroys the batch.
+ * \param [in] handle The handle to the DVP context.
+ * \param [in] pcache The pointer to the pointer to the batch. This will be set to NULL during this call.
+ * \ingroup group_dvp_mem
+ */
+void dvp_mem_cache_deinit(DVP_Handle handle, DVP_CacheOps_t **pcache);
+
+/*! \brief Queues a flush of a range a remote core is about to read, unless
+ * nothing local has written it since it was last flushed or invalidated.
+ * \ingroup group_dvp_mem
+ */
+void dvp_mem_cache_read(DVP_Handle handle, DVP_Core_e core, DVP_PTR ptr, DVP_U32 size, DVP_MemType_e mtype);
+
+/*! \brief Queues an invalidate of a range a remote core has written.
+ * \ingroup group_dvp_mem
+ */
+void dvp_mem_cache_written(DVP_Handle handle, DVP_Core_e core, DVP_PTR ptr, DVP_U32 size, DVP_MemType_e mtype);
+
+/*! \brief Issues the queued flushes, then the queued invalidates if asked,
+ * fusing the ranges which touch.
+ * \ingroup group_dvp_mem
+ */
+void dvp_mem_cache_commit(DVP_Handle handle, DVP_BOOL invalidate);
+
+/*! \brief Forgets which ranges are clean, as the local core may have written any of them.
+ * \ingroup group_dvp_mem
+ */
+void dvp_mem_cache_reset(DVP_Handle handle);
+
+/*! \brief Creates the memory pool of a DVP context.
+ * \ingroup group_dvp_mem
+ */
+DVP_MemPool_t *dvp_mem_pool_init();
+
+/*! \brief Returns all the allocations held by the memory pool to the allocator
+ * and destroys the pool.
+ * \param [in] handle The handle to the DVP context. The remote cores must still be connected.
+ * \param [in] ppool The pointer to the pointer to the pool. This will be set to NULL during this call.
+ * \ingroup group_dvp_mem
+ */
+void dvp_mem_pool_deinit(DVP_Handle handle, DVP_MemPool_t **ppool);
+
+/*! \brief Releases the oldest allocations held by the memory pool until it
+ * holds no more than maxBytes, then makes maxBytes the limit of the pool.
+ * \param [in] handle The handle to the DVP context.
+ * \param [in] maxBytes The new limit. Zero disables the pool.
+ * \ingroup group_dvp_mem
+ */
+void dvp_mem_pool_trim(DVP_Handle handle, DVP_U32 maxBytes);
+
+/*! \brief Allocates like \ref dvp_mem_calloc but first tries to reuse a freed
+ * allocation of the same type and dimensions from the memory pool.
+ * \note Reused memory is not cleared.
+ * \ingroup group_dvp_mem
+ */
+DVP_BOOL dvp_mem_pool_calloc(DVP_Handle handle,
+                             DVP_MemType_e mtype,
+                             DVP_S32 nptrs,
+                             DVP_S32 ndims,
+                             DVP_Dim_t *dims,
+                             DVP_PTR *ptrs,
+                             DVP_Dim_t *strides);
+
+/*! \brief Frees like \ref dvp_mem_free but keeps virtual allocations in the
+ * memory pool while it has room, evicting the oldest ones first.
+ * \ingroup group_dvp_mem
+ */
+DVP_BOOL dvp_mem_pool_free(DVP_Handle handle,
+                           DVP_MemType_e mtype,
+                           DVP_S32 nptrs,
+                           DVP_S32 ndims,
+                           DVP_Dim_t *dims,
+                           DVP_PTR *ptrs);
+
 /*! \brief Frees a multidimensional, multipointer buffer. 
  * \param [in] handle The handle to the DVP context. 
  * \param [in] mtype The memory type required. 
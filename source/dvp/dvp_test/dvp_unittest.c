@@ -17,13 +17,29 @@
 #include <dvp/dvp.h>
 #include <dvp/dvp_debug.h>
 
-#if defined(DVP_USE_YUV)
+#if !defined(DVP_USE_IPC)
+#include <dvp_kgb.h>
+#endif
+
+#if defined(POSIX)
+#include <sys/wait.h>
+#endif
+
+#if defined(DVP_USE_YUV) || defined(DVP_USE_YUV_C)
 #include <yuv/dvp_kl_yuv.h>
 #endif
 
-#if defined(DVP_USE_VRUN)
+#if defined(DVP_USE_VRUN) || defined(DVP_USE_LDC)
 #include <vrun/dvp_kl_vrun.h>
 #endif
+
+#if defined(DVP_USE_DEI_C)
+#include <dei/dvp_kl_dei.h>
+#endif
+
+#if defined(DVP_USE_DSPLIB_C)
+#include <dsplib/dvp_kl_dsplib.h>
+#endif
 #include "dvp_unittest_data.h"
 
 #define HERE {printf("=======> UNITTEST - %d <=======\n", __LINE__);fflush(stdout);}
@@ -241,6 +257,351 @@ status_e dvp_cpu_nop_test(void)
     return status;
 }
 
+/*! \brief Tests that the latency histograms of a graph, its sections and its
+ * nodes see every run.
+ * \return Returns status_e
+ * \retval STATUS_SUCCESS on success.
+ * \retval STATUS_FAILURE on failure.
+ * \ingroup group_tests
+ */
+status_e dvp_perf_histogram_test(void)
+{
+    status_e status = STATUS_FAILURE;
+    DVP_Handle dvp = DVP_KernelGraph_Init();
+    if (dvp)
+    {
+        DVP_U32 numNodes = 2;
+        DVP_U32 numSections = 1;
+        DVP_U32 numRuns = 100;
+        DVP_KernelNode_t *nodes = DVP_KernelNode_Alloc(dvp, numNodes);
+        if (nodes)
+        {
+            DVP_KernelGraph_t *graph = DVP_KernelGraph_Alloc(dvp, numSections);
+            if (graph)
+            {
+                if (DVP_KernelGraphSection_Init(dvp, graph, 0, nodes, numNodes) == DVP_SUCCESS &&
+                    DVP_PerformanceHistograms(dvp, graph, DVP_TRUE) == DVP_TRUE)
+                {
+                    DVP_U32 r, numNodesExecuted = 0;
+
+                    nodes[0].header.kernel = DVP_KN_NOOP;
+                    nodes[0].header.affinity = DVP_CORE_CPU;
+                    nodes[1].header.kernel = DVP_KN_NOOP;
+                    nodes[1].header.affinity = DVP_CORE_CPU;
+
+                    for (r = 0; r < numRuns; r++)
+                    {
+                        numNodesExecuted = 0;
+                        if (DVP_KernelGraph_Process(dvp, graph, &numNodesExecuted, dvp_section_complete) != numSections)
+                            break;
+                    }
+                    if (r == numRuns &&
+                        DVP_Perf_Samples(&graph->totalperf) == numRuns &&
+                        DVP_Perf_Samples(&graph->sections[0].perf) == numRuns &&
+                        DVP_Perf_Samples(&nodes[0].header.perf) == numRuns &&
+                        DVP_Perf_Samples(&nodes[1].header.perf) == numRuns &&
+                        DVP_Perf_Percentile(&graph->totalperf, 50.0) <= DVP_Perf_Percentile(&graph->totalperf, 99.9))
+                    {
+                        status = STATUS_SUCCESS;
+                    }
+                    DVP_PrintPerformanceCSV(dvp, nodes, numNodes);
+                    DVP_PrintPerformanceGraph(dvp, graph);
+
+                    // clearing the nodes keeps their histograms but empties them
+                    DVP_PerformanceClear(dvp, nodes, numNodes);
+                    if (DVP_Perf_Samples(&nodes[0].header.perf) != 0)
+                        status = STATUS_FAILURE;
+                    DVP_KernelGraph_Process(dvp, graph, &numNodesExecuted, dvp_section_complete);
+                    if (DVP_Perf_Samples(&nodes[0].header.perf) != 1)
+                        status = STATUS_FAILURE;
+
+                    // clearing the graph's own structure keeps its histogram too
+                    DVP_Perf_Clear(&graph->totalperf);
+                    if (DVP_Perf_Samples(&graph->totalperf) != 0)
+                        status = STATUS_FAILURE;
+                }
+                DVP_KernelGraph_Free(dvp, graph);
+                graph = NULL;
+            }
+            DVP_KernelNode_Free(dvp, nodes, numNodes);
+            nodes = NULL;
+        }
+        DVP_KernelGraph_Deinit(dvp);
+    }
+    return status;
+}
+
+#if defined(POSIX)
+/*! \brief Counts the occurrences of a string in a file. */
+static DVP_U32 dvp_trace_count(const char *filename, const char *str)
+{
+    DVP_U32 count = 0;
+    FILE *fp = fopen(filename, "r");
+    if (fp)
+    {
+        char line[256];
+        while (fgets(line, sizeof(line), fp))
+            if (strstr(line, str))
+                count++;
+        fclose(fp);
+    }
+    return count;
+}
+
+/*! \brief Traces two parallel sections through \ref DVP_TRACE_ENV and checks
+ * that the graph, the sections, the manager calls and the kernels of the CPU
+ * manager module were all recorded.
+ * \return Returns status_e
+ * \retval STATUS_SUCCESS on success.
+ * \retval STATUS_FAILURE on failure.
+ * \ingroup group_tests
+ */
+status_e dvp_trace_test(void)
+{
+    status_e status = STATUS_FAILURE;
+    DVP_Handle dvp = 0;
+    DVP_U32 numRuns = 10;
+    char filename[] = "/tmp/dvp_trace_XXXXXX";
+    int fd = mkstemp(filename);
+
+    if (fd < 0)
+        return STATUS_FAILURE;
+    close(fd);
+    setenv(DVP_TRACE_ENV, filename, 1);
+
+    dvp = DVP_KernelGraph_Init();
+    if (dvp)
+    {
+        DVP_KernelNode_t *nodes = DVP_KernelNode_Alloc(dvp, 2);
+        DVP_KernelGraph_t *graph = DVP_KernelGraph_Alloc(dvp, 2);
+        if (nodes && graph)
+        {
+            DVP_U32 r, n, numNodesExecuted = 0;
+            for (n = 0; n < 2; n++)
+            {
+                nodes[n].header.kernel = DVP_KN_NOOP;
+                nodes[n].header.affinity = DVP_CORE_CPU;
+                DVP_KernelGraphSection_Init(dvp, graph, n, &nodes[n], 1);
+                graph->order[n] = 0;
+            }
+            for (r = 0; r < numRuns; r++)
+                if (DVP_KernelGraph_Process(dvp, graph, &numNodesExecuted, dvp_section_complete) != 2)
+                    break;
+            if (r == numRuns)
+                status = STATUS_SUCCESS;
+        }
+        if (graph)
+            DVP_KernelGraph_Free(dvp, graph);
+        if (nodes)
+            DVP_KernelNode_Free(dvp, nodes, 2);
+        DVP_KernelGraph_Deinit(dvp);
+    }
+    unsetenv(DVP_TRACE_ENV);
+    trace_deinit();
+
+    if (status == STATUS_SUCCESS &&
+        (dvp_trace_count(filename, "\"traceEvents\":[") != 1 ||
+         dvp_trace_count(filename, "\"name\":\"graph\",\"cat\":\"dvp\",\"ph\":\"B\"") != numRuns ||
+         dvp_trace_count(filename, "\"name\":\"section dispatch\"") != 2 * numRuns ||
+         dvp_trace_count(filename, "\"name\":\"section\",\"cat\":\"dvp\",\"ph\":\"E\"") != 2 * numRuns ||
+         dvp_trace_count(filename, "\"name\":\"cpu\",\"cat\":\"dvp\",\"ph\":\"B\"") != 2 * numRuns ||
+         dvp_trace_count(filename, "\"cat\":\"cpu\",\"ph\":\"E\"") != 2 * numRuns))
+    {
+        DVP_PRINT(DVP_ZONE_ERROR, "The trace in %s is missing events!\n", filename);
+        status = STATUS_FAILURE;
+    }
+    unlink(filename);
+    return status;
+}
+#endif
+
+#if defined(POSIX) && !defined(DVP_USE_IPC)
+#define DVP_LOAD_TEST_PROCESSES (4)
+#define DVP_LOAD_TEST_RUNS      (1000)
+
+/*! \brief Runs a CPU section which claims a share of the CPU load, in its own
+ * process, once the parent lets it go.
+ * \return Returns the exit code of the process.
+ */
+static int dvp_load_contention_child(int ready, int go)
+{
+    int ret = 1;
+    DVP_Handle dvp = DVP_KernelGraph_Init();
+    char c = 0;
+
+    // every child attaches to the table before any detaches from it
+    if (write(ready, &c, 1) != 1 || read(go, &c, 1) != 0 || dvp == 0)
+    {
+        if (dvp)
+            DVP_KernelGraph_Deinit(dvp);
+        return ret;
+    }
+    else
+    {
+        DVP_KernelNode_t *nodes = DVP_KernelNode_Alloc(dvp, 1);
+        DVP_KernelGraph_t *graph = DVP_KernelGraph_Alloc(dvp, 1);
+        if (nodes && graph)
+        {
+            DVP_U32 r, hwMaxLoad = 0, numNodesExecuted = 0;
+            DVP_U32 maxLoad = DVP_GetMaxLoad((DVP_t *)dvp, DVP_CORE_CPU, &hwMaxLoad);
+            rtime_t start;
+
+            nodes[0].header.kernel = DVP_KN_NOOP;
+            nodes[0].header.affinity = DVP_CORE_CPU;
+            DVP_KernelGraphSection_Init(dvp, graph, 0, nodes, 1);
+            if (DVP_KernelGraph_Verify(dvp, graph) == DVP_TRUE)
+            {
+                // together the children exactly fill the CPU, so a lost update fails a commit
+                graph->sections[0].coreLoad[DVP_CORE_CPU] = maxLoad / DVP_LOAD_TEST_PROCESSES;
+                start = rtimer_now();
+                for (r = 0; r < DVP_LOAD_TEST_RUNS; r++)
+                    if (DVP_KernelGraph_Process(dvp, graph, &numNodesExecuted, dvp_section_complete) != 1)
+                        break;
+                DVP_PRINT(DVP_ZONE_ALWAYS, "Process %d ran %u sections at %lf us each\n", getpid(), r,
+                          (double)rtimer_to_us(rtimer_now() - start) / DVP_LOAD_TEST_RUNS);
+                if (r == DVP_LOAD_TEST_RUNS)
+                    ret = 0;
+            }
+        }
+        if (graph)
+            DVP_KernelGraph_Free(dvp, graph);
+        if (nodes)
+            DVP_KernelNode_Free(dvp, nodes, 1);
+        DVP_KernelGraph_Deinit(dvp);
+    }
+    fflush(stdout); // the child leaves with _exit
+    return ret;
+}
+
+/*! \brief Checks the capacity rules of \ref DVP_CommitLoad and then processes
+ * sections in several processes, each with its own DVP handle, which share the
+ * load table.
+ * \return Returns status_e
+ * \retval STATUS_SUCCESS on success.
+ * \retval STATUS_FAILURE on failure.
+ * \ingroup group_tests
+ */
+status_e dvp_load_contention_test(void)
+{
+    status_e status = STATUS_FAILURE;
+    DVP_Handle dvp = DVP_KernelGraph_Init();
+    shared_t *shm = NULL;
+    DVP_Load_t *loads = NULL;
+    pid_t pids[DVP_LOAD_TEST_PROCESSES];
+    int ready[2], go[2];
+    DVP_U32 p, numStarted = 0;
+
+    if (dvp)
+    {
+        DVP_t *pdvp = (DVP_t *)dvp;
+        DVP_KernelGraphSection_t section;
+        DVP_U32 hwMaxLoad = 0;
+        DVP_S32 maxLoad = (DVP_S32)DVP_GetMaxLoad(pdvp, DVP_CORE_CPU, &hwMaxLoad);
+        DVP_S32 before = pdvp->loads->cores[DVP_CORE_CPU].currentLoad;
+        DVP_Core_e other;
+
+        memset(&section, 0, sizeof(section));
+        section.numNodes = 1;
+        section.coreLoad[DVP_CORE_CPU] = maxLoad / 2;
+        // a core with no capacity fails the commit after the CPU was claimed
+        for (other = DVP_CORE_CPU + 1; other < DVP_CORE_MAX; other++)
+            if (pdvp->loads->cores[other].maximumLoad == 0)
+                break;
+
+        if (maxLoad > 0 &&
+            DVP_CommitLoad(pdvp, &section) == DVP_TRUE &&
+            DVP_CommitLoad(pdvp, &section) == DVP_TRUE &&
+            DVP_CommitLoad(pdvp, &section) == DVP_FALSE &&
+            pdvp->loads->cores[DVP_CORE_CPU].currentLoad == before + 2 * (maxLoad / 2))
+        {
+            DVP_DecommitLoad(pdvp, &section);
+            DVP_DecommitLoad(pdvp, &section);
+            DVP_SetCoreCapacity(dvp, DVP_CORE_CPU, DVP_CAPACITY_DATA_RANGE / 4);
+            if (DVP_CommitLoad(pdvp, &section) == DVP_FALSE)
+            {
+                status = STATUS_SUCCESS;
+                if (other < DVP_CORE_MAX)
+                {
+                    section.coreLoad[DVP_CORE_CPU] = 1;
+                    section.coreLoad[other] = 1;
+                    if (DVP_CommitLoad(pdvp, &section) == DVP_TRUE)
+                        status = STATUS_FAILURE;
+                }
+            }
+            DVP_SetCoreCapacity(dvp, DVP_CORE_CPU, DVP_CAPACITY_DATA_RANGE);
+        }
+        if (pdvp->loads->cores[DVP_CORE_CPU].currentLoad != before)
+        {
+            DVP_PRINT(DVP_ZONE_ERROR, "The CPU load was left at %d!\n", pdvp->loads->cores[DVP_CORE_CPU].currentLoad);
+            status = STATUS_FAILURE;
+        }
+        DVP_KernelGraph_Deinit(dvp);
+    }
+    if (status != STATUS_SUCCESS)
+        return status;
+
+    // holds the table for the final check, the children attach to the same one
+    shm = shared_alloc(DVP_LOAD_TABLE_NAME, sizeof(DVP_Load_t));
+    if (shm == NULL)
+        return STATUS_NOT_IMPLEMENTED;
+    loads = (DVP_Load_t *)shm->data;
+    if (pipe(ready) != 0)
+    {
+        shared_free(&shm);
+        return STATUS_FAILURE;
+    }
+    if (pipe(go) != 0)
+    {
+        close(ready[0]);
+        close(ready[1]);
+        shared_free(&shm);
+        return STATUS_FAILURE;
+    }
+    fflush(stdout);
+    for (p = 0; p < DVP_LOAD_TEST_PROCESSES; p++)
+    {
+        pids[p] = fork();
+        if (pids[p] == 0)
+        {
+            close(ready[0]);
+            close(go[1]);
+            _exit(dvp_load_contention_child(ready[1], go[0]));
+        }
+        else if (pids[p] < 0)
+            break;
+        numStarted++;
+    }
+    close(ready[1]);
+    close(go[0]);
+    // wait for every child to attach, then release them together
+    for (p = 0; p < numStarted; p++)
+    {
+        char c;
+        if (read(ready[0], &c, 1) != 1)
+            break;
+    }
+    close(go[1]);
+    close(ready[0]);
+
+    status = (numStarted == DVP_LOAD_TEST_PROCESSES ? STATUS_SUCCESS : STATUS_FAILURE);
+    for (p = 0; p < numStarted; p++)
+    {
+        int code = 0;
+        if (waitpid(pids[p], &code, 0) != pids[p] || !WIFEXITED(code) || WEXITSTATUS(code) != 0)
+        {
+            DVP_PRINT(DVP_ZONE_ERROR, "Process %d failed!\n", pids[p]);
+            status = STATUS_FAILURE;
+        }
+    }
+    if (loads->cores[DVP_CORE_CPU].currentLoad != 0)
+    {
+        DVP_PRINT(DVP_ZONE_ERROR, "The processes left a CPU load of %d!\n", loads->cores[DVP_CORE_CPU].currentLoad);
+        status = STATUS_FAILURE;
+    }
+    shared_free(&shm);
+    return status;
+}
+#endif
 
 /*! \brief Tests a serial array of nodes graph on all available cores.
  * \return Returns status_e
@@ -371,6 +732,66 @@ status_e dvp_parallel_nop_test(void)
     return status;
 }
 
+/*! \brief Times graphs of 1 to 4 parallel sections, each with one CPU no-op
+ * node, to show how the sections scale as they are added.
+ * \return Returns status_e
+ * \retval STATUS_SUCCESS on success.
+ * \retval STATUS_FAILURE on failure.
+ * \ingroup group_tests
+ */
+status_e dvp_section_scaling_test(void)
+{
+    status_e status = STATUS_FAILURE;
+    DVP_Handle dvp = DVP_KernelGraph_Init();
+    if (dvp)
+    {
+        DVP_U32 numSections, numNodes = 4;
+        DVP_KernelNode_t *nodes = DVP_KernelNode_Alloc(dvp, numNodes);
+        status = (nodes ? STATUS_SUCCESS : STATUS_NOT_ENOUGH_MEMORY);
+        for (numSections = 1; numSections <= numNodes && status == STATUS_SUCCESS; numSections++)
+        {
+            DVP_KernelGraph_t *graph = DVP_KernelGraph_Alloc(dvp, numSections);
+            DVP_U32 s, i, numRuns = 200;
+            rtime_t start;
+
+            if (graph == NULL)
+            {
+                status = STATUS_NOT_ENOUGH_MEMORY;
+                break;
+            }
+            for (s = 0; s < numSections; s++)
+            {
+                nodes[s].header.kernel = DVP_KN_NOOP;
+                nodes[s].header.affinity = DVP_CORE_CPU;
+                if (DVP_KernelGraphSection_Init(dvp, graph, s, &nodes[s], 1) != DVP_SUCCESS)
+                    status = STATUS_NOT_ENOUGH_MEMORY;
+            }
+            start = rtimer_now();
+            for (i = 0; i < numRuns && status == STATUS_SUCCESS; i++)
+            {
+                if (DVP_KernelGraph_Process(dvp, graph, NULL, NULL) != numSections)
+                    status = STATUS_FAILURE;
+            }
+            start = rtimer_now() - start;
+            for (s = 0; s < numSections; s++)
+            {
+                if (status == STATUS_SUCCESS && graph->sections[s].perf.numTimes != numRuns)
+                {
+                    DVP_PRINT(DVP_ZONE_ERROR, "Section %u ran %u of %u times!\n", s, graph->sections[s].perf.numTimes, numRuns);
+                    status = STATUS_FAILURE;
+                }
+            }
+            DVP_PRINT(DVP_ZONE_ALWAYS, "%u parallel sections took %lf us per graph, %lf us per section\n", numSections,
+                      (double)rtimer_to_us(start) / numRuns, (double)rtimer_to_us(start) / (numRuns * numSections));
+            DVP_KernelGraph_Free(dvp, graph);
+        }
+        if (nodes)
+            DVP_KernelNode_Free(dvp, nodes, numNodes);
+        DVP_KernelGraph_Deinit(dvp);
+    }
+    return status;
+}
+
 /*! \brief Tests a set of copy nodes in series on all available cores.
  * \return Returns status_e
  * \retval STATUS_SUCCESS on success.
@@ -462,6 +883,87 @@ status_e dvp_copy_test(void)
 #undef height
 }
 
+/*! \brief Tests that a chain of copies still produces its input after its
+ * intermediate images have been aliased at verify.
+ * \return Returns status_e
+ * \retval STATUS_SUCCESS on success.
+ * \retval STATUS_FAILURE on failure.
+ * \ingroup group_tests
+ */
+status_e dvp_alias_test(void)
+{
+    status_e status = STATUS_FAILURE;
+    DVP_Handle dvp = DVP_KernelGraph_Init();
+    if (dvp)
+    {
+        DVP_U32 numSections = 1;
+        DVP_U32 numNodes = 4;
+        DVP_U32 numNodesExecuted = 0;
+        DVP_KernelNode_t *nodes = DVP_KernelNode_Alloc(dvp, numNodes);
+        DVP_KernelGraph_t *graph = DVP_KernelGraph_Alloc(dvp, numSections);
+        DVP_Image_t images[5];
+        DVP_U32 n;
+        DVP_BOOL allocated = DVP_TRUE;
+
+        for (n = 0; n < dimof(images); n++)
+        {
+            DVP_Image_Init(&images[n], width, height, FOURCC_NV12);
+            if (DVP_Image_Alloc(dvp, &images[n], DVP_MTYPE_MPUCACHED_VIRTUAL) == DVP_FALSE)
+                allocated = DVP_FALSE;
+        }
+        if (allocated)
+        {
+            DVP_S08 *ptr = (DVP_S08 *)malloc(images[0].numBytes);
+            if (ptr)
+            {
+                for (n = 0; n < images[0].numBytes; n++)
+                    ptr[n] = (DVP_S08)(n * 7);
+                DVP_Image_Fill(&images[0], ptr, images[0].numBytes);
+                free(ptr);
+            }
+        }
+
+        if (nodes && graph && allocated &&
+            DVP_KernelGraphSection_Init(dvp, graph, 0, nodes, numNodes) == DVP_SUCCESS)
+        {
+            DVP_Transform_t *pT[4];
+            for (n = 0; n < numNodes; n++)
+            {
+                nodes[n].header.kernel = DVP_KN_COPY;
+                nodes[n].header.affinity = DVP_CORE_CPU;
+                pT[n] = dvp_knode_to(&nodes[n], DVP_Transform_t);
+                pT[n]->input = images[n];
+                pT[n]->output = images[n+1];
+            }
+            graph->aliasImages = DVP_TRUE;
+
+            // the first and last intermediates never live at the same time,
+            // the input and the output of the graph are never aliased
+            if (DVP_KernelGraph_Verify(dvp, graph) == DVP_TRUE &&
+                pT[2]->output.pBuffer[0] == images[1].pBuffer[0] &&
+                pT[3]->input.pBuffer[1] == images[1].pBuffer[1] &&
+                pT[1]->output.pBuffer[0] == images[2].pBuffer[0] &&
+                pT[0]->input.pBuffer[0] == images[0].pBuffer[0] &&
+                pT[3]->output.pBuffer[0] == images[4].pBuffer[0] &&
+                DVP_KernelGraph_Process(dvp, graph, &numNodesExecuted, dvp_section_complete) == numSections &&
+                dvp_get_error_from_nodes(nodes, numNodes) == DVP_SUCCESS &&
+                DVP_Image_Equal(&images[4], &images[0]) == DVP_TRUE)
+                status = STATUS_SUCCESS;
+            else
+                DVP_PRINT(DVP_ZONE_ERROR, "Aliased images %p %p %p\n",
+                          pT[0]->output.pBuffer[0], pT[1]->output.pBuffer[0], pT[2]->output.pBuffer[0]);
+        }
+        for (n = 0; n < dimof(images); n++)
+            DVP_Image_Free(dvp, &images[n]);
+        if (graph)
+            DVP_KernelGraph_Free(dvp, graph);
+        if (nodes)
+            DVP_KernelNode_Free(dvp, nodes, numNodes);
+        DVP_KernelGraph_Deinit(dvp);
+    }
+    return status;
+}
+
 /*! \brief Tests a serial/parallel/serial copy graph on all available cores.
  * \return Returns status_e
  * \retval STATUS_SUCCESS on success.
@@ -677,56 +1179,809 @@ status_e dvp_split_cc_test(void)
                     DVP_Image_Dup(&io[0]->input, &images[0]);
                     DVP_Image_Dup(&io[0]->output, &images[1]);
 
-                    nodes[1].header.kernel = DVP_KN_YUV_ARGB_TO_UYVY;
-                    nodes[1].header.affinity = DVP_CORE_CPU;
-                    io[1] = dvp_knode_to(&nodes[1],DVP_Transform_t);
-                    DVP_Image_Dup(&io[1]->input, &images[0]);
-                    DVP_Image_Dup(&io[1]->output, &images[1]);
+                    nodes[1].header.kernel = DVP_KN_YUV_ARGB_TO_UYVY;
+                    nodes[1].header.affinity = DVP_CORE_CPU;
+                    io[1] = dvp_knode_to(&nodes[1],DVP_Transform_t);
+                    DVP_Image_Dup(&io[1]->input, &images[0]);
+                    DVP_Image_Dup(&io[1]->output, &images[1]);
+
+                    // now perform some arimethic on the pointers to make each
+                    // node cover half the image.
+                    img[0] = &io[0]->input;
+                    img[1] = &io[0]->output;
+                    img[2] = &io[1]->input;
+                    img[3] = &io[1]->output;
+
+                    img[0]->height /= 2;
+                    img[1]->height /= 2;
+                    img[2]->height /= 2;
+                    img[3]->height /= 2;
+
+                    // move the pointer 1/2 down the image
+                    img[2]->pData[0] = &img[2]->pData[0][img[2]->height * img[2]->y_stride];
+                    img[3]->pData[0] = &img[3]->pData[0][img[3]->height * img[3]->y_stride];
+
+                    // assign each node to a separate section
+                    DVP_KernelGraphSection_Init(dvp, graph, 0, &nodes[0], 1);
+                    DVP_KernelGraphSection_Init(dvp, graph, 1, &nodes[1], 1);
+
+                    numSectionsRun = DVP_KernelGraph_Process(dvp, graph, &numNodesExecuted, dvp_section_complete);
+                    err = dvp_get_error_from_nodes(nodes, numNodes);
+                    if (numSectionsRun == numSections && numNodesExecuted == numNodes && err == DVP_SUCCESS)
+                    {
+                        status = STATUS_SUCCESS;
+                    }
+
+                    DVP_Image_Free(dvp, &images[0]);
+                    DVP_Image_Free(dvp, &images[1]);
+
+                    DVP_PRINT(DVP_ZONE_ALWAYS, "CPU CC processed %u sections, %u nodes, first DVP_Error_e=%d\n", numSectionsRun, numNodesExecuted, err);
+                    DVP_PrintPerformanceGraph(dvp, graph);
+                }
+                DVP_KernelGraph_Free(dvp, graph);
+                graph = NULL;
+            }
+            DVP_KernelNode_Free(dvp, nodes, numNodes);
+            nodes = NULL;
+        }
+        DVP_KernelGraph_Deinit(dvp);
+    }
+    return status;
+}
+#endif
+#if defined(DVP_USE_YUV) || defined(DVP_USE_YUV_C)
+/*! \brief Tests the rotation and mirroring kernels against a per-pixel
+ * reference and checks that the 90 degree rotations undo each other. The
+ * dimensions are not multiples of the tile size so the edges are covered too.
+ * \return Returns status_e
+ * \retval STATUS_SUCCESS on success.
+ * \retval STATUS_FAILURE on failure.
+ * \ingroup group_tests
+ */
+status_e dvp_rotate_test(void)
+{
+    status_e status = STATUS_FAILURE;
+    DVP_U32 width = 104, height = 72;
+    DVP_U32 numNodes = 7;
+    DVP_U32 numNodesExecuted = 0;
+    DVP_U32 numSectionsRun = 0;
+    DVP_Image_t luma[4];
+    DVP_Image_t uyvy[5];
+    DVP_Image_t yu16[3];
+    DVP_KernelNode_t *nodes = NULL;
+    DVP_KernelGraph_t *graph = NULL;
+    DVP_Transform_t *pT;
+    DVP_Error_e err = DVP_SUCCESS;
+    DVP_U32 n, x, y;
+    DVP_Handle dvp = DVP_KernelGraph_Init();
+    if (dvp == 0)
+        return status;
+
+    DVP_Image_Init(&luma[0], width, height, FOURCC_Y800);
+    DVP_Image_Init(&luma[1], height, width, FOURCC_Y800);
+    DVP_Image_Init(&luma[2], width, height, FOURCC_Y800);
+    DVP_Image_Init(&luma[3], width, height, FOURCC_Y800);
+    DVP_Image_Init(&uyvy[0], width, height, FOURCC_UYVY);
+    DVP_Image_Init(&uyvy[1], height, width, FOURCC_UYVY);
+    DVP_Image_Init(&uyvy[2], width, height, FOURCC_UYVY);
+    DVP_Image_Init(&uyvy[3], width, height, FOURCC_UYVY);
+    DVP_Image_Init(&uyvy[4], width, height, FOURCC_UYVY);
+    DVP_Image_Init(&yu16[0], width, height, FOURCC_YU16);
+    DVP_Image_Init(&yu16[1], height, width, FOURCC_YU16);
+    DVP_Image_Init(&yu16[2], width, height, FOURCC_YU16);
+    for (n = 0; n < dimof(luma); n++)
+        DVP_Image_Alloc(dvp, &luma[n], DVP_MTYPE_DEFAULT);
+    for (n = 0; n < dimof(uyvy); n++)
+        DVP_Image_Alloc(dvp, &uyvy[n], DVP_MTYPE_DEFAULT);
+    for (n = 0; n < dimof(yu16); n++)
+        DVP_Image_Alloc(dvp, &yu16[n], DVP_MTYPE_DEFAULT);
+
+    // the chroma is kept flat so that the chroma resampling of the 90 degree
+    // rotations does not change the round trip.
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < width; x++)
+        {
+            DVP_U08 *pY = DVP_Image_Addressing(&luma[0], x, y, 0);
+            DVP_U08 *pU = DVP_Image_Addressing(&uyvy[0], x, y, 0);
+            *pY = (DVP_U08)rand();
+            pU[0] = 0x80;
+            pU[1] = (DVP_U08)rand();
+        }
+    }
+
+    nodes = DVP_KernelNode_Alloc(dvp, numNodes);
+    graph = DVP_KernelGraph_Alloc(dvp, 1);
+    if (nodes == NULL || graph == NULL)
+        goto exit;
+
+    nodes[0].header.kernel = DVP_KN_YUV_Y800_ROTATE_CW_90;
+    nodes[1].header.kernel = DVP_KN_YUV_Y800_ROTATE_CCW_90;
+    nodes[2].header.kernel = DVP_KN_YUV_Y800_ROTATE_180;
+    nodes[3].header.kernel = DVP_KN_YUV_UYVY_ROTATE_CW_90;
+    nodes[4].header.kernel = DVP_KN_YUV_UYVY_ROTATE_CCW_90;
+    nodes[5].header.kernel = DVP_KN_YUV_UYVY_ROTATE_180;
+    nodes[6].header.kernel = DVP_KN_YUV_UYVY_MIRROR;
+    for (n = 0; n < numNodes; n++)
+        nodes[n].header.affinity = DVP_CORE_CPU;
+
+    pT = dvp_knode_to(&nodes[0], DVP_Transform_t);
+    DVP_Image_Dup(&pT->input, &luma[0]);
+    DVP_Image_Dup(&pT->output, &luma[1]);
+    pT = dvp_knode_to(&nodes[1], DVP_Transform_t);
+    DVP_Image_Dup(&pT->input, &luma[1]);
+    DVP_Image_Dup(&pT->output, &luma[2]);
+    pT = dvp_knode_to(&nodes[2], DVP_Transform_t);
+    DVP_Image_Dup(&pT->input, &luma[0]);
+    DVP_Image_Dup(&pT->output, &luma[3]);
+    pT = dvp_knode_to(&nodes[3], DVP_Transform_t);
+    DVP_Image_Dup(&pT->input, &uyvy[0]);
+    DVP_Image_Dup(&pT->output, &uyvy[1]);
+    pT = dvp_knode_to(&nodes[4], DVP_Transform_t);
+    DVP_Image_Dup(&pT->input, &uyvy[1]);
+    DVP_Image_Dup(&pT->output, &uyvy[2]);
+    pT = dvp_knode_to(&nodes[5], DVP_Transform_t);
+    DVP_Image_Dup(&pT->input, &uyvy[0]);
+    DVP_Image_Dup(&pT->output, &uyvy[3]);
+    pT = dvp_knode_to(&nodes[6], DVP_Transform_t);
+    DVP_Image_Dup(&pT->input, &uyvy[0]);
+    DVP_Image_Dup(&pT->output, &uyvy[4]);
+
+    err = DVP_KernelGraphSection_Init(dvp, graph, 0, nodes, numNodes);
+    if (err != DVP_SUCCESS)
+        goto exit;
+
+    numSectionsRun = DVP_KernelGraph_Process(dvp, graph, &numNodesExecuted, dvp_section_complete);
+    err = dvp_get_error_from_nodes(nodes, numNodes);
+    DVP_PRINT(DVP_ZONE_ALWAYS, "ROTATE processed %u sections, %u nodes, first DVP_Error_e=%d\n", numSectionsRun, numNodesExecuted, err);
+    if (numSectionsRun != 1 || numNodesExecuted != numNodes || err != DVP_SUCCESS)
+        goto exit;
+
+    if (DVP_Image_Equal(&luma[2], &luma[0]) == DVP_FALSE ||
+        DVP_Image_Equal(&uyvy[2], &uyvy[0]) == DVP_FALSE)
+    {
+        DVP_PRINT(DVP_ZONE_ERROR, "dvp_rotate_test: CW90 then CCW90 is not the original image!\n");
+        goto exit;
+    }
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < width; x++)
+        {
+            DVP_U08 a = *DVP_Image_Addressing(&luma[0], x, y, 0);
+            DVP_U08 b = *DVP_Image_Addressing(&luma[1], height - 1 - y, x, 0);
+            DVP_U08 c = *DVP_Image_Addressing(&luma[3], width - 1 - x, height - 1 - y, 0);
+            DVP_U08 d = DVP_Image_Addressing(&uyvy[0], x, y, 0)[1];
+            DVP_U08 e = DVP_Image_Addressing(&uyvy[1], height - 1 - y, x, 0)[1];
+            DVP_U08 f = DVP_Image_Addressing(&uyvy[3], width - 1 - x, height - 1 - y, 0)[1];
+            DVP_U08 g = DVP_Image_Addressing(&uyvy[4], width - 1 - x, y, 0)[1];
+            if (a != b || a != c || d != e || d != f || d != g)
+            {
+                DVP_PRINT(DVP_ZONE_ERROR, "dvp_rotate_test: Pixel {%u,%u} is misplaced!\n", x, y);
+                goto exit;
+            }
+        }
+    }
+
+    // 4:2:2 planes can be turned half way around but not a quarter
+    pT = dvp_knode_to(&nodes[0], DVP_Transform_t);
+    DVP_Image_Dup(&pT->input, &yu16[0]);
+    DVP_Image_Dup(&pT->output, &yu16[1]);
+    pT = dvp_knode_to(&nodes[2], DVP_Transform_t);
+    DVP_Image_Dup(&pT->input, &yu16[0]);
+    DVP_Image_Dup(&pT->output, &yu16[2]);
+    graph->verified = DVP_FALSE;
+    if (DVP_KernelGraph_Verify(dvp, graph) == DVP_TRUE ||
+        nodes[0].header.error != DVP_ERROR_INVALID_PARAMETER ||
+        nodes[2].header.error != DVP_SUCCESS)
+    {
+        DVP_PRINT(DVP_ZONE_ERROR, "dvp_rotate_test: YU16 verified as %d for CW90 and %d for 180!\n",
+                  nodes[0].header.error, nodes[2].header.error);
+        goto exit;
+    }
+    status = STATUS_SUCCESS;
+
+exit:
+    for (n = 0; n < dimof(luma); n++)
+    {
+        DVP_Image_Free(dvp, &luma[n]);
+        DVP_Image_Deinit(&luma[n]);
+    }
+    for (n = 0; n < dimof(yu16); n++)
+    {
+        DVP_Image_Free(dvp, &yu16[n]);
+        DVP_Image_Deinit(&yu16[n]);
+    }
+    for (n = 0; n < dimof(uyvy); n++)
+    {
+        DVP_Image_Free(dvp, &uyvy[n]);
+        DVP_Image_Deinit(&uyvy[n]);
+    }
+    if (graph)
+        DVP_KernelGraph_Free(dvp, graph);
+    if (nodes)
+        DVP_KernelNode_Free(dvp, nodes, numNodes);
+    DVP_KernelGraph_Deinit(dvp);
+    return status;
+}
+#endif
+
+#if defined(DVP_USE_YUV) || defined(DVP_USE_YUV_C)
+/*! \brief Tests the arbitrary ratio scaler. Unity ratios must reproduce the
+ * input with every filter and a 2:1 area downscale must be the rounded
+ * average of each 2x2 block.
+ * \return Returns status_e
+ * \retval STATUS_SUCCESS on success.
+ * \retval STATUS_FAILURE on failure.
+ * \ingroup group_tests
+ */
+status_e dvp_scale_test(void)
+{
+    status_e status = STATUS_FAILURE;
+    DVP_U32 width = 64, height = 48;
+    DVP_U32 numNodes = 5;
+    DVP_U32 numNodesExecuted = 0;
+    DVP_U32 numSectionsRun = 0;
+    DVP_Image_t images[8];
+    DVP_KernelNode_t *nodes = NULL;
+    DVP_KernelGraph_t *graph = NULL;
+    DVP_YUV_Scale_t *pS;
+    DVP_Error_e err = DVP_SUCCESS;
+    DVP_U32 n, p, x, y;
+    struct {
+        DVP_U32 in;
+        DVP_U32 out;
+        DVP_U32 filter;
+    } cfg[] = {
+        {0, 1, DVP_YUV_SCALE_BILINEAR},
+        {0, 2, DVP_YUV_SCALE_AREA},
+        {3, 4, DVP_YUV_SCALE_AREA},
+        {5, 6, DVP_YUV_SCALE_BILINEAR},
+        {0, 7, DVP_YUV_SCALE_NEAREST},
+    };
+    DVP_U32 sources[] = {0, 3, 5};
+    DVP_Handle dvp = DVP_KernelGraph_Init();
+    if (dvp == 0)
+        return status;
+
+    DVP_Image_Init(&images[0], width, height, FOURCC_Y800);
+    DVP_Image_Init(&images[1], width, height, FOURCC_Y800);
+    DVP_Image_Init(&images[2], width/2, height/2, FOURCC_Y800);
+    DVP_Image_Init(&images[3], width, height, FOURCC_UYVY);
+    DVP_Image_Init(&images[4], width, height, FOURCC_UYVY);
+    DVP_Image_Init(&images[5], width, height, FOURCC_NV12);
+    DVP_Image_Init(&images[6], width, height, FOURCC_NV12);
+    DVP_Image_Init(&images[7], 100, 70, FOURCC_Y800);
+    for (n = 0; n < dimof(images); n++)
+        DVP_Image_Alloc(dvp, &images[n], DVP_MTYPE_DEFAULT);
+    for (n = 0; n < dimof(sources); n++)
+    {
+        DVP_Image_t *pImage = &images[sources[n]];
+        for (p = 0; p < pImage->planes; p++)
+            for (y = 0; y < pImage->height/DVP_Image_HeightDiv(pImage, p); y++)
+                for (x = 0; x < DVP_Image_LineSize(pImage, p); x++)
+                    pImage->pData[p][(y * pImage->y_stride) + x] = (DVP_U08)rand();
+    }
+
+    nodes = DVP_KernelNode_Alloc(dvp, numNodes);
+    graph = DVP_KernelGraph_Alloc(dvp, 1);
+    if (nodes == NULL || graph == NULL)
+        goto exit;
+
+    for (n = 0; n < numNodes; n++)
+    {
+        nodes[n].header.kernel = DVP_KN_YUV_SCALE;
+        nodes[n].header.affinity = DVP_CORE_CPU;
+        pS = dvp_knode_to(&nodes[n], DVP_YUV_Scale_t);
+        DVP_Image_Dup(&pS->input, &images[cfg[n].in]);
+        DVP_Image_Dup(&pS->output, &images[cfg[n].out]);
+        pS->filter = cfg[n].filter;
+    }
+
+    err = DVP_KernelGraphSection_Init(dvp, graph, 0, nodes, numNodes);
+    if (err != DVP_SUCCESS)
+        goto exit;
+
+    numSectionsRun = DVP_KernelGraph_Process(dvp, graph, &numNodesExecuted, dvp_section_complete);
+    err = dvp_get_error_from_nodes(nodes, numNodes);
+    DVP_PRINT(DVP_ZONE_ALWAYS, "SCALE processed %u sections, %u nodes, first DVP_Error_e=%d\n", numSectionsRun, numNodesExecuted, err);
+    if (numSectionsRun != 1 || numNodesExecuted != numNodes || err != DVP_SUCCESS)
+        goto exit;
+
+    if (DVP_Image_Equal(&images[1], &images[0]) == DVP_FALSE ||
+        DVP_Image_Equal(&images[4], &images[3]) == DVP_FALSE ||
+        DVP_Image_Equal(&images[6], &images[5]) == DVP_FALSE)
+    {
+        DVP_PRINT(DVP_ZONE_ERROR, "dvp_scale_test: Unity scale is not the original image!\n");
+        goto exit;
+    }
+    for (y = 0; y < height/2; y++)
+    {
+        for (x = 0; x < width/2; x++)
+        {
+            DVP_U32 sum = *DVP_Image_Addressing(&images[0], 2*x+0, 2*y+0, 0) +
+                          *DVP_Image_Addressing(&images[0], 2*x+1, 2*y+0, 0) +
+                          *DVP_Image_Addressing(&images[0], 2*x+0, 2*y+1, 0) +
+                          *DVP_Image_Addressing(&images[0], 2*x+1, 2*y+1, 0);
+            if (*DVP_Image_Addressing(&images[2], x, y, 0) != (sum + 2)/4)
+            {
+                DVP_PRINT(DVP_ZONE_ERROR, "dvp_scale_test: Pixel {%u,%u} is not the average!\n", x, y);
+                goto exit;
+            }
+        }
+    }
+    status = STATUS_SUCCESS;
+
+exit:
+    for (n = 0; n < dimof(images); n++)
+    {
+        DVP_Image_Free(dvp, &images[n]);
+        DVP_Image_Deinit(&images[n]);
+    }
+    if (graph)
+        DVP_KernelGraph_Free(dvp, graph);
+    if (nodes)
+        DVP_KernelNode_Free(dvp, nodes, numNodes);
+    DVP_KernelGraph_Deinit(dvp);
+    return status;
+}
+#endif
+
+#if defined(DVP_USE_LDC)
+/*!
+ * \brief Tests the lens distortion correction. An identity affine transform
+ * and an identity LUT must reproduce the input for UYVY and NV12, and an
+ * affine offset of 2 pixels must shift the luma left (clamped at the edge).
+ * \return Returns status_e
+ * \retval STATUS_SUCCESS on success.
+ * \retval STATUS_FAILURE on failure.
+ * \ingroup group_tests
+ */
+status_e dvp_ldc_test(void)
+{
+    status_e status = STATUS_FAILURE;
+    DVP_U32 width = 72, height = 40;
+    DVP_U32 numNodes = 3;
+    DVP_U32 numNodesExecuted = 0;
+    DVP_U32 numSectionsRun = 0;
+    DVP_Image_t images[5];
+    DVP_Buffer_t lut;
+    DVP_KernelNode_t *nodes = NULL;
+    DVP_KernelGraph_t *graph = NULL;
+    DVP_Ldc_t *pLdc;
+    DVP_Error_e err = DVP_SUCCESS;
+    DVP_S16 identity[6] = {4096, 0, 0, 0, 4096, 0};
+    DVP_U32 n, p, x, y;
+    struct {
+        DVP_U32 kernel;
+        DVP_U32 in;
+        DVP_U32 out;
+        DVP_S16 offset;     // Q3
+    } cfg[] = {
+        {DVP_KN_LDC_AFFINE_TRANSFORM, 0, 1, 0},
+        {DVP_KN_LDC_DISTORTION_AND_AFFINE, 2, 3, 0},
+        {DVP_KN_LDC_AFFINE_TRANSFORM, 0, 4, 16},
+    };
+    DVP_U32 sources[] = {0, 2};
+    DVP_Handle dvp = DVP_KernelGraph_Init();
+    if (dvp == 0)
+        return status;
+
+    DVP_Image_Init(&images[0], width, height, FOURCC_UYVY);
+    DVP_Image_Init(&images[1], width, height, FOURCC_UYVY);
+    DVP_Image_Init(&images[2], width, height, FOURCC_NV12);
+    DVP_Image_Init(&images[3], width, height, FOURCC_NV12);
+    DVP_Image_Init(&images[4], width, height, FOURCC_UYVY);
+    for (n = 0; n < dimof(images); n++)
+        DVP_Image_Alloc(dvp, &images[n], DVP_MTYPE_DEFAULT);
+    for (n = 0; n < dimof(sources); n++)
+    {
+        DVP_Image_t *pImage = &images[sources[n]];
+        for (p = 0; p < pImage->planes; p++)
+            for (y = 0; y < pImage->height/DVP_Image_HeightDiv(pImage, p); y++)
+                for (x = 0; x < DVP_Image_LineSize(pImage, p); x++)
+                    pImage->pData[p][(y * pImage->y_stride) + x] = (DVP_U08)rand();
+    }
+    DVP_Buffer_Init(&lut, sizeof(DVP_U16), 256);
+    DVP_Buffer_Alloc(dvp, &lut, DVP_MTYPE_DEFAULT);
+    for (n = 0; lut.pData && n < 256; n++)
+        ((DVP_U16 *)lut.pData)[n] = 1 << 8;
+
+    nodes = DVP_KernelNode_Alloc(dvp, numNodes);
+    graph = DVP_KernelGraph_Alloc(dvp, 1);
+    if (nodes == NULL || graph == NULL || lut.pData == NULL)
+        goto exit;
+
+    for (n = 0; n < numNodes; n++)
+    {
+        nodes[n].header.kernel = cfg[n].kernel;
+        nodes[n].header.affinity = DVP_CORE_CPU;
+        pLdc = dvp_knode_to(&nodes[n], DVP_Ldc_t);
+        DVP_Image_Dup(&pLdc->input, &images[cfg[n].in]);
+        DVP_Image_Dup(&pLdc->output, &images[cfg[n].out]);
+        memcpy(pLdc->affine, identity, sizeof(identity));
+        pLdc->affine[2] = cfg[n].offset;
+        pLdc->interpolationLuma = 1;
+        memcpy(&pLdc->ldcLut, &lut, sizeof(lut));
+        pLdc->ldcLensCenterX = (DVP_U16)(width/2);
+        pLdc->ldcLensCenterY = (DVP_U16)(height/2);
+        pLdc->ldcKhl = pLdc->ldcKhr = pLdc->ldcKvu = pLdc->ldcKvl = 16;
+        pLdc->ldcRth = (DVP_U16)width;
+        pLdc->ldcRightShiftBits = 8;
+    }
+
+    err = DVP_KernelGraphSection_Init(dvp, graph, 0, nodes, numNodes);
+    if (err != DVP_SUCCESS)
+        goto exit;
+
+    numSectionsRun = DVP_KernelGraph_Process(dvp, graph, &numNodesExecuted, dvp_section_complete);
+    err = dvp_get_error_from_nodes(nodes, numNodes);
+    DVP_PRINT(DVP_ZONE_ALWAYS, "LDC processed %u sections, %u nodes, first DVP_Error_e=%d\n", numSectionsRun, numNodesExecuted, err);
+    if (numSectionsRun != 1 || numNodesExecuted != numNodes || err != DVP_SUCCESS)
+        goto exit;
+
+    if (DVP_Image_Equal(&images[1], &images[0]) == DVP_FALSE ||
+        DVP_Image_Equal(&images[3], &images[2]) == DVP_FALSE)
+    {
+        DVP_PRINT(DVP_ZONE_ERROR, "dvp_ldc_test: Identity LDC is not the original image!\n");
+        goto exit;
+    }
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < width; x++)
+        {
+            DVP_U32 sx = (x + 2 < width ? x + 2 : width - 1);
+            // the luma of UYVY is at the odd bytes
+            if (images[4].pData[0][(y * images[4].y_stride) + (x * 2) + 1] !=
+                images[0].pData[0][(y * images[0].y_stride) + (sx * 2) + 1])
+            {
+                DVP_PRINT(DVP_ZONE_ERROR, "dvp_ldc_test: Pixel {%u,%u} is not shifted!\n", x, y);
+                goto exit;
+            }
+        }
+    }
+    status = STATUS_SUCCESS;
+
+exit:
+    for (n = 0; n < dimof(images); n++)
+    {
+        DVP_Image_Free(dvp, &images[n]);
+        DVP_Image_Deinit(&images[n]);
+    }
+    DVP_Buffer_Free(dvp, &lut);
+    DVP_Buffer_Deinit(&lut);
+    if (graph)
+        DVP_KernelGraph_Free(dvp, graph);
+    if (nodes)
+        DVP_KernelNode_Free(dvp, nodes, numNodes);
+    DVP_KernelGraph_Deinit(dvp);
+    return status;
+}
+#endif
+
+#if defined(DVP_USE_DEI_C)
+/*!
+ * \brief Tests the deinterlacer. The fields of a still scene are fed in turn,
+ * so once the motion has decayed the motion adaptive mode must weave the
+ * scene back exactly. The line average mode must average the field lines.
+ * \return Returns status_e
+ * \retval STATUS_SUCCESS on success.
+ * \retval STATUS_FAILURE on failure.
+ * \ingroup group_tests
+ */
+status_e dvp_deinterlace_test(void)
+{
+    status_e status = STATUS_FAILURE;
+    DVP_U32 width = 88, height = 36;
+    DVP_U32 numNodes = 1;
+    DVP_U32 numNodesExecuted = 0;
+    DVP_U32 numSectionsRun = 0;
+    DVP_U32 numFields = 10;
+    DVP_Image_t images[3]; // scene, current, previous
+    DVP_Buffer_t buffers[3];
+    DVP_KernelNode_t *nodes = NULL;
+    DVP_KernelGraph_t *graph = NULL;
+    DVP_Deinterlacer_t *pD;
+    DVP_Error_e err = DVP_SUCCESS;
+    DVP_U32 n, f, x, y, lineSize = width * 2;
+    DVP_Handle dvp = DVP_KernelGraph_Init();
+    if (dvp == 0)
+        return status;
+
+    for (n = 0; n < dimof(images); n++)
+    {
+        DVP_Image_Init(&images[n], width, height, FOURCC_UYVY);
+        DVP_Image_Alloc(dvp, &images[n], DVP_MTYPE_DEFAULT);
+    }
+    for (n = 0; n < dimof(buffers); n++)
+    {
+        DVP_Buffer_Init(&buffers[n], 1, width * height / 2);
+        DVP_Buffer_Alloc(dvp, &buffers[n], DVP_MTYPE_DEFAULT);
+    }
+    for (y = 0; y < height; y++)
+        for (x = 0; x < lineSize; x++)
+            images[0].pData[0][(y * images[0].y_stride) + x] = (DVP_U08)rand();
+
+    nodes = DVP_KernelNode_Alloc(dvp, numNodes);
+    graph = DVP_KernelGraph_Alloc(dvp, 1);
+    if (nodes == NULL || graph == NULL)
+        goto exit;
+
+    nodes[0].header.kernel = DVP_KN_DEI_DEINTERLACER;
+    nodes[0].header.affinity = DVP_CORE_CPU;
+    pD = dvp_knode_to(&nodes[0], DVP_Deinterlacer_t);
+    DVP_Image_Dup(&pD->phy_fld_in_current, &images[1]);
+    DVP_Image_Dup(&pD->phy_fld_in_prev, &images[2]);
+    memcpy(&pD->phy_luma_d0, &buffers[0], sizeof(DVP_Buffer_t));
+    memcpy(&pD->phy_luma_d1, &buffers[1], sizeof(DVP_Buffer_t));
+    memcpy(&pD->phy_luma_d2, &buffers[2], sizeof(DVP_Buffer_t));
+    pD->bias = 8;
+    pD->sad_corr = 3;
+    pD->sad_scale = 128;
+    pD->mode = DVP_DEI_MODE_MOTION_ADAPTIVE;
+
+    err = DVP_KernelGraphSection_Init(dvp, graph, 0, nodes, numNodes);
+    if (err != DVP_SUCCESS)
+        goto exit;
+
+    for (f = 0; f < numFields; f++)
+    {
+        // the current field comes from the scene, the other lines are garbage
+        for (y = 0; y < height; y++)
+        {
+            DVP_U08 *pLine = &images[1].pData[0][y * images[1].y_stride];
+            if ((y & 1) == (f & 1))
+                memcpy(pLine, &images[0].pData[0][y * images[0].y_stride], lineSize);
+            else
+                memset(pLine, 0, lineSize);
+        }
+        pD->fldnum = f;
+        numNodesExecuted = 0;
+        numSectionsRun = DVP_KernelGraph_Process(dvp, graph, &numNodesExecuted, dvp_section_complete);
+        err = dvp_get_error_from_nodes(nodes, numNodes);
+        if (numSectionsRun != 1 || numNodesExecuted != numNodes || err != DVP_SUCCESS)
+        {
+            DVP_PRINT(DVP_ZONE_ERROR, "DEI processed %u sections, %u nodes, first DVP_Error_e=%d\n", numSectionsRun, numNodesExecuted, err);
+            goto exit;
+        }
+        for (y = 0; y < height; y++)
+            memcpy(&images[2].pData[0][y * images[2].y_stride], &images[1].pData[0][y * images[1].y_stride], lineSize);
+    }
+    if (DVP_Image_Equal(&images[1], &images[0]) == DVP_FALSE)
+    {
+        DVP_PRINT(DVP_ZONE_ERROR, "dvp_deinterlace_test: The still scene was not woven back!\n");
+        goto exit;
+    }
+
+    pD->mode = DVP_DEI_MODE_LINE_AVERAGE;
+    pD->fldnum = 0;
+    numNodesExecuted = 0;
+    numSectionsRun = DVP_KernelGraph_Process(dvp, graph, &numNodesExecuted, dvp_section_complete);
+    err = dvp_get_error_from_nodes(nodes, numNodes);
+    DVP_PRINT(DVP_ZONE_ALWAYS, "DEI processed %u sections, %u nodes, first DVP_Error_e=%d\n", numSectionsRun, numNodesExecuted, err);
+    if (numSectionsRun != 1 || numNodesExecuted != numNodes || err != DVP_SUCCESS)
+        goto exit;
+    for (y = 1; y < height; y += 2)
+    {
+        DVP_U08 *pA = &images[0].pData[0][(y - 1) * images[0].y_stride];
+        DVP_U08 *pB = &images[0].pData[0][(y + 1 < height ? y + 1 : y - 1) * images[0].y_stride];
+        DVP_U08 *pO = &images[1].pData[0][y * images[1].y_stride];
+        for (x = 0; x < lineSize; x++)
+        {
+            if (pO[x] != (pA[x] + pB[x] + 1) / 2)
+            {
+                DVP_PRINT(DVP_ZONE_ERROR, "dvp_deinterlace_test: Byte {%u,%u} is not the line average!\n", x, y);
+                goto exit;
+            }
+        }
+    }
+    status = STATUS_SUCCESS;
+
+exit:
+    for (n = 0; n < dimof(images); n++)
+    {
+        DVP_Image_Free(dvp, &images[n]);
+        DVP_Image_Deinit(&images[n]);
+    }
+    for (n = 0; n < dimof(buffers); n++)
+    {
+        DVP_Buffer_Free(dvp, &buffers[n]);
+        DVP_Buffer_Deinit(&buffers[n]);
+    }
+    if (graph)
+        DVP_KernelGraph_Free(dvp, graph);
+    if (nodes)
+        DVP_KernelNode_Free(dvp, nodes, numNodes);
+    DVP_KernelGraph_Deinit(dvp);
+    return status;
+}
+#endif
+
+#if defined(DVP_USE_DSPLIB_C)
+/*!
+ * \brief Compares the interleaved complex output of an FFT node to the DFT of
+ * its input divided by the number of points.
+ */
+static DVP_BOOL dvp_dsplib_check_fft(DVP_Buffer_t *pIn, DVP_Buffer_t *pOut, DVP_U32 points, DVP_U32 q, double tolerance)
+{
+    DVP_U32 k, i;
+    for (k = 0; k < points; k++)
+    {
+        double re = 0.0, im = 0.0;
+        for (i = 0; i < points; i++)
+        {
+            double a = -2.0 * 3.14159265358979323846 * (double)((k * i) % points) / points;
+            double xr = (q == 31 ? ((DVP_S32 *)pIn->pData)[2*i] : ((DVP_S16 *)pIn->pData)[2*i]);
+            double xi = (q == 31 ? ((DVP_S32 *)pIn->pData)[2*i+1] : ((DVP_S16 *)pIn->pData)[2*i+1]);
+            re += xr * cos(a) - xi * sin(a);
+            im += xr * sin(a) + xi * cos(a);
+        }
+        re = re / points - (q == 31 ? ((DVP_S32 *)pOut->pData)[2*k] : ((DVP_S16 *)pOut->pData)[2*k]);
+        im = im / points - (q == 31 ? ((DVP_S32 *)pOut->pData)[2*k+1] : ((DVP_S16 *)pOut->pData)[2*k+1]);
+        if (fabs(re) > tolerance || fabs(im) > tolerance)
+        {
+            DVP_PRINT(DVP_ZONE_ERROR, "dvp_dsplib_test: Q%u bin %u is off by {%lf,%lf}!\n", q, k, re, im);
+            return DVP_FALSE;
+        }
+    }
+    return DVP_TRUE;
+}
 
-                    // now perform some arimethic on the pointers to make each
-                    // node cover half the image.
-                    img[0] = &io[0]->input;
-                    img[1] = &io[0]->output;
-                    img[2] = &io[1]->input;
-                    img[3] = &io[1]->output;
+/*!
+ * \brief Tests the "C" DSPLIB kernels. The twiddles are generated by the
+ * twiddle nodes, the FFTs are compared to a floating point DFT, the IFFT must
+ * bring the 16 bit signal back and the FIR must match the DSPLIB definition.
+ * \return Returns status_e
+ * \retval STATUS_SUCCESS on success.
+ * \retval STATUS_FAILURE on failure.
+ * \ingroup group_tests
+ */
+status_e dvp_dsplib_test(void)
+{
+    status_e status = STATUS_FAILURE;
+    DVP_U32 points16 = 128, points32 = 64; // a radix 2 and a radix 4 last stage
+    DVP_U32 nh = 16, nr = 100;
+    DVP_U32 numNodes = 6;
+    DVP_U32 numNodesExecuted = 0;
+    DVP_U32 numSectionsRun = 0;
+    DVP_Buffer_t buffers[10];
+    DVP_KernelNode_t *nodes = NULL;
+    DVP_KernelGraph_t *graph = NULL;
+    DVP_DSPFunc *pF;
+    DVP_Error_e err = DVP_SUCCESS;
+    DVP_S16 *x16, *y16, *fx, *fh, *fr;
+    DVP_S32 *x32;
+    DVP_U32 n, i, j;
+    DVP_Handle dvp = DVP_KernelGraph_Init();
+    if (dvp == 0)
+        return status;
 
-                    img[0]->height /= 2;
-                    img[1]->height /= 2;
-                    img[2]->height /= 2;
-                    img[3]->height /= 2;
+    DVP_Buffer_Init(&buffers[0], sizeof(DVP_S16), 2 * points16);   // 16x16 twiddles
+    DVP_Buffer_Init(&buffers[1], sizeof(DVP_S16), 2 * points16);   // signal
+    DVP_Buffer_Init(&buffers[2], sizeof(DVP_S16), 2 * points16);   // spectrum
+    DVP_Buffer_Init(&buffers[3], sizeof(DVP_S16), 2 * points16);   // signal again
+    DVP_Buffer_Init(&buffers[4], sizeof(DVP_S32), 2 * points32);   // 32x32 twiddles
+    DVP_Buffer_Init(&buffers[5], sizeof(DVP_S32), 2 * points32);   // signal
+    DVP_Buffer_Init(&buffers[6], sizeof(DVP_S32), 2 * points32);   // spectrum
+    DVP_Buffer_Init(&buffers[7], sizeof(DVP_S16), nr + nh - 1);    // FIR x
+    DVP_Buffer_Init(&buffers[8], sizeof(DVP_S16), nh);             // FIR h
+    DVP_Buffer_Init(&buffers[9], sizeof(DVP_S16), nr);             // FIR r
+    for (n = 0; n < dimof(buffers); n++)
+        DVP_Buffer_Alloc(dvp, &buffers[n], DVP_MTYPE_DEFAULT);
+
+    x16 = (DVP_S16 *)buffers[1].pData;
+    y16 = (DVP_S16 *)buffers[3].pData;
+    x32 = (DVP_S32 *)buffers[5].pData;
+    fx = (DVP_S16 *)buffers[7].pData;
+    fh = (DVP_S16 *)buffers[8].pData;
+    fr = (DVP_S16 *)buffers[9].pData;
+    for (i = 0; i < 2 * points16; i++)
+        x16[i] = (DVP_S16)((rand() % 32768) - 16384);
+    for (i = 0; i < 2 * points32; i++)
+        x32[i] = (DVP_S32)(((rand() % 32768) - 16384) * 65536);
+    for (i = 0; i < nr + nh - 1; i++)
+        fx[i] = (DVP_S16)((rand() % 65536) - 32768);
+    for (i = 0; i < nh; i++)
+        fh[i] = (DVP_S16)((rand() % 4096) - 2048);
+
+    nodes = DVP_KernelNode_Alloc(dvp, numNodes);
+    graph = DVP_KernelGraph_Alloc(dvp, 1);
+    if (nodes == NULL || graph == NULL)
+        goto exit;
 
-                    // move the pointer 1/2 down the image
-                    img[2]->pData[0] = &img[2]->pData[0][img[2]->height * img[2]->y_stride];
-                    img[3]->pData[0] = &img[3]->pData[0][img[3]->height * img[3]->y_stride];
+    nodes[0].header.kernel = DVP_KN_GEN_TWIDDLE_FFT_16X16;
+    pF = dvp_knode_to(&nodes[0], DVP_DSPFunc);
+    pF->input0 = buffers[0];
+    pF->val1 = points16;
+
+    nodes[1].header.kernel = DVP_KN_DSP_FFT_16x16;
+    pF = dvp_knode_to(&nodes[1], DVP_DSPFunc);
+    pF->input0 = buffers[1];
+    pF->twoway = buffers[0];
+    pF->output0 = buffers[2];
+
+    nodes[2].header.kernel = DVP_KN_DSP_IFFT_16x16;
+    pF = dvp_knode_to(&nodes[2], DVP_DSPFunc);
+    pF->input0 = buffers[2];
+    pF->twoway = buffers[0];
+    pF->output0 = buffers[3];
+    pF->val1 = points16;
+
+    nodes[3].header.kernel = DVP_KN_GEN_TWIDDLE_FFT_32x32;
+    pF = dvp_knode_to(&nodes[3], DVP_DSPFunc);
+    pF->input0 = buffers[4];
+    pF->val1 = points32;
+
+    nodes[4].header.kernel = DVP_KN_DSP_FFT_32x32;
+    pF = dvp_knode_to(&nodes[4], DVP_DSPFunc);
+    pF->input0 = buffers[5];
+    pF->twoway = buffers[4];
+    pF->output0 = buffers[6];
+
+    nodes[5].header.kernel = DVP_KN_DSP_FIR_R8;
+    pF = dvp_knode_to(&nodes[5], DVP_DSPFunc);
+    pF->input0 = buffers[7];
+    pF->twoway = buffers[8];
+    pF->output0 = buffers[9];
 
-                    // assign each node to a separate section
-                    DVP_KernelGraphSection_Init(dvp, graph, 0, &nodes[0], 1);
-                    DVP_KernelGraphSection_Init(dvp, graph, 1, &nodes[1], 1);
+    for (n = 0; n < numNodes; n++)
+        nodes[n].header.affinity = DVP_CORE_CPU;
 
-                    numSectionsRun = DVP_KernelGraph_Process(dvp, graph, &numNodesExecuted, dvp_section_complete);
-                    err = dvp_get_error_from_nodes(nodes, numNodes);
-                    if (numSectionsRun == numSections && numNodesExecuted == numNodes && err == DVP_SUCCESS)
-                    {
-                        status = STATUS_SUCCESS;
-                    }
+    err = DVP_KernelGraphSection_Init(dvp, graph, 0, nodes, numNodes);
+    if (err != DVP_SUCCESS)
+        goto exit;
 
-                    DVP_Image_Free(dvp, &images[0]);
-                    DVP_Image_Free(dvp, &images[1]);
+    numSectionsRun = DVP_KernelGraph_Process(dvp, graph, &numNodesExecuted, dvp_section_complete);
+    err = dvp_get_error_from_nodes(nodes, numNodes);
+    DVP_PRINT(DVP_ZONE_ALWAYS, "DSPLIB processed %u sections, %u nodes, first DVP_Error_e=%d\n", numSectionsRun, numNodesExecuted, err);
+    if (numSectionsRun != 1 || numNodesExecuted != numNodes || err != DVP_SUCCESS)
+        goto exit;
 
-                    DVP_PRINT(DVP_ZONE_ALWAYS, "CPU CC processed %u sections, %u nodes, first DVP_Error_e=%d\n", numSectionsRun, numNodesExecuted, err);
-                    DVP_PrintPerformanceGraph(dvp, graph);
-                }
-                DVP_KernelGraph_Free(dvp, graph);
-                graph = NULL;
-            }
-            DVP_KernelNode_Free(dvp, nodes, numNodes);
-            nodes = NULL;
+    if (dvp_knode_to(&nodes[0], DVP_DSPFunc)->val2 != (DVP_S32)(3 * points16 / 2 + 3 * points16 / 8 + 3 * points16 / 32))
+    {
+        DVP_PRINT(DVP_ZONE_ERROR, "dvp_dsplib_test: %d twiddles were generated!\n", dvp_knode_to(&nodes[0], DVP_DSPFunc)->val2);
+        goto exit;
+    }
+    // each stage rounds, so the error grows with the number of stages
+    if (dvp_dsplib_check_fft(&buffers[1], &buffers[2], points16, 15, 4.0) == DVP_FALSE ||
+        dvp_dsplib_check_fft(&buffers[5], &buffers[6], points32, 31, 4.0) == DVP_FALSE)
+        goto exit;
+    for (i = 0; i < 2 * points16; i++)
+    {
+        // the spectrum lost log2(points) bits
+        if (abs(x16[i] - y16[i]) > (DVP_S32)(points16 / 2))
+        {
+            DVP_PRINT(DVP_ZONE_ERROR, "dvp_dsplib_test: IFFT value %u is %d instead of %d!\n", i, y16[i], x16[i]);
+            goto exit;
         }
-        DVP_KernelGraph_Deinit(dvp);
     }
+    for (j = 0; j < nr; j++)
+    {
+        DVP_S32 sum = 0;
+        for (i = 0; i < nh; i++)
+            sum += fx[j + i] * fh[i];
+        if (fr[j] != (DVP_S16)(sum >> 15))
+        {
+            DVP_PRINT(DVP_ZONE_ERROR, "dvp_dsplib_test: FIR output %u is %d instead of %d!\n", j, fr[j], (DVP_S16)(sum >> 15));
+            goto exit;
+        }
+    }
+    status = STATUS_SUCCESS;
+
+exit:
+    for (n = 0; n < dimof(buffers); n++)
+    {
+        DVP_Buffer_Free(dvp, &buffers[n]);
+        DVP_Buffer_Deinit(&buffers[n]);
+    }
+    if (graph)
+        DVP_KernelGraph_Free(dvp, graph);
+    if (nodes)
+        DVP_KernelNode_Free(dvp, nodes, numNodes);
+    DVP_KernelGraph_Deinit(dvp);
     return status;
 }
 #endif
+
 /*!
  * \brief Tests core capacity APIs
  * \return Returns status_e
@@ -895,6 +2150,299 @@ status_e dvp_image_free_test(void)
     return dvp_image_allocation_test(FREE);
 }
 
+status_e dvp_mem_pool_test(void)
+{
+    status_e status = STATUS_FAILURE;
+    DVP_Handle dvp = DVP_KernelGraph_Init();
+    if (dvp)
+    {
+        DVP_Image_t images[2];
+        DVP_Buffer_t buffer;
+        DVP_U08 *pBuffer[DVP_MAX_PLANES];
+        DVP_U08 *pData = NULL;
+        DVP_S32 y_stride = 0;
+        DVP_MemPool_Stats_t stats;
+
+        DVP_Image_Init(&images[0], width, height, FOURCC_NV12);
+        DVP_Image_Init(&images[1], width, height, FOURCC_UYVY);
+        DVP_Buffer_Init(&buffer, 2, width);
+
+        // a freed image is reused by the next image of the same planes and dimensions
+        if (DVP_Image_Alloc(dvp, &images[0], DVP_MTYPE_MPUCACHED_VIRTUAL) &&
+            DVP_MemPool_Stats(dvp, &stats))
+        {
+            DVP_MemPool_Stats_t before = stats;
+            memcpy(pBuffer, images[0].pBuffer, sizeof(pBuffer));
+            y_stride = images[0].y_stride;
+            DVP_Image_Free(dvp, &images[0]);
+            DVP_Image_Init(&images[0], width, height, FOURCC_NV12);
+            if (DVP_Image_Alloc(dvp, &images[0], DVP_MTYPE_MPUCACHED_VIRTUAL) &&
+                DVP_Image_Alloc(dvp, &images[1], DVP_MTYPE_MPUCACHED_VIRTUAL) &&
+                DVP_MemPool_Stats(dvp, &stats))
+            {
+                if (images[0].pBuffer[0] == pBuffer[0] &&
+                    images[0].pBuffer[1] == pBuffer[1] &&
+                    images[0].y_stride == y_stride &&
+                    stats.hits == before.hits + 1 &&
+                    stats.misses == before.misses + 1 &&
+                    stats.recycled == before.recycled + 1 &&
+                    stats.count == before.count)
+                    status = STATUS_SUCCESS;
+                else
+                    DVP_PRINT(DVP_ZONE_ERROR, "Image was not recycled! %p,%p => %p,%p hits=%u misses=%u\n",
+                              pBuffer[0], pBuffer[1], images[0].pBuffer[0], images[0].pBuffer[1],
+                              stats.hits, stats.misses);
+                DVP_Image_Free(dvp, &images[1]);
+            }
+            DVP_Image_Free(dvp, &images[0]);
+        }
+
+        // so is a buffer
+        if (status == STATUS_SUCCESS)
+        {
+            status = STATUS_FAILURE;
+            if (DVP_Buffer_Alloc(dvp, &buffer, DVP_MTYPE_MPUCACHED_VIRTUAL))
+            {
+                pData = buffer.pData;
+                DVP_Buffer_Free(dvp, &buffer);
+                if (DVP_Buffer_Alloc(dvp, &buffer, DVP_MTYPE_MPUCACHED_VIRTUAL))
+                {
+                    if (buffer.pData == pData)
+                        status = STATUS_SUCCESS;
+                    DVP_Buffer_Free(dvp, &buffer);
+                }
+            }
+        }
+
+        // trimming to zero empties the pool and stops it from keeping frees
+        if (status == STATUS_SUCCESS)
+        {
+            DVP_MemPool_Stats_t before;
+            status = STATUS_FAILURE;
+            DVP_MemPool_Trim(dvp, 0);
+            if (DVP_MemPool_Stats(dvp, &before) && before.count == 0 && before.bytes == 0 &&
+                DVP_Image_Alloc(dvp, &images[0], DVP_MTYPE_MPUCACHED_VIRTUAL))
+            {
+                DVP_Image_Free(dvp, &images[0]);
+                if (DVP_MemPool_Stats(dvp, &stats) &&
+                    stats.count == 0 && stats.recycled == before.recycled && stats.limit == 0)
+                    status = STATUS_SUCCESS;
+            }
+        }
+        DVP_KernelGraph_Deinit(dvp);
+    }
+    return status;
+}
+
+status_e dvp_mem_pin_test(void)
+{
+    status_e status = STATUS_FAILURE;
+    DVP_Handle dvp = DVP_KernelGraph_Init();
+    if (dvp)
+    {
+        DVP_Image_t image;
+        DVP_Buffer_t buffer;
+        DVP_MemPin_Stats_t stats;
+
+        DVP_Image_Init(&image, width, height, FOURCC_NV12);
+        DVP_Buffer_Init(&buffer, 1, width*height);
+
+        // allocations made after the flags are set are committed up front
+        DVP_MemPin_Set(dvp, DVP_MEM_PIN_PREFAULT|DVP_MEM_PIN_LOCK);
+        if (DVP_Image_Alloc(dvp, &image, DVP_MTYPE_MPUCACHED_VIRTUAL) &&
+            DVP_Buffer_Alloc(dvp, &buffer, DVP_MTYPE_MPUCACHED_VIRTUAL) &&
+            DVP_MemPin_Stats(dvp, &stats))
+        {
+            DVP_U32 total = image.numBytes + buffer.numBytes;
+            if (stats.prefaulted >= total &&
+                ((stats.locked >= total && stats.count == image.planes + 1) || stats.failures > 0))
+                status = STATUS_SUCCESS;
+            else
+                DVP_PRINT(DVP_ZONE_ERROR, "Memory was not pinned! prefaulted=%u locked=%u count=%u failures=%u\n",
+                          stats.prefaulted, stats.locked, stats.count, stats.failures);
+
+            // the pool keeps the memory locked until it releases it
+            DVP_Image_Free(dvp, &image);
+            DVP_Buffer_Free(dvp, &buffer);
+            DVP_MemPool_Trim(dvp, 0);
+            if (DVP_MemPin_Stats(dvp, &stats) == DVP_FALSE || stats.locked != 0 || stats.count != 0)
+                status = STATUS_FAILURE;
+        }
+        DVP_MemPin_Set(dvp, DVP_MEM_PIN_NONE);
+        DVP_KernelGraph_Deinit(dvp);
+    }
+    return status;
+}
+
+#if !defined(DVP_USE_IPC)
+// runs a NOOP section on the CPU, which makes the KGB issue the invalidates of the remote runs
+static DVP_BOOL dvp_cache_ops_cpu_run(DVP_Handle dvp)
+{
+    DVP_BOOL ret = DVP_FALSE;
+    DVP_U32 numNodesExecuted = 0;
+    DVP_KernelNode_t *nodes = DVP_KernelNode_Alloc(dvp, 1);
+    DVP_KernelGraph_t *graph = DVP_KernelGraph_Alloc(dvp, 1);
+    if (nodes && graph && DVP_KernelGraphSection_Init(dvp, graph, 0, nodes, 1) == DVP_SUCCESS)
+    {
+        nodes[0].header.kernel = DVP_KN_NOOP;
+        nodes[0].header.affinity = DVP_CORE_CPU;
+        if (DVP_KernelGraph_Process(dvp, graph, &numNodesExecuted, dvp_section_complete) == 1)
+            ret = DVP_TRUE;
+    }
+    if (graph)
+        DVP_KernelGraph_Free(dvp, graph);
+    if (nodes)
+        DVP_KernelNode_Free(dvp, nodes, 1);
+    return ret;
+}
+
+/*! \brief Drives the stub RPC layer the way a remote KGM does and checks
+ * which cache operations are skipped, merged and deferred.
+ */
+status_e dvp_cache_ops_test(void)
+{
+    status_e status = STATUS_FAILURE;
+    DVP_Handle dvp = DVP_KernelGraph_Init();
+    if (dvp)
+    {
+        DVP_RPC_t *rpc = ((DVP_t *)dvp)->rpc;
+        DVP_Image_t a, b, c, d;
+        DVP_CacheOps_Stats_t base, stats;
+        DVP_Core_e dsp = DVP_CORE_DSP, simcop = DVP_CORE_SIMCOP;
+
+        DVP_Image_Init(&a, width, height, FOURCC_Y800);
+        DVP_Image_Init(&b, width, height, FOURCC_Y800);
+        DVP_Image_Init(&c, width, height, FOURCC_Y800);
+        DVP_Image_Init(&d, width, height, FOURCC_Y800);
+        if (rpc &&
+            DVP_Image_Alloc(dvp, &a, DVP_MTYPE_MPUCACHED_VIRTUAL) &&
+            DVP_Image_Alloc(dvp, &b, DVP_MTYPE_MPUCACHED_VIRTUAL) &&
+            DVP_Image_Alloc(dvp, &c, DVP_MTYPE_MPUCACHED_VIRTUAL) &&
+            DVP_Image_Alloc(dvp, &d, DVP_MTYPE_MPUCACHED_VIRTUAL) &&
+            DVP_CacheOps_Stats(dvp, &base))
+        {
+            status = STATUS_SUCCESS;
+
+            // a DSP run of two copies which both read a
+            dvp_rpc_prepare_image(rpc, dsp, &a, DVP_TRUE, NULL, NULL);
+            dvp_rpc_prepare_image(rpc, dsp, &b, DVP_FALSE, NULL, NULL);
+            dvp_rpc_prepare_image(rpc, dsp, &a, DVP_TRUE, NULL, NULL);
+            dvp_rpc_prepare_image(rpc, dsp, &c, DVP_FALSE, NULL, NULL);
+            dvp_rpc_remote_execute(rpc, NULL, 0, NULL, 0, NULL);
+            dvp_rpc_return_image(rpc, dsp, &a, DVP_FALSE);
+            dvp_rpc_return_image(rpc, dsp, &b, DVP_TRUE);
+            dvp_rpc_return_image(rpc, dsp, &a, DVP_FALSE);
+            dvp_rpc_return_image(rpc, dsp, &c, DVP_TRUE);
+            DVP_CacheOps_Stats(dvp, &stats);
+            if (stats.flushes - base.flushes != 2 || stats.flushed - base.flushed != 1 ||
+                stats.invalidates - base.invalidates != 2 || stats.invalidated - base.invalidated != 0)
+                status = STATUS_FAILURE;
+
+            // a SIMCOP run reading what the DSP wrote needs no flush
+            dvp_rpc_prepare_image(rpc, simcop, &b, DVP_TRUE, NULL, NULL);
+            dvp_rpc_prepare_image(rpc, simcop, &d, DVP_FALSE, NULL, NULL);
+            dvp_rpc_remote_execute(rpc, NULL, 0, NULL, 0, NULL);
+            dvp_rpc_return_image(rpc, simcop, &b, DVP_FALSE);
+            dvp_rpc_return_image(rpc, simcop, &d, DVP_TRUE);
+            DVP_CacheOps_Stats(dvp, &stats);
+            if (stats.flushes - base.flushes != 3 || stats.flushed - base.flushed != 1)
+                status = STATUS_FAILURE;
+
+            // the invalidates wait for the CPU, which may then write anything
+            if (dvp_cache_ops_cpu_run(dvp) == DVP_FALSE)
+                status = STATUS_FAILURE;
+            DVP_CacheOps_Stats(dvp, &stats);
+            if (stats.invalidated - base.invalidated == 0 ||
+                stats.invalidated - base.invalidated > 3 ||
+                stats.batches - base.batches != 2)
+                status = STATUS_FAILURE;
+
+            dvp_rpc_prepare_image(rpc, dsp, &a, DVP_TRUE, NULL, NULL);
+            dvp_rpc_remote_execute(rpc, NULL, 0, NULL, 0, NULL);
+            DVP_CacheOps_Stats(dvp, &stats);
+            if (stats.flushed - base.flushed != 2)
+                status = STATUS_FAILURE;
+
+            DVP_PRINT(DVP_ZONE_ALWAYS, "Cache Ops: %u of %u flushes and %u of %u invalidates issued in %u batches\n",
+                      stats.flushed - base.flushed, stats.flushes - base.flushes,
+                      stats.invalidated - base.invalidated, stats.invalidates - base.invalidates,
+                      stats.batches - base.batches);
+        }
+        DVP_Image_Free(dvp, &a);
+        DVP_Image_Free(dvp, &b);
+        DVP_Image_Free(dvp, &c);
+        DVP_Image_Free(dvp, &d);
+        DVP_Image_Deinit(&a);
+        DVP_Image_Deinit(&b);
+        DVP_Image_Deinit(&c);
+        DVP_Image_Deinit(&d);
+        DVP_KernelGraph_Deinit(dvp);
+    }
+    return status;
+}
+#endif
+
+status_e dvp_image_row_align_test(void)
+{
+    status_e status = STATUS_FAILURE;
+    DVP_Handle dvp = DVP_KernelGraph_Init();
+    if (dvp)
+    {
+        DVP_Image_t images[4];
+        DVP_U08 *pBuffer = NULL;
+        DVP_U32 p;
+
+        DVP_Image_Init(&images[0], 100, 70, FOURCC_IYUV);
+        DVP_Image_Init(&images[1], 100, 70, FOURCC_BGR);
+        DVP_Image_Init(&images[2], 100, 70, FOURCC_Y800);
+        DVP_Image_Init(&images[3], 100, 70, FOURCC_UYVY);
+
+        // cpu images are packed by default, padded lines must be asked for
+        if (DVP_Image_AllocAligned(dvp, &images[0], DVP_MTYPE_MPUCACHED_VIRTUAL, DVP_IMAGE_ROW_ALIGN) &&
+            DVP_Image_AllocAligned(dvp, &images[1], DVP_MTYPE_MPUCACHED_VIRTUAL, DVP_IMAGE_ROW_ALIGN) &&
+            DVP_Image_Alloc(dvp, &images[2], DVP_MTYPE_MPUCACHED_VIRTUAL) &&
+            DVP_Image_AllocAligned(dvp, &images[3], DVP_MTYPE_MPUCACHED_VIRTUAL_SHARED, DVP_IMAGE_ROW_ALIGN))
+        {
+            if (DVP_Image_RowAlign(&images[0]) >= DVP_IMAGE_ROW_ALIGN &&
+                DVP_Image_RowAlign(&images[1]) >= DVP_IMAGE_ROW_ALIGN &&
+                images[0].y_stride == 128 &&
+                DVP_Image_LineRange(&images[0], 1) == 128 &&
+                (images[1].y_stride % images[1].x_stride) == 0 &&
+                images[1].y_stride >= 300 &&
+                images[2].y_stride == 100 &&
+                images[3].y_stride == 256)
+                status = STATUS_SUCCESS;
+            else
+                DVP_PRINT(DVP_ZONE_ERROR, "Image lines were not aligned! strides=%d,%d,%d,%d aligns=%u,%u\n",
+                          images[0].y_stride, images[1].y_stride, images[2].y_stride, images[3].y_stride,
+                          DVP_Image_RowAlign(&images[0]), DVP_Image_RowAlign(&images[1]));
+
+            // the padding and a line of slack after each plane are writable
+            for (p = 0; p < images[0].planes; p++)
+            {
+                DVP_U32 range = DVP_Image_PlaneRange(&images[0], p) + DVP_Image_LineRange(&images[0], p);
+                memset(images[0].pBuffer[p], 0x80, range);
+            }
+
+            // and the padded image returns to the same place in the pool
+            pBuffer = images[0].pBuffer[0];
+            DVP_Image_Free(dvp, &images[0]);
+            DVP_Image_Init(&images[0], 100, 70, FOURCC_IYUV);
+            if (DVP_Image_AllocAligned(dvp, &images[0], DVP_MTYPE_MPUCACHED_VIRTUAL, DVP_IMAGE_ROW_ALIGN))
+            {
+                if (status == STATUS_SUCCESS && images[0].pBuffer[0] != pBuffer)
+                    status = STATUS_FAILURE;
+            }
+            else
+                status = STATUS_FAILURE;
+        }
+        for (p = 0; p < dimof(images); p++)
+            DVP_Image_Free(dvp, &images[p]);
+        DVP_KernelGraph_Deinit(dvp);
+    }
+    return status;
+}
+
 status_e dvp_image_share_test(void)
 {
     status_e stat = STATUS_FAILURE;
@@ -1137,6 +2685,199 @@ status_e dvp_img_copy_test(void)
     return status;
 }
 
+// returns the luma and chroma of a pixel, Y800 and the planar formats report neutral chroma
+static void dvp_img_copy_sample(DVP_Image_t *pImage, DVP_U32 x, DVP_U32 y, DVP_U08 yuv[3])
+{
+    DVP_U08 *ptr = DVP_Image_PatchAddressing(pImage, x & ~1, y, 0);
+    yuv[1] = yuv[2] = 128;
+    switch (pImage->color)
+    {
+        case FOURCC_UYVY: yuv[0] = ptr[1 + 2*(x&1)]; yuv[1] = ptr[0]; yuv[2] = ptr[2]; break;
+        case FOURCC_VYUY: yuv[0] = ptr[1 + 2*(x&1)]; yuv[1] = ptr[2]; yuv[2] = ptr[0]; break;
+        case FOURCC_YUY2: yuv[0] = ptr[0 + 2*(x&1)]; yuv[1] = ptr[1]; yuv[2] = ptr[3]; break;
+        case FOURCC_YVYU: yuv[0] = ptr[0 + 2*(x&1)]; yuv[1] = ptr[3]; yuv[2] = ptr[1]; break;
+        default:
+            yuv[0] = *(DVP_U08 *)DVP_Image_PatchAddressing(pImage, x, y, 0);
+            break;
+    }
+}
+
+status_e dvp_img_copy_bench_test(void)
+{
+    status_e status = STATUS_SUCCESS;
+    DVP_Handle dvp = DVP_KernelGraph_Init();
+    DVP_Image_t srcImage, dstImage;
+    color_conversion_t same[] = {
+        {FOURCC_Y800, FOURCC_Y800},
+        {FOURCC_UYVY, FOURCC_UYVY},
+        {FOURCC_NV12, FOURCC_NV12},
+        {FOURCC_IYUV, FOURCC_IYUV},
+    };
+    DVP_U32 i, j, n, x, y, iters = 20;
+    DVP_U32 w = 1280, h = 720;
+
+    if (!dvp)
+        return STATUS_NOT_ENOUGH_MEMORY;
+
+    for (i = 0; i < dimof(same) + dimof(img_copy_conversions) && status == STATUS_SUCCESS; i++)
+    {
+        color_conversion_t *conv = (i < dimof(same) ? &same[i] : &img_copy_conversions[i - dimof(same)]);
+        DVP_Image_Init(&srcImage, w, h, conv->from);
+        DVP_Image_Init(&dstImage, w, h, conv->to);
+        if (DVP_Image_Alloc(dvp, &srcImage, DVP_MTYPE_DEFAULT) &&
+            DVP_Image_Alloc(dvp, &dstImage, DVP_MTYPE_DEFAULT))
+        {
+            rtime_t start, diff;
+            DVP_U08 a[3], b[3];
+            DVP_S08 *ptr = malloc(srcImage.numBytes);
+
+            if (ptr == NULL)
+                status = STATUS_NOT_ENOUGH_MEMORY;
+            else
+            {
+                for (n = 0; n < srcImage.numBytes; n++)
+                    ptr[n] = (DVP_S08)(rand() & 0xFF);
+                DVP_Image_Fill(&srcImage, ptr, srcImage.numBytes);
+                free(ptr);
+            }
+
+            start = rtimer_now();
+            for (j = 0; j < iters && status == STATUS_SUCCESS; j++)
+            {
+                if (DVP_Image_Copy(&dstImage, &srcImage) == DVP_FALSE)
+                {
+                    DVP_PRINT(DVP_ZONE_ERROR, "Failed to copy 0x%08x to 0x%08x\n",
+                              conv->from, conv->to);
+                    status = STATUS_FAILURE;
+                    break;
+                }
+            }
+            diff = rtimer_to_us(rtimer_now() - start);
+
+            for (y = 0; y < h && status == STATUS_SUCCESS; y++)
+            {
+                for (x = 0; x < w; x++)
+                {
+                    dvp_img_copy_sample(&srcImage, x, y, a);
+                    dvp_img_copy_sample(&dstImage, x, y, b);
+                    // Y800 destinations drop the chroma
+                    if (a[0] != b[0] || (conv->to != FOURCC_Y800 && (a[1] != b[1] || a[2] != b[2])))
+                    {
+                        DVP_PRINT(DVP_ZONE_ERROR, "Copy 0x%08x to 0x%08x differs at %ux%u\n",
+                                  conv->from, conv->to, x, y);
+                        status = STATUS_FAILURE;
+                        break;
+                    }
+                }
+            }
+            if (status == STATUS_SUCCESS && conv->from == conv->to &&
+                DVP_Image_Equal(&dstImage, &srcImage) == DVP_FALSE)
+                status = STATUS_FAILURE;
+
+            if (diff == 0)
+                diff = 1;
+            DVP_PRINT(DVP_ZONE_ALWAYS, "Copy 0x%08x to 0x%08x %ux%u: "FMT_RTIMER_T" us/frame, "FMT_RTIMER_T" MB/s\n",
+                      conv->from, conv->to, w, h,
+                      diff/iters, ((rtime_t)dstImage.numBytes * iters)/diff);
+        }
+        else
+        {
+            status = STATUS_NOT_ENOUGH_MEMORY;
+        }
+        DVP_Image_Free(dvp, &dstImage);
+        DVP_Image_Free(dvp, &srcImage);
+        DVP_Image_Deinit(&dstImage);
+        DVP_Image_Deinit(&srcImage);
+    }
+    DVP_KernelGraph_Deinit(dvp);
+    return status;
+}
+
+#if defined(POSIX)
+/*! \brief Runs two copies placed on the nodes of a fake NUMA topology, in
+ * parallel and then as a single synchronous section.
+ */
+status_e dvp_numa_test(void)
+{
+    status_e status = STATUS_FAILURE;
+    DVP_Handle dvp = 0;
+    char prev[16] = {0};
+
+    if (getenv(NUMA_FAKE_ENV))
+        strncpy(prev, getenv(NUMA_FAKE_ENV), sizeof(prev) - 1);
+    setenv(NUMA_FAKE_ENV, "2", 1);
+
+    dvp = DVP_KernelGraph_Init();
+    if (dvp)
+    {
+        DVP_Image_t src, dst[2];
+        DVP_KernelNode_t *nodes = DVP_KernelNode_Alloc(dvp, 2);
+        DVP_KernelGraph_t *graph = DVP_KernelGraph_Alloc(dvp, 2);
+        DVP_U32 numNodesExecuted = 0;
+        DVP_U32 n;
+
+        DVP_Image_Init(&src, width, height, FOURCC_UYVY);
+        DVP_Image_Init(&dst[0], width, height, FOURCC_UYVY);
+        DVP_Image_Init(&dst[1], width, height, FOURCC_UYVY);
+        if (nodes && graph &&
+            DVP_Image_Alloc(dvp, &src, DVP_MTYPE_MPUCACHED_VIRTUAL) &&
+            DVP_Image_Alloc(dvp, &dst[0], DVP_MTYPE_MPUCACHED_VIRTUAL) &&
+            DVP_Image_Alloc(dvp, &dst[1], DVP_MTYPE_MPUCACHED_VIRTUAL) &&
+            DVP_Image_Place(dvp, &dst[0], DVP_NUMA_NODE(0)) &&
+            DVP_Image_Place(dvp, &dst[1], DVP_NUMA_NODE(1)) &&
+            DVP_Image_Place(dvp, &src, DVP_NUMA_NODE_ANY))
+        {
+            status = STATUS_SUCCESS;
+            for (n = 0; n < src.numBytes; n++)
+                src.pBuffer[0][n] = (DVP_U08)rand();
+            for (n = 0; n < dimof(dst); n++)
+            {
+                nodes[n].header.kernel = DVP_KN_COPY;
+                nodes[n].header.affinity = DVP_CORE_CPU;
+                dvp_knode_to(&nodes[n], DVP_Transform_t)->input = src;
+                dvp_knode_to(&nodes[n], DVP_Transform_t)->output = dst[n];
+                DVP_KernelGraphSection_Init(dvp, graph, n, &nodes[n], 1);
+                DVP_KernelGraphSection_Place(dvp, graph, n, DVP_NUMA_NODE(n));
+                graph->order[n] = 0;
+            }
+            if (graph->sections[1].numaNode != DVP_NUMA_NODE(1))
+                status = STATUS_FAILURE;
+
+            if (DVP_KernelGraph_Process(dvp, graph, &numNodesExecuted, dvp_section_complete) != 2 ||
+                DVP_Image_Equal(&dst[0], &src) == DVP_FALSE ||
+                DVP_Image_Equal(&dst[1], &src) == DVP_FALSE)
+                status = STATUS_FAILURE;
+
+            // a lone section runs synchronously but still goes to its node
+            memset(dst[1].pBuffer[0], 0, dst[1].numBytes);
+            graph->order[0] = 1;
+            if (DVP_KernelGraph_Process(dvp, graph, &numNodesExecuted, dvp_section_complete) != 2 ||
+                DVP_Image_Equal(&dst[1], &src) == DVP_FALSE)
+                status = STATUS_FAILURE;
+
+            DVP_PRINT(DVP_ZONE_ALWAYS, "NUMA: copies placed over %u nodes %s\n", numa_node_count(), (status == STATUS_SUCCESS ? "matched" : "FAILED"));
+        }
+        DVP_Image_Free(dvp, &src);
+        DVP_Image_Free(dvp, &dst[0]);
+        DVP_Image_Free(dvp, &dst[1]);
+        DVP_Image_Deinit(&src);
+        DVP_Image_Deinit(&dst[0]);
+        DVP_Image_Deinit(&dst[1]);
+        if (graph)
+            DVP_KernelGraph_Free(dvp, graph);
+        if (nodes)
+            DVP_KernelNode_Free(dvp, nodes, 2);
+        DVP_KernelGraph_Deinit(dvp);
+    }
+
+    if (prev[0])
+        setenv(NUMA_FAKE_ENV, prev, 1);
+    else
+        unsetenv(NUMA_FAKE_ENV);
+    return status;
+}
+#endif
+
 status_e dvp_image_serialization(const char *testVariant)
 {
 #define num_imgs_max (21)
@@ -1594,12 +3335,34 @@ dvp_unittest_t unittests[] = {
     {STATUS_FAILURE, "Framework: Context", dvp_context_test},
     {STATUS_FAILURE, "Framework: Query System", dvp_info_test},//
     {STATUS_FAILURE, "Framework: CPU Nop Test", dvp_cpu_nop_test},//
+    {STATUS_FAILURE, "Framework: Perf Histogram Test", dvp_perf_histogram_test},
+#if defined(POSIX)
+    {STATUS_FAILURE, "Framework: Trace Test", dvp_trace_test},
+#endif
+#if defined(POSIX) && !defined(DVP_USE_IPC)
+    {STATUS_FAILURE, "Framework: Load Contention Test", dvp_load_contention_test},
+#endif
     {STATUS_FAILURE, "Framework: SERIAL Nop Test", dvp_serial_nop_test},
     {STATUS_FAILURE, "Framework: PARALLEL Nop Test", dvp_parallel_nop_test},
+    {STATUS_FAILURE, "Framework: Section Scaling Test", dvp_section_scaling_test},
     {STATUS_FAILURE, "Framework: SERIAL Copy Test", dvp_copy_test},
+    {STATUS_FAILURE, "Framework: Graph Alias Test", dvp_alias_test},
     {STATUS_FAILURE, "Framework: CUSTOM Copy Test", dvp_custom_copy_test},
 #if defined(DVP_USE_YUV)
     {STATUS_FAILURE, "Framework: PARALLEL CC Test", dvp_split_cc_test},//
+#endif
+#if defined(DVP_USE_YUV) || defined(DVP_USE_YUV_C)
+    {STATUS_FAILURE, "Framework: Rotate Test", dvp_rotate_test},
+    {STATUS_FAILURE, "Framework: Scale Test", dvp_scale_test},
+#endif
+#if defined(DVP_USE_LDC)
+    {STATUS_FAILURE, "Framework: LDC Test", dvp_ldc_test},
+#endif
+#if defined(DVP_USE_DEI_C)
+    {STATUS_FAILURE, "Framework: Deinterlacer Test", dvp_deinterlace_test},
+#endif
+#if defined(DVP_USE_DSPLIB_C)
+    {STATUS_FAILURE, "Framework: DSPLIB Test", dvp_dsplib_test},
 #endif
     {STATUS_FAILURE, "Framework: ImageShift", dvp_imageshift_test},
     {STATUS_FAILURE, "Framework: Core Capacity Test", dvp_capacity_test },
@@ -1610,10 +3373,20 @@ dvp_unittest_t unittests[] = {
     {STATUS_FAILURE, "Framework: Buffer Image Init Test", dvp_image_init_test},
     {STATUS_FAILURE, "Framework: Buffer Image Alloc Test", dvp_image_alloc_test},
     {STATUS_FAILURE, "Framework: Buffer Image Free Test", dvp_image_free_test},
+    {STATUS_FAILURE, "Framework: Memory Pool Test", dvp_mem_pool_test},
+    {STATUS_FAILURE, "Framework: Image Row Align Test", dvp_image_row_align_test},
+    {STATUS_FAILURE, "Framework: Memory Pin Test", dvp_mem_pin_test},
+#if !defined(DVP_USE_IPC)
+    {STATUS_FAILURE, "Framework: Cache Ops Test", dvp_cache_ops_test},
+#endif
     {STATUS_FAILURE, "Framework: Image Share Test", dvp_image_share_test},
     {STATUS_FAILURE, "Framework: Image Importer Test", dvp_image_import_test},
     {STATUS_FAILURE, "Framework: Image Importer Free Test", dvp_image_import_free_test},
     {STATUS_FAILURE, "Framework: Image Copy Test", dvp_img_copy_test},
+    {STATUS_FAILURE, "Framework: Image Copy Benchmark", dvp_img_copy_bench_test},
+#if defined(POSIX)
+    {STATUS_FAILURE, "Framework: NUMA Placement Test", dvp_numa_test},
+#endif
     {STATUS_FAILURE, "Framework: Image Serialize Test", dvp_serialize_test},
     {STATUS_FAILURE, "Framework: Image Unerialize Test", dvp_unserialize_test},
     {STATUS_FAILURE, "Framework: Get image Size Test", dvp_image_size_test},
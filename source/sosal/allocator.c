@@ -18,6 +18,22 @@
 #include <sosal/debug.h>
 #include <sosal/list.h>
 
+#if defined(SOSAL_USE_HUGEPAGES) || defined(SOSAL_USE_ION)
+#include <sosal/hash.h>
+#include <sosal/mutex.h>
+#endif
+
+#if defined(SOSAL_USE_MEMFD)
+#include <sys/syscall.h>
+#include <sys/stat.h>
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC (0x0001U)
+#endif
+#ifndef MFD_HUGETLB
+#define MFD_HUGETLB (0x0004U)
+#endif
+#endif
+
 #if defined(SOSAL_USE_SHARED_T)
 #include <sosal/shared.h>
 #endif
@@ -55,12 +71,28 @@ typedef struct _ion_fd_hdl_t {
 } ion_fd_hdl_t;
 #endif
 
+#if defined(SOSAL_USE_HUGEPAGES)
+typedef struct _alloc_mapping_t {
+    ptr_t ptr;
+    size_t size;
+} alloc_mapping_t;
+#endif
+
+#if defined(SOSAL_USE_MEMFD)
+typedef struct _alloc_memfd_t {
+    int fd;
+    ptr_t ptr;
+    size_t size;
+} alloc_memfd_t;
+#endif
+
 #define _SOSAL_ALLOCATOR_T_DEFINED
 typedef struct _allocator_t {
 #if defined(TARGET_DVP_OMAP4) || defined(TARGET_DVP_OMAP5)
 #if defined(SOSAL_USE_ION)
     int32_t device;
-    list_t fd_list;
+    mutex_t fd_lock;
+    hash_t *fd_hash;    /**< The ion_fd_hdl_t of each mapped buffer, keyed by its ION handle */
 #endif
 #if defined(SOSAL_USE_GRALLOC)
     IMG_gralloc_module_public_t *module;
@@ -70,6 +102,10 @@ typedef struct _allocator_t {
     int32_t drm_fd;
     struct omap_device *drm_dev;
 #endif
+#endif
+#if defined(SOSAL_USE_HUGEPAGES)
+    mutex_t huge_lock;
+    hash_t *huge_hash;  /**< The alloc_mapping_t of each huge mapping, keyed by its huge page number */
 #endif
     uint32_t reserved;
 } allocator_t;
@@ -78,21 +114,11 @@ typedef struct _allocator_t {
 
 #define SOSAL_ALLOCATOR_ALIGN (128)
 
-#if defined(SOSAL_USE_ION)
-static int list_hdl_compare(node_t *a, node_t *b)
-{
-    ion_fd_hdl_t *ad = (ion_fd_hdl_t *)a->data;
-    ion_fd_hdl_t *bd = (ion_fd_hdl_t *)b->data;
-    if (ad->handle > bd->handle)
-        return 1;
-    else if (ad->handle < bd->handle)
-        return -1;
-    else
-        return 0;
-}
+#if defined(SOSAL_USE_HUGEPAGES) || defined(SOSAL_USE_MEMFD)
+#define SOSAL_ALLOCATOR_HUGE_WASTE (8)
 #endif
 
-#if defined(SOSAL_USE_SHARED_T)
+#if defined(SOSAL_USE_SHARED_T) && !defined(SOSAL_USE_MEMFD)
 /** Returns a randomly generated unique number */
 static unique_t allocator_rand()
 {
@@ -117,6 +143,168 @@ static size_t allocator_page_align_size(size_t size)
     return rsize;
 }
 
+#if defined(SOSAL_USE_HUGEPAGES) || defined(SOSAL_USE_MEMFD)
+/** This returns the SOSAL_HUGE_PAGE_SIZE aligned size */
+static size_t allocator_huge_align_size(size_t size)
+{
+    return (size + SOSAL_HUGE_PAGE_SIZE - 1) & ~((size_t)SOSAL_HUGE_PAGE_SIZE - 1);
+}
+
+/** Huge pages only pay off when rounding up to them wastes at most 1/SOSAL_ALLOCATOR_HUGE_WASTE
+ * of the mapping, a 1MB plane would otherwise take twice its memory.
+ */
+static bool_e allocator_huge_fits(size_t size)
+{
+    size_t hsize = allocator_huge_align_size(size);
+    if (size == 0 || hsize - size > hsize / SOSAL_ALLOCATOR_HUGE_WASTE)
+        return false_e;
+    return true_e;
+}
+#endif
+
+#if defined(SOSAL_USE_HUGEPAGES)
+/** Huge mappings are aligned to a huge page, so their page numbers are unique keys. */
+static value_t allocator_huge_key(ptr_t ptr)
+{
+    return (value_t)ptr / SOSAL_HUGE_PAGE_SIZE;
+}
+
+/** Maps zeroed anonymous memory from the reserved huge pages, or if there are
+ * none, aligns a normal mapping so the kernel can back it with transparent huge pages.
+ */
+static ptr_t allocator_huge_map(allocator_t *alloc, size_t size)
+{
+    size_t hsize = allocator_huge_align_size(size);
+    uint8_t *ptr = MAP_FAILED;
+    alloc_mapping_t *map = NULL;
+
+#if defined(MAP_HUGETLB)
+    ptr = mmap(NULL, hsize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+#endif
+    if (ptr == MAP_FAILED)
+    {
+        size_t head = 0;
+        ptr = mmap(NULL, hsize + SOSAL_HUGE_PAGE_SIZE, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED)
+            return NULL;
+        head = (SOSAL_HUGE_PAGE_SIZE - ((size_t)ptr & (SOSAL_HUGE_PAGE_SIZE - 1))) & (SOSAL_HUGE_PAGE_SIZE - 1);
+        if (head > 0)
+            munmap(ptr, head);
+        if (SOSAL_HUGE_PAGE_SIZE - head > 0)
+            munmap(ptr + head + hsize, SOSAL_HUGE_PAGE_SIZE - head);
+        ptr += head;
+#if defined(MADV_HUGEPAGE)
+        madvise(ptr, hsize, MADV_HUGEPAGE);
+#endif
+    }
+
+    map = (alloc_mapping_t *)calloc(1, sizeof(alloc_mapping_t));
+    if (map == NULL)
+    {
+        munmap(ptr, hsize);
+        return NULL;
+    }
+    map->ptr = ptr;
+    map->size = hsize;
+    mutex_lock(&alloc->huge_lock);
+    hash_set(alloc->huge_hash, allocator_huge_key(ptr), (value_t)map);
+    mutex_unlock(&alloc->huge_lock);
+    SOSAL_PRINT(SOSAL_ZONE_MEM, "HUGE: Mapped %p for "FMT_SIZE_T" bytes\n", ptr, hsize);
+    return ptr;
+}
+
+/** Unmaps memory from \ref allocator_huge_map, returns false_e if it was not mapped there. */
+static bool_e allocator_huge_unmap(allocator_t *alloc, ptr_t ptr)
+{
+    alloc_mapping_t *map = NULL;
+    value_t key = allocator_huge_key(ptr);
+
+    mutex_lock(&alloc->huge_lock);
+    if (((value_t)ptr & (SOSAL_HUGE_PAGE_SIZE - 1)) == 0 &&
+        hash_get(alloc->huge_hash, key, (value_t *)&map) == true_e)
+        hash_set(alloc->huge_hash, key, 0);
+    mutex_unlock(&alloc->huge_lock);
+    if (map)
+    {
+        SOSAL_PRINT(SOSAL_ZONE_MEM, "HUGE: Unmapping %p for "FMT_SIZE_T" bytes\n", map->ptr, map->size);
+        munmap(map->ptr, map->size);
+        free(map);
+        return true_e;
+    }
+    return false_e;
+}
+#endif
+
+#if defined(SOSAL_USE_MEMFD)
+/** Maps a memfd of the size, taking ownership of the descriptor. */
+static alloc_memfd_t *allocator_memfd_map(int fd, size_t size)
+{
+    alloc_memfd_t *mfd = (alloc_memfd_t *)calloc(1, sizeof(alloc_memfd_t));
+    if (mfd)
+    {
+        mfd->fd = fd;
+        mfd->size = size;
+        mfd->ptr = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mfd->ptr == MAP_FAILED)
+        {
+            SOSAL_PRINT(SOSAL_ZONE_MEM, "MEMFD: Failed to map fd %d (errno=%d)\n", fd, errno);
+            free(mfd);
+            mfd = NULL;
+        }
+#if defined(MADV_HUGEPAGE)
+        else if (size >= SOSAL_HUGE_PAGE_SIZE)
+            madvise(mfd->ptr, size, MADV_HUGEPAGE);
+#endif
+    }
+    if (mfd == NULL)
+        close(fd);
+    return mfd;
+}
+
+/** Creates a memfd, preferring reserved huge pages for sizes which nearly fill them. */
+static alloc_memfd_t *allocator_memfd_create(size_t size)
+{
+    int fd = -1;
+    size_t rsize = allocator_page_align_size(size);
+    if (allocator_huge_fits(rsize) == true_e)
+    {
+        // the mapping fails when there are no reserved huge pages left
+        alloc_memfd_t *mfd = NULL;
+        fd = (int)syscall(SYS_memfd_create, "sosal", MFD_CLOEXEC|MFD_HUGETLB);
+        if (fd >= 0 && ftruncate(fd, allocator_huge_align_size(rsize)) == 0)
+            mfd = allocator_memfd_map(fd, allocator_huge_align_size(rsize));
+        else if (fd >= 0)
+            close(fd);
+        if (mfd)
+            return mfd;
+    }
+    fd = (int)syscall(SYS_memfd_create, "sosal", MFD_CLOEXEC);
+    if (fd < 0)
+    {
+        SOSAL_PRINT(SOSAL_ZONE_ERROR, "MEMFD: Failed to create (errno=%d)\n", errno);
+        return NULL;
+    }
+    if (ftruncate(fd, rsize) < 0)
+    {
+        SOSAL_PRINT(SOSAL_ZONE_ERROR, "MEMFD: Failed to size to "FMT_SIZE_T" (errno=%d)\n", rsize, errno);
+        close(fd);
+        return NULL;
+    }
+    return allocator_memfd_map(fd, rsize);
+}
+
+static void allocator_memfd_free(alloc_memfd_t *mfd)
+{
+    if (mfd)
+    {
+        munmap(mfd->ptr, mfd->size);
+        close(mfd->fd);
+        free(mfd);
+    }
+}
+#endif
+
+
 void allocator_deinit(allocator_t **palloc)
 {
     if (palloc)
@@ -144,6 +332,34 @@ void allocator_deinit(allocator_t **palloc)
                 alloc->drm_dev = NULL;
                 close(alloc->drm_fd);
             }
+#endif
+#if defined(SOSAL_USE_ION)
+            // any remaining buffers are leaked by the caller, only forget them
+            if (alloc->fd_hash)
+            {
+                while (hash_length(alloc->fd_hash) > 0)
+                {
+                    value_t value = 0;
+                    hash_clean(alloc->fd_hash, &value);
+                    free((ion_fd_hdl_t *)value);
+                }
+                hash_deinit(alloc->fd_hash);
+            }
+            mutex_deinit(&alloc->fd_lock);
+#endif
+#if defined(SOSAL_USE_HUGEPAGES)
+            // any remaining mappings are leaked by the caller, only forget them
+            if (alloc->huge_hash)
+            {
+                while (hash_length(alloc->huge_hash) > 0)
+                {
+                    value_t value = 0;
+                    hash_clean(alloc->huge_hash, &value);
+                    free((alloc_mapping_t *)value);
+                }
+                hash_deinit(alloc->huge_hash);
+            }
+            mutex_deinit(&alloc->huge_lock);
 #endif
             free(alloc);
          }
@@ -158,9 +374,19 @@ allocator_t *allocator_init()
     int32_t errors = 0;
     if (alloc)
     {
+#if defined(SOSAL_USE_HUGEPAGES)
+        mutex_init(&alloc->huge_lock);
+        alloc->huge_hash = hash_init(HASH_SIZE_SMALL, NULL);
+        if (alloc->huge_hash == NULL)
+            errors++;
+#endif
 #if defined(SOSAL_USE_TILER)
         alloc->reserved = 1;
 #elif defined(SOSAL_USE_ION)
+        mutex_init(&alloc->fd_lock);
+        alloc->fd_hash = hash_init(HASH_SIZE_SMALL, NULL);
+        if (alloc->fd_hash == NULL)
+            errors++;
         if (errors == 0)
         {
             alloc->device = ion_open();
@@ -319,6 +545,100 @@ bool_e allocator_invalidate(allocator_t *alloc,
     return ret;
 }
 
+/** Returns the number of bytes the dimensions of a plane cover. */
+static size_t allocator_plane_size(int32_t ndims, allocator_dimensions_t *dim)
+{
+    int32_t n;
+    size_t size = 1;
+    for (n = 0; n < ndims; n++)
+        size *= dim->dims[n];
+    return size;
+}
+
+bool_e allocator_pin(allocator_t *alloc,
+                     allocator_memory_type_e mtype,
+                     int32_t nptrs,
+                     int32_t ndims,
+                     allocator_dimensions_t *dims,
+                     ptr_t *ptrs,
+                     bool_e lock)
+{
+    bool_e ret = true_e;
+    int32_t p;
+
+    if (alloc == NULL || mtype > ALLOCATOR_MEMORY_TYPE_MAX || nptrs <= 0 || ndims <= 0 || dims == NULL || ptrs == NULL)
+        return false_e;
+
+    // the other types are physically backed when they are allocated
+    if (mtype != ALLOCATOR_MEMORY_TYPE_VIRTUAL && mtype != ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED)
+        return true_e;
+
+    for (p = 0; p < nptrs; p++)
+    {
+        uint8_t *ptr = (uint8_t *)ptrs[p];
+        size_t size = allocator_plane_size(ndims, &dims[p]);
+        bool_e faulted = false_e;
+        if (ptr == NULL)
+            continue;
+#if defined(LINUX) || defined(ANDROID) || defined(__QNX__)
+        if (lock == true_e)
+        {
+            // locking faults in every page as well
+            if (mlock(ptr, size) == 0)
+                faulted = true_e;
+            else
+            {
+                SOSAL_PRINT(SOSAL_ZONE_WARNING, "Failed to lock %p for "FMT_SIZE_T" bytes (errno=%d)\n", ptr, size, errno);
+                ret = false_e;
+            }
+        }
+#if defined(MADV_POPULATE_WRITE)
+        if (faulted == false_e && madvise(ptr, size, MADV_POPULATE_WRITE) == 0)
+            faulted = true_e;
+#endif
+#endif
+        if (faulted == false_e)
+        {
+            // write each page back to itself so the contents are kept
+            size_t i;
+            for (i = 0; i < size; i += SOSAL_PAGE_SIZE)
+            {
+                volatile uint8_t *b = &ptr[i];
+                *b = *b;
+            }
+        }
+    }
+    return ret;
+}
+
+bool_e allocator_unpin(allocator_t *alloc,
+                       allocator_memory_type_e mtype,
+                       int32_t nptrs,
+                       int32_t ndims,
+                       allocator_dimensions_t *dims,
+                       ptr_t *ptrs)
+{
+    bool_e ret = true_e;
+
+    if (alloc == NULL || mtype > ALLOCATOR_MEMORY_TYPE_MAX || nptrs <= 0 || ndims <= 0 || dims == NULL || ptrs == NULL)
+        return false_e;
+
+    if (mtype != ALLOCATOR_MEMORY_TYPE_VIRTUAL && mtype != ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED)
+        return true_e;
+
+#if defined(LINUX) || defined(ANDROID) || defined(__QNX__)
+    {
+        int32_t p;
+        for (p = 0; p < nptrs; p++)
+        {
+            if (ptrs[p] && munlock(ptrs[p], allocator_plane_size(ndims, &dims[p])) != 0)
+                ret = false_e;
+        }
+    }
+#endif
+    return ret;
+}
+
 bool_e allocator_free(allocator_t *alloc,
                       allocator_memory_type_e mtype,
                       int32_t nptrs,
@@ -359,29 +679,24 @@ bool_e allocator_free(allocator_t *alloc,
             if (hdls == NULL)
                 return false_e;
             for (p = 0; p < nptrs; p++) {
-                node_t node, *tmp;
-                ion_fd_hdl_t fd_hdl = {
-                    .handle = 0,
-                    .fd = 0,
-                };
+                ion_fd_hdl_t *fd_hdl = NULL;
                 if (ptrs[p] == NULL || hdls[p] == 0)
                     continue;
                 SOSAL_PRINT(SOSAL_ZONE_MEM, "ION: Freeing %p Hdl:"FMT_VALUE_T"\n", ptrs[p],hdls[p]);
                 if (ion_free(alloc->device, (struct ion_handle *)hdls[p]) < 0) {
                     SOSAL_PRINT(SOSAL_ZONE_ERROR, "%s: Failed to free ION hdl: "FMT_VALUE_T" ptr: %p\n", __FUNCTION__, hdls[p], ptrs[p]);
                 }
-                fd_hdl.handle = (struct ion_handle *)hdls[p];
-                node.data = (value_t)&fd_hdl;
-                tmp = list_remove_match(&alloc->fd_list, &node, list_hdl_compare);
-                if (tmp)
+                mutex_lock(&alloc->fd_lock);
+                if (hash_get(alloc->fd_hash, hdls[p], (value_t *)&fd_hdl) == true_e)
+                    hash_set(alloc->fd_hash, hdls[p], 0);
+                mutex_unlock(&alloc->fd_lock);
+                if (fd_hdl)
                 {
-                    ion_fd_hdl_t *fd_hdl = (ion_fd_hdl_t *)tmp->data;
                     if (munmap(ptrs[p], fd_hdl->size) < 0) {
                         SOSAL_PRINT(SOSAL_ZONE_ERROR, "%s: Failed to munmap ION hdl: "FMT_VALUE_T" ptr: %p\n", __FUNCTION__, hdls[p], ptrs[p]);
                     }
                     close(fd_hdl->fd);
                     free(fd_hdl);
-                    free(tmp);
                 }
                 hdls[p] = 0;
                 ptrs[p] = NULL;
@@ -436,11 +751,26 @@ bool_e allocator_free(allocator_t *alloc,
                 if (ptrs[p] == NULL)
                     continue;
                 SOSAL_PRINT(SOSAL_ZONE_MEM, "Freeing %p\n", ptrs[p]);
+#if defined(SOSAL_USE_HUGEPAGES)
+                if (allocator_huge_unmap(alloc, ptrs[p]) == false_e)
+#endif
                 free(ptrs[p]);
                 ptrs[p] = NULL;
             }
             break;
-#if defined(SOSAL_USE_SHARED_T)
+#if defined(SOSAL_USE_MEMFD)
+        case ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED:
+            if (hdls == NULL)
+                return false_e;
+            for (p = 0; p < nptrs; p++)
+            {
+                SOSAL_PRINT(SOSAL_ZONE_MEM, "MEMFD: Freeing %p Hdl:"FMT_VALUE_T"\n", ptrs[p], hdls[p]);
+                allocator_memfd_free((alloc_memfd_t *)hdls[p]);
+                hdls[p] = 0;
+                ptrs[p] = NULL;
+            }
+            break;
+#elif defined(SOSAL_USE_SHARED_T)
         case ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED:
         {
             for (p = 0; p < nptrs; p++)
@@ -646,17 +976,11 @@ bool_e allocator_calloc(allocator_t *alloc,
                             SOSAL_PRINT(SOSAL_ZONE_ERROR, "%s: ION Mapping Failed, status=%d, errno=%d\n", __FUNCTION__, status, errno);
                             ret = false_e;
                         } else {
-                            node_t *node = node_create((value_t)fd_hdl);
-                            if (node)
-                            {
-                                fd_hdl->handle = (struct ion_handle *)hdls[p];
-                                fd_hdl->size = rsize;
-                                list_append(&alloc->fd_list, node);
-                            }
-                            else
-                            {
-                                SOSAL_PRINT(SOSAL_ZONE_ERROR, "Failed to remember fd to hdl relation. LEAK!\n");
-                            }
+                            fd_hdl->handle = (struct ion_handle *)hdls[p];
+                            fd_hdl->size = rsize;
+                            mutex_lock(&alloc->fd_lock);
+                            hash_set(alloc->fd_hash, hdls[p], (value_t)fd_hdl);
+                            mutex_unlock(&alloc->fd_lock);
                             /** \note Memset'ing the ION buffer can be a VERY SLOW OPERATION! */
                             if (mtype == ALLOCATOR_MEMORY_TYPE_TILED_2D_UNCACHED) {
                                 int32_t y;
@@ -825,6 +1149,11 @@ bool_e allocator_calloc(allocator_t *alloc,
                 }
                 // if we're running on an OMAP, the SIMCOP needs page aligned data.
                 rsize = allocator_page_align_size(size);
+#if defined(SOSAL_USE_HUGEPAGES)
+                // large planes take a dTLB miss on nearly every line with small pages
+                if (allocator_huge_fits(rsize) == true_e && (ptrs[p] = allocator_huge_map(alloc, rsize)) != NULL)
+                    continue; // anonymous mappings are already zeroed
+#endif
 #if defined(ANDROID)
                 ptrs[p] = memalign(SOSAL_PAGE_SIZE, rsize);
                 if (ptrs[p]) memset(ptrs[p], 0, rsize);
@@ -848,6 +1177,9 @@ bool_e allocator_calloc(allocator_t *alloc,
                 if (ptrs[p] == NULL) {
                     ret = false_e;
                     for (p = p-1; p > -1; p--) {
+#if defined(SOSAL_USE_HUGEPAGES)
+                        if (allocator_huge_unmap(alloc, ptrs[p]) == false_e)
+#endif
                         free(ptrs[p]);
                         ptrs[p] = NULL;
                     }
@@ -856,7 +1188,39 @@ bool_e allocator_calloc(allocator_t *alloc,
             }
             break;
         }
-#if defined(SOSAL_USE_SHARED_T)
+#if defined(SOSAL_USE_MEMFD)
+        case ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED:
+        {
+            for (p = 0; p < nptrs; p++)
+            {
+                alloc_memfd_t *mfd = NULL;
+                size = 1;
+                for (n = 0; n < ndims; n++)
+                {
+                    size *= dims[p].dims[n];
+                    strides[p].dims[n] = size;
+                }
+                mfd = allocator_memfd_create(size);
+                if (mfd)
+                {
+                    SOSAL_PRINT(SOSAL_ZONE_MEM, "MEMFD: FD:%d SIZE:"FMT_SIZE_T"\n", mfd->fd, mfd->size);
+                    hdls[p] = (value_t)mfd;
+                    ptrs[p] = mfd->ptr;
+                }
+                else
+                {
+                    for (p = p-1; p > -1; p--) {
+                        allocator_memfd_free((alloc_memfd_t *)hdls[p]);
+                        hdls[p] = 0;
+                        ptrs[p] = NULL;
+                    }
+                    ret = false_e;
+                    break;
+                }
+            }
+            break;
+        }
+#elif defined(SOSAL_USE_SHARED_T)
         case ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED:
         {
             for (p = 0; p < nptrs; p++)
@@ -945,7 +1309,19 @@ bool_e allocator_share(allocator_t *alloc,
             ret = true_e;
             break;
 #endif
-#if defined(SOSAL_USE_SHARED_T)
+#if defined(SOSAL_USE_MEMFD)
+        case ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED:
+            ret = true_e;
+            for (p = 0; p < nptrs; p++)
+            {
+                alloc_memfd_t *mfd = (alloc_memfd_t *)hdls[p];
+                // the descriptor is lent, it is closed when the memory is freed.
+                fds[p] = (mfd ? mfd->fd : -1);
+                if (fds[p] < 0)
+                    ret = false_e;
+            }
+            break;
+#elif defined(SOSAL_USE_SHARED_T)
         case ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED:
             for (p = 0; p < nptrs; p++)
             {
@@ -1017,15 +1393,9 @@ bool_e allocator_import(allocator_t *alloc,
                     {
                         fd_hdl->handle = (struct ion_handle *)hdls[p];
                         fd_hdl->size = rsize;
-                        node_t *node = node_create((value_t)fd_hdl);
-                        if (node)
-                            list_append(&alloc->fd_list, node);
-                        else
-                        {
-                            SOSAL_PRINT(SOSAL_ZONE_ERROR, "ERROR: Failed to remember file descriptor. LEAK!\n");
-                            ret = false_e;
-                            break;
-                        }
+                        mutex_lock(&alloc->fd_lock);
+                        hash_set(alloc->fd_hash, hdls[p], (value_t)fd_hdl);
+                        mutex_unlock(&alloc->fd_lock);
                     }
                 }
                 else
@@ -1052,7 +1422,43 @@ bool_e allocator_import(allocator_t *alloc,
             }
             break;
 #endif
-#if defined(SOSAL_USE_SHARED_T)
+#if defined(SOSAL_USE_MEMFD)
+        case ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED:
+            ret = true_e;
+            for (p = 0; p < nptrs; p++)
+            {
+                alloc_memfd_t *mfd = NULL;
+                struct stat st;
+                int fd = dup(fds[p]); // the caller keeps its descriptor
+                size = 1;
+                for (n = 0; n < ndims; n++)
+                {
+                    size *= dims[p].dims[n];
+                    strides[p].dims[n] = size;
+                }
+                if (fd >= 0 && fstat(fd, &st) == 0 && (size_t)st.st_size >= size)
+                    mfd = allocator_memfd_map(fd, (size_t)st.st_size);
+                else if (fd >= 0)
+                    close(fd);
+                if (mfd)
+                {
+                    SOSAL_PRINT(SOSAL_ZONE_MEM, "MEMFD: Imported FD:%d as %p SIZE:"FMT_SIZE_T"\n", fds[p], mfd->ptr, mfd->size);
+                    hdls[p] = (value_t)mfd;
+                    ptrs[p] = mfd->ptr;
+                }
+                else
+                {
+                    for (p = p-1; p > -1; p--) {
+                        allocator_memfd_free((alloc_memfd_t *)hdls[p]);
+                        hdls[p] = 0;
+                        ptrs[p] = NULL;
+                    }
+                    ret = false_e;
+                    break;
+                }
+            }
+            break;
+#elif defined(SOSAL_USE_SHARED_T)
         case ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED:
             for (p = 0; p < nptrs; p++)
             {
@@ -1164,6 +1570,81 @@ bool_e allocator_memory_import(allocator_t *alloc, allocator_memory_t *memory)
 #include <sosal/image.h>
 #include <sosal/fph.h>
 
+#if defined(SOSAL_USE_ION) || defined(SOSAL_USE_MEMFD) || defined(SOSAL_USE_SHARED_T)
+/** Shares batches of buffers, then imports, frees and re-imports each of them,
+ * so that thousands of handles come and go from the tracking of the allocator.
+ */
+static int32_t allocator_unittest_imports(allocator_t *alloc, uint32_t rounds)
+{
+#if defined(SOSAL_USE_ION) && !defined(SOSAL_USE_MEMFD)
+    allocator_memory_type_e mtype = ALLOCATOR_MEMORY_TYPE_TILED_1D_UNCACHED;
+#else
+    allocator_memory_type_e mtype = ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED;
+#endif
+    allocator_dimensions_t dims[1] = {{{{1, 4096, 1}}}};
+    allocator_dimensions_t strides[1];
+    ptr_t sptr[128], iptr[128];
+    value_t shdl[128], ihdl[128];
+    int32_t fds[128];
+    bool_e shared[128];
+    int32_t errors = 0;
+    uint32_t r, i, pass;
+
+    for (r = 0; r < rounds; r++)
+    {
+        for (i = 0; i < dimof(sptr); i++)
+        {
+            sptr[i] = NULL;
+            shdl[i] = 0;
+            fds[i] = -1;
+            // a shared_t share is a key, not a descriptor, so it may well be negative
+            shared[i] = false_e;
+            if (allocator_calloc(alloc, mtype, 1, 3, dims, &sptr[i], &shdl[i], strides) == false_e ||
+                allocator_share(alloc, mtype, 1, &shdl[i], &fds[i]) == false_e)
+                errors++;
+            else
+            {
+                ((uint8_t *)sptr[i])[0] = (uint8_t)(r + i);
+                shared[i] = true_e;
+            }
+        }
+        // the second import reuses the handles which the first one freed
+        for (pass = 0; pass < 2; pass++)
+        {
+            for (i = 0; i < dimof(iptr); i++)
+            {
+                iptr[i] = NULL;
+                ihdl[i] = 0;
+                if (shared[i] == false_e)
+                    continue;
+                if (allocator_import(alloc, mtype, 1, 3, dims, &iptr[i], &ihdl[i], strides, &fds[i]) == false_e ||
+                    ((uint8_t *)iptr[i])[0] != (uint8_t)(r + i))
+                    errors++;
+            }
+            for (i = 0; i < dimof(iptr); i++)
+            {
+                if (iptr[i] && allocator_free(alloc, mtype, 1, &iptr[i], &ihdl[i]) == false_e)
+                    errors++;
+            }
+        }
+        for (i = 0; i < dimof(sptr); i++)
+        {
+#if defined(SOSAL_USE_ION) && !defined(SOSAL_USE_MEMFD)
+            // an ION share is a new descriptor, a memfd share is lent by the allocator
+            if (shared[i] == true_e)
+                close(fds[i]);
+#endif
+            if (sptr[i] && allocator_free(alloc, mtype, 1, &sptr[i], &shdl[i]) == false_e)
+                errors++;
+        }
+    }
+    if (errors > 0) {
+        SOSAL_PRINT(SOSAL_ZONE_ERROR, "There were %d errors importing %u buffers\n", errors, rounds * 2 * (uint32_t)dimof(iptr));
+    }
+    return errors;
+}
+#endif
+
 bool_e allocator_unittest(int argc, char *argv[])
 {
     uint32_t width = 320;
@@ -1217,12 +1698,17 @@ bool_e allocator_unittest(int argc, char *argv[])
 
 #if !defined(SOSAL_USE_TILER) && !defined(SOSAL_USE_ION) && !defined(SOSAL_USE_BO)
             if (types[t] == ALLOCATOR_MEMORY_TYPE_TILED_1D_UNCACHED ||
+                types[t] == ALLOCATOR_MEMORY_TYPE_TILED_1D_CACHED ||
                 types[t] == ALLOCATOR_MEMORY_TYPE_TILED_2D_UNCACHED)
-                break;
+                continue;
 #endif
 #if !defined(SOSAL_USE_GRALLOC) && !defined(SOSAL_USE_BO)
             if (types[t] == ALLOCATOR_MEMORY_TYPE_GFX_2D_UNCACHED)
-                break;
+                continue;
+#endif
+#if !defined(SOSAL_USE_SHARED_T) && !defined(SOSAL_USE_MEMFD)
+            if (types[t] == ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED)
+                continue;
 #endif
             SOSAL_PRINT(SOSAL_ZONE_ALWAYS, "IMAGE ALLOC\n");
             for (i = 0; i < numImages; i++) {
@@ -1272,6 +1758,62 @@ bool_e allocator_unittest(int argc, char *argv[])
             }
         }
 
+#if defined(SOSAL_USE_MEMFD) || defined(SOSAL_USE_SHARED_T)
+        SOSAL_PRINT(SOSAL_ZONE_ALWAYS, "SHARE/IMPORT\n");
+        {
+            // an imported plane is a second mapping of the same pages
+            ptr_t sptr[1] = {NULL}, iptr[1] = {NULL};
+            value_t shdl[1] = {0}, ihdl[1] = {0};
+            int32_t fds[1] = {-1};
+            if (allocator_calloc(alloc, ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED, 1, 3, dims, sptr, shdl, strides) &&
+                allocator_share(alloc, ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED, 1, shdl, fds) &&
+                allocator_import(alloc, ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED, 1, 3, dims, iptr, ihdl, strides, fds))
+            {
+                memset(sptr[0], 0x5A, width);
+                ((uint8_t *)iptr[0])[width*height - 1] = 0xA5;
+                if (iptr[0] == sptr[0] ||
+                    ((uint8_t *)iptr[0])[width - 1] != 0x5A ||
+                    ((uint8_t *)sptr[0])[width*height - 1] != 0xA5)
+                    errors++;
+                allocator_free(alloc, ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED, 1, iptr, ihdl);
+            }
+            else
+                errors++;
+            if (sptr[0])
+                allocator_free(alloc, ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED, 1, sptr, shdl);
+        }
+#endif
+
+#if defined(SOSAL_USE_HUGEPAGES) || defined(SOSAL_USE_MEMFD)
+        SOSAL_PRINT(SOSAL_ZONE_ALWAYS, "HUGE ROUNDING\n");
+        if (allocator_huge_fits(SOSAL_HUGE_PAGE_SIZE/2) == true_e ||
+            allocator_huge_fits(3*SOSAL_HUGE_PAGE_SIZE/2) == true_e ||
+            allocator_huge_fits(SOSAL_HUGE_PAGE_SIZE - SOSAL_HUGE_PAGE_SIZE/16) == false_e ||
+            allocator_huge_fits(SOSAL_HUGE_PAGE_SIZE) == false_e)
+            errors++;
+#endif
+#if defined(SOSAL_USE_MEMFD)
+        {
+            // a 1MB plane must not be rounded up to a whole huge page
+            allocator_dimensions_t mdims[1] = {{{{1, SOSAL_HUGE_PAGE_SIZE/2, 1}}}};
+            ptr_t mptr[1] = {NULL};
+            value_t mhdl[1] = {0};
+            if (allocator_calloc(alloc, ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED, 1, 3, mdims, mptr, mhdl, strides) == false_e)
+                errors++;
+            else
+            {
+                if (((alloc_memfd_t *)mhdl[0])->size != SOSAL_HUGE_PAGE_SIZE/2)
+                    errors++;
+                allocator_free(alloc, ALLOCATOR_MEMORY_TYPE_VIRTUAL_SHARED, 1, mptr, mhdl);
+            }
+        }
+#endif
+
+#if defined(SOSAL_USE_ION) || defined(SOSAL_USE_MEMFD) || defined(SOSAL_USE_SHARED_T)
+        SOSAL_PRINT(SOSAL_ZONE_ALWAYS, "IMPORT STRESS\n");
+        errors += allocator_unittest_imports(alloc, 16);
+#endif
+
         allocator_deinit(&alloc);
     }
     fph_deinit(handle_hash);
@@ -16,26 +16,74 @@
 
 #include <sosal/cache.h>
 #include <sosal/module.h> // just for unittest
+#include <sosal/thread.h> // just for unittest
+#include <sosal/rtimer.h> // just for unittest
+#include <sosal/numa.h>   // just for unittest
 #include <sosal/debug.h>
 
+/** Returns the number of ways of a set, the sets differ by at most one line. */
+static size_t cache_ways(cache_t *cache, size_t s)
+{
+    return (cache->numLines - s + cache->numSets - 1) / cache->numSets;
+}
+
+/** Returns the set which may hold the line of the offset. */
+static size_t cache_set(cache_t *cache, size_t offset)
+{
+    return (offset / cache->lineSize) % cache->numSets;
+}
+
+static size_t cache_round_offset(cache_t *c, size_t offset)
+{
+    return (offset / c->lineSize) *  c->lineSize;
+}
+
+/** Commits a line if it holds uncommitted data. Call with the set of the line locked. */
+static void cache_clean(cache_t *cache, cache_line_t *line)
+{
+    if (line->valid && line->dirty)
+    {
+        cache->commitLine(cache->cookie, line->data, cache->lineSize, line->start_offset);
+        line->dirty = false_e;
+    }
+}
+
 void cache_destroy(cache_t *cache)
 {
     size_t i = 0;
-    for (i = 0; i < cache->numLines; i++)
+    for (i = 0; i < cache->numLines && cache->line != NULL; i++)
     {
         if (cache->line[i].data != NULL)
         {
-            if (cache->line[i].data)
-                free(cache->line[i].data);
+            cache_clean(cache, &cache->line[i]);
+            free(cache->line[i].data);
             cache->line[i].data = NULL;
         }
     }
     free(cache->line);
-    mutex_deinit(&cache->mutex);
+    for (i = 0; i < cache->numSets && cache->sets != NULL; i++)
+        mutex_deinit(&cache->sets[i].mutex);
+    free(cache->sets);
     memset(cache, 0, sizeof(cache_t));
     free(cache);
 }
 
+/** Returns zeroed memory which starts on a cache line, so that the padded sets
+ * and lines each own whole cache lines.
+ */
+static void *cache_calloc(size_t count, size_t size)
+{
+#if defined(POSIX)
+    void *ptr = NULL;
+    if (posix_memalign(&ptr, SOSAL_CACHE_LINE_SIZE, count * size) != 0)
+        return NULL;
+    memset(ptr, 0, count * size);
+    return ptr;
+#else
+    return calloc(count, size);
+#endif
+}
+
 cache_t *cache_create(size_t lineSize,
                       size_t numLines,
                       cache_policy_e policy,
@@ -53,10 +101,13 @@ cache_t *cache_create(size_t lineSize,
         cache->fillLine = fill;
         cache->commitLine = commit;
         cache->policy = policy;
-        mutex_init(&cache->mutex);
-        cache->line  = calloc(cache->numLines, sizeof(cache_line_t));
-        if (cache->line)
+        cache->numSets = (numLines > CACHE_WAYS ? numLines / CACHE_WAYS : 1);
+        cache->sets = cache_calloc(cache->numSets, sizeof(cache_set_t));
+        cache->line = cache_calloc(cache->numLines, sizeof(cache_line_t));
+        if (cache->line && cache->sets)
         {
+            for (i = 0; i < cache->numSets; i++)
+                mutex_init(&cache->sets[i].mutex);
             for (i = 0; i < cache->numLines; i++)
             {
                 cache->line[i].data = calloc(cache->lineSize, 1);
@@ -70,6 +121,8 @@ cache_t *cache_create(size_t lineSize,
         }
         else
         {
+            // the mutexes were not initialized yet
+            cache->numSets = 0;
             cache_destroy(cache);
             cache = NULL;
         }
@@ -77,93 +130,109 @@ cache_t *cache_create(size_t lineSize,
     return cache;
 }
 
-bool_e cache_index(cache_t *cache, size_t offset, size_t *index)
+/** Returns the index of the line which holds the offset or numLines. Call with the set locked. */
+static size_t cache_index(cache_t *cache, size_t offset)
 {
+    size_t start = cache_round_offset(cache, offset);
     size_t i;
-    for (i = 0; i < cache->numLines; i++)
+    for (i = cache_set(cache, offset); i < cache->numLines; i += cache->numSets)
     {
-        if (cache->line[i].valid == true_e && cache->line[i].start_offset <= offset && offset < cache->line[i].end_offset)
-        {
-            *index = i;
-            return true_e;
-        }
+        if (cache->line[i].valid == true_e && cache->line[i].start_offset == start)
+            return i;
     }
-    return false_e;
+    return cache->numLines;
 }
 
-static size_t cache_round_offset(cache_t *c, size_t offset)
+/** Returns a line of the set to reuse, or numLines if every line is locked.
+ * The clock hand skips each line which was used since it last passed, so the
+ * line which is taken is one which was not used for a full turn. Call with the
+ * set locked.
+ */
+static size_t cache_next(cache_t *cache, size_t s)
 {
-    return (offset / c->lineSize) *  c->lineSize;
-}
+    cache_set_t *set = &cache->sets[s];
+    size_t ways = cache_ways(cache, s);
+    size_t pass;
 
-static size_t cache_next(cache_t *cache)
-{
-    size_t i = 0;
-    bool_e found = false_e;
-    size_t free_index = 0;
-    size_t oldest_index = 0;
-    clock_t oldest_clock = clock();
-    // find the an empty cache line
-    for (i = 0; i < cache->numLines; i++)
+    for (pass = 0; pass < 2 * ways; pass++)
     {
-        if (cache->line[i].valid == false_e) {
-            free_index = i;
-            found = true_e;
-        } else {
-            if (cache->line[i].locked == false_e && cache->line[i].age < oldest_clock) {
-                oldest_clock = cache->line[i].age;
-                oldest_index = i;
-            }
+        size_t i = s + (set->hand * cache->numSets);
+        cache_line_t *line = &cache->line[i];
+
+        set->hand = (set->hand + 1) % ways;
+        if (line->locked == true_e)
+            continue;
+        if (line->valid == true_e && line->referenced == true_e)
+        {
+            line->referenced = false_e;
+            continue;
         }
+        // age out the line
+        cache_clean(cache, line);
+        line->valid = false_e;
+        return i;
     }
-    if (found)
-        return free_index;
-    else {
-        // age out the oldest!
-        if (cache->policy == CACHE_POLICY_WRITE_BACK)
-            cache->commitLine(cache->cookie, cache->line[i].data, cache->lineSize, cache->line[i].start_offset);
-        cache->line[i].valid = false_e;
-        return oldest_index;
-    }
+    return cache->numLines;
+}
+
+/** Fills a line from the source. Call with the set locked. */
+static void cache_fill_line(cache_t *cache, size_t index, size_t offset)
+{
+    cache_line_t *line = &cache->line[index];
+    size_t filled;
+
+    line->start_offset = cache_round_offset(cache, offset);
+    line->end_offset = line->start_offset + cache->lineSize;
+    filled = cache->fillLine(cache->cookie, line->data, cache->lineSize, line->start_offset);
+    if (filled < cache->lineSize) // past the end of the source
+        memset(&line->data[filled], 0, cache->lineSize - filled);
+    line->valid = true_e;
+    line->dirty = false_e;
 }
 
 size_t cache_read(cache_t *cache, uint8_t *data, size_t len, size_t offset)
 {
     size_t bytesRead = 0;
 
-    // lock the cache
-    mutex_lock(&cache->mutex);
-    do
+    while (len > 0)
     {
+        size_t s = cache_set(cache, offset);
         size_t index = 0;
         size_t intraOffset = (offset % cache->lineSize);
 
         // calculate the useful size within this line.
         size_t size = cache->lineSize - intraOffset;
-        if (len < cache->lineSize ) // if the remainder is smaller than the lineSize
+        if (len < size) // if the remainder is smaller than the rest of the line
             size = len; // then use the remainder
 
+        mutex_lock(&cache->sets[s].mutex);
+
         // get the line index for this ptr, if it exists
-        if (cache_index(cache, offset, &index) == false_e)
+        index = cache_index(cache, offset);
+        if (index == cache->numLines)
         {
             // find a cache line to fill
-            index = cache_next(cache);
-
-            // fetch the data and assign the index
-            cache->fillLine(cache->cookie, cache->line[index].data, cache->lineSize, cache_round_offset(cache, offset));
+            index = cache_next(cache, s);
+            if (index == cache->numLines)
+            {
+                mutex_unlock(&cache->sets[s].mutex);
+                break;
+            }
+            cache_fill_line(cache, index, offset);
         }
 
         // copy the data from this line...
         memcpy(data, &cache->line[index].data[intraOffset], size);
+        cache->line[index].referenced = true_e;
+
+        mutex_unlock(&cache->sets[s].mutex);
 
         // move the pointers
         data += size;
         offset += size;
         len -= size;
         bytesRead += size;
-    } while(len > 0);
-    // unlock the cache
-    mutex_unlock(&cache->mutex);
+    }
     return bytesRead;
 }
 
@@ -171,41 +240,57 @@ size_t cache_write(cache_t *cache, uint8_t *data, size_t len, size_t offset)
 {
     size_t written = 0;
 
-    // lock the cache
-    mutex_lock(&cache->mutex);
-    do
+    while (len > 0)
     {
+        size_t s = cache_set(cache, offset);
         size_t index = 0;
         size_t intraOffset = (offset % cache->lineSize);
 
         // calculate the useful size within this line.
         size_t size = cache->lineSize - intraOffset;
-        if (len < cache->lineSize) // if the remainder is smaller than the lineSize
+        if (len < size) // if the remainder is smaller than the rest of the line
             size = len; // then use the remainder
 
+        mutex_lock(&cache->sets[s].mutex);
+
         // get the line index for this ptr, if it exists
-        if (cache_index(cache, offset, &index) == false_e)
+        index = cache_index(cache, offset);
+        if (index == cache->numLines)
         {
-            // find a cache line to fill
-            // this doesn't fail, if there are no open ones it will age out an
-            // older line and we'll need to initialize it's data
-            index = cache_next(cache);
-
-            // initialize the correct start_offset and size
-            cache->line[index].start_offset = cache_round_offset(cache, offset);
-            cache->line[index].end_offset = cache->line[index].start_offset + cache->lineSize;
+            // find a cache line to fill, this ages out an older line if there are no open ones
+            index = cache_next(cache, s);
+            if (index == cache->numLines)
+            {
+                mutex_unlock(&cache->sets[s].mutex);
+                break;
+            }
+            if (size < cache->lineSize)
+            {
+                // the rest of the line has to come from the source
+                cache_fill_line(cache, index, offset);
+            }
+            else
+            {
+                // initialize the correct start_offset and size
+                cache->line[index].start_offset = cache_round_offset(cache, offset);
+                cache->line[index].end_offset = cache->line[index].start_offset + cache->lineSize;
+            }
         }
 
-        // copy the data from this line...
+        // copy the data into this line...
         memcpy(&cache->line[index].data[intraOffset], data, size);
 
         // update the meta-data
         cache->line[index].valid = true_e;
-        cache->line[index].age = clock();
+        cache->line[index].referenced = true_e;
 
         // if it's a write-through policy, go ahead and write
         if (cache->policy == CACHE_POLICY_WRITE_THROUGH)
             cache->commitLine(cache->cookie, cache->line[index].data, cache->lineSize, cache->line[index].start_offset);
+        else
+            cache->line[index].dirty = true_e;
+
+        mutex_unlock(&cache->sets[s].mutex);
 
         // move the pointers
         data += size;
@@ -213,41 +298,40 @@ size_t cache_write(cache_t *cache, uint8_t *data, size_t len, size_t offset)
         len -= size;
         written += size;
         //printf("%u bytes left to write to cache\n", len);
-    } while(len > 0);
-    // unlock the cache
-    mutex_unlock(&cache->mutex);
+    }
     return written;
 }
 
 void cache_invalidate(cache_t *cache)
 {
-    size_t i = 0;
-    mutex_lock(&cache->mutex);
-    for (i = 0; i < cache->numLines; i++)
+    size_t s, i;
+    for (s = 0; s < cache->numSets; s++)
     {
-        if (cache->line[i].valid)
+        mutex_lock(&cache->sets[s].mutex);
+        for (i = s; i < cache->numLines; i += cache->numSets)
         {
-            cache->line[i].age = 0;
+            cache->line[i].referenced = false_e;
+            cache->line[i].dirty = false_e;
             cache->line[i].valid = false_e;
         }
+        mutex_unlock(&cache->sets[s].mutex);
     }
-    mutex_unlock(&cache->mutex);
 }
 
 void cache_flush(cache_t *cache)
 {
-    size_t i = 0;
-    mutex_lock(&cache->mutex);
-    for (i = 0; i < cache->numLines; i++)
+    size_t s, i;
+    for (s = 0; s < cache->numSets; s++)
     {
-        if (cache->line[i].valid)
+        mutex_lock(&cache->sets[s].mutex);
+        for (i = s; i < cache->numLines; i += cache->numSets)
         {
-            cache->commitLine(cache->cookie, cache->line[i].data, cache->lineSize, cache->line[i].start_offset);
-            cache->line[i].age = 0;
+            cache_clean(cache, &cache->line[i]);
+            cache->line[i].referenced = false_e;
             cache->line[i].valid = false_e;
         }
+        mutex_unlock(&cache->sets[s].mutex);
     }
-    mutex_unlock(&cache->mutex);
 }
 
 //******************************************************************************
@@ -284,6 +368,141 @@ static void countUp(uint8_t *ptr, size_t size, uint32_t start)
     }
 }
 
+#define CACHE_BENCH_THREADS (4)
+
+typedef struct _cache_bench_t {
+    cache_t *cache;
+    uint8_t *source;        /*!< The memory behind the cache, four times its size */
+    size_t   size;
+    uint32_t ops;
+    uint32_t seed;
+    uint32_t errors;
+} cache_bench_t;
+
+static size_t cache_bench_fill(void *cookie, uint8_t *ptr, size_t size, size_t offset)
+{
+    cache_bench_t *b = (cache_bench_t *)cookie;
+    memcpy(ptr, &b->source[offset], size);
+    return size;
+}
+
+static size_t cache_bench_commit(void *cookie, uint8_t *ptr, size_t size, size_t offset)
+{
+    cache_bench_t *b = (cache_bench_t *)cookie;
+    memcpy(&b->source[offset], ptr, size);
+    return size;
+}
+
+/** Reads or writes 64 random bytes per op. Each word holds its own index so
+ * writers never change what a reader expects to see.
+ */
+static thread_ret_t cache_bench_worker(void *arg)
+{
+    cache_bench_t *b = (cache_bench_t *)arg;
+    uint32_t words[16];
+    uint32_t seed = b->seed;
+    uint32_t i, w;
+
+    for (i = 0; i < b->ops; i++)
+    {
+        size_t offset;
+        seed = (seed * 1103515245) + 12345;
+        offset = (((size_t)(seed >> 8) % ((b->size - sizeof(words)) / sizeof(uint32_t))) * sizeof(uint32_t));
+        if ((seed & 3) == 0)
+        {
+            for (w = 0; w < dimof(words); w++)
+                words[w] = (uint32_t)(offset / sizeof(uint32_t)) + w;
+            cache_write(b->cache, (uint8_t *)words, sizeof(words), offset);
+        }
+        else
+        {
+            cache_read(b->cache, (uint8_t *)words, sizeof(words), offset);
+            for (w = 0; w < dimof(words); w++)
+            {
+                if (words[w] != (uint32_t)(offset / sizeof(uint32_t)) + w)
+                {
+                    b->errors++;
+                    break;
+                }
+            }
+        }
+    }
+    thread_exit(0);
+}
+
+/** Times random reads and writes from 1 and then several threads. When there
+ * is more than one CPU the threads must get more done than one does alone.
+ */
+static bool_e cache_unittest_bench(cache_policy_e policy, size_t lineSize, size_t numLines)
+{
+    cache_bench_t shared, workers[CACHE_BENCH_THREADS];
+    thread_t threads[CACHE_BENCH_THREADS];
+    numa_topology_t topo;
+    double rate[2] = {0.0, 0.0};
+    bool_e scaled = true_e;
+    uint32_t *words;
+    uint32_t t, n, numThreads, errors = 0;
+    size_t w;
+
+    numa_topology(&topo);
+    memset(&shared, 0, sizeof(shared));
+    shared.size = 4 * lineSize * numLines;
+    shared.source = (uint8_t *)malloc(shared.size);
+    if (shared.source == NULL)
+        return false_e;
+    words = (uint32_t *)shared.source;
+    for (w = 0; w < shared.size / sizeof(uint32_t); w++)
+        words[w] = (uint32_t)w;
+    shared.cache = cache_create(lineSize, numLines, policy, cache_bench_fill, cache_bench_commit, &shared);
+    if (shared.cache == NULL)
+    {
+        free(shared.source);
+        return false_e;
+    }
+    for (numThreads = 1; numThreads <= CACHE_BENCH_THREADS; numThreads *= CACHE_BENCH_THREADS)
+    {
+        rtime_t start = rtimer_now();
+        for (t = 0; t < numThreads; t++)
+        {
+            workers[t] = shared;
+            workers[t].ops = (1 << 18) / numThreads;
+            workers[t].seed = t + 1;
+            threads[t] = thread_create(cache_bench_worker, &workers[t]);
+        }
+        for (t = 0; t < numThreads; t++)
+        {
+            thread_join(threads[t]);
+            errors += workers[t].errors;
+        }
+        start = rtimer_now() - start;
+        n = (1 << 18) / numThreads * numThreads;
+        rate[numThreads > 1] = (double)n / (rtimer_to_us(start) + 1);
+        printf("cache %s: %u threads did %u ops in "FMT_RTIMER_T" us (%lf ops/us)\n",
+               (policy == CACHE_POLICY_WRITE_BACK ? "write-back" : "write-through"),
+               numThreads, n, rtimer_to_us(start), rate[numThreads > 1]);
+    }
+    if (topo.numCpus > 1 && rate[1] <= rate[0])
+    {
+        printf("ERROR! %u threads on %u CPUs did not beat 1 thread (%lf <= %lf ops/us)!\n",
+               CACHE_BENCH_THREADS, topo.numCpus, rate[1], rate[0]);
+        scaled = false_e;
+    }
+    cache_destroy(shared.cache);
+    // every write back line was committed, so the source is still counting up
+    for (w = 0; w < shared.size / sizeof(uint32_t); w++)
+    {
+        if (words[w] != (uint32_t)w)
+        {
+            errors++;
+            break;
+        }
+    }
+    free(shared.source);
+    if (errors > 0)
+        printf("ERROR! The cache returned %u stale reads!\n", errors);
+    return (errors == 0 && scaled == true_e ? true_e : false_e);
+}
+
 bool_e cache_unittest(int argc __attribute__((unused)), char *argv[] __attribute__((unused)))
 {
     bool_e ret = true_e;
@@ -357,6 +576,7 @@ bool_e cache_unittest(int argc __attribute__((unused)), char *argv[] __attribute
         printf("ERROR: Failed to open cache file, probably a permission issue or read-only location?\n");
         ret = false_e;
     }
+    free(buffer);
     f = fopen("poetry.txt","r");
     if (f)
     {
@@ -405,6 +625,10 @@ bool_e cache_unittest(int argc __attribute__((unused)), char *argv[] __attribute
     }
     //else
     //    ret = false_e;
+    if (cache_unittest_bench(CACHE_POLICY_WRITE_THROUGH, lineSize, numLines) == false_e)
+        ret = false_e;
+    if (cache_unittest_bench(CACHE_POLICY_WRITE_BACK, lineSize, numLines) == false_e)
+        ret = false_e;
     return ret;
 }
 
@@ -18,12 +18,74 @@
 #include <sosal/mutex.h>
 #endif
 #include <sosal/event.h>
+#include <sosal/thread.h>
 #include <sosal/debug.h>
 
 #if defined(POSIX) && !defined(ESUCCESS)
 #define ESUCCESS 0
 #endif
 
+#if defined(POSIX) && defined(SOSAL_USE_FUTEX)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sched.h>
+#include <time.h>
+
+static int event_futex(volatile int32_t *addr, int op, int32_t val, const struct timespec *rel)
+{
+    return (int)syscall(SYS_futex, addr, op, val, rel, NULL, 0);
+}
+
+/** Reads the event value, ordered after the writes the setter made before raising it. */
+static int32_t event_is_set(event_t *e)
+{
+#if defined(__ATOMIC_ACQUIRE)
+    return __atomic_load_n(&e->set, __ATOMIC_ACQUIRE);
+#else
+    int32_t set = e->set;
+    __sync_synchronize();
+    return set;
+#endif
+}
+
+/** Wakes every thread sleeping on the sequence word, if there are any. */
+static void event_futex_wake(event_t *e)
+{
+    if (e->waiters > 0)
+        event_futex(&e->seq, FUTEX_WAKE_PRIVATE, INT_MAX, NULL);
+}
+
+/** Sleeps until the sequence word moves from seq or ms pass. Returns false_e on a timeout. */
+static bool_e event_futex_sleep(event_t *e, int32_t seq, uint32_t ms)
+{
+    struct timespec start, now, rel;
+    struct timespec *pRel = NULL;
+
+    if (ms < EVENT_FOREVER)
+        clock_gettime(CLOCK_MONOTONIC, &start);
+    while (e->seq == seq)
+    {
+        if (ms < EVENT_FOREVER)
+        {
+            int64_t left;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            left = ((int64_t)ms * 1000000) - (((int64_t)(now.tv_sec - start.tv_sec) * 1000000000) + (now.tv_nsec - start.tv_nsec));
+            if (left <= 0)
+                return false_e;
+            rel.tv_sec = (time_t)(left / 1000000000);
+            rel.tv_nsec = (long)(left % 1000000000);
+            pRel = &rel;
+        }
+        // EAGAIN means the word already moved, EINTR and stale wakes just go around again.
+        if (event_futex(&e->seq, FUTEX_WAIT_PRIVATE, seq, pRel) == -1 && errno == ETIMEDOUT)
+            return (e->seq != seq ? true_e : false_e);
+    }
+    return true_e;
+}
+#endif
+
 #ifdef POSIX
 void milliseconds_from_now(struct timespec *time_spec, uint32_t milliseconds)
 {
@@ -41,6 +103,14 @@ void milliseconds_from_now(struct timespec *time_spec, uint32_t milliseconds)
 
 bool_e event_init(event_t *e, bool_e autoreset)
 {
+#if defined(POSIX) && defined(SOSAL_USE_FUTEX)
+    e->set = 0;
+    e->seq = 0;
+    e->waiters = 0;
+    e->autoreset = autoreset;
+    __sync_synchronize();
+    return true_e;
+#else
 #ifdef POSIX
     int err = 0;
     err |= pthread_mutex_init(&e->mutex, NULL);
@@ -65,11 +135,22 @@ bool_e event_init(event_t *e, bool_e autoreset)
         return true_e;
     else
         return false_e;
+#endif
 }
 
 bool_e event_deinit(event_t *e)
 {
-#ifdef POSIX
+#if defined(POSIX) && defined(SOSAL_USE_FUTEX)
+    // kick out the waiters with the event lowered, then wait for them to leave.
+    e->set = 0;
+    __sync_fetch_and_add(&e->seq, 1);
+    while (e->waiters > 0)
+    {
+        event_futex_wake(e);
+        sched_yield();
+    }
+    return true_e;
+#elif defined(POSIX)
     int err = 0;
     do {
         err = pthread_cond_destroy(&e->cond);
@@ -92,7 +173,7 @@ bool_e event_deinit(event_t *e)
 #endif
 }
 
-#ifdef POSIX
+#if defined(POSIX) && !defined(SOSAL_USE_FUTEX)
 static bool_e event_timed_wait(event_t *e, uint32_t ms)
 {
     int retcode = 0;
@@ -133,7 +214,44 @@ static bool_e event_timed_wait(event_t *e, uint32_t ms)
 bool_e event_wait(event_t *e, uint32_t timeout)
 {
     bool_e ret = false_e;
-#ifdef POSIX
+#if defined(POSIX) && defined(SOSAL_USE_FUTEX)
+    int32_t seq;
+    bool_e woken;
+
+    // a raised manual event costs a single load.
+    if (!e->autoreset && event_is_set(e))
+        return true_e;
+
+    SOSAL_PRINT(SOSAL_ZONE_EVENT, "SOSAL: Waiting on Event %p (%s) for %u ms\n", e, ((e->autoreset)?"Auto":"Manual"), timeout);
+    // register before sampling the sequence so a setter which moves it also wakes us.
+    __sync_fetch_and_add(&e->waiters, 1);
+    seq = e->seq;
+    if (!e->autoreset && event_is_set(e))
+        woken = true_e;
+    else
+        woken = event_futex_sleep(e, seq, timeout);
+    if (!e->autoreset)
+    {
+        // woken with the event lowered means we were kicked out.
+        ret = (event_is_set(e) ? true_e : false_e);
+    }
+    else
+    {
+        // "pulse" mode events, the first waiter to see the event raised takes it.
+        ret = (__sync_bool_compare_and_swap(&e->set, 1, 0) ? true_e : false_e);
+    }
+    __sync_fetch_and_sub(&e->waiters, 1);
+    if (ret == false_e)
+    {
+        if (woken == false_e) {
+            SOSAL_PRINT(SOSAL_ZONE_WARNING, "WARNING: Event %p Timeout!\n", e);
+        } else {
+            SOSAL_PRINT(SOSAL_ZONE_WARNING, "WARNING: Kicking out of event %p!\n", e);
+        }
+    }
+    SOSAL_PRINT(SOSAL_ZONE_EVENT, "SOSAL: Event %p ret = %u set = %u!\n", e, ret, e->set);
+    return ret;
+#elif defined(POSIX)
     pthread_mutex_lock(&e->mutex);
     SOSAL_PRINT(SOSAL_ZONE_EVENT, "SOSAL: Waiting on Event %p (%s) for %u ms\n", e, ((e->autoreset)?"Auto":"Manual"), timeout);
     if (!e->autoreset)
@@ -194,7 +312,23 @@ bool_e event_wait(event_t *e, uint32_t timeout)
 
 bool_e event_set(event_t *e)
 {
-#ifdef POSIX
+#if defined(POSIX) && defined(SOSAL_USE_FUTEX)
+    int32_t was;
+    // the exchange publishes the writes made before the event was raised.
+#if defined(__ATOMIC_SEQ_CST)
+    was = __atomic_exchange_n(&e->set, 1, __ATOMIC_SEQ_CST);
+#else
+    __sync_synchronize();
+    was = __sync_lock_test_and_set(&e->set, 1);
+#endif
+    // raising a raised manual event has already woken everyone who saw it lowered.
+    if (was == 0 || e->autoreset)
+    {
+        __sync_fetch_and_add(&e->seq, 1);
+        event_futex_wake(e);
+    }
+    return true_e;
+#elif defined(POSIX)
     int err = 0;
     pthread_mutex_lock(&e->mutex);
     //SOSAL_PRINT(SOSAL_ZONE_EVENT, "Setting Event %p\n", e);
@@ -218,7 +352,11 @@ bool_e event_set(event_t *e)
 
 bool_e event_reset(event_t *e)
 {
-#ifdef POSIX
+#if defined(POSIX) && defined(SOSAL_USE_FUTEX)
+    e->set = 0;
+    __sync_synchronize();
+    return true_e;
+#elif defined(POSIX)
     pthread_mutex_lock(&e->mutex);
     //SOSAL_PRINT(SOSAL_ZONE_EVENT, "Resetting Event %p\n", e);
     e->set = false_e;
@@ -234,6 +372,167 @@ bool_e event_reset(event_t *e)
 #endif
 }
 
+#ifdef POSIX
+
+#define EVENT_BENCH_ROUNDS  (20000)
+#define EVENT_BENCH_THREADS (4)
+
+typedef struct _event_bench_t {
+    event_t ping;
+    event_t pong;
+    event_t go[2];
+    event_t done;
+    volatile int32_t count;
+    int32_t rounds;
+    int32_t numThreads;
+} event_bench_t;
+
+static uint64_t event_bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+static void event_bench_report(const char *name, uint64_t start, int32_t signals)
+{
+    uint64_t ns = event_bench_now() - start;
+    printf("event %s: %d signals in %llu us, %llu ns/signal\n",
+           name, signals, (unsigned long long)(ns/1000), (unsigned long long)(ns/(signals ? signals : 1)));
+}
+
+/** Answers each ping with a pong. */
+static thread_ret_t event_bench_pong(void *arg)
+{
+    event_bench_t *b = (event_bench_t *)arg;
+    int32_t r;
+    for (r = 0; r < b->rounds; r++)
+    {
+        event_wait(&b->ping, EVENT_FOREVER);
+        event_reset(&b->ping);
+        event_set(&b->pong);
+    }
+    thread_exit(0);
+}
+
+/** Counts each broadcast round in, the last thread in raises done. */
+static thread_ret_t event_bench_fan_out(void *arg)
+{
+    event_bench_t *b = (event_bench_t *)arg;
+    int32_t r;
+    for (r = 0; r < b->rounds; r++)
+    {
+        event_wait(&b->go[r&1], EVENT_FOREVER);
+        if (__sync_add_and_fetch(&b->count, 1) == b->numThreads)
+            event_set(&b->done);
+    }
+    thread_exit(0);
+}
+
+/** Raises the shared event once per count. */
+static thread_ret_t event_bench_fan_in(void *arg)
+{
+    event_bench_t *b = (event_bench_t *)arg;
+    int32_t r;
+    for (r = 0; r < b->rounds; r++)
+    {
+        __sync_fetch_and_add(&b->count, 1);
+        event_set(&b->ping);
+    }
+    thread_exit(0);
+}
+
+/** Times the uncontended calls and the 1 to 1, 1 to N and N to 1 signalling of events. */
+static bool_e event_benchmark(void)
+{
+    event_bench_t b;
+    thread_t threads[EVENT_BENCH_THREADS];
+    uint64_t start;
+    int32_t r, t, total;
+    bool_e ret = true_e;
+
+    memset(&b, 0, sizeof(b));
+    event_init(&b.ping, false_e);
+    event_init(&b.pong, false_e);
+    event_init(&b.go[0], false_e);
+    event_init(&b.go[1], false_e);
+    event_init(&b.done, false_e);
+    b.rounds = EVENT_BENCH_ROUNDS;
+
+    // uncontended, the cost of the calls themselves.
+    start = event_bench_now();
+    for (r = 0; r < b.rounds; r++)
+    {
+        event_set(&b.ping);
+        if (event_wait(&b.ping, EVENT_FOREVER) == false_e)
+            ret = false_e;
+        event_reset(&b.ping);
+    }
+    event_bench_report("uncontended", start, b.rounds);
+
+    // 1 to 1, a round trip between two threads.
+    threads[0] = thread_create(event_bench_pong, &b);
+    start = event_bench_now();
+    for (r = 0; r < b.rounds; r++)
+    {
+        event_set(&b.ping);
+        event_wait(&b.pong, EVENT_FOREVER);
+        event_reset(&b.pong);
+    }
+    thread_join(threads[0]);
+    event_bench_report("1->1", start, 2 * b.rounds);
+
+    // 1 to N, a broadcast acknowledged by the last thread. The go events
+    // alternate so a fast thread can not pass the same round twice.
+    b.numThreads = EVENT_BENCH_THREADS;
+    b.rounds = EVENT_BENCH_ROUNDS / EVENT_BENCH_THREADS;
+    for (t = 0; t < b.numThreads; t++)
+        threads[t] = thread_create(event_bench_fan_out, &b);
+    start = event_bench_now();
+    for (r = 0; r < b.rounds; r++)
+    {
+        b.count = 0;
+        event_set(&b.go[r&1]);
+        event_wait(&b.done, EVENT_FOREVER);
+        event_reset(&b.done);
+        event_reset(&b.go[r&1]);
+    }
+    for (t = 0; t < b.numThreads; t++)
+        thread_join(threads[t]);
+    event_bench_report("1->N", start, b.rounds * (b.numThreads + 1));
+
+    // N to 1, every thread raises the same event which one thread drains.
+    event_reset(&b.ping);
+    b.count = 0;
+    total = b.rounds * b.numThreads;
+    for (t = 0; t < b.numThreads; t++)
+        threads[t] = thread_create(event_bench_fan_in, &b);
+    start = event_bench_now();
+    while (b.count < total)
+    {
+        event_wait(&b.ping, EVENT_FOREVER);
+        event_reset(&b.ping);
+    }
+    for (t = 0; t < b.numThreads; t++)
+        thread_join(threads[t]);
+    event_bench_report("N->1", start, total);
+
+    event_deinit(&b.ping);
+    event_deinit(&b.pong);
+    event_deinit(&b.go[0]);
+    event_deinit(&b.go[1]);
+    event_deinit(&b.done);
+    return ret;
+}
+
+static thread_ret_t event_pulse_waiter(void *arg)
+{
+    event_t *e = (event_t *)arg;
+    int32_t err = (event_wait(e, 2000) == true_e ? 0 : 1);
+    thread_exit((size_t)err);
+}
+#endif
+
 bool_e event_unittest(int argc __attribute__((unused)),
                       char *argv[] __attribute__((unused)))
 {
@@ -274,6 +573,32 @@ bool_e event_unittest(int argc __attribute__((unused)),
 
     event_deinit(&e);
 
+#ifdef POSIX
+    {
+        thread_t t;
+
+        // an auto-reset event is taken by the one waiter it wakes.
+        event_init(&e, true_e);
+        t = thread_create(event_pulse_waiter, &e);
+        thread_msleep(20);
+        event_set(&e);
+        if (thread_join(t) != 0)
+        {
+            numErrors++;
+            SOSAL_PRINT(SOSAL_ZONE_ERROR, "ERROR! Failed to wait for pulse!\n");
+        }
+        if (event_wait(&e, timeout) == true_e)
+        {
+            numErrors++;
+            SOSAL_PRINT(SOSAL_ZONE_ERROR, "ERROR! Pulse was not reset!\n");
+        }
+        event_deinit(&e);
+    }
+
+    if (event_benchmark() == false_e)
+        numErrors++;
+#endif
+
     if (numErrors > 0)
         return false_e;
     else
@@ -15,76 +15,15 @@
  */
 
 #include <sosal/hash.h>
+#include <sosal/list.h> // just for unittest
 #include <sosal/options.h>
+#include <sosal/rtimer.h>
 #include <sosal/debug.h>
 
-static record_t *record_create(value_t key, value_t value)
+static uint32_t hash_key_to_index(hash_t *h, value_t key)
 {
-    record_t *record = calloc(1, sizeof(record_t));
-    if (record)
-    {
-        record->key = key;
-        record->value = value;
-    }
-    return record;
-}
-
-static void record_destroy(record_t *record)
-{
-    if (record)
-        free(record);
-}
-
-static int hash_compare_record(node_t *a, node_t *b)
-{
-    if (a != NULL && b != NULL)
-    {
-        record_t *ra = (record_t *)a->data;
-        record_t *rb = (record_t *)b->data;
-        if (ra != NULL && rb != NULL)
-        {
-            if (ra->key > rb->key)
-                return 1;
-            else if (ra->key == rb->key)
-                return 0;
-            else if (ra->key < rb->key)
-                return -1;
-        }
-    }
-    return 0;
-}
-
-static void hash_print_record(node_t *node)
-{
-    if (node)
-    {
-        record_t *record = (record_t *)node->data;
-
-        if (record != NULL) {
-            SOSAL_PRINT(SOSAL_ZONE_HASH, ""FMT_SIZE_T":"FMT_SIZE_T" ",record->key, record->value);
-        }
-    }
-}
-
-static int hash_is_valid_index(hash_t *h, value_t hKey)
-{
-    if ((h->size == HASH_SIZE_SMALL ||
-         h->size == HASH_SIZE_MEDIUM ||
-         h->size == HASH_SIZE_LARGE) &&
-        (hKey < h->numSlots))
-        return 1;
-    else
-        return 0;
-}
-
-static uint32_t hash_key_to_index(hash_t *h, value_t hKey)
-{
-    if ((h->size == HASH_SIZE_SMALL ||
-         h->size == HASH_SIZE_MEDIUM ||
-         h->size == HASH_SIZE_LARGE))
-        return (uint32_t)hKey;
-    else
-        return 0;
+    // custom keying functions may not honor the table size
+    return (uint32_t)(h->keyFunc(h->size, key) & (h->numSlots - 1));
 }
 
 /**
@@ -109,24 +48,107 @@ static value_t hash_key(size_t numElem, value_t keyin)
     return key;
 }
 
+/** Returns the slot which holds the key or NULL. The probe stops at the first
+ * record which is closer to its home than the key would be, as Robin Hood
+ * placement would have put the key before it.
+ */
+static hash_slot_t *hash_find(hash_t *h, value_t key)
+{
+    size_t mask = h->numSlots - 1;
+    size_t index = hash_key_to_index(h, key);
+    uint32_t distance = 1;
+
+    while (h->slots[index].distance >= distance)
+    {
+        if (h->slots[index].record.key == key)
+            return &h->slots[index];
+        index = (index + 1) & mask;
+        distance++;
+    }
+    return NULL;
+}
+
+/** Places a record whose key is not in the table, displacing any record which is closer to its home. */
+static void hash_place(hash_t *h, record_t record)
+{
+    size_t mask = h->numSlots - 1;
+    size_t index = hash_key_to_index(h, record.key);
+    uint32_t distance = 1;
+
+    while (h->slots[index].distance != 0)
+    {
+        hash_slot_t *slot = &h->slots[index];
+        if (slot->distance < distance)
+        {
+            record_t r = slot->record;
+            uint32_t d = slot->distance;
+            slot->record = record;
+            slot->distance = distance;
+            record = r;
+            distance = d;
+        }
+        index = (index + 1) & mask;
+        distance++;
+    }
+    h->slots[index].record = record;
+    h->slots[index].distance = distance;
+}
+
+/** Empties a slot, shifting the records displaced past it back towards their homes. */
+static void hash_erase(hash_t *h, size_t index)
+{
+    size_t mask = h->numSlots - 1;
+    size_t next = (index + 1) & mask;
+
+    while (h->slots[next].distance > 1)
+    {
+        h->slots[index].record = h->slots[next].record;
+        h->slots[index].distance = h->slots[next].distance - 1;
+        index = next;
+        next = (next + 1) & mask;
+    }
+    memset(&h->slots[index], 0, sizeof(hash_slot_t));
+    h->numTotalElem--;
+}
+
+/** Moves every record into a new table of the given bit depth. */
+static bool_e hash_resize(hash_t *h, hash_size_e size)
+{
+    size_t numSlots = (size_t)1 << size;
+    hash_slot_t *slots = (hash_slot_t *)calloc(numSlots, sizeof(hash_slot_t));
+    hash_slot_t *old = h->slots;
+    size_t i, numOld = h->numSlots;
+
+    if (slots == NULL)
+        return false_e; // keep using the current table
+
+    SOSAL_PRINT(SOSAL_ZONE_HASH, "Growing hash %p to "FMT_SIZE_T" slots for "FMT_SIZE_T" elements\n", h, numSlots, h->numTotalElem);
+    h->slots = slots;
+    h->numSlots = numSlots;
+    h->size = size;
+    for (i = 0; i < numOld; i++)
+    {
+        if (old[i].distance != 0)
+            hash_place(h, old[i].record);
+    }
+    free(old);
+    return true_e;
+}
+
 /* =============================================================================
  * GLOBAL FUNCTIONS
  * ===========================================================================*/
 
-
-void hash_destroy(hash_t *h)
+void hash_deinit(hash_t *h)
 {
     if (h != NULL)
     {
-        if (h->bucket != NULL)
-        {
-            free(h->bucket);
-        }
+        free(h->slots);
         free(h);
     }
 }
 
-hash_t *hash_create(hash_size_e size, hash_func_f keyFunc)
+hash_t *hash_init(hash_size_e size, hash_func_f keyFunc)
 {
     hash_t *h = NULL;
     int hashElem = 1 << size;
@@ -134,8 +156,8 @@ hash_t *hash_create(hash_size_e size, hash_func_f keyFunc)
     h = (hash_t *)calloc(1, sizeof(hash_t));
     if (h != NULL)
     {
-        h->bucket = (list_t **)calloc(hashElem, sizeof(list_t *));
-        if (h->bucket == NULL)
+        h->slots = (hash_slot_t *)calloc(hashElem, sizeof(hash_slot_t));
+        if (h->slots == NULL)
         {
             free(h);
             h = NULL;
@@ -143,8 +165,8 @@ hash_t *hash_create(hash_size_e size, hash_func_f keyFunc)
         else
         {
             h->numSlots = hashElem;
-            h->numActiveSlots = 0;
             h->numTotalElem = 0;
+            h->cleanIndex = 0;
             h->size = size;
             if (keyFunc == NULL)
                 h->keyFunc = hash_key;
@@ -155,99 +177,46 @@ hash_t *hash_create(hash_size_e size, hash_func_f keyFunc)
     return h;
 }
 
-
-
 void hash_set(hash_t *h, value_t key, value_t value)
 {
     // is the hash valid?
     if (h != NULL)
     {
-        // generate the key
-        value_t hKey = h->keyFunc(h->size, key);
+        hash_slot_t *slot = hash_find(h, key);
 
-        // is the key valid?
-        if (hash_is_valid_index(h, hKey))
+        if (value == 0)
         {
-            uint32_t  index = hash_key_to_index(h,hKey);
-            record_t *record = record_create(key, value);
-            node_t   *node = node_create((value_t)record);
-
-            // do we have a collision?
-            if (h->bucket[index] == NULL && value != 0)
+            // remove the record if it exists
+            if (slot != NULL)
             {
-                // no, create a list and the first element
-                //SOSAL_PRINT(SOSAL_ZONE_HASH, "Created new list added node to list\n");
-                hash_print_record(node);
-                h->bucket[index] = list_create();
-                list_push(h->bucket[index], node);
-                h->numActiveSlots++;
-                h->numTotalElem++;
-                SOSAL_PRINT(SOSAL_ZONE_HASH, "SET: "FMT_SIZE_T":"FMT_SIZE_T"\n", record->key, record->value);
+                SOSAL_PRINT(SOSAL_ZONE_HASH, "CLR: "FMT_SIZE_T":"FMT_SIZE_T"\n", slot->record.key, slot->record.value);
+                hash_erase(h, (size_t)(slot - h->slots));
             }
-            else if (h->bucket[index] != NULL)
+        }
+        else if (slot != NULL)
+        {
+            // overwrite the existing value
+            slot->record.value = value;
+            SOSAL_PRINT(SOSAL_ZONE_HASH, "SET: "FMT_SIZE_T":"FMT_SIZE_T"\n", key, value);
+        }
+        else
+        {
+            record_t record;
+
+            // keep the probes short by growing before the table is three quarters full
+            if ((h->numTotalElem + 1) * 4 > h->numSlots * 3 && h->size < HASH_SIZE_MAX)
+                hash_resize(h, (hash_size_e)(h->size + 1));
+            if (h->numTotalElem < h->numSlots)
             {
-                // there's a key collision
-                //SOSAL_PRINT(SOSAL_ZONE_HASH, "Collision detected!\n");
-
-                // are we removing the value or adding a value?
-                if (value == 0)
-                {
-                    node_t *removed = NULL;
-                    do {
-                        removed = list_remove_match(h->bucket[index], node, hash_compare_record);
-                        if (removed != NULL)
-                        {
-#if defined(SOSAL_DEBUG)
-                            record_t *r = (record_t *)removed->data;
-#endif
-                            //SOSAL_PRINT(SOSAL_ZONE_HASH, "Removed Record from List!\n");
-                            h->numTotalElem--;
-                            if (list_length(h->bucket[index]) == 0)
-                            {
-                                list_destroy(h->bucket[index]);
-                                h->numActiveSlots--;
-                                h->bucket[index] = NULL;
-                            }
-                            SOSAL_PRINT(SOSAL_ZONE_HASH, "CLR: "FMT_SIZE_T":"FMT_SIZE_T"\n", r->key, r->value);
-                            record_destroy((record_t*)node_destroy(removed));
-                        }
-                    } while (removed != NULL);
-                }
-                else // we're adding to a link list
-                {
-                    // remove existing key/value pair if it exists
-                    node_t *removed = list_remove_match(h->bucket[index], node, hash_compare_record);
-                    if (removed)
-                    {
-#if defined(SOSAL_DEBUG)
-                        record_t *r = (record_t *)removed->data;
-#endif
-                        //SOSAL_PRINT(SOSAL_ZONE_HASH, "Record already exists in hash, removing!\n");
-                        h->numTotalElem--;
-                        SOSAL_PRINT(SOSAL_ZONE_HASH, "CLR: "FMT_SIZE_T":"FMT_SIZE_T"\n", r->key, r->value);
-                        record_destroy((record_t*)node_destroy(removed));
-                        // don't remove the list here, we're about to add to it.
-                    }
-
-                    //SOSAL_PRINT(SOSAL_ZONE_HASH, "Adding record to hash...\n");
-                    // put the items in sorted order
-                    node = list_insert(h->bucket[index], node, hash_compare_record, true_e);
-                    if (node)
-                    {
-                        h->numTotalElem++;
-                        SOSAL_PRINT(SOSAL_ZONE_HASH, "SET: "FMT_SIZE_T":"FMT_SIZE_T"\n", record->key, record->value);
-                    }
-                    else
-                    {
-                        SOSAL_PRINT(SOSAL_ZONE_HASH, "SET: "FMT_SIZE_T":--\n", record->key);
-                    }
-                }
+                record.key = key;
+                record.value = value;
+                hash_place(h, record);
+                h->numTotalElem++;
+                SOSAL_PRINT(SOSAL_ZONE_HASH, "SET: "FMT_SIZE_T":"FMT_SIZE_T"\n", key, value);
             }
-            else if (h->bucket[index] == NULL && value == 0)
+            else
             {
-                // tried to remove something that wasn't there.
-                record_destroy((record_t *)node_destroy(node));
-                return;
+                SOSAL_PRINT(SOSAL_ZONE_ERROR, "ERROR: hash %p is full, dropped "FMT_SIZE_T"\n", h, key);
             }
         }
     }
@@ -259,40 +228,14 @@ bool_e hash_get(hash_t *h, value_t key, value_t *value)
     bool_e found = false_e;
 
     // is the hash valid and does it have items?
-    if (h != NULL && h->numActiveSlots > 0)
+    if (h != NULL && h->numTotalElem > 0)
     {
-        // generate the key
-        value_t hKey = h->keyFunc(h->size, key);
-
-        // is the key valid?
-        if (hash_is_valid_index(h, hKey))
+        hash_slot_t *slot = hash_find(h, key);
+        if (slot != NULL)
         {
-            // define tmp pointer
-            uint32_t index = hash_key_to_index(h,hKey);
-
-            // is there something at that index?
-            if (h->bucket[index] != NULL)
-            {
-                record_t *record = record_create(key, 0);
-                node_t *node = node_create((value_t)record);
-                node_t *desired = NULL;
-
-                // now get value from the list
-                desired = list_search(h->bucket[index], node, hash_compare_record);
-
-                // key was found in the list
-                if (desired != NULL)
-                {
-                    record_t *match = (record_t *)desired->data;
-                    SOSAL_PRINT(SOSAL_ZONE_HASH, "GET: "FMT_SIZE_T":"FMT_SIZE_T"\n", match->key, match->value);
-
-                    // get the value
-                    *value = match->value;
-                    found = true_e;
-                }
-                node_destroy(node);
-                record_destroy(record);
-            }
+            SOSAL_PRINT(SOSAL_ZONE_HASH, "GET: "FMT_SIZE_T":"FMT_SIZE_T"\n", slot->record.key, slot->record.value);
+            *value = slot->record.value;
+            found = true_e;
         }
     }
     if (found == false_e) {
@@ -301,48 +244,26 @@ bool_e hash_get(hash_t *h, value_t key, value_t *value)
     return found;
 }
 
-/**
- * @note If the hash index loops you will get the same count back again and
- *       your pointer will not be set. Be sure to NULL (and check) your pointer
- *       between each usage to prevent this scenario.
- */
 size_t hash_clean(hash_t *h, value_t *value)
 {
-    static uint32_t index = 0;
-
-    if (h != NULL && value != NULL && h->numActiveSlots > 0)
+    if (h != NULL && value == NULL)
     {
-        // move to a non-null section.
-        while (h->bucket[index] == NULL && index < h->numSlots) {
-            //SOSAL_PRINT(SOSAL_ZONE_HASH, "Bucket[%u] is empty\n", index);
-            index++;
-        }
+        h->cleanIndex = 0;
+        return h->numTotalElem;
+    }
+    if (h != NULL && h->numTotalElem > 0)
+    {
+        size_t mask = h->numSlots - 1;
+        size_t index = h->cleanIndex & mask;
 
-        if (index >= h->numSlots)
-        {
-            // reset the index
-            index = 0;
-        }
+        // move to a used slot, there is at least one.
+        while (h->slots[index].distance == 0)
+            index = (index + 1) & mask;
 
-        // if we are in hash still...
-        if (index < h->numSlots)
-        {
-            // we found a list
-            list_t *bucket = h->bucket[index];
-            node_t *node = list_pop(bucket);
-            if (node)
-            {
-                record_t *record = (record_t *)node->data;
-                h->numTotalElem--;
-                *value = record->value;
-                if (list_length(bucket) == 0)
-                {
-                    list_destroy(bucket);
-                    h->numActiveSlots--;
-                    h->bucket[index] = NULL;
-                }
-            }
-        }
+        *value = h->slots[index].record.value;
+        hash_erase(h, index);
+        // a displaced record may have shifted into this slot, so resume here.
+        h->cleanIndex = index;
         return h->numTotalElem;
     }
     else
@@ -361,35 +282,31 @@ size_t hash_length(hash_t *h)
 
 void hash_print(hash_t *h, bool_e printElems)
 {
-    unsigned int i;
-    int sum = 0;
-    int avg = 0;
-    int num = 0;
-    int len = 0;
+    size_t i;
+    size_t displaced = 0;
+    size_t sum = 0;
+    uint32_t longest = 0;
     float util = 0.0;
     if (h != NULL)
     {
-        util = (float)((float)h->numActiveSlots * 100)/h->numSlots;
-        printf("[%p] hash_t ["FMT_SIZE_T"/"FMT_SIZE_T"] => %lf%%\n", h, h->numActiveSlots, h->numSlots, util);
-        if (printElems == true_e)
+        util = (float)((float)h->numTotalElem * 100)/h->numSlots;
+        printf("[%p] hash_t ["FMT_SIZE_T"/"FMT_SIZE_T"] => %lf%%\n", h, h->numTotalElem, h->numSlots, util);
+        for (i = 0; i < h->numSlots; i++)
         {
-            for (i = 0; i < h->numSlots;i++)
-            {
-                len = list_length(h->bucket[i]);
-                if (len > 0)
-                {
-                    printf("Bucket[%u] has %u records: ",i,len);
-                    sum += len;
-                    num++;
-                    avg = sum/num;
-                    list_print(h->bucket[i], hash_print_record);
-                    printf("\n");
-                }
-            }
-            printf("Average List Depth is %d\n",avg);
+            uint32_t distance = h->slots[i].distance;
+            if (distance == 0)
+                continue;
+            if (printElems == true_e)
+                printf("Slot["FMT_SIZE_T"] "FMT_SIZE_T":"FMT_SIZE_T" is %u from home\n", i, h->slots[i].record.key, h->slots[i].record.value, distance - 1);
+            if (distance > 1)
+                displaced++;
+            if (distance > longest)
+                longest = distance;
+            sum += distance;
         }
         printf("\tTotal hash_t Size is "FMT_SIZE_T" elements\n",h->numTotalElem);
-        printf("\tTotal Collisions is "FMT_SIZE_T"\n",(h->numTotalElem - h->numActiveSlots));
+        printf("\tTotal Collisions is "FMT_SIZE_T"\n", displaced);
+        printf("\tAverage Probe Length is %lf (longest %u)\n", (h->numTotalElem ? (double)sum/h->numTotalElem : 0.0), longest);
     }
 }
 
@@ -398,6 +315,262 @@ static value_t rand_value()
     return (value_t)(rand()<<2);
 }
 
+/** The hash as it was before the open addressed table: a sorted list of
+ * allocated records per slot, which doubles once the lists average more than
+ * two records. It is only kept to compare the benchmark against.
+ */
+typedef struct _hash_chain_t {
+    hash_size_e size;
+    size_t numTotalElem;
+    size_t numSlots;
+    list_t **bucket;
+} hash_chain_t;
+
+static int hash_chain_compare(node_t *a, node_t *b)
+{
+    record_t *ra, *rb;
+    // the list compares against the NULL after its tail
+    if (a == NULL || b == NULL)
+        return 0;
+    ra = (record_t *)a->data;
+    rb = (record_t *)b->data;
+    return (ra->key > rb->key ? 1 : (ra->key < rb->key ? -1 : 0));
+}
+
+static void *hash_chain_init(hash_size_e size)
+{
+    hash_chain_t *h = (hash_chain_t *)calloc(1, sizeof(hash_chain_t));
+    if (h != NULL)
+    {
+        h->size = size;
+        h->numSlots = (size_t)1 << size;
+        h->bucket = (list_t **)calloc(h->numSlots, sizeof(list_t *));
+        if (h->bucket == NULL)
+        {
+            free(h);
+            h = NULL;
+        }
+    }
+    return h;
+}
+
+static void hash_chain_deinit(void *arg)
+{
+    hash_chain_t *h = (hash_chain_t *)arg;
+    size_t i;
+    node_t *node;
+    for (i = 0; i < h->numSlots; i++)
+    {
+        if (h->bucket[i] == NULL)
+            continue;
+        while ((node = list_pop(h->bucket[i])) != NULL)
+            free((record_t *)node_destroy(node));
+        list_destroy(h->bucket[i]);
+    }
+    free(h->bucket);
+    free(h);
+}
+
+static void hash_chain_grow(hash_chain_t *h)
+{
+    size_t numSlots = h->numSlots << 1;
+    list_t **bucket = (list_t **)calloc(numSlots, sizeof(list_t *));
+    size_t i;
+    node_t *node;
+
+    if (bucket == NULL)
+        return;
+    for (i = 0; i < h->numSlots; i++)
+    {
+        if (h->bucket[i] == NULL)
+            continue;
+        while ((node = list_pop(h->bucket[i])) != NULL)
+        {
+            record_t *record = (record_t *)node->data;
+            size_t index = hash_key(h->size + 1, record->key) & (numSlots - 1);
+            if (bucket[index] == NULL)
+                bucket[index] = list_create();
+            list_insert(bucket[index], node, hash_chain_compare, true_e);
+        }
+        list_destroy(h->bucket[i]);
+    }
+    free(h->bucket);
+    h->bucket = bucket;
+    h->numSlots = numSlots;
+    h->size = (hash_size_e)(h->size + 1);
+}
+
+static void hash_chain_set(void *arg, value_t key, value_t value)
+{
+    hash_chain_t *h = (hash_chain_t *)arg;
+    size_t index = hash_key(h->size, key) & (h->numSlots - 1);
+    record_t *record = (record_t *)calloc(1, sizeof(record_t));
+    node_t *node = node_create((value_t)record);
+    node_t *removed;
+
+    record->key = key;
+    record->value = value;
+    if (h->bucket[index] != NULL)
+    {
+        removed = list_remove_match(h->bucket[index], node, hash_chain_compare);
+        if (removed != NULL)
+        {
+            free((record_t *)node_destroy(removed));
+            h->numTotalElem--;
+        }
+    }
+    if (value == 0)
+    {
+        free((record_t *)node_destroy(node));
+        return;
+    }
+    if (h->bucket[index] == NULL)
+        h->bucket[index] = list_create();
+    list_insert(h->bucket[index], node, hash_chain_compare, true_e);
+    h->numTotalElem++;
+    if (h->numTotalElem > (h->numSlots * 2) && h->size < HASH_SIZE_MAX)
+        hash_chain_grow(h);
+}
+
+static bool_e hash_chain_get(void *arg, value_t key, value_t *value)
+{
+    hash_chain_t *h = (hash_chain_t *)arg;
+    size_t index = hash_key(h->size, key) & (h->numSlots - 1);
+    bool_e found = false_e;
+
+    if (h->bucket[index] != NULL)
+    {
+        // the lookup allocates a record to search with, as the old hash did
+        record_t *record = (record_t *)calloc(1, sizeof(record_t));
+        node_t *node = node_create((value_t)record);
+        node_t *match;
+
+        record->key = key;
+        match = list_search(h->bucket[index], node, hash_chain_compare);
+        if (match != NULL)
+        {
+            *value = ((record_t *)match->data)->value;
+            found = true_e;
+        }
+        free((record_t *)node_destroy(node));
+    }
+    return found;
+}
+
+static size_t hash_chain_length(void *arg)
+{
+    return ((hash_chain_t *)arg)->numTotalElem;
+}
+
+static void *hash_bench_init(hash_size_e size)
+{
+    return hash_init(size, NULL);
+}
+
+static void hash_bench_deinit(void *h)
+{
+    hash_deinit((hash_t *)h);
+}
+
+static void hash_bench_set(void *h, value_t key, value_t value)
+{
+    hash_set((hash_t *)h, key, value);
+}
+
+static bool_e hash_bench_get(void *h, value_t key, value_t *value)
+{
+    return hash_get((hash_t *)h, key, value);
+}
+
+static size_t hash_bench_length(void *h)
+{
+    return hash_length((hash_t *)h);
+}
+
+/** The calls of a table which is benchmarked. */
+typedef struct _hash_bench_calls_t {
+    const char *name;
+    void *(*init)(hash_size_e size);
+    void (*deinit)(void *h);
+    void (*set)(void *h, value_t key, value_t value);
+    bool_e (*get)(void *h, value_t key, value_t *value);
+    size_t (*length)(void *h);
+} hash_bench_calls_t;
+
+/** Times the sets, hits, misses and clears of random keys in a table which
+ * starts small, first in the chained hash and then in the open addressed one.
+ */
+static bool_e hash_unittest_bench(int numElem)
+{
+    const hash_bench_calls_t tables[] = {
+        {"chained", hash_chain_init, hash_chain_deinit, hash_chain_set, hash_chain_get, hash_chain_length},
+        {"open",    hash_bench_init, hash_bench_deinit, hash_bench_set, hash_bench_get, hash_bench_length},
+    };
+    const char *names[] = {"set", "hit", "miss", "clear"};
+    rtime_t times[dimof(tables)][dimof(names)];
+    value_t *keys = (value_t *)malloc(numElem * sizeof(value_t));
+    value_t getValue = 0;
+    bool_e ret = true_e;
+    rtime_t start;
+    int i, found;
+    uint32_t p, t;
+
+    if (keys == NULL)
+        return false_e;
+    // odd keys are stored, even keys miss
+    for (i = 0; i < numElem; i++)
+        keys[i] = (((value_t)rand() << 16) ^ rand()) | 1;
+
+    for (t = 0; t < dimof(tables); t++)
+    {
+        void *h = tables[t].init(HASH_SIZE_SMALL);
+        if (h == NULL)
+        {
+            ret = false_e;
+            break;
+        }
+        found = 0;
+
+        start = rtimer_now();
+        for (i = 0; i < numElem; i++)
+            tables[t].set(h, keys[i], (value_t)(i + 1));
+        times[t][0] = rtimer_now() - start;
+
+        start = rtimer_now();
+        for (i = 0; i < numElem; i++)
+            found += tables[t].get(h, keys[i], &getValue);
+        times[t][1] = rtimer_now() - start;
+
+        start = rtimer_now();
+        for (i = 0; i < numElem; i++)
+            found -= tables[t].get(h, keys[i] & ~1, &getValue);
+        times[t][2] = rtimer_now() - start;
+
+        start = rtimer_now();
+        for (i = 0; i < numElem; i++)
+            tables[t].set(h, keys[i], 0);
+        times[t][3] = rtimer_now() - start;
+
+        // repeated random keys still hit, so only check that every key was found and removed
+        if (found != numElem || tables[t].length(h) != 0)
+            ret = false_e;
+        tables[t].deinit(h);
+    }
+    if (ret == true_e)
+    {
+        for (p = 0; p < dimof(names); p++)
+        {
+            double ns[dimof(tables)];
+            for (t = 0; t < dimof(tables); t++)
+                ns[t] = (rtimer_to_sec(times[t][p]) * 1000000000) / numElem;
+            printf("hash %s: %d ops, %s %lf ns/op, %s %lf ns/op (%.1lfx)\n", names[p], numElem,
+                   tables[0].name, ns[0], tables[1].name, ns[1], (ns[1] > 0.0 ? ns[0] / ns[1] : 0.0));
+        }
+    }
+    free(keys);
+    return ret;
+}
+
 bool_e hash_unittest(int argc, char *argv[])
 {
     int numElem = 0;
@@ -417,7 +590,7 @@ bool_e hash_unittest(int argc, char *argv[])
 
     option_process(argc, argv, hash_opts, 1);
 
-    h = hash_create(size, NULL);
+    h = hash_init(size, NULL);
     numElem = (1 << (h->size-1)); // half the elements that we could hold...
     if (verbose)
         printf("Adding %u elements to hash\n",numElem);
@@ -492,7 +665,36 @@ bool_e hash_unittest(int argc, char *argv[])
 
     if (verbose)
         hash_print(h, false_e);
-    hash_destroy(h);
+    hash_deinit(h);
+
+    // fill a small table well past its size, it should grow and keep every record
+    h = hash_init(HASH_SIZE_SMALL, NULL);
+    numElem = 16 << HASH_SIZE_SMALL;
+    for (i = 0; i < numElem; i++)
+        hash_set(h, (value_t)i, (value_t)(i + 1));
+    for (i = 0; i < numElem; i++)
+    {
+        if (hash_get(h, (value_t)i, &getValue) == false_e || getValue != (value_t)(i + 1))
+        {
+            numErrors++;
+            printf("ERROR: Lost key %d after growing the hash!\n", i);
+            break;
+        }
+    }
+    if (h->numSlots <= (1 << HASH_SIZE_SMALL) || hash_length(h) != (size_t)numElem)
+    {
+        numErrors++;
+        printf("ERROR! hash did not grow ("FMT_SIZE_T" slots, "FMT_SIZE_T" elements)\n", h->numSlots, hash_length(h));
+    }
+    if (verbose)
+        hash_print(h, false_e);
+    hash_deinit(h);
+
+    if (hash_unittest_bench(1 << HASH_SIZE_LARGE) == false_e)
+    {
+        numErrors++;
+        printf("ERROR! hash benchmark lost keys!\n");
+    }
 
     if (numErrors > 0) {
         printf("Hashing Unit Test failed with %u errors!\n", numErrors);
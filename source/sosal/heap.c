@@ -16,6 +16,8 @@
 
 #include <sosal/list.h>
 #include <sosal/heap.h>
+#include <sosal/thread.h>
+#include <sosal/rtimer.h>
 #include <sosal/debug.h>
 
 #if SOSAL_ZONE_EXTRA != 0
@@ -249,6 +251,203 @@ static bool_e heap_calc_overhead(heap_t *heap)
     return true_e;
 }
 
+/** Returns the size class of an allocation, or HEAP_SLAB_CLASSES if it is too large for the slab area. */
+static uint32_t heap_slab_class(heap_t *heap, size_t num_bytes)
+{
+    uint32_t c = 0;
+    size_t size = heap->align;
+    while (size < num_bytes && c < HEAP_SLAB_CLASSES)
+    {
+        size <<= 1;
+        c++;
+    }
+    return c;
+}
+
+/** Splits the next page of the slab area into free objects of a class. The heap mutex must be held. */
+static bool_e heap_slab_carve(heap_t *heap, uint32_t c)
+{
+    heap_slab_t *slab = &heap->slab;
+    size_t size = heap->align << c;
+    size_t i;
+    uint8_t *page;
+
+    if (slab->nextPage == slab->numPages)
+        return false_e;
+
+    page = slab->base + (slab->nextPage * slab->pageSize);
+    slab->classes[slab->nextPage++] = (uint8_t)c;
+    for (i = slab->pageSize/size; i > 0; i--)
+    {
+        void **obj = (void **)(page + ((i - 1) * size));
+        *obj = slab->free[c];
+        slab->free[c] = obj;
+    }
+    SOSAL_PRINT(SOSAL_ZONE_HEAP, "Carved slab page %p into "FMT_SIZE_T" byte objects\n", page, size);
+    return true_e;
+}
+
+/** Moves a batch of free objects of a class from the heap to a cache. */
+static void heap_slab_refill(heap_t *heap, heap_slab_cache_t *cache, uint32_t c)
+{
+    heap_slab_t *slab = &heap->slab;
+    uint32_t n;
+
+    mutex_lock(&heap->mutex);
+    if (slab->free[c] == NULL)
+        heap_slab_carve(heap, c);
+    for (n = 0; n < (HEAP_SLAB_DEPTH/2) && slab->free[c] != NULL; n++)
+    {
+        void **obj = (void **)slab->free[c];
+        slab->free[c] = *obj;
+        *obj = cache->free[c];
+        cache->free[c] = obj;
+        cache->count[c]++;
+    }
+    mutex_unlock(&heap->mutex);
+}
+
+/** Moves up to count free objects of a class from a cache back to the heap. */
+static void heap_slab_drain(heap_t *heap, heap_slab_cache_t *cache, uint32_t c, size_t count)
+{
+    heap_slab_t *slab = &heap->slab;
+    size_t n;
+
+    mutex_lock(&heap->mutex);
+    for (n = 0; n < count && cache->free[c] != NULL; n++)
+    {
+        void **obj = (void **)cache->free[c];
+        cache->free[c] = *obj;
+        cache->count[c]--;
+        *obj = slab->free[c];
+        slab->free[c] = obj;
+    }
+    mutex_unlock(&heap->mutex);
+}
+
+#if defined(POSIX)
+/** Returns the objects of an exiting thread to the heap. Called by the thread key. */
+static void heap_slab_release(void *arg)
+{
+    heap_slab_cache_t *cache = (heap_slab_cache_t *)arg;
+    heap_t *heap = cache->heap;
+    heap_slab_cache_t **pc;
+    uint32_t c;
+
+    for (c = 0; c < HEAP_SLAB_CLASSES; c++)
+        heap_slab_drain(heap, cache, c, cache->count[c]);
+    mutex_lock(&heap->mutex);
+    for (pc = &heap->slab.caches; *pc != NULL; pc = &(*pc)->next)
+    {
+        if (*pc == cache)
+        {
+            *pc = cache->next;
+            break;
+        }
+    }
+    heap->slab.allocs += cache->allocs;
+    heap->slab.frees += cache->frees;
+    mutex_unlock(&heap->mutex);
+    free(cache);
+}
+#endif
+
+/** Returns the cache of the calling thread, or NULL if threads can not have one. */
+static heap_slab_cache_t *heap_slab_cache(heap_t *heap __attribute__((unused)))
+{
+#if defined(POSIX)
+    heap_slab_cache_t *cache = (heap_slab_cache_t *)pthread_getspecific(heap->slab.key);
+    if (cache == NULL)
+    {
+        // not from the heap itself, the cache would be a slab object of its own.
+        // it gets whole cache lines so the caches of threads on other CPUs never share one.
+        if (posix_memalign((void **)&cache, SOSAL_CACHE_LINE_SIZE,
+                           (sizeof(heap_slab_cache_t) + SOSAL_CACHE_LINE_SIZE - 1) & ~(SOSAL_CACHE_LINE_SIZE - 1)) != 0)
+            return NULL;
+        memset(cache, 0, sizeof(heap_slab_cache_t));
+        cache->heap = heap;
+        mutex_lock(&heap->mutex);
+        cache->next = heap->slab.caches;
+        heap->slab.caches = cache;
+        mutex_unlock(&heap->mutex);
+        pthread_setspecific(heap->slab.key, cache);
+    }
+    return cache;
+#else
+    return NULL;
+#endif
+}
+
+static void *heap_slab_alloc(heap_t *heap, uint32_t c)
+{
+    heap_slab_cache_t *cache = heap_slab_cache(heap);
+    heap_slab_t *slab = &heap->slab;
+    void **obj;
+
+    if (cache == NULL)
+    {
+        mutex_lock(&heap->mutex);
+        if (slab->free[c] == NULL)
+            heap_slab_carve(heap, c);
+        obj = (void **)slab->free[c];
+        if (obj != NULL)
+        {
+            slab->free[c] = *obj;
+            slab->allocs++;
+            *obj = NULL;
+        }
+        mutex_unlock(&heap->mutex);
+        return obj;
+    }
+
+    if (cache->free[c] == NULL)
+        heap_slab_refill(heap, cache, c);
+    obj = (void **)cache->free[c];
+    if (obj != NULL)
+    {
+        cache->free[c] = *obj;
+        cache->count[c]--;
+        cache->allocs++;
+        *obj = NULL;
+    }
+    return obj;
+}
+
+static bool_e heap_slab_free(heap_t *heap, void *pointer)
+{
+    heap_slab_t *slab = &heap->slab;
+    size_t offset = (uint8_t *)pointer - slab->base;
+    size_t page = offset / slab->pageSize;
+    uint32_t c = slab->classes[page];
+    heap_slab_cache_t *cache;
+
+    // the pointer must be the start of an object in a carved page
+    if (c >= HEAP_SLAB_CLASSES || ((offset % slab->pageSize) % (heap->align << c)) != 0)
+    {
+        SOSAL_PRINT(SOSAL_ZONE_ERROR, "ERROR! %p is not a slab object!\n", pointer);
+        return false_e;
+    }
+
+    cache = heap_slab_cache(heap);
+    if (cache == NULL)
+    {
+        mutex_lock(&heap->mutex);
+        *(void **)pointer = slab->free[c];
+        slab->free[c] = pointer;
+        slab->frees++;
+        mutex_unlock(&heap->mutex);
+        return true_e;
+    }
+
+    *(void **)pointer = cache->free[c];
+    cache->free[c] = pointer;
+    cache->count[c]++;
+    cache->frees++;
+    if (cache->count[c] > HEAP_SLAB_DEPTH)
+        heap_slab_drain(heap, cache, c, HEAP_SLAB_DEPTH/2);
+    return true_e;
+}
+
 /*******************************************************************************
  * GLOBAL FUNCTIONS
  ******************************************************************************/
@@ -349,6 +548,19 @@ bool_e heap_init(heap_t *heap, void *buffer, size_t size, uint32_t p2align)
  */
 void heap_deinit(heap_t *heap)
 {
+    if (heap->slab.base != NULL)
+    {
+        // the caches of threads which are still alive are dropped with the heap
+#if defined(POSIX)
+        pthread_key_delete(heap->slab.key);
+#endif
+        while (heap->slab.caches)
+        {
+            heap_slab_cache_t *cache = heap->slab.caches;
+            heap->slab.caches = cache->next;
+            free(cache);
+        }
+    }
     mutex_deinit(&heap->mutex);
     memset(heap->raw, 0, heap->bytesTotal);
     memset(heap, 0, sizeof(heap_t));
@@ -373,6 +585,18 @@ void *heap_alloc(heap_t *heap, size_t num_bytes)
     if (num_bytes == 0)
         return NULL;
 
+    // small allocations are served from the slab area while it lasts
+    if (heap->slab.base != NULL)
+    {
+        uint32_t c = heap_slab_class(heap, num_bytes);
+        if (c < HEAP_SLAB_CLASSES)
+        {
+            ptr = heap_slab_alloc(heap, c);
+            if (ptr != NULL)
+                return ptr;
+        }
+    }
+
     // round up to the actual amount of bytes we'll allocate
     num_bytes = block_size(heap->align, num_bytes);
 
@@ -472,6 +696,11 @@ bool_e heap_free(heap_t *heap, void *pointer)
     if (ptr_is_aligned(pointer, heap->align) == false_e)
         return false_e;
 
+    if (heap->slab.base != NULL &&
+        heap->slab.base <= (uint8_t *)pointer &&
+        (uint8_t *)pointer < heap->slab.base + (heap->slab.numPages * heap->slab.pageSize))
+        return heap_slab_free(heap, pointer);
+
     mutex_lock(&heap->mutex);
 
     // show current allocations
@@ -509,42 +738,77 @@ bool_e heap_free(heap_t *heap, void *pointer)
     if (heap->cleanPolicy)
         memset(block->data, '0', block->size);
 
-    /// @todo can the free list be coalesced at this point? Yes. There should be at most 2 operations to do.
+    // merge with the free neighbours, returning their meta-data to the spare list
     if (heap->coalescePolicy)
     {
         node_t  *prev_node = node->prev;
         node_t  *next_node = node->next;
         block_t *prev_block = (prev_node?(block_t *)prev_node->data:NULL);
         block_t *next_block = (next_node?(block_t *)next_node->data:NULL);
-        if (block_is_adjacent(prev_block, block) == true_e)
-        {
-            block->data = prev_block->data;
-            block->size += prev_block->size;
-            block_clear(prev_block);
-
-            prev_node->data = (value_t)block;
-            prev_node->next = node->next;
-            if (node->next)
-                node->next->prev = prev_node;
-            node_clear(node);
-            SOSAL_PRINT(SOSAL_ZONE_HEAP, "Coalesced with previous node\n");
-        }
-        else if (block_is_adjacent(block, next_block) == true_e)
+        if (block_is_adjacent(block, next_block) == true_e)
         {
             block->size += next_block->size;
             block_clear(next_block);
-
-            node->next = next_node->next;
-            if (next_node->next)
-                next_node->next->prev = node;
-            node_clear(next_node);
+            list_extract(&heap->free, next_node);
+            list_push(&heap->spare, next_node);
             SOSAL_PRINT(SOSAL_ZONE_HEAP, "Coalesced with next node\n");
         }
+        if (block_is_adjacent(prev_block, block) == true_e)
+        {
+            prev_block->size += block->size;
+            block_clear(block);
+            list_extract(&heap->free, node);
+            list_push(&heap->spare, node);
+            SOSAL_PRINT(SOSAL_ZONE_HEAP, "Coalesced with previous node\n");
+        }
     }
     mutex_unlock(&heap->mutex);
     return true_e;
 }
 
+bool_e heap_slab_init(heap_t *heap, size_t bytes)
+{
+    heap_slab_t *slab = &heap->slab;
+    size_t pageSize = heap->align << (HEAP_SLAB_CLASSES + 1);
+    size_t numPages = (bytes + pageSize - 1) / pageSize;
+    uint8_t *area = NULL;
+    uint8_t *classes = NULL;
+
+    if (heap->raw == NULL || slab->base != NULL || numPages == 0)
+        return false_e;
+
+    area = heap_alloc(heap, numPages * pageSize);
+    classes = heap_alloc(heap, numPages);
+    if (area == NULL || classes == NULL)
+    {
+        SOSAL_PRINT(SOSAL_ZONE_ERROR, "ERROR! Heap %p can not hold a slab area of "FMT_SIZE_T" pages\n", heap, numPages);
+        if (area)
+            heap_free(heap, area);
+        if (classes)
+            heap_free(heap, classes);
+        return false_e;
+    }
+#if defined(POSIX)
+    if (pthread_key_create(&slab->key, heap_slab_release) != 0)
+    {
+        heap_free(heap, area);
+        heap_free(heap, classes);
+        return false_e;
+    }
+#endif
+    memset(classes, HEAP_SLAB_CLASSES, numPages);
+    slab->caches = NULL;
+    slab->allocs = 0;
+    slab->frees = 0;
+    slab->classes = classes;
+    slab->pageSize = pageSize;
+    slab->numPages = numPages;
+    slab->nextPage = 0;
+    slab->base = area;
+    SOSAL_PRINT(SOSAL_ZONE_HEAP, "heap_slab_init(): heap_t *%p has "FMT_SIZE_T" slab pages of "FMT_SIZE_T" bytes at %p\n", heap, numPages, pageSize, area);
+    return true_e;
+}
+
 bool_e heap_valid(heap_t *heap, void *addr)
 {
     bool_e ret = false_e;
@@ -649,11 +913,171 @@ bool_e heap_unittest_iterations(void *buffer, size_t size)
     return ret;
 }
 
+/** Allocates and frees random sizes over a table of slots, timing the operations.
+ * The fragmentation is the share of the free bytes of the best fit heap outside
+ * its largest free block, measured while half the slots are still in use.
+ */
+static bool_e heap_unittest_churn(heap_t *h, uint32_t ops, size_t maxSize, rtime_t *pTime, double *pFrag)
+{
+    bool_e ret = true_e;
+    void *slots[128];
+    size_t largest = 0;
+    node_t *node;
+    rtime_t start;
+    uint32_t i, s;
+
+    memset(slots, 0, sizeof(slots));
+    start = rtimer_now();
+    for (i = 0; i < ops; i++)
+    {
+        s = rand() % dimof(slots);
+        if (slots[s])
+        {
+            if (heap_free(h, slots[s]) == false_e)
+                ret = false_e;
+            slots[s] = NULL;
+        }
+        else if ((slots[s] = heap_alloc(h, (rand() % maxSize) + 1)) == NULL)
+            ret = false_e;
+    }
+    *pTime = rtimer_to_us(rtimer_now() - start);
+
+    // free every other slot before measuring
+    for (s = 0; s < dimof(slots); s += 2)
+    {
+        if (slots[s] && heap_free(h, slots[s]) == false_e)
+            ret = false_e;
+        slots[s] = NULL;
+    }
+    mutex_lock(&h->mutex);
+    for (node = h->free.head; node != NULL; node = node->next)
+    {
+        block_t *block = (block_t *)node->data;
+        if (block->size > largest)
+            largest = block->size;
+    }
+    *pFrag = (h->bytesFree ? 1.0 - ((double)largest / h->bytesFree) : 0.0);
+    mutex_unlock(&h->mutex);
+
+    for (s = 1; s < dimof(slots); s += 2)
+    {
+        if (slots[s] && heap_free(h, slots[s]) == false_e)
+            ret = false_e;
+    }
+    if (ret == false_e) {
+        SOSAL_PRINT(SOSAL_ZONE_ERROR, "ERROR! heap churn failed to allocate or free a buffer\n");
+    }
+    return ret;
+}
+
+typedef struct _heap_unittest_worker_t {
+    heap_t  *heap;
+    uint32_t seed;
+    uint32_t errors;
+} heap_unittest_worker_t;
+
+static thread_ret_t heap_unittest_worker(void *arg)
+{
+    heap_unittest_worker_t *w = (heap_unittest_worker_t *)arg;
+    // sizes go past the largest class so the best fit fallback is used too
+    size_t maxSize = w->heap->align << HEAP_SLAB_CLASSES;
+    uint8_t *bufs[16];
+    size_t sizes[16];
+    uint8_t fill[16];
+    uint32_t i, j, k;
+
+    for (i = 0; i < 200; i++)
+    {
+        for (j = 0; j < dimof(bufs); j++)
+        {
+            w->seed = (w->seed * 1103515245) + 12345;
+            sizes[j] = ((w->seed >> 8) % maxSize) + 1;
+            fill[j] = (uint8_t)(w->seed >> 16);
+            bufs[j] = heap_alloc(w->heap, sizes[j]);
+            if (bufs[j])
+                memset(bufs[j], fill[j], sizes[j]);
+            else
+                w->errors++;
+        }
+        for (j = 0; j < dimof(bufs); j++)
+        {
+            if (bufs[j] == NULL)
+                continue;
+            for (k = 0; k < sizes[j]; k++)
+            {
+                if (bufs[j][k] != fill[j])
+                {
+                    w->errors++;
+                    break;
+                }
+            }
+            if (heap_free(w->heap, bufs[j]) == false_e)
+                w->errors++;
+        }
+    }
+    return 0;
+}
+
+bool_e heap_unittest_slab(void *buffer, size_t size)
+{
+    bool_e ret = true_e;
+    heap_unittest_worker_t workers[4];
+    thread_t threads[4];
+    size_t bytesUsed, allocs = 0, frees = 0;
+    heap_slab_cache_t *cache;
+    heap_t h;
+    uint32_t i;
+
+    if (heap_init(&h, buffer, size, 7) == false_e)
+        return false_e;
+    if (heap_slab_init(&h, size/2) == false_e)
+    {
+        heap_deinit(&h);
+        return false_e;
+    }
+    bytesUsed = h.bytesUsed;
+    for (i = 0; i < dimof(workers); i++)
+    {
+        workers[i].heap = &h;
+        workers[i].seed = i + 1;
+        workers[i].errors = 0;
+        threads[i] = thread_create(heap_unittest_worker, &workers[i]);
+    }
+    for (i = 0; i < dimof(workers); i++)
+    {
+        thread_join(threads[i]);
+        if (workers[i].errors > 0)
+        {
+            SOSAL_PRINT(SOSAL_ZONE_ERROR, "ERROR! heap slab worker %u had %u errors\n", i, workers[i].errors);
+            ret = false_e;
+        }
+    }
+    // the workers have exited, so their caches are already back in the heap
+    allocs = h.slab.allocs;
+    frees = h.slab.frees;
+    for (cache = h.slab.caches; cache != NULL; cache = cache->next)
+    {
+        allocs += cache->allocs;
+        frees += cache->frees;
+    }
+    // everything was returned to the slab area and the fallback heap
+    if (allocs == 0 || allocs != frees || h.bytesUsed != bytesUsed)
+    {
+        SOSAL_PRINT(SOSAL_ZONE_ERROR, "ERROR! heap slab has "FMT_SIZE_T" allocs, "FMT_SIZE_T" frees and "FMT_SIZE_T" of "FMT_SIZE_T" bytes used\n",
+                    allocs, frees, h.bytesUsed, bytesUsed);
+        ret = false_e;
+    }
+    heap_deinit(&h);
+    return ret;
+}
+
 bool_e heap_unittest_fragmentation(void *buffer, size_t size)
 {
     bool_e ret = true_e;
     uint32_t p2align = 7;
     uint32_t failures = 0;
+    uint32_t ops = 100000;
+    uint32_t mode;
     void *temp = NULL;
     heap_t h;
     if (heap_init(&h, buffer, size, p2align) == true_e)
@@ -694,6 +1118,26 @@ bool_e heap_unittest_fragmentation(void *buffer, size_t size)
         ret = false_e;
         SOSAL_PRINT(SOSAL_ZONE_ALWAYS, "heap fragmentation test; %u faiiures\n", failures);
     }
+
+    // compare the best fit heap alone against the slab mode on the same churn
+    for (mode = 0; mode < 2 && ret == true_e; mode++)
+    {
+        rtime_t time = 0;
+        double frag = 0.0;
+        if (heap_init(&h, buffer, size, p2align) == false_e)
+            return false_e;
+        if (mode == 1 && heap_slab_init(&h, size/4) == false_e)
+            ret = false_e;
+        // the sizes run to a quarter past the largest class, so a fifth of them
+        // still leave work for the best fit heap to fragment in the slab mode
+        else if (heap_unittest_churn(&h, ops, (5<<p2align) << (HEAP_SLAB_CLASSES - 3), &time, &frag) == false_e)
+            ret = false_e;
+        else {
+            SOSAL_PRINT(SOSAL_ZONE_ALWAYS, "heap %s: %u ops in "FMT_RTIMER_T" us (%lf ops/us), %.2lf%% of the free bytes are fragmented\n",
+                        (mode ? "slab" : "bestfit"), ops, time, (time ? (double)ops/time : 0.0), frag * 100.0);
+        }
+        heap_deinit(&h);
+    }
     return ret;
 }
 
@@ -763,6 +1207,8 @@ bool_e heap_unittest(int argc __attribute__((unused)),
             ret = false_e;
         if (heap_unittest_fragmentation(flatbuffer, size) == false_e)
             ret = false_e;
+        if (heap_unittest_slab(flatbuffer, size) == false_e)
+            ret = false_e;
         free(flatbuffer);
         flatbuffer = NULL;
     }
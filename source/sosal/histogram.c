@@ -15,6 +15,8 @@
  */
 
 #include <sosal/histogram.h>
+#include <sosal/thread.h>
+#include <sosal/rtimer.h>
 #include <sosal/debug.h>
 
 bool_e histogram_init(histogram_t *histogram, uint32_t bins, int32_t min, int32_t max)
@@ -69,6 +71,209 @@ uint32_t histogram_get(histogram_t *histogram, int32_t value)
     return freq;
 }
 
+/** Returns the bin of a value. Values below \ref HISTOGRAM_HDR_SUB_COUNT have
+ * their own bins, after that each power of two range gets as many bins. */
+static uint32_t histogram_hdr_index(uint64_t value)
+{
+    uint32_t msb;
+    if (value < HISTOGRAM_HDR_SUB_COUNT)
+        return (uint32_t)value;
+#if defined(__GNUC__)
+    msb = 63 - __builtin_clzll(value);
+#else
+    for (msb = HISTOGRAM_HDR_SUB_BITS; (value >> msb) > 1; msb++);
+#endif
+    return ((msb - HISTOGRAM_HDR_SUB_BITS + 1) << HISTOGRAM_HDR_SUB_BITS) +
+           (uint32_t)(value >> (msb - HISTOGRAM_HDR_SUB_BITS)) - HISTOGRAM_HDR_SUB_COUNT;
+}
+
+/** Returns the largest value which falls in a bin. */
+static uint64_t histogram_hdr_highest(uint32_t index)
+{
+    uint32_t range = index >> HISTOGRAM_HDR_SUB_BITS;
+    uint64_t low;
+    if (range == 0)
+        return index;
+    low = (uint64_t)(HISTOGRAM_HDR_SUB_COUNT + (index & (HISTOGRAM_HDR_SUB_COUNT - 1))) << (range - 1);
+    return low + ((1ULL << (range - 1)) - 1);
+}
+
+void histogram_hdr_init(histogram_hdr_t *hist)
+{
+    memset((void *)hist, 0, sizeof(histogram_hdr_t));
+    hist->min = (uint64_t)-1;
+}
+
+void histogram_hdr_record(histogram_hdr_t *hist, uint64_t value)
+{
+    uint32_t index = histogram_hdr_index(value);
+#if defined(__GNUC__)
+    uint64_t m;
+    __sync_fetch_and_add(&hist->bins[index], 1);
+    // the extremes only need a compare and swap while they are moving
+    for (m = hist->min; value < m; )
+    {
+        uint64_t prev = __sync_val_compare_and_swap(&hist->min, m, value);
+        if (prev == m)
+            break;
+        m = prev;
+    }
+    for (m = hist->max; value > m; )
+    {
+        uint64_t prev = __sync_val_compare_and_swap(&hist->max, m, value);
+        if (prev == m)
+            break;
+        m = prev;
+    }
+#else
+    hist->bins[index]++;
+    if (value < hist->min)
+        hist->min = value;
+    if (value > hist->max)
+        hist->max = value;
+#endif
+}
+
+void histogram_hdr_merge(histogram_hdr_t *dst, histogram_hdr_t *src)
+{
+    uint32_t i;
+    for (i = 0; i < HISTOGRAM_HDR_BINS; i++)
+    {
+        if (src->bins[i] == 0)
+            continue;
+#if defined(__GNUC__)
+        __sync_fetch_and_add(&dst->bins[i], src->bins[i]);
+#else
+        dst->bins[i] += src->bins[i];
+#endif
+    }
+    if (src->min < dst->min)
+        dst->min = src->min;
+    if (src->max > dst->max)
+        dst->max = src->max;
+}
+
+uint64_t histogram_hdr_count(histogram_hdr_t *hist)
+{
+    uint64_t count = 0;
+    uint32_t i;
+    for (i = 0; i < HISTOGRAM_HDR_BINS; i++)
+        count += hist->bins[i];
+    return count;
+}
+
+uint64_t histogram_hdr_percentile(histogram_hdr_t *hist, double percent)
+{
+    uint64_t count = histogram_hdr_count(hist);
+    uint64_t target, seen = 0;
+    uint32_t i;
+
+    if (count == 0)
+        return 0;
+    if (percent >= 100.0)
+        return hist->max;
+    target = (uint64_t)ceil((percent * count) / 100.0);
+    if (target == 0)
+        target = 1;
+    for (i = 0; i < HISTOGRAM_HDR_BINS; i++)
+    {
+        seen += hist->bins[i];
+        if (seen >= target)
+        {
+            uint64_t value = histogram_hdr_highest(i);
+            return (value < hist->max ? value : hist->max);
+        }
+    }
+    return hist->max;
+}
+
+#define HISTOGRAM_TEST_VALUES   (100000)
+#define HISTOGRAM_TEST_THREADS  (4)
+
+static thread_ret_t histogram_hdr_recorder(void *arg)
+{
+    histogram_hdr_t *hist = (histogram_hdr_t *)arg;
+    uint64_t v;
+    for (v = 1; v <= HISTOGRAM_TEST_VALUES; v++)
+        histogram_hdr_record(hist, v);
+    thread_exit(0);
+}
+
+/** Checks that a percentile is within the precision of the histogram. */
+static bool_e histogram_hdr_near(histogram_hdr_t *hist, double percent, uint64_t expected)
+{
+    uint64_t value = histogram_hdr_percentile(hist, percent);
+    uint64_t slack = (expected >> HISTOGRAM_HDR_SUB_BITS) + 1;
+    if (value + slack < expected || value > expected + slack)
+    {
+        SOSAL_PRINT(SOSAL_ZONE_ERROR, "p%lf was %llu, expected %llu\n", percent,
+                    (unsigned long long)value, (unsigned long long)expected);
+        return false_e;
+    }
+    return true_e;
+}
+
+static bool_e histogram_hdr_unittest(void)
+{
+    bool_e ret = true_e;
+    histogram_hdr_t *hist = (histogram_hdr_t *)calloc(2, sizeof(histogram_hdr_t));
+    thread_t threads[HISTOGRAM_TEST_THREADS];
+    rtime_t start, elapsed;
+    uint64_t v;
+    uint32_t t;
+
+    if (hist == NULL)
+        return false_e;
+
+    // every bin maps back onto the values which land in it
+    for (t = 0; t < HISTOGRAM_HDR_BINS - 1; t++)
+    {
+        if (histogram_hdr_index(histogram_hdr_highest(t)) != t ||
+            histogram_hdr_index(histogram_hdr_highest(t) + 1) != t + 1)
+        {
+            SOSAL_PRINT(SOSAL_ZONE_ERROR, "Histogram bin %u does not round trip!\n", t);
+            ret = false_e;
+            break;
+        }
+    }
+
+    // the cost of recording latencies which jitter around a typical value
+    histogram_hdr_init(&hist[0]);
+    start = rtimer_now();
+    for (v = 1; v <= HISTOGRAM_TEST_VALUES; v++)
+        histogram_hdr_record(&hist[0], 20000 + ((v * 2654435761U) & 0x3FFF));
+    elapsed = rtimer_now() - start;
+    printf("histogram record: %u values in "FMT_RTIMER_T" us (%lf ns/value)\n",
+           HISTOGRAM_TEST_VALUES, rtimer_to_us(elapsed),
+           ((double)elapsed * 1000000000.0 / rtimer_freq()) / HISTOGRAM_TEST_VALUES);
+
+    // a uniform distribution
+    histogram_hdr_init(&hist[0]);
+    for (v = 1; v <= HISTOGRAM_TEST_VALUES; v++)
+        histogram_hdr_record(&hist[0], v);
+    if (histogram_hdr_count(&hist[0]) != HISTOGRAM_TEST_VALUES ||
+        hist[0].min != 1 || hist[0].max != HISTOGRAM_TEST_VALUES ||
+        histogram_hdr_percentile(&hist[0], 100.0) != HISTOGRAM_TEST_VALUES ||
+        histogram_hdr_near(&hist[0], 50.0, HISTOGRAM_TEST_VALUES/2) == false_e ||
+        histogram_hdr_near(&hist[0], 99.0, (HISTOGRAM_TEST_VALUES/100)*99) == false_e ||
+        histogram_hdr_near(&hist[0], 99.9, (HISTOGRAM_TEST_VALUES/1000)*999) == false_e)
+        ret = false_e;
+
+    // concurrent recording loses nothing and merges add up
+    histogram_hdr_init(&hist[1]);
+    for (t = 0; t < HISTOGRAM_TEST_THREADS; t++)
+        threads[t] = thread_create(histogram_hdr_recorder, &hist[1]);
+    for (t = 0; t < HISTOGRAM_TEST_THREADS; t++)
+        thread_join(threads[t]);
+    histogram_hdr_merge(&hist[1], &hist[0]);
+    if (histogram_hdr_count(&hist[1]) != (HISTOGRAM_TEST_THREADS + 1) * HISTOGRAM_TEST_VALUES ||
+        histogram_hdr_near(&hist[1], 50.0, HISTOGRAM_TEST_VALUES/2) == false_e)
+        ret = false_e;
+
+    free(hist);
+    return ret;
+}
+
 bool_e histogram_unittest(int argc __attribute__((unused)), char *argv[] __attribute__((unused)))
 {
     bool_e ret = true_e;
@@ -98,7 +303,8 @@ bool_e histogram_unittest(int argc __attribute__((unused)), char *argv[] __attri
         }
         histogram_deinit(&histogram);
     }
-
+    if (histogram_hdr_unittest() == false_e)
+        ret = false_e;
     return ret;
 }
 
@@ -0,0 +1,402 @@
+/*
+ *  Copyright (C) 2009-2011 Texas Instruments, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sosal/numa.h>
+#include <sosal/thread.h>
+#include <sosal/mutex.h>
+#include <sosal/options.h> // unit test
+#include <sosal/debug.h>
+
+#if defined(LINUX) || defined(ANDROID)
+#include <unistd.h>
+#include <sys/syscall.h>
+#define NUMA_SYSFS_NODE "/sys/devices/system/node/node%u/cpulist"
+#endif
+
+// these come from numaif.h, which is part of libnuma rather than the C library
+#define NUMA_MPOL_PREFERRED (1)
+#define NUMA_MPOL_MF_MOVE   (1<<1)
+
+#define NUMA_MASK_BITS      (8*sizeof(unsigned long))
+
+typedef struct _numa_touch_t {
+    volatile uint8_t *ptr;
+    size_t            size;
+    uint32_t          node;
+} numa_touch_t;
+
+// the topology is read once, and again only when the fake node count changes
+static mutex_t numa_lock = MUTEX_INITIAL;
+static numa_topology_t numa_cache;
+static char numa_cache_env[16];
+static bool_e numa_cache_valid = false_e;
+
+static void numa_cpu_add(numa_topology_t *topo, uint32_t node, uint32_t cpu)
+{
+    if (node < NUMA_NODE_MAX && cpu < topo->numCpus)
+    {
+        if ((topo->cpus[node][cpu/32] & (1U << (cpu%32))) == 0)
+        {
+            topo->cpus[node][cpu/32] |= (1U << (cpu%32));
+            if (node < topo->cpuNode[cpu])
+                topo->cpuNode[cpu] = (uint8_t)node;
+        }
+        if (node >= topo->numNodes)
+            topo->numNodes = node + 1;
+    }
+}
+
+static bool_e numa_cpu_in(numa_topology_t *topo, uint32_t node, uint32_t cpu)
+{
+    if (node < NUMA_NODE_MAX && cpu < topo->numCpus && (topo->cpus[node][cpu/32] & (1U << (cpu%32))))
+        return true_e;
+    return false_e;
+}
+
+#if defined(NUMA_SYSFS_NODE)
+static bool_e numa_sysfs_node(numa_topology_t *topo, uint32_t node)
+{
+    char path[MAX_PATH];
+    char list[1024];
+    char *str = list;
+    FILE *fp = NULL;
+
+    sprintf(path, NUMA_SYSFS_NODE, node);
+    fp = fopen(path, "r");
+    if (fp == NULL)
+        return false_e;
+    if (fgets(list, sizeof(list), fp) == NULL)
+        list[0] = '\0';
+    fclose(fp);
+
+    // the list is formatted as "0-3,8-11"
+    while (*str >= '0' && *str <= '9')
+    {
+        uint32_t first = strtoul(str, &str, 10);
+        uint32_t last = first;
+        uint32_t cpu;
+        if (*str == '-')
+            last = strtoul(str + 1, &str, 10);
+        for (cpu = first; cpu <= last && cpu < topo->numCpus; cpu++)
+            numa_cpu_add(topo, node, cpu);
+        if (*str == ',')
+            str++;
+    }
+    return true_e;
+}
+#endif
+
+static void numa_topology_read(numa_topology_t *topo, char *env)
+{
+    uint32_t c, n, fake = 0;
+
+    memset(topo, 0, sizeof(numa_topology_t));
+#if defined(POSIX)
+    topo->numCpus = (uint32_t)sysconf(_SC_NPROCESSORS_ONLN);
+#elif defined(TARGET_NUM_CORES)
+    topo->numCpus = TARGET_NUM_CORES;
+#endif
+    if (topo->numCpus == 0)
+        topo->numCpus = 1;
+    if (topo->numCpus > NUMA_CPU_MAX)
+        topo->numCpus = NUMA_CPU_MAX;
+    memset(topo->cpuNode, NUMA_NODE_MAX, sizeof(topo->cpuNode));
+
+    if (env)
+        fake = strtoul(env, NULL, 10);
+    if (fake > NUMA_NODE_MAX)
+        fake = NUMA_NODE_MAX;
+
+    if (fake > 0)
+    {
+        // split the CPUs into contiguous blocks, sharing CPUs if there are too few
+        topo->fake = true_e;
+        for (c = 0; c < topo->numCpus; c++)
+            numa_cpu_add(topo, (c * fake) / topo->numCpus, c);
+        for (n = 0; n < fake; n++)
+            numa_cpu_add(topo, n, n % topo->numCpus);
+    }
+    else
+    {
+#if defined(NUMA_SYSFS_NODE)
+        for (n = 0; n < NUMA_NODE_MAX; n++)
+            numa_sysfs_node(topo, n);
+#endif
+        // CPUs which no node claimed go to the first node
+        for (c = 0; c < topo->numCpus; c++)
+            if (topo->cpuNode[c] == NUMA_NODE_MAX)
+                numa_cpu_add(topo, 0, c);
+    }
+    SOSAL_PRINT(SOSAL_ZONE_THREAD, "NUMA: %u nodes over %u CPUs%s\n", topo->numNodes, topo->numCpus, (topo->fake?" (fake)":""));
+}
+
+void numa_topology(numa_topology_t *topo)
+{
+    char *env = getenv(NUMA_FAKE_ENV);
+    mutex_lock(&numa_lock);
+    if (numa_cache_valid == false_e || strncmp(numa_cache_env, (env ? env : ""), sizeof(numa_cache_env) - 1) != 0)
+    {
+        numa_topology_read(&numa_cache, env);
+        memset(numa_cache_env, 0, sizeof(numa_cache_env));
+        if (env)
+            strncpy(numa_cache_env, env, sizeof(numa_cache_env) - 1);
+        numa_cache_valid = true_e;
+    }
+    memcpy(topo, &numa_cache, sizeof(numa_topology_t));
+    mutex_unlock(&numa_lock);
+}
+
+uint32_t numa_node_count(void)
+{
+    numa_topology_t topo;
+    numa_topology(&topo);
+    return topo.numNodes;
+}
+
+int32_t numa_cpu_node(uint32_t cpu)
+{
+    numa_topology_t topo;
+    numa_topology(&topo);
+    if (cpu < topo.numCpus)
+        return topo.cpuNode[cpu];
+    return -1;
+}
+
+int32_t numa_current_node(void)
+{
+    int32_t node = numa_thread_node();
+#if defined(__NR_getcpu)
+    if (node < 0)
+    {
+        unsigned cpu = 0;
+        if (syscall(__NR_getcpu, &cpu, NULL, NULL) == 0)
+            node = numa_cpu_node(cpu);
+    }
+#endif
+    return (node < 0 ? 0 : node);
+}
+
+bool_e numa_thread_pin(uint32_t node)
+{
+    bool_e ret = false_e;
+    numa_topology_t topo;
+    numa_topology(&topo);
+#if defined(__NR_sched_setaffinity)
+    if (node < topo.numNodes)
+    {
+        unsigned long mask[NUMA_CPU_MAX/NUMA_MASK_BITS];
+        uint32_t c, numSet = 0;
+        memset(mask, 0, sizeof(mask));
+        for (c = 0; c < topo.numCpus; c++)
+        {
+            if (numa_cpu_in(&topo, node, c))
+            {
+                mask[c/NUMA_MASK_BITS] |= (1UL << (c%NUMA_MASK_BITS));
+                numSet++;
+            }
+        }
+        if (numSet > 0 && syscall(__NR_sched_setaffinity, 0, sizeof(mask), mask) == 0)
+            ret = true_e;
+    }
+#else
+    if (node == 0 && topo.numNodes == 1)
+        ret = true_e; // there's nowhere else to run
+#endif
+    SOSAL_PRINT(SOSAL_ZONE_THREAD, "NUMA: pinning thread to node %u %s\n", node, (ret?"succeeded":"failed"));
+    return ret;
+}
+
+int32_t numa_thread_node(void)
+{
+    numa_topology_t topo;
+    numa_topology(&topo);
+#if defined(__NR_sched_getaffinity)
+    {
+        unsigned long mask[NUMA_CPU_MAX/NUMA_MASK_BITS];
+        uint32_t c, n, numSet = 0;
+        memset(mask, 0, sizeof(mask));
+        if (syscall(__NR_sched_getaffinity, 0, sizeof(mask), mask) < 0)
+            return -1;
+        for (n = 0; n < topo.numNodes; n++)
+        {
+            bool_e within = true_e;
+            numSet = 0;
+            for (c = 0; c < topo.numCpus; c++)
+            {
+                if (mask[c/NUMA_MASK_BITS] & (1UL << (c%NUMA_MASK_BITS)))
+                {
+                    numSet++;
+                    if (numa_cpu_in(&topo, n, c) == false_e)
+                        within = false_e;
+                }
+            }
+            if (numSet > 0 && within)
+                return (int32_t)n;
+        }
+        return -1;
+    }
+#else
+    return (topo.numNodes == 1 ? 0 : -1);
+#endif
+}
+
+static thread_ret_t numa_touch(void *arg)
+{
+    numa_touch_t *touch = (numa_touch_t *)arg;
+    bool_e ret = numa_thread_pin(touch->node);
+    size_t page = 4096;
+    size_t o;
+#if defined(POSIX)
+    page = (size_t)sysconf(_SC_PAGESIZE);
+#endif
+    if (ret == true_e)
+    {
+        // writing the same value back makes the kernel back the page locally
+        for (o = 0; o < touch->size; o += page)
+            touch->ptr[o] = touch->ptr[o];
+        touch->ptr[touch->size - 1] = touch->ptr[touch->size - 1];
+    }
+    thread_exit(ret);
+}
+
+bool_e numa_memory_place(void *ptr, size_t size, uint32_t node)
+{
+    numa_touch_t touch;
+    numa_topology_t topo;
+    thread_t t;
+
+    numa_topology(&topo);
+    if (ptr == NULL || size == 0 || node >= topo.numNodes)
+        return false_e;
+#if defined(__NR_mbind) && defined(POSIX)
+    if (topo.fake == false_e)
+    {
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        size_t start = (size_t)ptr & ~(page - 1);
+        size_t len = ((size_t)ptr + size) - start;
+        unsigned long nodemask = (1UL << node);
+        if (syscall(__NR_mbind, start, len, NUMA_MPOL_PREFERRED, &nodemask, NUMA_MASK_BITS + 1, NUMA_MPOL_MF_MOVE) == 0)
+            return true_e;
+        SOSAL_PRINT(SOSAL_ZONE_WARNING, "NUMA: mbind of %p for "FMT_SIZE_T" bytes failed, touching instead\n", ptr, size);
+    }
+#endif
+    touch.ptr = (volatile uint8_t *)ptr;
+    touch.size = size;
+    touch.node = node;
+    t = thread_create(numa_touch, &touch);
+    if (t == 0)
+        return false_e;
+    return (thread_join(t) == (thread_ret_t)true_e ? true_e : false_e);
+}
+
+typedef struct _numa_test_t {
+    uint32_t numCpus;
+    int      numErrors;
+    bool_e   verbose;
+} numa_test_t;
+
+static thread_ret_t numa_test_pins(void *arg)
+{
+    numa_test_t *test = (numa_test_t *)arg;
+    uint32_t n;
+    // pinning is done on a separate thread to leave the caller's affinity alone.
+    for (n = 0; n < 2; n++)
+    {
+        int32_t node;
+        if (numa_thread_pin(n) == false_e)
+        {
+            test->numErrors++;
+            continue;
+        }
+        node = numa_thread_node();
+        if (test->verbose)
+            SOSAL_PRINT(SOSAL_ZONE_THREAD, "Pinned to node %u, the thread reports node %d\n", n, node);
+        // the fake nodes share a single CPU, so the query can not tell them apart
+        if (node < 0 || (test->numCpus >= 2 && node != (int32_t)n))
+            test->numErrors++;
+    }
+    thread_exit(0);
+}
+
+bool_e numa_unittest(int argc, char *argv[])
+{
+    numa_topology_t topo;
+    numa_test_t test;
+    uint32_t c, size = 64*1024;
+    uint8_t *ptr = NULL;
+    char prev[16] = {0};
+    option_t opts[] = {
+        {OPTION_TYPE_BOOL, &test.verbose, sizeof(bool_e), "-v", "--verbose", "Used to print out debugging information"},
+    };
+
+    memset(&test, 0, sizeof(test));
+    if (getenv(NUMA_FAKE_ENV))
+        strncpy(prev, getenv(NUMA_FAKE_ENV), sizeof(prev) - 1);
+    option_process(argc, argv, opts, dimof(opts));
+
+    numa_topology(&topo);
+    if (topo.numNodes < 1 || numa_node_count() != topo.numNodes)
+        test.numErrors++;
+    if (test.verbose)
+        SOSAL_PRINT(SOSAL_ZONE_THREAD, "Found %u nodes over %u CPUs\n", topo.numNodes, topo.numCpus);
+
+#if defined(POSIX)
+    setenv(NUMA_FAKE_ENV, "2", 1);
+    numa_topology(&topo);
+    test.numCpus = topo.numCpus;
+    if (topo.fake == false_e || topo.numNodes != 2 || numa_node_count() != 2)
+        test.numErrors++;
+    for (c = 0; c < topo.numCpus; c++)
+    {
+        int32_t node = numa_cpu_node(c);
+        if (node < 0 || node >= 2 || numa_cpu_in(&topo, node, c) == false_e)
+            test.numErrors++;
+    }
+    if (numa_cpu_node(topo.numCpus) != -1)
+        test.numErrors++;
+    if (numa_current_node() < 0 || numa_current_node() >= 2)
+        test.numErrors++;
+    thread_join(thread_create(numa_test_pins, &test));
+
+    ptr = (uint8_t *)malloc(size);
+    if (ptr)
+    {
+        for (c = 0; c < size; c++)
+            ptr[c] = (uint8_t)c;
+        if (numa_memory_place(ptr, size, 1) == false_e || numa_memory_place(ptr, size, 2) == true_e)
+            test.numErrors++;
+        for (c = 0; c < size; c++)
+            if (ptr[c] != (uint8_t)c)
+                break;
+        if (c < size)
+            test.numErrors++;
+        free(ptr);
+    }
+
+    if (prev[0])
+        setenv(NUMA_FAKE_ENV, prev, 1);
+    else
+        unsetenv(NUMA_FAKE_ENV);
+#endif
+
+    if (test.numErrors > 0)
+    {
+        SOSAL_PRINT(SOSAL_ZONE_ERROR, "NUMA test failed with %d errors!\n", test.numErrors);
+        return false_e;
+    }
+    return true_e;
+}
+
@@ -42,6 +42,8 @@ void profiler_stop(profiler_t *pprof)
             pprof->maxTime = pprof->tmpTime;
         pprof->sumTime += pprof->tmpTime;
         pprof->avgTime = pprof->sumTime/pprof->numTimes;
+        if (pprof->hist)
+            histogram_hdr_record(pprof->hist, pprof->tmpTime);
     }
 }
 
@@ -15,8 +15,28 @@
  */
 
 #include <sosal/queue.h>
+#include <sosal/thread.h>
+#include <sosal/trace.h>
 #include <sosal/debug.h>
 
+#ifdef POSIX
+#include <time.h>
+#endif
+
+/** Only a wait on a full queue blocks a writer, and only one on an empty queue
+ * blocks a reader, so only those waits are traced. The ring is read unlocked,
+ * it only says how the queue looked.
+ */
+static bool_e queue_looks_full(queue_t *q)
+{
+    return (q->ringb->numBytesFree == 0 ? true_e : false_e);
+}
+
+static bool_e queue_looks_empty(queue_t *q)
+{
+    return (q->ringb->numBytesUsed == 0 ? true_e : false_e);
+}
+
 void queue_destroy(queue_t *q)
 {
     if (q)
@@ -74,7 +94,10 @@ bool_e queue_write(queue_t *q, bool_e blocking, void *datum)
     {
         if (blocking == true_e)
         {
+            bool_e traced = queue_looks_full(q);
             SOSAL_PRINT(SOSAL_ZONE_QUEUE, "Waiting for Space in Queue %p to Write!\n", q);
+            if (traced)
+                trace_begin("sosal", "queue write wait", (uint32_t)q->msgCount);
             do {
                 ret = event_wait(&q->writeEvent, EVENT_FOREVER);
                 if (ret == false_e) {
@@ -83,6 +106,8 @@ bool_e queue_write(queue_t *q, bool_e blocking, void *datum)
                     SOSAL_PRINT(SOSAL_ZONE_QUEUE, "Queue %p has been write signaled!\n",q);
                 }
             } while (ret == false_e);
+            if (traced)
+                trace_end("sosal", "queue write wait", (uint32_t)q->msgCount);
         }
         mutex_lock(&q->access);
         if (q->active && !q->popped)
@@ -121,7 +146,10 @@ bool_e queue_read(queue_t *q, bool_e blocking, void *datum)
     {
         if (blocking == true_e)
         {
+            bool_e traced = queue_looks_empty(q);
             SOSAL_PRINT(SOSAL_ZONE_QUEUE, "Waiting for Data in Queue %p to Read!\n", q);
+            if (traced)
+                trace_begin("sosal", "queue read wait", (uint32_t)q->msgCount);
             do {
                 ret = event_wait(&q->readEvent, EVENT_FOREVER);
                 if (ret == false_e) {
@@ -131,6 +159,8 @@ bool_e queue_read(queue_t *q, bool_e blocking, void *datum)
                     SOSAL_PRINT(SOSAL_ZONE_QUEUE, "Queue %p has been read signaled!\n",q);
                 }
             } while (ret == false_e);
+            if (traced)
+                trace_end("sosal", "queue read wait", (uint32_t)q->msgCount);
         }
         mutex_lock(&q->access);
         if (q->active && !q->popped)
@@ -161,6 +191,113 @@ bool_e queue_read(queue_t *q, bool_e blocking, void *datum)
     return ret;
 }
 
+/** Raises or lowers the events to match the contents of the ring. */
+static void queue_update_events(queue_t *q)
+{
+    if (q->ringb->numBytesFree > 0) {
+        event_set(&q->writeEvent);
+    } else {
+        event_reset(&q->writeEvent);
+    }
+    if (q->ringb->numBytesUsed > 0) {
+        event_set(&q->readEvent);
+    } else {
+        event_reset(&q->readEvent);
+    }
+}
+
+void *queue_reserve(queue_t *q, bool_e blocking)
+{
+    void *slot = NULL;
+    if (q)
+    {
+        if (blocking == true_e)
+        {
+            bool_e traced = queue_looks_full(q);
+            SOSAL_PRINT(SOSAL_ZONE_QUEUE, "Waiting for Space in Queue %p to Reserve!\n", q);
+            if (traced)
+                trace_begin("sosal", "queue reserve wait", (uint32_t)q->msgCount);
+            while (event_wait(&q->writeEvent, EVENT_FOREVER) == false_e) {
+                SOSAL_PRINT(SOSAL_ZONE_WARNING, "WARNING! Wait for event in queue reserving returned false!\n");
+            }
+            if (traced)
+                trace_end("sosal", "queue reserve wait", (uint32_t)q->msgCount);
+        }
+        mutex_lock(&q->access);
+        // messages are all the same size so a slot never wraps
+        if (q->active && !q->popped)
+            slot = ring_reserve(q->ringb, q->msgSize);
+        if (slot == NULL)
+            mutex_unlock(&q->access);
+    }
+    return slot;
+}
+
+bool_e queue_commit(queue_t *q, bool_e publish)
+{
+    bool_e ret = false_e;
+    if (q)
+    {
+        if (publish == true_e)
+        {
+            ring_commit(q->ringb, q->msgSize);
+            q->msgCount++;
+            queue_update_events(q);
+            ret = true_e;
+        }
+        mutex_unlock(&q->access);
+    }
+    return ret;
+}
+
+void *queue_peek(queue_t *q, bool_e blocking)
+{
+    void *slot = NULL;
+    size_t len = 0;
+    if (q)
+    {
+        if (blocking == true_e)
+        {
+            bool_e traced = queue_looks_empty(q);
+            SOSAL_PRINT(SOSAL_ZONE_QUEUE, "Waiting for Data in Queue %p to Peek!\n", q);
+            if (traced)
+                trace_begin("sosal", "queue peek wait", (uint32_t)q->msgCount);
+            while (event_wait(&q->readEvent, EVENT_FOREVER) == false_e) {
+                SOSAL_PRINT(SOSAL_ZONE_WARNING, "WARNING! Wait for the read event in the queue returned false\n");
+            }
+            if (traced)
+                trace_end("sosal", "queue peek wait", (uint32_t)q->msgCount);
+        }
+        mutex_lock(&q->access);
+        if (q->active && !q->popped)
+        {
+            slot = ring_peek(q->ringb, &len);
+            if (len < q->msgSize)
+                slot = NULL;
+        }
+        if (slot == NULL)
+            mutex_unlock(&q->access);
+    }
+    return slot;
+}
+
+bool_e queue_consume(queue_t *q, bool_e remove)
+{
+    bool_e ret = false_e;
+    if (q)
+    {
+        if (remove == true_e)
+        {
+            ring_consume(q->ringb, q->msgSize);
+            q->msgCount--;
+            queue_update_events(q);
+            ret = true_e;
+        }
+        mutex_unlock(&q->access);
+    }
+    return ret;
+}
+
 void queue_enable(queue_t *q)
 {
     if (q)
@@ -253,6 +390,77 @@ void queue_unpop(queue_t *q)
     }
 }
 
+#define QUEUE_TEST_MSGS     (16)
+#define QUEUE_TEST_ROUNDS   (20000)
+
+/** A message large enough that copying it shows, like a frame and its metadata. */
+typedef struct _queue_test_msg_t {
+    uint32_t index;
+    uint32_t meta[255];
+} queue_test_msg_t;
+
+static thread_ret_t queue_test_consumer(void *arg)
+{
+    queue_t *q = (queue_t *)arg;
+    uint32_t i, errors = 0;
+    for (i = 0; i < QUEUE_TEST_ROUNDS; i++)
+    {
+        queue_test_msg_t *msg = (queue_test_msg_t *)queue_peek(q, true_e);
+        if (msg == NULL)
+        {
+            errors++;
+            break;
+        }
+        if (msg->index != i || msg->meta[254] != i)
+            errors++;
+        queue_consume(q, true_e);
+    }
+    thread_exit((size_t)errors);
+}
+
+#ifdef POSIX
+static uint64_t queue_bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+/** Compares passing large messages by copy and in place. */
+static void queue_benchmark(queue_t *q)
+{
+    static queue_test_msg_t msg;
+    queue_test_msg_t *slot;
+    uint64_t start, copied, inplace;
+    uint32_t i, sum = 0;
+
+    start = queue_bench_now();
+    for (i = 0; i < QUEUE_TEST_ROUNDS; i++)
+    {
+        msg.index = i;
+        msg.meta[254] = i;
+        queue_write(q, false_e, &msg);
+        queue_read(q, false_e, &msg);
+        sum += msg.meta[254];
+    }
+    copied = queue_bench_now() - start;
+    start = queue_bench_now();
+    for (i = 0; i < QUEUE_TEST_ROUNDS; i++)
+    {
+        slot = (queue_test_msg_t *)queue_reserve(q, false_e);
+        slot->index = i;
+        slot->meta[254] = i;
+        queue_commit(q, true_e);
+        slot = (queue_test_msg_t *)queue_peek(q, false_e);
+        sum += slot->meta[254];
+        queue_consume(q, true_e);
+    }
+    inplace = queue_bench_now() - start;
+    printf("queue copy: %u msgs in %llu us, in place: %llu us (sum %u)\n",
+           QUEUE_TEST_ROUNDS, (unsigned long long)(copied/1000), (unsigned long long)(inplace/1000), sum);
+}
+#endif
+
 bool_e queue_unittest(int argc __attribute__((unused)),
                       char *argv[] __attribute__((unused)))
 {
@@ -277,6 +485,42 @@ bool_e queue_unittest(int argc __attribute__((unused)),
     else
         ret = false_e;
 
+    // messages filled and read in place by two threads
+    q = queue_create(QUEUE_TEST_MSGS, sizeof(queue_test_msg_t));
+    if (q)
+    {
+        thread_t consumer = thread_create(queue_test_consumer, q);
+        thread_ret_t errors = 0;
+        for (i = 0; i < QUEUE_TEST_ROUNDS; i++)
+        {
+            queue_test_msg_t *msg = (queue_test_msg_t *)queue_reserve(q, true_e);
+            if (msg == NULL)
+            {
+                ret = false_e;
+                queue_pop(q);
+                break;
+            }
+            msg->index = i;
+            msg->meta[254] = i;
+            queue_commit(q, true_e);
+        }
+        errors = thread_join(consumer);
+        if (errors != 0)
+            ret = false_e;
+
+        // a slot which is given back is not seen by the reader
+        queue_unpop(q);
+        if (queue_reserve(q, false_e) == NULL || queue_commit(q, false_e) == true_e ||
+            queue_peek(q, false_e) != NULL || queue_length(q) != 0)
+            ret = false_e;
+#ifdef POSIX
+        if (ret == true_e)
+            queue_benchmark(q);
+#endif
+        queue_destroy(q);
+    }
+    else
+        ret = false_e;
+
     return ret;
 }
-
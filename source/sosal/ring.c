@@ -16,9 +16,21 @@
 
 #include <sosal/ring.h>
 #include <sosal/debug.h>
+#ifdef POSIX
+#include <time.h>
+#endif
 #ifdef SYSOSAL
 #include <xdc/runtime/Assert.h> //for assert support
 #endif
+#if defined(LINUX) || defined(ANDROID)
+#include <sys/syscall.h>
+#if defined(SYS_memfd_create)
+#define RING_USE_MIRROR
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC (0x0001U)
+#endif
+#endif
+#endif
 
 ring_t *ring_create(size_t totalNumBytes)
 {
@@ -43,12 +55,75 @@ ring_t *ring_create(size_t totalNumBytes)
     return rb;
 }
 
+ring_t *ring_create_mirrored(size_t totalNumBytes)
+{
+#if defined(RING_USE_MIRROR)
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t size = ((totalNumBytes + pageSize - 1) / pageSize) * pageSize;
+    uint8_t *base = MAP_FAILED;
+    ring_t *rb = NULL;
+    int fd = -1;
+
+    if (size == 0)
+        return NULL;
+    fd = (int)syscall(SYS_memfd_create, "sosal_ring", MFD_CLOEXEC);
+    if (fd < 0 || ftruncate(fd, size) < 0)
+    {
+        SOSAL_PRINT(SOSAL_ZONE_WARNING, "Could not create a mirrored ring (errno=%d), using a plain ring\n", errno);
+        if (fd >= 0)
+            close(fd);
+        return ring_create(totalNumBytes);
+    }
+
+    // reserve the address space of both copies, then map the file over each half
+    base = (uint8_t *)mmap(NULL, 2*size, PROT_NONE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (base != MAP_FAILED)
+    {
+        if (mmap(base, size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_FIXED, fd, 0) == MAP_FAILED ||
+            mmap(&base[size], size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_FIXED, fd, 0) == MAP_FAILED)
+        {
+            munmap(base, 2*size);
+            base = MAP_FAILED;
+        }
+    }
+    close(fd);
+    if (base == MAP_FAILED)
+    {
+        SOSAL_PRINT(SOSAL_ZONE_WARNING, "Could not map a mirrored ring (errno=%d), using a plain ring\n", errno);
+        return ring_create(totalNumBytes);
+    }
+
+    rb = (ring_t *)calloc(1, sizeof(ring_t));
+    if (rb == NULL)
+    {
+        munmap(base, 2*size);
+        return NULL;
+    }
+    rb->mirrored = true_e;
+    rb->start = base;
+    rb->totalNumBytes = size;
+    rb->front = rb->start;
+    rb->back = rb->start;
+    rb->end = &(rb->start[rb->totalNumBytes]);
+    rb->numBytesFree = size;
+    rb->numBytesUsed = 0;
+    return rb;
+#else
+    return ring_create(totalNumBytes);
+#endif
+}
+
 void ring_destroy(ring_t *rb)
 {
     if (rb == NULL)
         return;
 
     // destroy the raw buffer
+#if defined(RING_USE_MIRROR)
+    if (rb->mirrored == true_e)
+        munmap(rb->start, 2*rb->totalNumBytes);
+    else
+#endif
     if (rb->start != NULL)
         free(rb->start);
 
@@ -335,6 +410,70 @@ size_t ring_read(ring_t *rb, uint8_t *b, size_t len)
     return numBytesRead;
 }
 
+uint8_t *ring_reserve(ring_t *rb, size_t len)
+{
+    size_t contiguous = 0;
+
+    if (len == 0 || len > rb->numBytesFree)
+        return NULL;
+    if (rb->numBytesUsed == 0)
+    {
+        // nothing is held, so start over to make the largest region
+        rb->front = rb->start;
+        rb->back = rb->start;
+    }
+    if (rb->mirrored == true_e)
+        contiguous = rb->numBytesFree;
+    else if (rb->back >= rb->front)
+        contiguous = (size_t)(rb->end - rb->back);
+    else
+        contiguous = (size_t)(rb->front - rb->back);
+    if (len > contiguous)
+        return NULL;
+    return rb->back;
+}
+
+void ring_commit(ring_t *rb, size_t len)
+{
+    assert(len <= rb->numBytesFree);
+    if (len > rb->numBytesFree)
+        len = rb->numBytesFree;
+    // a mirrored region may run past the end into the second copy
+    rb->back += len;
+    if (rb->back >= rb->end)
+        rb->back -= rb->totalNumBytes;
+    rb->numBytesFree -= len;
+    rb->numBytesUsed += len;
+}
+
+uint8_t *ring_peek(ring_t *rb, size_t *len)
+{
+    if (rb->numBytesUsed == 0)
+    {
+        *len = 0;
+        return NULL;
+    }
+    if (rb->mirrored == true_e)
+        *len = rb->numBytesUsed;
+    else if (rb->back > rb->front)
+        *len = (size_t)(rb->back - rb->front);
+    else
+        *len = (size_t)(rb->end - rb->front);
+    return rb->front;
+}
+
+void ring_consume(ring_t *rb, size_t len)
+{
+    assert(len <= rb->numBytesUsed);
+    if (len > rb->numBytesUsed)
+        len = rb->numBytesUsed;
+    rb->front += len;
+    if (rb->front >= rb->end)
+        rb->front -= rb->totalNumBytes;
+    rb->numBytesUsed -= len;
+    rb->numBytesFree += len;
+}
+
 void ring_print(ring_t *rb)
 {
     size_t i;
@@ -414,3 +553,151 @@ void ring_print(ring_t *rb)
     }
 }
 
+
+#define RING_TEST_SIZE      (4096)
+#define RING_TEST_ROUNDS    (100000)
+
+/** Writes a record of a length byte followed by a counting payload. */
+static size_t ring_test_record(uint8_t *b, uint32_t i)
+{
+    size_t len = 2 + (i * 37) % 250, j;
+    b[0] = (uint8_t)len;
+    for (j = 1; j < len; j++)
+        b[j] = (uint8_t)(i + j);
+    return len;
+}
+
+static bool_e ring_test_check(uint8_t *b, size_t len, uint32_t i)
+{
+    size_t j;
+    if (len != (size_t)b[0])
+        return false_e;
+    for (j = 1; j < len; j++)
+        if (b[j] != (uint8_t)(i + j))
+            return false_e;
+    return true_e;
+}
+
+#ifdef POSIX
+static uint64_t ring_bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+/** Compares passing variable sized records through the copying and in place calls. */
+static void ring_benchmark(void)
+{
+    uint8_t record[256];
+    ring_t *rb = ring_create_mirrored(RING_TEST_SIZE);
+    uint64_t start, copied, inplace;
+    uint32_t i, sum = 0;
+    size_t len, j;
+
+    if (rb == NULL)
+        return;
+    // a plain ring, where the mirror could not be made, hands out no region
+    // which crosses the end of the buffer, so the in place loop needs the mirror.
+    if (rb->mirrored == false_e)
+    {
+        ring_destroy(rb);
+        return;
+    }
+    start = ring_bench_now();
+    for (i = 0; i < RING_TEST_ROUNDS; i++)
+    {
+        len = ring_test_record(record, i);
+        ring_write(rb, record, len);
+        ring_read(rb, record, 1);
+        ring_read(rb, &record[1], record[0] - 1);
+        for (j = 0; j < len; j++)
+            sum += record[j];
+    }
+    copied = ring_bench_now() - start;
+    start = ring_bench_now();
+    for (i = 0; i < RING_TEST_ROUNDS; i++)
+    {
+        uint8_t *b = ring_reserve(rb, sizeof(record));
+        ring_commit(rb, ring_test_record(b, i));
+        b = ring_peek(rb, &len);
+        len = b[0];
+        for (j = 0; j < len; j++)
+            sum += b[j];
+        ring_consume(rb, len);
+    }
+    inplace = ring_bench_now() - start;
+    printf("ring copy: %u records in %llu us, in place: %llu us (sum %u)\n",
+           RING_TEST_ROUNDS, (unsigned long long)(copied/1000), (unsigned long long)(inplace/1000), sum);
+    ring_destroy(rb);
+}
+#endif
+
+bool_e ring_unittest(int argc __attribute__((unused)),
+                     char *argv[] __attribute__((unused)))
+{
+    uint8_t data[16] = {0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15};
+    uint8_t *b;
+    size_t len = 0;
+    uint32_t i, r = 0, w = 0;
+    bool_e ret = true_e;
+    ring_t *rb = ring_create(sizeof(data));
+
+    // a plain ring hands out regions which stop at the end of the buffer
+    if (rb)
+    {
+        ring_write(rb, data, 10);
+        ring_read(rb, data, 6);
+        if (ring_reserve(rb, 8) != NULL)
+            ret = false_e;
+        b = ring_reserve(rb, 6);
+        if (b == NULL)
+            ret = false_e;
+        else
+        {
+            memset(b, 0xAA, 6);
+            ring_commit(rb, 6);
+        }
+        b = ring_peek(rb, &len);
+        if (b == NULL || len != 10 || b[0] != 6 || b[9] != 0xAA)
+            ret = false_e;
+        ring_consume(rb, 4);
+        if (ring_read(rb, data, 6) != 6 || data[0] != 0xAA || rb->numBytesUsed != 0)
+            ret = false_e;
+        ring_destroy(rb);
+    }
+    else
+        ret = false_e;
+
+    // a mirrored ring never splits a record, even while the offsets wrap
+    rb = ring_create_mirrored(RING_TEST_SIZE);
+    if (rb)
+    {
+        while (ret == true_e && r < RING_TEST_ROUNDS/10)
+        {
+            while ((b = ring_reserve(rb, 256)) != NULL)
+                ring_commit(rb, ring_test_record(b, w++));
+            if (rb->mirrored == true_e && rb->numBytesFree >= 256)
+                ret = false_e;
+            for (i = 0; i < 7 && (b = ring_peek(rb, &len)) != NULL; i++, r++)
+            {
+                if (len < b[0] || ring_test_check(b, b[0], r) == false_e)
+                {
+                    SOSAL_PRINT(SOSAL_ZONE_ERROR, "Ring record %u is corrupt!\n", r);
+                    ret = false_e;
+                    break;
+                }
+                ring_consume(rb, b[0]);
+            }
+        }
+        ring_destroy(rb);
+    }
+    else
+        ret = false_e;
+
+#ifdef POSIX
+    if (ret == true_e)
+        ring_benchmark();
+#endif
+    return ret;
+}
@@ -17,6 +17,7 @@
 #if !defined(DARWIN)
 #include <sosal/types.h>
 #include <sosal/rtimer.h>
+#include <sosal/thread.h>
 #else
 #define MACH_TIMER
 #define __LITTLE_ENDIAN__ 1
@@ -45,20 +46,222 @@ typedef uint64_t rtime_t;
 
 #ifdef POSIX_TIMER
 
-rtime_t rtimer_now()
+#include <sched.h>
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <cpuid.h>
+#define RTIMER_COUNTER
+#elif defined(__aarch64__)
+#define RTIMER_COUNTER
+#endif
+
+#define RTIMER_UNCALIBRATED (0)
+#define RTIMER_CALIBRATING  (1)
+#define RTIMER_USE_COUNTER  (2)
+#define RTIMER_USE_CLOCK    (3)
+
+/** The time the counter is calibrated over, in nanoseconds */
+#define RTIMER_CALIBRATION_NS   (5000000)
+
+/** The clock behind rtimer_now, and which the counter is anchored to and
+ * calibrated against. NTP does not slew the raw clock, so the counter and the
+ * clock advance at the same rate and never drift apart.
+ */
+#if defined(CLOCK_MONOTONIC_RAW)
+#define RTIMER_CLOCK    CLOCK_MONOTONIC_RAW
+#else
+#define RTIMER_CLOCK    CLOCK_MONOTONIC
+#endif
+
+static volatile int32_t rtimer_state = RTIMER_UNCALIBRATED;
+static rtime_t rtimer_baseCycles;   // the counter at the anchor
+static rtime_t rtimer_baseTime;     // RTIMER_CLOCK at the anchor
+static rtime_t rtimer_counterFreq;  // ticks of the counter per second
+static uint64_t rtimer_mult;        // nanoseconds per tick << rtimer_shift, always below 2^32
+static uint32_t rtimer_shift;
+
+static rtime_t rtimer_clock(clockid_t id)
 {
     struct timespec t;
-    clock_gettime(CLOCK_MONOTONIC, &t);
-    SOSAL_PRINT(SOSAL_ZONE_TIMER, "TIME sec:%lu nsec:%lu\n",t.tv_sec,t.tv_nsec);
+    clock_gettime(id, &t);
     return (rtime_t)((rtime_t)t.tv_nsec + ((rtime_t)t.tv_sec*BILLION));
 }
 
+#if defined(RTIMER_COUNTER)
+static inline rtime_t rtimer_counter()
+{
+#if defined(__aarch64__)
+    uint64_t v;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r" (v));
+    return v;
+#else
+    uint32_t lo, hi;
+    __asm__ __volatile__("rdtsc" : "=a" (lo), "=d" (hi));
+    return ((rtime_t)hi << 32) | lo;
+#endif
+}
+
+/** The counter must tick at a fixed rate on every core, in every power state. */
+static bool_e rtimer_counter_usable(rtime_t *freq)
+{
+#if defined(__aarch64__)
+    uint64_t v;
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r" (v));
+    *freq = v;
+    return (v > 0 ? true_e : false_e);
+#else
+    unsigned int a, b, c, d;
+    *freq = 0; // calibrated against the clock
+    if (__get_cpuid(0x80000007, &a, &b, &c, &d) == 0 || (d & (1 << 8)) == 0)
+        return false_e; // not an invariant TSC
+#if defined(LINUX) || defined(ANDROID)
+    {
+        // if the kernel has given up on the TSC, so should we
+        char name[32] = {0};
+        FILE *fp = fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+        if (fp)
+        {
+            if (fgets(name, sizeof(name), fp) == NULL || strncmp(name, "tsc", 3) != 0)
+            {
+                fclose(fp);
+                return false_e;
+            }
+            fclose(fp);
+        }
+    }
+#endif
+    return true_e;
+#endif
+}
+
+/** Reads a clock and the counter at the same moment, retrying to shrink the window between them. */
+static rtime_t rtimer_sample(clockid_t id, rtime_t *cycles)
+{
+    rtime_t best = MAX_RTIMER_T, ns = 0;
+    uint32_t i;
+    for (i = 0; i < 5; i++)
+    {
+        rtime_t c0 = rtimer_counter();
+        rtime_t t = rtimer_clock(id);
+        rtime_t c1 = rtimer_counter();
+        if (c1 - c0 < best)
+        {
+            best = c1 - c0;
+            *cycles = c0 + (c1 - c0)/2;
+            ns = t;
+        }
+    }
+    return ns;
+}
+
+static inline rtime_t rtimer_scale(rtime_t cycles)
+{
+    // (cycles * mult) >> shift without overflowing 64 bits
+    return (((cycles >> 32) * rtimer_mult) << (32 - rtimer_shift)) +
+           (((cycles & 0xFFFFFFFF) * rtimer_mult) >> rtimer_shift);
+}
+#endif
+
+/** Picks the counter and measures its rate once, any calls made meanwhile read the clock. */
+static void rtimer_calibrate()
+{
+    int32_t state = RTIMER_USE_CLOCK;
+#if defined(RTIMER_COUNTER)
+    rtime_t freq = 0;
+#endif
+
+    if (!__sync_bool_compare_and_swap(&rtimer_state, RTIMER_UNCALIBRATED, RTIMER_CALIBRATING))
+        return;
+
+#if defined(RTIMER_COUNTER)
+    if (rtimer_counter_usable(&freq))
+    {
+        rtime_t c0 = 0, c1 = 0;
+        rtime_t t0, t1;
+
+        if (freq == 0)
+        {
+            t0 = rtimer_sample(RTIMER_CLOCK, &c0);
+            do {
+                t1 = rtimer_sample(RTIMER_CLOCK, &c1);
+            } while (t1 - t0 < RTIMER_CALIBRATION_NS);
+            freq = ((c1 - c0) * BILLION) / (t1 - t0);
+        }
+        if (freq > 0)
+        {
+            rtimer_counterFreq = freq;
+            for (rtimer_shift = 32; rtimer_shift > 0; rtimer_shift--)
+            {
+                rtimer_mult = ((uint64_t)BILLION << rtimer_shift) / freq;
+                if (rtimer_mult < 0x100000000ULL)
+                    break;
+            }
+            rtimer_baseTime = rtimer_sample(RTIMER_CLOCK, &rtimer_baseCycles);
+            state = RTIMER_USE_COUNTER;
+        }
+    }
+#endif
+    if (state == RTIMER_USE_CLOCK)
+        rtimer_counterFreq = BILLION;
+    SOSAL_PRINT(SOSAL_ZONE_TIMER, "rtimer uses the %s at "FMT_RTIMER_T" Hz\n", (state == RTIMER_USE_COUNTER ? "cycle counter" : "clock"), rtimer_counterFreq);
+    __sync_synchronize();
+    rtimer_state = state;
+}
+
+static inline int32_t rtimer_load_state()
+{
+#if defined(__ATOMIC_ACQUIRE)
+    return __atomic_load_n(&rtimer_state, __ATOMIC_ACQUIRE);
+#else
+    return rtimer_state;
+#endif
+}
+
+/** Returns the calibrated state, a caller which must not mix units waits out a calibration in another thread. */
+static inline int32_t rtimer_get_state(bool_e wait)
+{
+    int32_t state = rtimer_load_state();
+    if (state == RTIMER_UNCALIBRATED)
+    {
+        rtimer_calibrate();
+        state = rtimer_load_state();
+    }
+    while (wait && state == RTIMER_CALIBRATING)
+    {
+        sched_yield();
+        state = rtimer_load_state();
+    }
+    return state;
+}
+
+rtime_t rtimer_now()
+{
+#if defined(RTIMER_COUNTER)
+    if (rtimer_get_state(false_e) == RTIMER_USE_COUNTER)
+        return rtimer_baseTime + rtimer_scale(rtimer_counter() - rtimer_baseCycles);
+#endif
+    return rtimer_clock(RTIMER_CLOCK);
+}
+
 rtime_t rtimer_freq()
 {
-    struct timespec t;
-    clock_getres(CLOCK_MONOTONIC, &t);
-    //SOSAL_PRINT(SOSAL_ZONE_TIMER, "FREQ sec:%lu nsec:%lu\n",t.tv_sec,t.tv_nsec);
-    return (rtime_t)(BILLION/t.tv_nsec);
+    // rtimer_now is always in nanoseconds, whatever the resolution of the clock
+    return BILLION;
+}
+
+rtime_t rtimer_cycles()
+{
+#if defined(RTIMER_COUNTER)
+    if (rtimer_get_state(true_e) == RTIMER_USE_COUNTER)
+        return rtimer_counter();
+#endif
+    return rtimer_clock(RTIMER_CLOCK);
+}
+
+rtime_t rtimer_cycles_freq()
+{
+    rtimer_get_state(true_e);
+    return rtimer_counterFreq;
 }
 
 #elif defined(MACH_TIMER)
@@ -124,20 +327,29 @@ rtime_t rtimer_freq()
 
 #endif
 
+#if !defined(POSIX_TIMER)
+
+rtime_t rtimer_cycles()
+{
+    return rtimer_now();
+}
+
+rtime_t rtimer_cycles_freq()
+{
+    return rtimer_freq();
+}
+
+#endif
+
 rtime_t rtimer_from_rate_to_us(rtime_t t, rtime_t rate)
 {
-    double power = log(rate)/log(10);
-    //SOSAL_PRINT(SOSAL_ZONE_TIMER, "%s: log10("FMT_RTIMER_T")=%lf\n", __FUNCTION__, rate, power);
-    if (power > 6.0)
-    {
-        return (rtime_t)t / pow(10, power - 6.0);
-    }
-    else if (power < 6.0)
-    {
-        return (rtime_t)t * pow(10, 6.0 - power);
-    }
+    // the common rates divide evenly, which keeps this off the FPU
+    if (rate >= 1000000 && (rate % 1000000) == 0)
+        return t / (rate / 1000000);
+    else if (rate > 0 && rate < 1000000 && (1000000 % rate) == 0)
+        return t * (1000000 / rate);
     else
-        return (rtime_t)t;
+        return (rtime_t)((double)t * 1000000.0 / (double)rate);
 }
 
 rtime_t rtimer_to_us(rtime_t t)
@@ -145,6 +357,11 @@ rtime_t rtimer_to_us(rtime_t t)
     return rtimer_from_rate_to_us(t, rtimer_freq());
 }
 
+rtime_t rtimer_cycles_to_us(rtime_t t)
+{
+    return rtimer_from_rate_to_us(t, rtimer_cycles_freq());
+}
+
 double rtimer_from_rate_to_sec(rtime_t t, rtime_t rate)
 {
     return (double)t/rate;
@@ -155,3 +372,93 @@ double rtimer_to_sec(rtime_t t)
     return rtimer_from_rate_to_sec(t, rtimer_freq());
 }
 
+
+#if !defined(DARWIN)
+
+#define RTIMER_TEST_ROUNDS  (1000000)
+#define RTIMER_TEST_SLEEP   (50)
+
+static double rtimer_test_ns(rtime_t t)
+{
+    return (rtimer_to_sec(t) * BILLION) / RTIMER_TEST_ROUNDS;
+}
+
+/** Checks that a measured interval is within 1% (and a scheduling slop) of the reference. */
+static bool_e rtimer_test_close(rtime_t us, rtime_t ref)
+{
+    rtime_t diff = (us > ref ? us - ref : ref - us);
+    return (diff <= (ref / 100) + 200 ? true_e : false_e);
+}
+
+bool_e rtimer_unittest(int argc __attribute__((unused)),
+                       char *argv[] __attribute__((unused)))
+{
+    bool_e ret = true_e;
+    rtime_t start, prev, now, c0, c1;
+    volatile rtime_t sink = 0;
+    uint32_t i;
+
+    // the first call calibrates, time it apart from the rest
+    start = rtimer_now();
+    printf("rtimer: counter at "FMT_RTIMER_T" Hz\n", rtimer_cycles_freq());
+
+    // the cost of a call, and the time must never go backwards
+    start = prev = rtimer_now();
+    for (i = 0; i < RTIMER_TEST_ROUNDS; i++)
+    {
+        now = rtimer_now();
+        if (now < prev)
+            ret = false_e;
+        prev = now;
+    }
+    printf("rtimer: rtimer_now %lf ns/call\n", rtimer_test_ns(prev - start));
+    if (ret == false_e) {
+        SOSAL_PRINT(SOSAL_ZONE_ERROR, "rtimer_now went backwards!\n");
+    }
+    start = rtimer_now();
+    for (i = 0; i < RTIMER_TEST_ROUNDS; i++)
+        sink += rtimer_cycles();
+    printf("rtimer: rtimer_cycles %lf ns/call\n", rtimer_test_ns(rtimer_now() - start));
+#if defined(POSIX_TIMER)
+    start = rtimer_now();
+    for (i = 0; i < RTIMER_TEST_ROUNDS; i++)
+        sink += rtimer_clock(RTIMER_CLOCK);
+    printf("rtimer: clock_gettime %lf ns/call\n", rtimer_test_ns(rtimer_now() - start));
+#endif
+
+    // the counter and the clock must agree over a sleep
+    {
+#if defined(POSIX_TIMER)
+        rtime_t t0 = rtimer_clock(RTIMER_CLOCK), t1;
+#endif
+        start = rtimer_now();
+        c0 = rtimer_cycles();
+        thread_msleep(RTIMER_TEST_SLEEP);
+        c1 = rtimer_cycles();
+        now = rtimer_now();
+#if defined(POSIX_TIMER)
+        t1 = rtimer_clock(RTIMER_CLOCK);
+        if (rtimer_test_close(rtimer_to_us(now - start), (t1 - t0)/1000) == false_e ||
+            rtimer_test_close(rtimer_cycles_to_us(c1 - c0), (t1 - t0)/1000) == false_e)
+#else
+        if (rtimer_to_us(now - start) < RTIMER_TEST_SLEEP * 1000 / 2)
+#endif
+        {
+            SOSAL_PRINT(SOSAL_ZONE_ERROR, "rtimer measured "FMT_RTIMER_T" us ("FMT_RTIMER_T" us in cycles) over a %u ms sleep!\n",
+                        rtimer_to_us(now - start), rtimer_cycles_to_us(c1 - c0), RTIMER_TEST_SLEEP);
+            ret = false_e;
+        }
+    }
+
+    if (rtimer_from_rate_to_us(3000000000ULL, BILLION) != 3000000 ||
+        rtimer_from_rate_to_us(1000, 1000) != 1000000 ||
+        rtimer_from_rate_to_us(32768, 32768) != 1000000 ||
+        rtimer_from_rate_to_us(rtimer_freq(), rtimer_freq()) != 1000000)
+    {
+        SOSAL_PRINT(SOSAL_ZONE_ERROR, "rtimer conversions are wrong!\n");
+        ret = false_e;
+    }
+    return ret;
+}
+
+#endif
@@ -29,8 +29,11 @@ void shared_free(shared_t **pshm)
         if (shm)
         {
 #ifdef SHM_SYSVIPC
+            struct shmid_ds ds;
             shmdt(shm->data);
-            shmctl(shm->shmid, IPC_RMID, 0);
+            // the segment stays while others have it attached, so they can still import it
+            if (shmctl(shm->shmid, IPC_STAT, &ds) == 0 && ds.shm_nattch == 0)
+                shmctl(shm->shmid, IPC_RMID, 0);
 #endif
 #ifdef SHM_QNX
             munmap(shm->data, shm->size);
@@ -15,29 +15,138 @@
  */
 
 #include <sosal/threadpool.h>
+#include <sosal/trace.h>
 #include <sosal/debug.h>
 
+#if defined(LINUX) || defined(ANDROID)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/** Restricts the calling thread to one online CPU, chosen by index. */
+static void threadpool_pin(uint32_t index)
+{
+#if defined(LINUX) || defined(ANDROID)
+    uint32_t mask[32];
+    uint32_t cpu, numCpus = 0;
+
+    memset(mask, 0, sizeof(mask));
+    if (syscall(__NR_sched_getaffinity, 0, sizeof(mask), mask) < 0)
+        return;
+    for (cpu = 0; cpu < sizeof(mask) * 8; cpu++)
+        if (mask[cpu/32] & (1u << (cpu % 32)))
+            numCpus++;
+    if (numCpus == 0)
+        return;
+    index %= numCpus;
+    for (cpu = 0; cpu < sizeof(mask) * 8; cpu++)
+    {
+        if ((mask[cpu/32] & (1u << (cpu % 32))) && index-- == 0)
+        {
+            memset(mask, 0, sizeof(mask));
+            mask[cpu/32] = (1u << (cpu % 32));
+            syscall(__NR_sched_setaffinity, 0, sizeof(mask), mask);
+            break;
+        }
+    }
+#else
+    (void)index; // pinning is not supported
+#endif
+}
+
+/** Adds to the pending count of a group, raising or lowering its event on the transitions through zero. */
+static void threadpool_group_add(threadpool_group_t *group, int32_t count)
+{
+    int32_t pending;
+    mutex_lock(&group->lock);
+    pending = __sync_fetch_and_add(&group->pending, count);
+    if (pending == 0 && count > 0)
+        event_reset(&group->completed);
+    if (pending + count == 0)
+        event_set(&group->completed);
+    mutex_unlock(&group->lock);
+}
+
+/** Counts an item of a group as completed. Only the last item takes the lock. */
+static void threadpool_group_done(threadpool_group_t *group)
+{
+    if (__sync_sub_and_fetch(&group->pending, 1) == 0)
+    {
+        mutex_lock(&group->lock);
+        // an issuer may have added work since
+        if (group->pending == 0)
+            event_set(&group->completed);
+        mutex_unlock(&group->lock);
+    }
+}
+
+/** Claims one of the available items, lowering the work event when the last one is claimed. */
+static bool_e threadpool_claim(threadpool_t *pool)
+{
+    int32_t available = pool->available;
+    while (available > 0)
+    {
+        if (__sync_bool_compare_and_swap(&pool->available, available, available - 1))
+        {
+            if (available == 1)
+            {
+                event_reset(&pool->work);
+                // an issuer may have added work and raised the event before we lowered it
+                if (pool->available > 0)
+                    event_set(&pool->work);
+            }
+            return true_e;
+        }
+        available = pool->available;
+    }
+    return false_e;
+}
+
+/** Takes the oldest item of a deque, copying it into the data of the worker.
+ * The slot is read before the top is claimed. If the claim fails, another worker
+ * took the item, or the issuer reused the slot, and the copy is thrown away.
+ */
+static bool_e threadpool_take(threadpool_t *pool, threadpool_deque_t *deque, threadpool_worker_t *worker, threadpool_group_t **group)
+{
+    uint32_t top = deque->top;
+    uint32_t bottom;
+    uint8_t *slot;
+
+    __sync_synchronize();
+    bottom = deque->bottom;
+    if ((int32_t)(bottom - top) <= 0)
+        return false_e;
+    __sync_synchronize();
+    slot = &deque->slots[(top & deque->mask) * pool->sizeSlot];
+    memcpy(group, slot, sizeof(threadpool_group_t *));
+    memcpy(worker->data, &slot[sizeof(threadpool_group_t *)], pool->sizeWorkItem);
+    return (__sync_bool_compare_and_swap(&deque->top, top, top + 1) ? true_e : false_e);
+}
+
 void threadpool_destroy(threadpool_t *pool)
 {
     if (pool)
     {
         uint32_t i;
-        for (i = 0; i < pool->numWorkers; i++)
+        pool->exiting = true_e;
+        event_set(&pool->work);
+        for (i = 0; i < pool->numWorkers && pool->workers != NULL; i++)
         {
-            queue_pop(pool->workers[i].queue);
-            thread_join(pool->workers[i].handle);
+            if (pool->workers[i].handle)
+                thread_join(pool->workers[i].handle);
             profiler_stop(&pool->workers[i].perf);
-            SOSAL_PRINT(SOSAL_ZONE_THREAD, "Worker %u Thread "THREAD_FMT" took %lf sec to die\n", pool->workers[i].index, pool->workers[i].handle,  rtimer_to_sec(pool->workers[i].perf.tmpTime));
+            SOSAL_PRINT(SOSAL_ZONE_THREAD, "Worker %u Thread "THREAD_FMT" took %lf sec to die, stole %u items\n", pool->workers[i].index, pool->workers[i].handle,  rtimer_to_sec(pool->workers[i].perf.tmpTime), pool->workers[i].numStolen);
             pool->workers[i].handle = 0;
-            queue_destroy(pool->workers[i].queue);
-            pool->workers[i].queue = NULL;
+            free(pool->workers[i].deque.slots);
+            pool->workers[i].deque.slots = NULL;
             free(pool->workers[i].data);
             pool->workers[i].data = NULL;
         }
         free(pool->workers);
         pool->workers = NULL;
-        semaphore_delete(&pool->sem);
-        event_deinit(&pool->completed);
+        event_deinit(&pool->work);
+        mutex_deinit(&pool->issue);
+        threadpool_group_deinit(&pool->group);
         free(pool);
     }
 }
@@ -45,57 +154,99 @@ void threadpool_destroy(threadpool_t *pool)
 static thread_ret_t threadpool_worker(void *arg)
 {
     threadpool_worker_t *worker = (threadpool_worker_t *)arg;
+    threadpool_t *pool = worker->pool;
+    profiler_t perf; // kept by this thread, the workers sit next to each other in the pool
 
     profiler_stop(&worker->perf);
 
     SOSAL_PRINT(SOSAL_ZONE_THREAD, "Worker %u Thread "THREAD_FMT" running! (Launch took %lf sec)\n", worker->index, worker->handle,  rtimer_to_sec(worker->perf.avgTime));
 
-    thread_nextaffinity();
+    if (pool->pinned)
+        threadpool_pin(worker->index);
 
-    profiler_clear(&worker->perf);
-    profiler_start(&worker->perf);
+    profiler_clear(&perf);
+    profiler_start(&perf);
 
-    while (queue_read(worker->queue, true_e, worker->data) == true_e)
+    while (pool->exiting == false_e)
     {
+        threadpool_group_t *group = NULL;
+        uint32_t i = 0;
+
+        // a claim reserves one of the items in the deques, sleep until one can be made
+        if (threadpool_claim(pool) == false_e)
+        {
+            // publish the times only when going idle, not once per item
+            memcpy(&worker->perf, &perf, sizeof(profiler_t));
+            trace_begin("sosal", "work wait", worker->index);
+            event_wait(&pool->work, EVENT_FOREVER);
+            trace_end("sosal", "work wait", worker->index);
+            continue;
+        }
+
+        // look in our own deque first, then steal from the others
+        while (threadpool_take(pool, &pool->workers[(worker->index + i) % pool->numWorkers].deque, worker, &group) == false_e)
+            i++;
+        if ((i % pool->numWorkers) != 0)
+            worker->numStolen++;
+
         worker->active = true_e;
-        profiler_stop(&worker->perf);
-        SOSAL_PRINT(SOSAL_ZONE_THREAD, "Worker %u Thread "THREAD_FMT" took %lf sec to get message\n", worker->index, worker->handle, rtimer_to_sec(worker->perf.tmpTime));
+        profiler_stop(&perf);
+        SOSAL_PRINT(SOSAL_ZONE_THREAD, "Worker %u Thread "THREAD_FMT" took %lf sec to get message\n", worker->index, worker->handle, rtimer_to_sec(perf.tmpTime));
+        trace_begin("sosal", "work", i);
         worker->function(worker); // <=== WORK IS DONE HERE
-        semaphore_wait(&worker->pool->sem);
-        worker->pool->numCurrentItems--;
-        if (worker->pool->numCurrentItems <= 0)
-            event_set(&worker->pool->completed);
-        semaphore_post(&worker->pool->sem);
-        SOSAL_PRINT(SOSAL_ZONE_THREAD, "Worker %u Thread "THREAD_FMT" completed work, %u items left\n", worker->index, worker->handle, worker->pool->numCurrentItems);
-        profiler_start(&worker->perf);
+        trace_end("sosal", "work", i);
+        // the group may be gone once it is done, so it is not touched again
+        threadpool_group_done(group);
+        SOSAL_PRINT(SOSAL_ZONE_THREAD, "Worker %u Thread "THREAD_FMT" completed work\n", worker->index, worker->handle);
+        profiler_start(&perf);
         worker->active = false_e;
     }
+    memcpy(&worker->perf, &perf, sizeof(profiler_t));
     SOSAL_PRINT(SOSAL_ZONE_THREAD, "Worker %u Thread "THREAD_FMT" exitting!\n", worker->index, worker->handle);
     thread_exit(0);
 }
 
-threadpool_t *threadpool_create(uint32_t numThreads, uint32_t numWorkItems, size_t sizeWorkItem, threadpool_f worker, void *arg)
+static threadpool_t *threadpool_create_internal(uint32_t numThreads, uint32_t numWorkItems, size_t sizeWorkItem, threadpool_f worker, void *arg, bool_e pinned)
 {
     threadpool_t *pool = (threadpool_t *)calloc(1, sizeof(threadpool_t));
     if (pool)
     {
-        uint32_t i;
-        semaphore_create(&pool->sem, 1, false_e);
+        uint32_t i, numSlots = 1;
+        while (numSlots < numWorkItems)
+            numSlots <<= 1;
+        event_init(&pool->work, false_e);
+        mutex_init(&pool->issue);
+        threadpool_group_init(&pool->group);
         pool->numWorkers = numThreads;
         pool->numWorkItems = numWorkItems;
         pool->sizeWorkItem = sizeWorkItem;
-        event_init(&pool->completed, false_e);
+        pool->sizeSlot = sizeof(threadpool_group_t *) + ((sizeWorkItem + sizeof(void *) - 1) & ~(sizeof(void *) - 1));
+        pool->pinned = pinned;
         pool->workers = (threadpool_worker_t *)calloc(pool->numWorkers, sizeof(threadpool_worker_t));
         if (pool->workers)
         {
             for (i = 0; i < pool->numWorkers; i++)
             {
                 pool->workers[i].data = calloc(1, sizeWorkItem);
-                pool->workers[i].queue = queue_create(numWorkItems, sizeWorkItem);
+                pool->workers[i].deque.mask = numSlots - 1;
+                pool->workers[i].deque.slots = (uint8_t *)calloc(numSlots, pool->sizeSlot);
                 pool->workers[i].index = i;
                 pool->workers[i].arg = arg;
                 pool->workers[i].function = worker;
                 pool->workers[i].pool = pool; // back reference to top level info
+            }
+            for (i = 0; i < pool->numWorkers; i++)
+            {
+                if (pool->workers[i].data == NULL || pool->workers[i].deque.slots == NULL)
+                    break;
+            }
+            if (i < pool->numWorkers)
+            {
+                threadpool_destroy(pool);
+                return NULL;
+            }
+            for (i = 0; i < pool->numWorkers; i++)
+            {
                 profiler_clear(&pool->workers[i].perf);
                 profiler_start(&pool->workers[i].perf);
                 pool->workers[i].handle = thread_create(threadpool_worker, &pool->workers[i]);
@@ -105,56 +256,109 @@ threadpool_t *threadpool_create(uint32_t numThreads, uint32_t numWorkItems, size
     return pool;
 }
 
-bool_e threadpool_issue(threadpool_t *pool, void *workitems[], uint32_t numWorkItems)
+threadpool_t *threadpool_create(uint32_t numThreads, uint32_t numWorkItems, size_t sizeWorkItem, threadpool_f worker, void *arg)
 {
-    uint32_t i;
-    bool_e wrote = false_e;
+    return threadpool_create_internal(numThreads, numWorkItems, sizeWorkItem, worker, arg, false_e);
+}
+
+threadpool_t *threadpool_create_pinned(uint32_t numThreads, uint32_t numWorkItems, size_t sizeWorkItem, threadpool_f worker, void *arg)
+{
+    return threadpool_create_internal(numThreads, numWorkItems, sizeWorkItem, worker, arg, true_e);
+}
+
+bool_e threadpool_issue_group(threadpool_t *pool, threadpool_group_t *group, void *workitems[], uint32_t numWorkItems)
+{
+    uint32_t i, issued = 0;
 
     SOSAL_PRINT(SOSAL_ZONE_THREAD, "About to issue %u workitems!\n", numWorkItems);
-    semaphore_wait(&pool->sem);
-    event_reset(&pool->completed); // we're going to have items to work on, so clear the event
+
+    // count the items before a worker can finish one
+    threadpool_group_add(group, (int32_t)numWorkItems);
+
+    mutex_lock(&pool->issue);
     for (i = 0; i < numWorkItems; i++)
     {
-        uint32_t index = 0xFFFFFFFF;
-        uint32_t count = 0; // cycle-detector
+        uint32_t count;
         // issue the work to the next worker, but don't wait if it's full
-        do {
-            count++;
-            index = pool->nextWorkerIndex;
+        for (count = 0; count < pool->numWorkers; count++)
+        {
+            threadpool_deque_t *deque = &pool->workers[pool->nextWorkerIndex].deque;
+            uint32_t bottom = deque->bottom;
+
             pool->nextWorkerIndex = (pool->nextWorkerIndex + 1) % pool->numWorkers;
-            pool->numCurrentItems++;
-            wrote = queue_write(pool->workers[index].queue, false_e, workitems[i]);
-            if (wrote == false_e) {
-                pool->numCurrentItems--;
+            if ((bottom - deque->top) <= deque->mask && (bottom - deque->top) < pool->numWorkItems)
+            {
+                uint8_t *slot = &deque->slots[(bottom & deque->mask) * pool->sizeSlot];
+                memcpy(slot, &group, sizeof(threadpool_group_t *));
+                memcpy(&slot[sizeof(threadpool_group_t *)], workitems[i], pool->sizeWorkItem);
+                // publish the slot before the bottom
+                __sync_synchronize();
+                deque->bottom = bottom + 1;
+                issued++;
+                break;
             }
-            SOSAL_PRINT(SOSAL_ZONE_THREAD, "Issued workitem %p to worker %u (%s)\n", workitems[i], index, (wrote?"TRUE":"FALSE"));
-        } while (wrote == false_e && count < pool->numWorkers);
+        }
         // there's too much work to do, there's an overflow condition. some of the work may have been issued, others not.
-        if (wrote == false_e)
+        if (count == pool->numWorkers)
             break;
     }
+    mutex_unlock(&pool->issue);
 
-    // if none of the writes worked for whatever reason, and we didn't have any previous pending work (how?) then set the completed event
-    if (pool->numCurrentItems == 0)
-        event_set(&pool->completed);
+    // wake the workers once for the whole batch
+    if (issued > 0)
+    {
+        __sync_fetch_and_add(&pool->available, (int32_t)issued);
+        event_set(&pool->work);
+    }
 
-    semaphore_post(&pool->sem);
-    return wrote;
+    SOSAL_PRINT(SOSAL_ZONE_THREAD, "Issued %u of %u workitems\n", issued, numWorkItems);
+
+    // the items which were not issued will never complete
+    if (issued < numWorkItems)
+        threadpool_group_add(group, -(int32_t)(numWorkItems - issued));
+    return (issued == numWorkItems ? true_e : false_e);
 }
 
-bool_e threadpool_complete(threadpool_t *pool, bool_e blocking)
+bool_e threadpool_issue(threadpool_t *pool, void *workitems[], uint32_t numWorkItems)
+{
+    return threadpool_issue_group(pool, &pool->group, workitems, numWorkItems);
+}
+
+bool_e threadpool_group_init(threadpool_group_t *group)
 {
+    group->pending = 0;
+    mutex_init(&group->lock);
+    event_init(&group->completed, false_e);
+    // nothing is pending yet
+    return event_set(&group->completed);
+}
+
+void threadpool_group_deinit(threadpool_group_t *group)
+{
+    event_deinit(&group->completed);
+    mutex_deinit(&group->lock);
+}
+
+bool_e threadpool_group_complete(threadpool_group_t *group, bool_e blocking)
+{
+    bool_e ret = false_e;
     if (blocking)
-    {
-        return event_wait(&pool->completed, EVENT_FOREVER);
-    }
-    else
-    {
-        if (pool->numCurrentItems == 0)
-            return true_e;
-        else
-            return false_e;
-    }
+        ret = event_wait(&group->completed, EVENT_FOREVER);
+    else if (group->pending != 0)
+        return false_e;
+    // the last worker raises the event while holding the lock, so once the
+    // caller has held the lock too no worker touches the group again and it
+    // may be deinitialized.
+    mutex_lock(&group->lock);
+    if (blocking == false_e)
+        ret = event_wait(&group->completed, 0);
+    mutex_unlock(&group->lock);
+    return ret;
+}
+
+bool_e threadpool_complete(threadpool_t *pool, bool_e blocking)
+{
+    return threadpool_group_complete(&pool->group, blocking);
 }
 
 typedef struct _threadpool_data_t {
@@ -179,6 +383,201 @@ static bool_e threadpool_test(threadpool_worker_t *worker)
     return true_e;
 }
 
+#define THREADPOOL_BENCH_WORKERS   (4)
+#define THREADPOOL_BENCH_ITEMS      (64)
+#define THREADPOOL_BENCH_BATCHES    (500)
+
+typedef struct _threadpool_bench_item_t {
+    uint32_t spins;         /*!< The amount of work to do */
+    volatile uint32_t *sum; /*!< Where to count the finished items */
+} threadpool_bench_item_t;
+
+static bool_e threadpool_bench(threadpool_worker_t *worker)
+{
+    threadpool_bench_item_t *item = (threadpool_bench_item_t *)worker->data;
+    volatile uint32_t x = 0;
+    uint32_t i;
+    for (i = 0; i < item->spins; i++)
+        x += i;
+    __sync_fetch_and_add(item->sum, 1);
+    return true_e;
+}
+
+/** Times batches of even and of uneven items, where every fourth item is heavy.
+ * Round robin placement puts every heavy item on one worker.
+ */
+static bool_e threadpool_unittest_bench(void)
+{
+    threadpool_bench_item_t items[THREADPOOL_BENCH_ITEMS];
+    void *workitems[THREADPOOL_BENCH_ITEMS];
+    volatile uint32_t sum = 0;
+    uint32_t i, b, uneven, expected = 0;
+    bool_e ret = true_e;
+    threadpool_t *pool = threadpool_create(THREADPOOL_BENCH_WORKERS,
+                                           THREADPOOL_BENCH_ITEMS/THREADPOOL_BENCH_WORKERS,
+                                           sizeof(threadpool_bench_item_t), threadpool_bench, NULL);
+    if (pool == NULL)
+        return false_e;
+    for (uneven = 0; uneven < 2; uneven++)
+    {
+        uint32_t batches = (uneven ? THREADPOOL_BENCH_BATCHES/10 : THREADPOOL_BENCH_BATCHES);
+        rtime_t start;
+        for (i = 0; i < THREADPOOL_BENCH_ITEMS; i++)
+        {
+            items[i].spins = (uneven && (i % THREADPOOL_BENCH_WORKERS) == 0 ? 100000 : 10);
+            items[i].sum = &sum;
+            workitems[i] = &items[i];
+        }
+        start = rtimer_now();
+        for (b = 0; b < batches; b++)
+        {
+            if (threadpool_issue(pool, workitems, THREADPOOL_BENCH_ITEMS) == false_e ||
+                threadpool_complete(pool, true_e) == false_e)
+                ret = false_e;
+            expected += THREADPOOL_BENCH_ITEMS;
+        }
+        start = rtimer_now() - start;
+        printf("threadpool %s: %u items in "FMT_RTIMER_T" us (%lf us/item)\n", (uneven ? "uneven" : "even"),
+               batches * THREADPOOL_BENCH_ITEMS, rtimer_to_us(start), (double)rtimer_to_us(start) / (batches * THREADPOOL_BENCH_ITEMS));
+    }
+    threadpool_destroy(pool);
+    if (sum != expected)
+    {
+        printf("ERROR! threadpool completed %u of %u items\n", sum, expected);
+        ret = false_e;
+    }
+    return ret;
+}
+
+/** Issues a heavy and a light group to a pinned pool and waits for each on its own.
+ * The heavy group leaves a worker free, so the light group must be done while
+ * the heavy group is still running.
+ */
+static bool_e threadpool_unittest_groups(void)
+{
+    threadpool_bench_item_t heavy[THREADPOOL_BENCH_WORKERS - 1], light[THREADPOOL_BENCH_ITEMS];
+    void *heavyitems[THREADPOOL_BENCH_WORKERS - 1], *lightitems[THREADPOOL_BENCH_ITEMS];
+    volatile uint32_t heavySum = 0, lightSum = 0;
+    threadpool_group_t heavyGroup, lightGroup;
+    bool_e ret = true_e;
+    uint32_t i, stolen = 0;
+    threadpool_t *pool = threadpool_create_pinned(THREADPOOL_BENCH_WORKERS,
+                                                  THREADPOOL_BENCH_ITEMS/THREADPOOL_BENCH_WORKERS + 1,
+                                                  sizeof(threadpool_bench_item_t), threadpool_bench, NULL);
+    if (pool == NULL)
+        return false_e;
+    threadpool_group_init(&heavyGroup);
+    threadpool_group_init(&lightGroup);
+    for (i = 0; i < dimof(heavy); i++)
+    {
+        heavy[i].spins = 20000000;
+        heavy[i].sum = &heavySum;
+        heavyitems[i] = &heavy[i];
+    }
+    for (i = 0; i < dimof(light); i++)
+    {
+        light[i].spins = 10;
+        light[i].sum = &lightSum;
+        lightitems[i] = &light[i];
+    }
+    if (threadpool_issue_group(pool, &heavyGroup, heavyitems, dimof(heavyitems)) == false_e ||
+        threadpool_issue_group(pool, &lightGroup, lightitems, dimof(lightitems)) == false_e)
+        ret = false_e;
+    if (threadpool_group_complete(&lightGroup, true_e) == false_e || lightSum != dimof(light))
+    {
+        printf("ERROR! light group completed %u of "FMT_CONST" items\n", lightSum, dimof(light));
+        ret = false_e;
+    }
+    else if (heavySum == dimof(heavy))
+    {
+        printf("ERROR! light group waited for the heavy group to complete\n");
+        ret = false_e;
+    }
+    if (threadpool_group_complete(&heavyGroup, true_e) == false_e || heavySum != dimof(heavy))
+    {
+        printf("ERROR! heavy group completed %u of "FMT_CONST" items\n", heavySum, dimof(heavy));
+        ret = false_e;
+    }
+    if (threadpool_group_complete(&lightGroup, false_e) == false_e || threadpool_complete(pool, false_e) == false_e)
+        ret = false_e;
+    for (i = 0; i < pool->numWorkers; i++)
+        stolen += pool->workers[i].numStolen;
+    printf("threadpool groups: the light group finished before the heavy one, %u items were stolen\n", stolen);
+    threadpool_destroy(pool);
+    threadpool_group_deinit(&heavyGroup);
+    threadpool_group_deinit(&lightGroup);
+    return ret;
+}
+
+/** A per worker count, on a cache line of its own. */
+typedef struct _threadpool_slot_t {
+    volatile uint32_t count;
+    uint8_t resv[SOSAL_CACHE_LINE_SIZE - sizeof(uint32_t)];
+} threadpool_slot_t;
+
+static bool_e threadpool_count(threadpool_worker_t *worker)
+{
+    threadpool_bench_item_t *item = (threadpool_bench_item_t *)worker->data;
+    threadpool_slot_t *slots = (threadpool_slot_t *)item->sum;
+    volatile uint32_t x = 0;
+    uint32_t i;
+    for (i = 0; i < item->spins; i++)
+        x += i;
+    // only this worker writes its slot, the slots are summed once the work is complete
+    slots[worker->index].count++;
+    return true_e;
+}
+
+/** Runs the same batches of small items through pools of 1 to N workers. Each
+ * worker counts into its own slot, which are added up once the batches complete.
+ */
+static bool_e threadpool_unittest_scaling(void)
+{
+    threadpool_slot_t slots[THREADPOOL_BENCH_WORKERS];
+    threadpool_bench_item_t items[THREADPOOL_BENCH_ITEMS];
+    void *workitems[THREADPOOL_BENCH_ITEMS];
+    uint32_t n, i, b, batches = THREADPOOL_BENCH_BATCHES/5;
+    bool_e ret = true_e;
+
+    for (i = 0; i < THREADPOOL_BENCH_ITEMS; i++)
+    {
+        items[i].spins = 1000;
+        items[i].sum = (volatile uint32_t *)slots;
+        workitems[i] = &items[i];
+    }
+    for (n = 1; n <= THREADPOOL_BENCH_WORKERS; n++)
+    {
+        uint32_t sum = 0, stolen = 0;
+        rtime_t start;
+        threadpool_t *pool = threadpool_create(n, THREADPOOL_BENCH_ITEMS, sizeof(threadpool_bench_item_t), threadpool_count, NULL);
+        if (pool == NULL)
+            return false_e;
+        memset(slots, 0, sizeof(slots));
+        start = rtimer_now();
+        for (b = 0; b < batches; b++)
+        {
+            if (threadpool_issue(pool, workitems, THREADPOOL_BENCH_ITEMS) == false_e ||
+                threadpool_complete(pool, true_e) == false_e)
+                ret = false_e;
+        }
+        start = rtimer_now() - start;
+        for (i = 0; i < n; i++)
+        {
+            sum += slots[i].count;
+            stolen += pool->workers[i].numStolen;
+        }
+        printf("threadpool scaling: %u workers, %lf us/item, %u items stolen\n", n,
+               (double)rtimer_to_us(start) / (batches * THREADPOOL_BENCH_ITEMS), stolen);
+        threadpool_destroy(pool);
+        if (sum != batches * THREADPOOL_BENCH_ITEMS)
+        {
+            printf("ERROR! %u workers completed %u of %u items\n", n, sum, batches * THREADPOOL_BENCH_ITEMS);
+            ret = false_e;
+        }
+    }
+    return ret;
+}
+
 #ifdef THREADPOOL_TEST
 uint32_t sosal_zone_mask; // declare a local version for testing
 int main(int argc, char *argv[])
@@ -188,6 +587,7 @@ bool_e threadpool_unittest(int argc __attribute__((unused)), char *argv[] __attr
 {
     threadpool_t *pool = NULL;
     threadpool_test_t test;
+    bool_e ret = true_e;
     uint32_t numWorkers = 5;
     threadpool_data_t dummydata[2][10] = {
         { {0}, {1}, {2}, {3}, {4}, {5}, {6}, {7}, {8}, {9}},
@@ -229,9 +629,15 @@ bool_e threadpool_unittest(int argc __attribute__((unused)), char *argv[] __attr
     }
     threadpool_destroy(pool);
     semaphore_delete(&test.sem);
+    if (threadpool_unittest_bench() == false_e)
+        ret = false_e;
+    if (threadpool_unittest_groups() == false_e)
+        ret = false_e;
+    if (threadpool_unittest_scaling() == false_e)
+        ret = false_e;
 #ifdef THREADPOOL_TEST
-    return 0;
+    return (ret == true_e ? 0 : 1);
 #else
-    return true_e;
+    return ret;
 #endif
 }
@@ -0,0 +1,419 @@
+/*
+ *  Copyright (C) 2009-2011 Texas Instruments, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sosal/trace.h>
+#include <sosal/thread.h>
+#include <sosal/queue.h> // just for unittest
+#include <sosal/debug.h>
+
+#if defined(LINUX) || defined(ANDROID)
+#include <sys/syscall.h>
+#include <sched.h>
+#endif
+#if defined(POSIX)
+#include <pthread.h>
+#endif
+
+#if defined(_MSC_VER)
+#define TRACE_LOCAL __declspec(thread)
+#else
+#define TRACE_LOCAL __thread
+#endif
+
+static volatile bool_e trace_on = false_e;
+// the buffers are never freed, a thread may still be writing into one after
+// tracing is stopped. The buffers of exited threads are given to new threads.
+static trace_buffer_t *volatile trace_buffers[TRACE_THREADS_MAX];
+static volatile int32_t trace_numBuffers = 0;
+static TRACE_LOCAL trace_buffer_t *trace_local = NULL;
+static TRACE_LOCAL bool_e trace_localAttached = false_e;
+
+#if defined(POSIX)
+static pthread_once_t trace_keyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t trace_key;
+
+/** Runs as a thread exits, its events stay in the buffer until another thread takes it. */
+static void trace_release(void *arg)
+{
+    trace_buffer_t *buf = (trace_buffer_t *)arg;
+#if defined(__ATOMIC_RELEASE)
+    __atomic_store_n(&buf->owned, 0, __ATOMIC_RELEASE);
+#else
+    __sync_synchronize();
+    buf->owned = 0;
+#endif
+}
+
+static void trace_key_create(void)
+{
+    pthread_key_create(&trace_key, trace_release);
+}
+#endif
+
+/** Gives the calling thread a buffer, or NULL once every buffer is taken. */
+static trace_buffer_t *trace_attach(void)
+{
+    trace_buffer_t *buf = NULL;
+    int32_t index;
+
+    trace_localAttached = true_e;
+    // once every buffer exists, take the buffer of an exited thread
+    for (index = 0; trace_numBuffers >= TRACE_THREADS_MAX && index < TRACE_THREADS_MAX; index++)
+    {
+        trace_buffer_t *old = trace_buffers[index];
+        if (old && old->owned == 0 && __sync_bool_compare_and_swap(&old->owned, 0, 1))
+        {
+            buf = old;
+            buf->head = 0;
+            break;
+        }
+    }
+    if (buf == NULL)
+    {
+        if (trace_numBuffers >= TRACE_THREADS_MAX)
+        {
+            // every thread which owns a buffer is still running
+            trace_localAttached = false_e;
+            return NULL;
+        }
+        buf = (trace_buffer_t *)calloc(1, sizeof(trace_buffer_t));
+        if (buf == NULL)
+            return NULL;
+        buf->owned = 1;
+        index = __sync_fetch_and_add(&trace_numBuffers, 1);
+        if (index >= TRACE_THREADS_MAX)
+        {
+            free(buf);
+            return NULL;
+        }
+        trace_buffers[index] = buf;
+    }
+#if defined(LINUX) || defined(ANDROID)
+    buf->tid = (uint32_t)syscall(SYS_gettid);
+#else
+    buf->tid = (uint32_t)index + 1;
+#endif
+#if defined(POSIX)
+    pthread_once(&trace_keyOnce, trace_key_create);
+    pthread_setspecific(trace_key, buf);
+#endif
+    trace_local = buf;
+    return buf;
+}
+
+static void trace_record(trace_phase_e phase, const char *category, const char *name, uint32_t arg)
+{
+    trace_buffer_t *buf = trace_local;
+    trace_event_t *ev;
+    uint32_t head;
+
+    if (trace_on == false_e)
+        return;
+    if (trace_localAttached == false_e)
+        buf = trace_attach();
+    if (buf == NULL)
+        return;
+
+    head = buf->head;
+    ev = &buf->events[head & (TRACE_EVENTS - 1)];
+    ev->time = rtimer_now();
+    ev->category = category;
+    ev->name = name;
+    ev->arg = arg;
+#if defined(LINUX) || defined(ANDROID)
+    ev->cpu = (uint16_t)sched_getcpu();
+#else
+    ev->cpu = 0;
+#endif
+    ev->phase = (uint8_t)phase;
+    // only the owner writes the buffer, the exporter must see the event before the count
+#if defined(__ATOMIC_RELEASE)
+    __atomic_store_n(&buf->head, head + 1, __ATOMIC_RELEASE);
+#else
+    __sync_synchronize();
+    buf->head = head + 1;
+#endif
+}
+
+void trace_enable(bool_e enable)
+{
+    trace_on = enable;
+}
+
+bool_e trace_enabled(void)
+{
+    return trace_on;
+}
+
+void trace_begin(const char *category, const char *name, uint32_t arg)
+{
+    trace_record(TRACE_PHASE_BEGIN, category, name, arg);
+}
+
+void trace_end(const char *category, const char *name, uint32_t arg)
+{
+    trace_record(TRACE_PHASE_END, category, name, arg);
+}
+
+void trace_instant(const char *category, const char *name, uint32_t arg)
+{
+    trace_record(TRACE_PHASE_INSTANT, category, name, arg);
+}
+
+void trace_reset(void)
+{
+    int32_t i;
+    for (i = 0; i < trace_numBuffers && i < TRACE_THREADS_MAX; i++)
+    {
+        if (trace_buffers[i])
+            trace_buffers[i]->head = 0;
+    }
+}
+
+/** Writes a JSON string, escaping what JSON requires. */
+static void trace_write_string(FILE *fp, const char *str)
+{
+    fputc('"', fp);
+    for (; str && *str; str++)
+    {
+        if (*str == '"' || *str == '\\')
+            fprintf(fp, "\\%c", *str);
+        else if ((unsigned char)*str < 0x20)
+            fprintf(fp, "\\u%04x", (unsigned char)*str);
+        else
+            fputc(*str, fp);
+    }
+    fputc('"', fp);
+}
+
+size_t trace_export(FILE *fp)
+{
+    double usPerTick = 1000000.0 / (double)rtimer_freq();
+    size_t numEvents = 0;
+    uint32_t pid = 0;
+    int32_t i;
+
+#if defined(POSIX)
+    pid = (uint32_t)getpid();
+#endif
+    if (fp == NULL)
+        return 0;
+    fprintf(fp, "{\"traceEvents\":[\n");
+    for (i = 0; i < trace_numBuffers && i < TRACE_THREADS_MAX; i++)
+    {
+        trace_buffer_t *buf = trace_buffers[i];
+        uint32_t head, e;
+
+        if (buf == NULL)
+            continue;
+        head = buf->head;
+        // the oldest events have been overwritten once the ring wrapped
+        for (e = (head > TRACE_EVENTS ? head - TRACE_EVENTS : 0); e < head; e++)
+        {
+            trace_event_t *ev = &buf->events[e & (TRACE_EVENTS - 1)];
+            fprintf(fp, "%s{\"name\":", (numEvents > 0 ? ",\n" : ""));
+            trace_write_string(fp, ev->name);
+            fprintf(fp, ",\"cat\":");
+            trace_write_string(fp, ev->category);
+            fprintf(fp, ",\"ph\":\"%c\",\"ts\":%.3lf,\"pid\":%u,\"tid\":%u,", ev->phase, (double)ev->time * usPerTick, pid, buf->tid);
+            if (ev->phase == TRACE_PHASE_INSTANT)
+                fprintf(fp, "\"s\":\"t\",");
+            fprintf(fp, "\"args\":{\"cpu\":%u,\"arg\":%u}}", ev->cpu, ev->arg);
+            numEvents++;
+        }
+    }
+    fprintf(fp, "\n],\"displayTimeUnit\":\"ns\"}\n");
+    return numEvents;
+}
+
+bool_e trace_export_file(const char *filename)
+{
+    FILE *fp = fopen(filename, "w");
+    size_t numEvents;
+    if (fp == NULL)
+    {
+        SOSAL_PRINT(SOSAL_ZONE_ERROR, "Could not open trace file %s\n", filename);
+        return false_e;
+    }
+    numEvents = trace_export(fp);
+    fclose(fp);
+    SOSAL_PRINT(SOSAL_ZONE_API, "Wrote "FMT_SIZE_T" trace events to %s\n", numEvents, filename);
+    return true_e;
+}
+
+void trace_deinit(void)
+{
+    trace_on = false_e;
+    __sync_synchronize();
+    trace_reset();
+}
+
+#define TRACE_TEST_THREADS  (3)
+#define TRACE_TEST_SPANS    (1000)
+#define TRACE_TEST_ROUNDS   (1000000)
+#define TRACE_TEST_EXITED   (2 * TRACE_THREADS_MAX)
+#define TRACE_TEST_SLEEP    (20)
+
+static volatile int32_t trace_test_recorded = 0;
+
+static thread_ret_t trace_test_thread(void *arg)
+{
+    uint32_t i;
+    for (i = 0; i < TRACE_TEST_SPANS; i++)
+    {
+        trace_begin("test", "span", i);
+        trace_instant("test", "tick", i);
+        trace_end("test", "span", i);
+    }
+    if (trace_local)
+        __sync_fetch_and_add(&trace_test_recorded, 1);
+    thread_exit(0);
+}
+
+/** Blocks on the empty queue until the test writes to it. */
+static thread_ret_t trace_test_reader(void *arg)
+{
+    uint32_t msg = 0;
+    queue_read((queue_t *)arg, true_e, &msg);
+    thread_exit(0);
+}
+
+/** Counts the occurrences of a string in a file. */
+static uint32_t trace_test_count(FILE *fp, const char *str)
+{
+    char line[256];
+    uint32_t count = 0;
+    rewind(fp);
+    while (fgets(line, sizeof(line), fp))
+    {
+        char *s = line;
+        while ((s = strstr(s, str)) != NULL)
+        {
+            count++;
+            s++;
+        }
+    }
+    return count;
+}
+
+bool_e trace_unittest(int argc __attribute__((unused)),
+                      char *argv[] __attribute__((unused)))
+{
+    bool_e ret = true_e;
+    thread_t threads[TRACE_TEST_THREADS];
+    rtime_t start, off, on;
+    uint32_t i, count;
+    FILE *fp = NULL;
+
+    // the cost of a disabled and of an enabled event
+    trace_deinit();
+    start = rtimer_now();
+    for (i = 0; i < TRACE_TEST_ROUNDS; i++)
+        trace_instant("test", "off", i);
+    off = rtimer_now() - start;
+    trace_enable(true_e);
+    start = rtimer_now();
+    for (i = 0; i < TRACE_TEST_ROUNDS; i++)
+        trace_instant("test", "on", i);
+    on = rtimer_now() - start;
+    printf("trace: disabled %lf ns/event, enabled %lf ns/event\n",
+           ((double)off * 1000000000.0 / rtimer_freq()) / TRACE_TEST_ROUNDS,
+           ((double)on * 1000000000.0 / rtimer_freq()) / TRACE_TEST_ROUNDS);
+
+    // a ring keeps only the newest events
+    fp = tmpfile();
+    if (fp == NULL)
+        return false_e;
+    if (trace_export(fp) != TRACE_EVENTS || trace_test_count(fp, "\"name\":\"on\"") != TRACE_EVENTS)
+    {
+        SOSAL_PRINT(SOSAL_ZONE_ERROR, "The wrapped ring exported the wrong events!\n");
+        ret = false_e;
+    }
+    fclose(fp);
+
+    // each thread records into its own ring
+    trace_reset();
+    for (i = 0; i < TRACE_TEST_THREADS; i++)
+        threads[i] = thread_create(trace_test_thread, NULL);
+    for (i = 0; i < TRACE_TEST_THREADS; i++)
+        thread_join(threads[i]);
+    trace_enable(false_e);
+    trace_instant("test", "ignored", 0);
+
+    fp = tmpfile();
+    if (fp == NULL)
+        return false_e;
+    count = (uint32_t)trace_export(fp);
+    if (count != TRACE_TEST_THREADS * TRACE_TEST_SPANS * 3 ||
+        trace_test_count(fp, "\"ph\":\"B\"") != TRACE_TEST_THREADS * TRACE_TEST_SPANS ||
+        trace_test_count(fp, "\"ph\":\"E\"") != TRACE_TEST_THREADS * TRACE_TEST_SPANS ||
+        trace_test_count(fp, "\"traceEvents\":[") != 1 ||
+        trace_test_count(fp, "ignored") != 0)
+    {
+        SOSAL_PRINT(SOSAL_ZONE_ERROR, "The threaded trace exported %u events!\n", count);
+        ret = false_e;
+    }
+    fclose(fp);
+
+    // a read of an empty queue traces its wait, a write with room does not
+    {
+        queue_t *q = queue_create(2, sizeof(uint32_t));
+        uint32_t msg = 0;
+        thread_t reader;
+        if (q == NULL)
+            return false_e;
+        trace_reset();
+        trace_enable(true_e);
+        reader = thread_create(trace_test_reader, q);
+        thread_msleep(TRACE_TEST_SLEEP);
+        queue_write(q, true_e, &msg);
+        thread_join(reader);
+        trace_enable(false_e);
+        queue_destroy(q);
+        fp = tmpfile();
+        if (fp == NULL)
+            return false_e;
+        trace_export(fp);
+        if (trace_test_count(fp, "\"name\":\"queue write wait\"") != 0 ||
+            trace_test_count(fp, "\"name\":\"queue read wait\"") != 2)
+        {
+            SOSAL_PRINT(SOSAL_ZONE_ERROR, "The queue waits were not traced!\n");
+            ret = false_e;
+        }
+        fclose(fp);
+    }
+
+#if defined(POSIX)
+    // the buffers of exited threads are given to new threads, so every one
+    // of more threads than buffers records.
+    trace_enable(true_e);
+    trace_test_recorded = 0;
+    for (i = 0; i < TRACE_TEST_EXITED; i++)
+    {
+        thread_t thread = thread_create(trace_test_thread, NULL);
+        thread_join(thread);
+    }
+    trace_enable(false_e);
+    if (trace_test_recorded != TRACE_TEST_EXITED)
+    {
+        SOSAL_PRINT(SOSAL_ZONE_ERROR, "Only %d of %u exited threads recorded events!\n", trace_test_recorded, TRACE_TEST_EXITED);
+        ret = false_e;
+    }
+#endif
+    trace_deinit();
+    return ret;
+}
+
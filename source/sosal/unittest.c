@@ -24,16 +24,18 @@ unittest_t tests[] = {
   // fourcc ?
   // fph ?
     {"hash",        hash_unittest,      true_e},
-  //{"heap",        heap_unittest,      true_e},
+    {"heap",        heap_unittest,      true_e},
     {"histogram",   histogram_unittest, true_e},
     {"ini",         ini_unittest,       true_e},
     {"list",        list_unittest,      true_e},
     {"module",      module_unittest,    false_e}, // needs explicit arguments
     // mutex ?
+    {"numa",        numa_unittest,      true_e},
     {"options",     option_unittest,    true_e},
     // profiler ?
     {"queue",       queue_unittest,     true_e},
-    // ring ?
+    {"ring",        ring_unittest,      true_e},
+    {"rtimer",      rtimer_unittest,    true_e},
     {"rpc",         rpc_unittest,       true_e},
     // semaphores ?
     // serial ?
@@ -41,6 +43,7 @@ unittest_t tests[] = {
     {"socket",      socket_unittest,    true_e},
     {"threads",     thread_unittest,    true_e},
     {"pool",        threadpool_unittest,true_e},
+    {"trace",       trace_unittest,     true_e},
     {"uinput",      uinput_unittest,    false_e}, // needs explicit arguments
     {"btreelist",   btreelist_unittest, true_e},
     // vector ?